@@ -0,0 +1,149 @@
+/***************************************************************
+* Summary: Collects timing samples per benchmark phase, checks *
+*          them against regression thresholds and writes the   *
+*          results as JSON.                                    *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "BenchmarkReport.h"
+#include <sstream>
+#include <fstream>
+
+namespace {
+    std::string jsonString(const std::string & value) {
+        std::stringstream json;
+        json << '"';
+        for(unsigned int i = 0; i < value.size(); i++) {
+            char c = value[i];
+            if(c == '"' || c == '\\')
+                json << '\\' << c;
+            else if(c == '\n')
+                json << "\\n";
+            else if(c == '\t')
+                json << "\\t";
+            else
+                json << c;
+        }
+        json << '"';
+        return json.str();
+    }
+
+    std::string jsonNumber(double value) {
+        std::stringstream json;
+        json.precision(9);
+        json << value;
+        return json.str();
+    }
+}
+
+BenchmarkReport::Phase::Phase() {
+    count = 0;
+    total = 0.0;
+    min = 0.0;
+    max = 0.0;
+    threshold = -1.0;
+}
+
+BenchmarkReport::BenchmarkReport(const std::string & name) {
+    m_name = name;
+}
+
+BenchmarkReport::~BenchmarkReport() {
+
+}
+
+void BenchmarkReport::setConfig(const std::string & key, double value) {
+    this->m_config.push_back( std::make_pair(key, jsonNumber(value)) );
+}
+
+void BenchmarkReport::setConfig(const std::string & key, const std::string & value) {
+    this->m_config.push_back( std::make_pair(key, jsonString(value)) );
+}
+
+BenchmarkReport::Phase & BenchmarkReport::getPhase(const std::string & phase) {
+    std::map<std::string, unsigned int>::iterator it = this->m_phaseIndices.find(phase);
+    if(it != this->m_phaseIndices.end())
+        return this->m_phases[it->second];
+    this->m_phaseIndices[phase] = (unsigned int)this->m_phases.size();
+    this->m_phases.push_back(Phase());
+    this->m_phases.back().name = phase;
+    return this->m_phases.back();
+}
+
+void BenchmarkReport::addSample(const std::string & phase, double seconds) {
+    Phase & sampled = this->getPhase(phase);
+    if(sampled.count == 0 || seconds < sampled.min)
+        sampled.min = seconds;
+    if(sampled.count == 0 || seconds > sampled.max)
+        sampled.max = seconds;
+    sampled.total += seconds;
+    sampled.count++;
+}
+
+void BenchmarkReport::setThreshold(const std::string & phase, double seconds) {
+    this->getPhase(phase).threshold = seconds;
+}
+
+bool BenchmarkReport::readThresholds(const std::string & filePath) {
+    std::ifstream thresholdFile(filePath.c_str());
+    if(!thresholdFile)
+        return false;
+    std::string line;
+    while(std::getline(thresholdFile, line)) {
+        if(line.empty() || line[0] == '#')
+            continue;
+        std::stringstream ss(line);
+        std::string phase;
+        double seconds;
+        if(ss >> phase >> seconds)
+            this->setThreshold(phase, seconds);
+    }
+    return true;
+}
+
+bool BenchmarkReport::passed() const {
+    for(unsigned int i = 0; i < this->m_phases.size(); i++) {
+        if(!this->m_phases[i].passed())
+            return false;
+    }
+    return true;
+}
+
+std::string BenchmarkReport::toJson() const {
+    std::stringstream json;
+    json << "{\n";
+    json << "  \"name\": " << jsonString(this->m_name) << ",\n";
+    json << "  \"config\": {";
+    for(unsigned int i = 0; i < this->m_config.size(); i++) {
+        json << (i == 0 ? "\n" : ",\n") << "    " << jsonString(this->m_config[i].first) << ": " << this->m_config[i].second;
+    }
+    json << (this->m_config.empty() ? "},\n" : "\n  },\n");
+    json << "  \"phases\": [";
+    for(unsigned int i = 0; i < this->m_phases.size(); i++) {
+        const Phase & phase = this->m_phases[i];
+        json << (i == 0 ? "\n" : ",\n") << "    {";
+        json << "\"name\": " << jsonString(phase.name);
+        json << ", \"count\": " << phase.count;
+        json << ", \"total\": " << jsonNumber(phase.total);
+        json << ", \"mean\": " << jsonNumber(phase.mean());
+        json << ", \"min\": " << jsonNumber(phase.min);
+        json << ", \"max\": " << jsonNumber(phase.max);
+        if(phase.threshold >= 0.0)
+            json << ", \"threshold\": " << jsonNumber(phase.threshold);
+        else
+            json << ", \"threshold\": null";
+        json << ", \"passed\": " << (phase.passed() ? "true" : "false") << "}";
+    }
+    json << (this->m_phases.empty() ? "],\n" : "\n  ],\n");
+    json << "  \"passed\": " << (this->passed() ? "true" : "false") << "\n";
+    json << "}\n";
+    return json.str();
+}
+
+bool BenchmarkReport::writeJson(const std::string & filePath) const {
+    std::ofstream jsonFile(filePath.c_str());
+    if(!jsonFile)
+        return false;
+    jsonFile << this->toJson();
+    return jsonFile.good();
+}
@@ -0,0 +1,56 @@
+/***************************************************************
+* Summary: Collects timing samples per benchmark phase, checks *
+*          them against regression thresholds and writes the   *
+*          results as JSON.                                    *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _BenchmarkReport
+#define _BenchmarkReport
+
+#include <string>
+#include <vector>
+#include <map>
+
+class BenchmarkReport
+{
+public:
+    struct Phase
+    {
+        Phase();
+        std::string name;
+        unsigned int count;
+        double total; //seconds
+        double min;
+        double max;
+        double threshold; //maximum mean seconds per sample, negative when the phase isn't tracked
+        double mean() const { return count > 0 ? total / count : 0.0; }
+        bool passed() const { return threshold < 0.0 || mean() <= threshold; }
+    };
+
+    BenchmarkReport(const std::string & name = "");
+    ~BenchmarkReport();
+
+    //describes the benchmark configuration in the output, i.e. the number of rigs
+    void setConfig(const std::string & key, double value);
+    void setConfig(const std::string & key, const std::string & value);
+    void addSample(const std::string & phase, double seconds);
+    void setThreshold(const std::string & phase, double seconds);
+    //reads "phase seconds" pairs, one per line, lines starting with # are ignored
+    bool readThresholds(const std::string & filePath);
+
+    const std::vector<Phase> & getPhases() const { return m_phases; }
+    bool passed() const;
+    std::string toJson() const;
+    bool writeJson(const std::string & filePath) const;
+
+private:
+    Phase & getPhase(const std::string & phase);
+
+    std::string m_name;
+    std::vector<std::pair<std::string, std::string> > m_config; //keys with their values already formatted as JSON
+    std::vector<Phase> m_phases; //in the order they were first sampled
+    std::map<std::string, unsigned int> m_phaseIndices;
+};
+
+#endif //_BenchmarkReport
@@ -9,6 +9,8 @@
 
 #include "Component.h"
 #include "LoadRigUtils.h"
+#include "MetaDataNode.h"
+#include "RigProfiler.h"
 #include <maya/MGlobal.h>
 #include <maya/MPlug.h>
 
@@ -28,6 +30,22 @@ Component::~Component() {
 
 }
 
+GuideTransformsPtr Component::getGuideTransforms() {
+    if(!this->m_pGuideTransforms) {
+        this->m_pGuideTransforms.reset( new GuideTransforms(this->m_pCompGuide) );
+    }
+    return this->m_pGuideTransforms;
+}
+
+void Component::getPlanInput(ComponentPlan::Input & input) {
+    input.name = this->m_pCompGuide->getName().asChar();
+    std::vector<MVectorArray> locations = this->m_pCompGuide->getLocations();
+    for(unsigned int i = 0; i < locations.size(); i++) {
+        input.translations.push_back(locations[i][0]);
+        input.rotations.push_back(locations[i][1]);
+    }
+}
+
 void Component::addChildComp(boost::shared_ptr<Component> comp) {
     this->m_vpChildComps.push_back(comp);
 }
@@ -46,16 +64,12 @@ MStatus Component::setMetaDataNode(MObject metaDataNode) {
 void Component::updateMetaParentNode(MDGModifier & dgMod) {
     //disconnect the old metaParent, connects the new metaParent of the parent component
     MObject newParentObj = this->getMetaParentNode();
-    MFnDependencyNode newParentFn( newParentObj );
     MObject oldParentObj; 
     lrutils::getMetaParent( this->m_metaDataNode, oldParentObj);
-    MFnDependencyNode oldParentFn( oldParentObj );
-
-    MFnDependencyNode metaDataNodeFn( this->m_metaDataNode );
 
-    dgMod.disconnect(oldParentFn.findPlug("metaChildren"), metaDataNodeFn.findPlug("metaParent"));
-    dgMod.connect(newParentFn.findPlug("metaChildren"), metaDataNodeFn.findPlug("metaParent"));
-    dgMod.doIt();
+    dgMod.disconnect(MetaDataNode::getCommonPlug(oldParentObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kMetaParent));
+    dgMod.connect(MetaDataNode::getCommonPlug(newParentObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kMetaParent));
+    lrutils::doIt(dgMod);
 }
 
 MObject Component::getMetaParentNode() {
@@ -22,6 +22,8 @@
 #include "GlobalComponentGuide.h"
 #include "HipComponentGuide.h"
 #include "SpineComponentGuide.h"
+#include "GuideTransforms.h"
+#include "ComponentPlan.h"
 
 typedef boost::shared_ptr<ComponentGuide> ComponentGuidePtr;
 typedef boost::shared_ptr<GlobalComponentGuide> GlobalComponentGuidePtr;
@@ -42,11 +44,22 @@ public:
     virtual void removeComponent(MDGModifier & dgMod) = 0; //removes the component from the scene
     MStatus setMetaDataNode(MObject metaDataNode);
     MObject getMetaDataNode() {return this->m_metaDataNode;};
+    boost::shared_ptr<Component> getParentComp() {return m_pParentComp;};
     //returns the meta data node of the parent component
     MObject getMetaParentNode();
     //updates the metaParent of the component's meta data node
     void updateMetaParentNode(MDGModifier & dgMod);
     MString getRigName() {return m_rigName;};
+    //shares the precomputed guide matrices of the whole rig with this component
+    void setGuideTransforms(GuideTransformsPtr guideTransforms) {m_pGuideTransforms = guideTransforms;};
+    //returns the guide matrices, computing them for this component's guide if none were shared
+    GuideTransformsPtr getGuideTransforms();
+    //copies what the component's build plan is computed from out of its guide, on the main thread
+    virtual void getPlanInput(ComponentPlan::Input & input);
+    //hands the component the plan computed from its plan input, used by the next load or update
+    void setBuildPlan(ComponentPlanPtr plan) {m_pBuildPlan = plan;};
+    //returns the build plan, NULL if none was computed
+    const ComponentPlan * getBuildPlan() {return m_pBuildPlan.get();};
 
 protected:
 
@@ -57,6 +70,8 @@ protected:
     ComponentGuidePtr m_pCompGuide;
     MObject m_metaDataNode; //the corresponding metaDataNode for this component in the DG
     boost::shared_ptr<Component> m_pParentComp; //parent component of this component (if present)
+    GuideTransformsPtr m_pGuideTransforms; //world and local matrices of every guide location in the rig
+    ComponentPlanPtr m_pBuildPlan; //names, matrices and joint orients precomputed for the build
 
 
 };
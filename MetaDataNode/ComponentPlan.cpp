@@ -0,0 +1,112 @@
+/***************************************************************
+* Summary: Build plan of a component: the names, matrices and  *
+*          joint orients its build writes into the scene,      *
+*          computed from a copy of its guide without calling   *
+*          into Maya so that the plans of a rig can be worked  *
+*          out in parallel before it is built.                 *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "ComponentPlan.h"
+#include "GuideTransforms.h"
+#include "JointOrient.h"
+#include "RigProfiler.h"
+#include "WorkerPool.h"
+#include <sstream>
+
+namespace {
+    const char * kPlanPhase = "ComponentPlan::compute";
+
+    class PlanTask : public WorkerPool::Task
+    {
+    public:
+        PlanTask(const ComponentPlan::Input * input, ComponentPlan * plan) : m_input(input), m_plan(plan) {};
+        virtual void run() {
+            bool tracing = RigProfiler::isTracing(RigProfiler::kHelperCategory);
+            if(tracing)
+                RigProfiler::getTraceBuffer().record(TraceBuffer::kBegin, RigProfiler::kHelperCategory, RigProfiler::now(), kPlanPhase);
+            m_plan->compute(*m_input);
+            if(tracing)
+                RigProfiler::getTraceBuffer().record(TraceBuffer::kEnd, RigProfiler::kHelperCategory, RigProfiler::now(), kPlanPhase, m_input->name.c_str());
+        };
+    private:
+        const ComponentPlan::Input * m_input;
+        ComponentPlan * m_plan;
+    };
+}
+
+ComponentPlan::Input::Input() {
+    this->parentWorldMatrix = MMatrix::identity;
+}
+
+ComponentPlan::ComponentPlan() {
+    this->m_computeTime = 0.0;
+}
+
+ComponentPlan::~ComponentPlan() {
+
+}
+
+void ComponentPlan::compute(const Input & input) {
+    double start = RigProfiler::now();
+    unsigned int numLocations = (unsigned int)input.translations.size();
+
+    this->m_worldMatrices.resize(numLocations);
+    this->m_controllerLocalMatrices.resize(numLocations);
+    this->m_parentWorldMatrix = input.parentWorldMatrix;
+    MMatrix parentInverse = input.parentWorldMatrix.inverse();
+    for(unsigned int i = 0; i < numLocations; i++) {
+        this->m_worldMatrices[i] = GuideTransforms::getLocationMatrix(input.translations[i], input.rotations[i]);
+        this->m_controllerLocalMatrices[i] = this->m_worldMatrices[i] * parentInverse;
+        parentInverse = this->m_worldMatrices[i].inverse();
+    }
+
+    //the chain is oriented while it is still under the world, each joint under the one before it
+    std::vector<int> parents(numLocations);
+    for(unsigned int i = 0; i < numLocations; i++) {
+        parents[i] = (int)i - 1;
+    }
+    lrutils::solveJointOrients(input.translations, parents, MMatrix::identity, this->m_jointOrients, this->m_jointTranslations);
+
+    this->m_chainPrefixes = input.chainPrefixes;
+    this->m_jointNames.resize(this->m_chainPrefixes.size());
+    for(unsigned int c = 0; c < this->m_chainPrefixes.size(); c++) {
+        this->m_jointNames[c].resize(numLocations);
+        for(unsigned int i = 0; i < numLocations; i++) {
+            this->m_jointNames[c][i] = lrutils::getJointName(this->m_chainPrefixes[c], i);
+        }
+    }
+    this->m_computeTime = RigProfiler::now() - start;
+}
+
+MString ComponentPlan::getJointName(const MString & prefix, unsigned int num) const {
+    std::string prefixString = prefix.asChar();
+    for(unsigned int c = 0; c < this->m_chainPrefixes.size(); c++) {
+        if(this->m_chainPrefixes[c] == prefixString && num < this->m_jointNames[c].size())
+            return MString(this->m_jointNames[c][num].c_str());
+    }
+    return MString(lrutils::getJointName(prefixString, num).c_str());
+}
+
+std::string lrutils::getJointName(const std::string & prefix, unsigned int num) {
+    std::stringstream name;
+    name << prefix << "_Skel" << num << "_JNT";
+    return name.str();
+}
+
+void lrutils::computePlans(const std::vector<ComponentPlan::Input> & inputs, std::vector<ComponentPlanPtr> & plans, WorkerPool & pool) {
+    RigProfileScope profileScope("lrutils::computePlans");
+    plans.resize(inputs.size());
+    //the plans and tasks are allocated here, the workers only fill them in
+    std::vector<PlanTask> tasks;
+    tasks.reserve(inputs.size());
+    std::vector<WorkerPool::Task*> taskPtrs;
+    for(unsigned int i = 0; i < inputs.size(); i++) {
+        plans[i].reset( new ComponentPlan() );
+        tasks.push_back(PlanTask(&inputs[i], plans[i].get()));
+    }
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        taskPtrs.push_back(&tasks[i]);
+    }
+    pool.run(taskPtrs);
+}
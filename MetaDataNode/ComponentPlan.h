@@ -0,0 +1,81 @@
+/***************************************************************
+* Summary: Build plan of a component: the names, matrices and  *
+*          joint orients its build writes into the scene,      *
+*          computed from a copy of its guide without calling   *
+*          into Maya so that the plans of a rig can be worked  *
+*          out in parallel before it is built.                 *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _ComponentPlan
+#define _ComponentPlan
+
+#include <boost/shared_ptr.hpp>
+#include <maya/MString.h>
+#include <maya/MVector.h>
+#include <maya/MMatrix.h>
+#include <maya/MQuaternion.h>
+#include <string>
+#include <vector>
+
+class WorkerPool;
+
+class ComponentPlan
+{
+public:
+    //everything a plan is computed from, copied out of the component's guide on the main thread
+    struct Input
+    {
+        Input();
+        std::string name; //traced with the planning of the component
+        //translation and rotation (degrees) of every guide location
+        std::vector<MVector> translations;
+        std::vector<MVector> rotations;
+        //world matrix of the controller the first controller group is parented under
+        MMatrix parentWorldMatrix;
+        //prefixes of the joint chains the component builds along its locations
+        std::vector<std::string> chainPrefixes;
+    };
+
+    ComponentPlan();
+    ~ComponentPlan();
+
+    //pure computation, safe to run on any thread
+    void compute(const Input & input);
+
+    //world matrix of every location
+    const std::vector<MMatrix> & getWorldMatrices() const {return m_worldMatrices;};
+    //local matrices of controller groups built along the locations, each under the one before it,
+    //the first under the parent world matrix the plan was computed with
+    const std::vector<MMatrix> & getControllerLocalMatrices() const {return m_controllerLocalMatrices;};
+    const MMatrix & getParentWorldMatrix() const {return m_parentWorldMatrix;};
+    //orients and local translations of a joint chain built along the locations, as
+    //lrutils::orientJointChain would set them before the chain is parented
+    const std::vector<MQuaternion> & getJointOrients() const {return m_jointOrients;};
+    const std::vector<MVector> & getJointTranslations() const {return m_jointTranslations;};
+    //name of joint num of the chain with prefix, formatted on the spot for a chain that wasn't planned
+    MString getJointName(const MString & prefix, unsigned int num) const;
+    double getComputeTime() const {return m_computeTime;};
+
+private:
+    std::vector<MMatrix> m_worldMatrices;
+    std::vector<MMatrix> m_controllerLocalMatrices;
+    MMatrix m_parentWorldMatrix;
+    std::vector<MQuaternion> m_jointOrients;
+    std::vector<MVector> m_jointTranslations;
+    std::vector<std::string> m_chainPrefixes;
+    //m_jointNames[chain][num]
+    std::vector< std::vector<std::string> > m_jointNames;
+    double m_computeTime; //seconds
+};
+
+typedef boost::shared_ptr<ComponentPlan> ComponentPlanPtr;
+
+namespace lrutils {
+    //the joint name lrutils::createJointFromLocation gives joint num of a chain
+    std::string getJointName(const std::string & prefix, unsigned int num);
+    //computes a plan for every input on the pool's threads, plans[i] for inputs[i]
+    void computePlans(const std::vector<ComponentPlan::Input> & inputs, std::vector<ComponentPlanPtr> & plans, WorkerPool & pool);
+}
+
+#endif //_ComponentPlan
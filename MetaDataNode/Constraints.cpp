@@ -0,0 +1,219 @@
+/***************************************************************
+* Summary: Utility functions for creating parent constraints   *
+*          through the API. The constraint nodes are wired and *
+*          their maintain offset values computed directly,     *
+*          without the parentConstraint command.               *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "Constraints.h"
+#include "LoadRigUtils.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MDagModifier.h>
+#include <maya/MDagPath.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnNumericAttribute.h>
+#include <maya/MFnTransform.h>
+#include <maya/MTransformationMatrix.h>
+#include <maya/MMatrix.h>
+#include <maya/MPoint.h>
+#include <maya/MPlug.h>
+#include <maya/MIntArray.h>
+
+namespace {
+
+//a target waiting to be wired to its constraint
+struct PendingTarget
+{
+    MObject constraint;
+    MObject driver;
+    MObject driven;
+    unsigned int index;
+    MString weightName;
+};
+
+MMatrix getWorldMatrix(MObject obj) {
+    MDagPath path;
+    MDagPath::getAPathTo(obj, path);
+    return path.inclusiveMatrix();
+}
+
+//the world matrix moved to the node's rotate pivot, which is where the constraint measures its offsets from
+MMatrix getPivotMatrix(MObject obj) {
+    MFnTransform transformFn( obj );
+    MPoint rotatePivot = transformFn.rotatePivot(MSpace::kTransform);
+    MMatrix pivotMatrix;
+    pivotMatrix[3][0] = rotatePivot.x;
+    pivotMatrix[3][1] = rotatePivot.y;
+    pivotMatrix[3][2] = rotatePivot.z;
+    return pivotMatrix * getWorldMatrix(obj);
+}
+
+MPlug getTargetPlug(MFnDependencyNode & constraintFn, unsigned int index, MString name) {
+    MPlug targetPlug = lrutils::findPlug(constraintFn, "target").elementByLogicalIndex(index);
+    return targetPlug.child( constraintFn.attribute(name) );
+}
+
+//queues the weight attribute of a target, which has to exist before it can be connected
+void addWeightAttribute(MDGModifier & dgMod, PendingTarget & target) {
+    MFnDependencyNode driverFn( target.driver );
+    target.weightName = driverFn.name() + "W" + target.index;
+    MFnNumericAttribute nAttr;
+    MObject weightAttr = nAttr.create(target.weightName, MString("w") + target.index, MFnNumericData::kDouble, 1.0);
+    nAttr.setKeyable(true);
+    nAttr.setMin(0.0);
+    dgMod.addAttribute(target.constraint, weightAttr);
+}
+
+//the same connections parentConstraint makes from a target
+void connectTarget(MDGModifier & dgMod, const PendingTarget & target) {
+    MFnDependencyNode constraintFn( target.constraint );
+    MFnDependencyNode driverFn( target.driver );
+    unsigned int i = target.index;
+    dgMod.connect( lrutils::findPlug(driverFn, "translate"), getTargetPlug(constraintFn, i, "targetTranslate") );
+    dgMod.connect( lrutils::findPlug(driverFn, "rotatePivot"), getTargetPlug(constraintFn, i, "targetRotatePivot") );
+    dgMod.connect( lrutils::findPlug(driverFn, "rotatePivotTranslate"), getTargetPlug(constraintFn, i, "targetRotateTranslate") );
+    dgMod.connect( lrutils::findPlug(driverFn, "rotate"), getTargetPlug(constraintFn, i, "targetRotate") );
+    dgMod.connect( lrutils::findPlug(driverFn, "rotateOrder"), getTargetPlug(constraintFn, i, "targetRotateOrder") );
+    dgMod.connect( lrutils::findPlug(driverFn, "scale"), getTargetPlug(constraintFn, i, "targetScale") );
+    dgMod.connect( lrutils::findPlug(driverFn, "parentMatrix").elementByLogicalIndex(0), getTargetPlug(constraintFn, i, "targetParentMatrix") );
+    if(target.driver.hasFn(MFn::kJoint)) {
+        dgMod.connect( lrutils::findPlug(driverFn, "jointOrient"), getTargetPlug(constraintFn, i, "targetJointOrient") );
+        dgMod.connect( lrutils::findPlug(driverFn, "segmentScaleCompensate"), getTargetPlug(constraintFn, i, "targetScaleCompensate") );
+        dgMod.connect( lrutils::findPlug(driverFn, "inverseScale"), getTargetPlug(constraintFn, i, "targetInverseScale") );
+    }
+    dgMod.connect( lrutils::findPlug(constraintFn, target.weightName), getTargetPlug(constraintFn, i, "targetWeight") );
+}
+
+//the same connections parentConstraint makes to and from the constrained node
+void connectDriven(MDGModifier & dgMod, MObject constraintObj, MObject drivenObj) {
+    MFnDependencyNode constraintFn( constraintObj );
+    MFnDependencyNode drivenFn( drivenObj );
+    dgMod.connect( lrutils::findPlug(drivenFn, "parentInverseMatrix").elementByLogicalIndex(0), lrutils::findPlug(constraintFn, "constraintParentInverseMatrix") );
+    dgMod.connect( lrutils::findPlug(drivenFn, "rotatePivot"), lrutils::findPlug(constraintFn, "constraintRotatePivot") );
+    dgMod.connect( lrutils::findPlug(drivenFn, "rotatePivotTranslate"), lrutils::findPlug(constraintFn, "constraintRotateTranslate") );
+    dgMod.connect( lrutils::findPlug(drivenFn, "rotateOrder"), lrutils::findPlug(constraintFn, "constraintRotateOrder") );
+    if(drivenObj.hasFn(MFn::kJoint))
+        dgMod.connect( lrutils::findPlug(drivenFn, "jointOrient"), lrutils::findPlug(constraintFn, "constraintJointOrient") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintTranslateX"), lrutils::findPlug(drivenFn, "translateX") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintTranslateY"), lrutils::findPlug(drivenFn, "translateY") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintTranslateZ"), lrutils::findPlug(drivenFn, "translateZ") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintRotateX"), lrutils::findPlug(drivenFn, "rotateX") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintRotateY"), lrutils::findPlug(drivenFn, "rotateY") );
+    dgMod.connect( lrutils::findPlug(constraintFn, "constraintRotateZ"), lrutils::findPlug(drivenFn, "rotateZ") );
+}
+
+//wires the pending targets and writes their maintain offsets, the offset holds the driven node where it is
+MStatus applyTargets(MDGModifier & dgMod, std::vector<PendingTarget> & targets, bool maintainOffset) {
+    MStatus status;
+    //the offsets are measured before the constraints start driving anything
+    std::vector<MTransformationMatrix> offsets;
+    if(maintainOffset) {
+        for(unsigned int i = 0; i < targets.size(); i++)
+            offsets.push_back( MTransformationMatrix( getPivotMatrix(targets[i].driven) * getPivotMatrix(targets[i].driver).inverse() ) );
+    }
+
+    for(unsigned int i = 0; i < targets.size(); i++)
+        connectTarget(dgMod, targets[i]);
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    if(!maintainOffset)
+        return status;
+    //the offsets are written one target index at a time
+    std::vector<bool> written(targets.size(), false);
+    for(unsigned int i = 0; i < targets.size(); i++) {
+        if(written[i])
+            continue;
+        std::vector<MObject> constraintObjs;
+        std::vector<MTransformationMatrix> indexOffsets;
+        for(unsigned int j = i; j < targets.size(); j++) {
+            if(written[j] || targets[j].index != targets[i].index)
+                continue;
+            constraintObjs.push_back(targets[j].constraint);
+            indexOffsets.push_back(offsets[j]);
+            written[j] = true;
+        }
+        status = lrutils::setParentConstraintOffsets(constraintObjs, indexOffsets, targets[i].index);
+        MyCheckStatusReturn(status, "lrutils::setParentConstraintOffsets() failed");
+    }
+    return status;
+}
+
+}
+
+MStatus lrutils::createParentConstraint(MObject driverObj, MObject drivenObj, MObject & constraintObj, bool maintainOffset) {
+    RigProfileScope profileScope("lrutils::createParentConstraint");
+    std::vector<MObject> driverObjs(1, driverObj);
+    std::vector<MObject> drivenObjs(1, drivenObj);
+    std::vector<MObject> constraintObjs;
+    MStatus status = lrutils::createParentConstraints(driverObjs, drivenObjs, constraintObjs, maintainOffset);
+    if(status == MS::kSuccess)
+        constraintObj = constraintObjs.at(0);
+    return status;
+}
+
+MStatus lrutils::createParentConstraints(std::vector<MObject> driverObjs, std::vector<MObject> drivenObjs, std::vector<MObject> & constraintObjs, bool maintainOffset) {
+    RigProfileScope profileScope("lrutils::createParentConstraints");
+    MStatus status = MS::kFailure;
+    constraintObjs.clear();
+    if(driverObjs.size() != drivenObjs.size())
+        return status;
+
+    //create every constraint node under its constrained node, with the weight attribute of its first target
+    MDagModifier dagMod;
+    std::vector<PendingTarget> targets;
+    for(unsigned int i = 0; i < drivenObjs.size(); i++) {
+        MObject constraintObj = dagMod.createNode("parentConstraint", drivenObjs[i], &status);
+        MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
+        MFnDependencyNode drivenFn( drivenObjs[i] );
+        dagMod.renameNode(constraintObj, drivenFn.name() + "_parentConstraint1");
+        constraintObjs.push_back(constraintObj);
+
+        PendingTarget target;
+        target.constraint = constraintObj;
+        target.driver = driverObjs[i];
+        target.driven = drivenObjs[i];
+        target.index = 0;
+        addWeightAttribute(dagMod, target);
+        targets.push_back(target);
+    }
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+
+    //then wire the constraints and their targets in one pass
+    for(unsigned int i = 0; i < targets.size(); i++)
+        connectDriven(dagMod, targets[i].constraint, targets[i].driven);
+    return applyTargets(dagMod, targets, maintainOffset);
+}
+
+MStatus lrutils::addParentConstraintTarget(MObject constraintObj, MObject driverObj, bool maintainOffset) {
+    RigProfileScope profileScope("lrutils::addParentConstraintTarget");
+    MStatus status = MS::kFailure;
+    if(constraintObj.isNull() || driverObj.isNull())
+        return status;
+
+    MFnDagNode constraintFn( constraintObj );
+    MIntArray usedIndices;
+    lrutils::findPlug(constraintFn, "target").getExistingArrayAttributeIndices(usedIndices);
+    unsigned int nextIndex = 0;
+    for(unsigned int i = 0; i < usedIndices.length(); i++) {
+        if(usedIndices[i] >= (int)nextIndex)
+            nextIndex = usedIndices[i] + 1;
+    }
+
+    MDGModifier dgMod;
+    std::vector<PendingTarget> targets(1);
+    targets[0].constraint = constraintObj;
+    targets[0].driver = driverObj;
+    targets[0].driven = constraintFn.parent(0);
+    targets[0].index = nextIndex;
+    addWeightAttribute(dgMod, targets[0]);
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return applyTargets(dgMod, targets, maintainOffset);
+}
@@ -0,0 +1,25 @@
+/***************************************************************
+* Summary: Utility functions for creating parent constraints   *
+*          through the API. The constraint nodes are wired and *
+*          their maintain offset values computed directly,     *
+*          without the parentConstraint command.               *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _Constraints
+#define _Constraints
+
+#include <maya/MStatus.h>
+#include <maya/MObject.h>
+#include <vector>
+
+namespace lrutils {
+    //creates a parent constraint from driverObj to drivenObj, like parentConstraint [-mo] driver driven
+    MStatus createParentConstraint(MObject driverObj, MObject drivenObj, MObject & constraintObj, bool maintainOffset = true);
+    //creates one parent constraint for every driver/driven pair, wiring all of them in a single modifier
+    MStatus createParentConstraints(std::vector<MObject> driverObjs, std::vector<MObject> drivenObjs, std::vector<MObject> & constraintObjs, bool maintainOffset = true);
+    //adds driverObj as another target of an existing parent constraint
+    MStatus addParentConstraintTarget(MObject constraintObj, MObject driverObj, bool maintainOffset = true);
+}
+
+#endif //_Constraints
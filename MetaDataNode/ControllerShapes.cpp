@@ -0,0 +1,1077 @@
+/***************************************************************
+* Summary: Compiled library of controller shapes. The CV and   *
+*          knot tables are taken from rig101wireControllers.py *
+*          so that controllers can be built through the API    *
+*          without entering the Python interpreter. Shapes are *
+*          cached per build session as curve data prototypes.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "ControllerShapes.h"
+#include "LoadRigUtils.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MFnNurbsCurve.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MPointArray.h>
+#include <maya/MDoubleArray.h>
+#include <maya/MPlug.h>
+#include <maya/MFnNurbsCurveData.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace {
+
+struct ShapeCurveDef
+{
+    unsigned int degree;
+    MFnNurbsCurve::Form form;
+    unsigned int numCVs;
+    const double (*cvs)[3];
+    unsigned int numKnots;
+    const double * knots;
+};
+
+struct ShapeDef
+{
+    const char * name;
+    unsigned int firstCurve;
+    unsigned int numCurves;
+};
+
+//color names used by Utils.setControllerColor, indexed by overrideColor - 1
+const char * s_colorNames[] = {
+    "black", "darkGray", "lightGray", "darkRed", "darkBlue", "lightBlue", "darkGreen", "darkPurple",
+    "lightPurple", "lightBrown", "darkBrown", "red", "lightRed", "lightGreen", "blue", "white", "yellow",
+    "aquaBlue", "aquaGreen", "paleRed", "paleRed2", "paleYellow", "darkAquaGreen", "paleBrown", "mustard",
+    "leafGreen", "darkAquaGreen2", "darkAquaBlue", "darkPaleBlue", "darkPalePurple", "darkDeepPurple"
+};
+const unsigned int s_numColors = sizeof(s_colorNames) / sizeof(s_colorNames[0]);
+
+//shapes made of a single curve() call or a saved nurbsCurve in rig101wireControllers.py.
+//Shapes built from several transforms or from edits after creation (Transform, Hand,
+//Vision, Cog, Sun, Switch, Paw4Toes, Cylinder, Hex, 180Arc, 2NailLong) are not listed
+//and are still created through Python.
+//FourArrowCircle curve 0
+const double s_FourArrowCircle0CVs[][3] = {
+    {-0.5,-7.174648137e-43,-4.020341149},{-0.6666666667,-7.174648137e-43,-4.020341149},{-0.8333333333,-7.174648137e-43,-4.020341149},{-1,-7.174648137e-43,-4.020341149},
+    {-0.6666666667,-7.174648137e-43,-4.353674482},{-0.3333333333,-7.174648137e-43,-4.687007815},{0,-7.174648137e-43,-5.020341149},{0.3333333333,-7.174648137e-43,-4.687007815},
+    {0.6666666667,-7.174648137e-43,-4.353674482},{1,-7.174648137e-43,-4.020341149},{0.8333333333,-7.174648137e-43,-4.020341149},{0.6666666667,-7.174648137e-43,-4.020341149},
+    {0.5,-7.174648137e-43,-4.020341149},{0.5001137297,-7.174648137e-43,-3.672482108},{0.5002274595,-7.174648137e-43,-3.324623067},{0.5003411892,-7.174648137e-43,-2.976764026},
+    {1.108177363,1.745565691e-16,-2.87106626},{2.269735905,1.383764776e-16,-2.280200525},{2.857367029,6.705346721e-17,-1.115407371},{2.959944795,2.937063387e-17,-0.5000000004},
+    {3.313410247,-7.174648137e-43,-0.5},{3.666875698,-7.174648137e-43,-0.5},{4.020341149,-7.174648137e-43,-0.5},{4.020341149,-7.174648137e-43,-0.5},
+    {4.020341149,-7.174648137e-43,-0.5},{4.020341149,-7.174648137e-43,-0.5},{4.020341149,-7.174648137e-43,-0.6666666667},{4.020341149,-7.174648137e-43,-0.8333333333},
+    {4.020341149,-7.174648137e-43,-1},{4.353674482,-7.174648137e-43,-0.6666666667},{4.687007815,-7.174648137e-43,-0.3333333333},{5.020341149,-7.174648137e-43,1.776356839e-15},
+    {4.687007815,-7.174648137e-43,0.3333333333},{4.353674482,-7.174648137e-43,0.6666666667},{4.020341149,-7.174648137e-43,1},{4.020341149,-7.174648137e-43,0.8333333333},
+    {4.020341149,-7.174648137e-43,0.6666666667},{4.020341149,-7.174648137e-43,0.5},{3.664498126,-7.174648137e-43,0.50011634},{3.308655103,-7.174648137e-43,0.5002326801},
+    {2.952812081,-7.174648137e-43,0.5003490201},{2.844147264,-6.864488355e-17,1.100714875},{2.256686015,-1.38787831e-16,2.246236139},{1.107961251,-1.745633001e-16,2.830493887},
+    {0.5000000008,-1.810323224e-16,2.936141038},{0.5,-7.174648137e-43,3.297541076},{0.5,-7.174648137e-43,3.658941112},{0.5,-7.174648137e-43,4.020341149},
+    {0.6666666667,-7.174648137e-43,4.020341149},{0.8333333333,-7.174648137e-43,4.020341149},{1,-7.174648137e-43,4.020341149},{0.6666666667,-7.174648137e-43,4.353674482},
+    {0.3333333333,-7.174648137e-43,4.687007815},{0,-7.174648137e-43,5.020341149},{-0.3333333333,-7.174648137e-43,4.687007815},{-0.6666666667,-7.174648137e-43,4.353674482},
+    {-1,-7.174648137e-43,4.020341149},{-0.8333333333,-7.174648137e-43,4.020341149},{-0.6666666667,-7.174648137e-43,4.020341149},{-0.5,-7.174648137e-43,4.020341149},
+    {-0.5001181636,-7.174648137e-43,3.658920571},{-0.5002363271,-7.174648137e-43,3.297499994},{-0.5003544907,-7.174648137e-43,2.936079417},{-1.108185788,-1.745563067e-16,2.830379676},
+    {-2.25685409,-1.387775287e-16,2.246067889},{-2.844260448,-6.863136849e-17,1.100494157},{-2.952875231,-3.186170614e-17,0.5000000004},{-3.308697204,-7.174648137e-43,0.5},
+    {-3.664519176,-7.174648137e-43,0.5},{-4.020341149,-7.174648137e-43,0.5},{-4.020341149,-7.174648137e-43,0.6666666667},{-4.020341149,-7.174648137e-43,0.8333333333},
+    {-4.020341149,-7.174648137e-43,1},{-4.353674482,-7.174648137e-43,0.6666666667},{-4.687007815,-7.174648137e-43,0.3333333333},{-5.020341149,-7.174648137e-43,0},
+    {-4.687007815,-7.174648137e-43,-0.3333333333},{-4.353674482,-7.174648137e-43,-0.6666666667},{-4.020341149,-7.174648137e-43,-1},{-4.020341149,-7.174648137e-43,-0.8333333333},
+    {-4.020341149,-7.174648137e-43,-0.6666666667},{-4.020341149,-7.174648137e-43,-0.5},{-3.666856427,-7.174648137e-43,-0.500115569},{-3.313371705,-7.174648137e-43,-0.500231138},
+    {-2.959886984,-7.174648137e-43,-0.500346707},{-2.857256049,6.70669364e-17,-1.11562734},{-2.269571555,1.383865284e-16,-2.280364668},{-1.10796125,1.745633001e-16,-2.871176185},
+    {-0.5000000001,1.810323224e-16,-2.976823336},{-0.5,-7.174648137e-43,-3.324662607},{-0.5,-7.174648137e-43,-3.672501878},{-0.5,-7.174648137e-43,-4.020341149}
+};
+const double s_FourArrowCircle0Knots[] = {
+    0,0,0,1,1,1,2,2,2,3,3,3,
+    4,4,4,4.511386375,4.511386375,4.511386375,5.297596846,6.09271959,6.09271959,6.09271959,6.612347929,6.612347929,
+    6.612347929,7.612347929,7.612347929,7.612347929,8.612347929,8.612347929,8.612347929,9.612347929,9.612347929,9.612347929,10.61234793,10.61234793,
+    10.61234793,11.61234793,11.61234793,11.61234793,12.13547153,12.13547153,12.13547153,12.91290353,13.6992611,13.6992611,13.6992611,14.23055405,
+    14.23055405,14.23055405,15.23055405,15.23055405,15.23055405,16.23055405,16.23055405,16.23055405,17.23055405,17.23055405,17.23055405,18.23055405,
+    18.23055405,18.23055405,18.76187719,18.76187719,18.76187719,19.54808192,20.32566457,20.32566457,20.32566457,20.84875722,20.84875722,20.84875722,
+    21.84875722,21.84875722,21.84875722,22.84875722,22.84875722,22.84875722,23.84875722,23.84875722,23.84875722,24.84875722,24.84875722,24.84875722,
+    25.36841389,25.36841389,25.36841389,26.16338732,26.94974489,26.94974489,26.94974489,27.4611022,27.4611022,27.4611022
+};
+
+//Triangle curve 0
+const double s_Triangle0CVs[][3] = {
+    {-1.03923,0,0.6},{1.03923,0,0.6},{0,0,-1.2},{-1.03923,0,0.6}
+};
+const double s_Triangle0Knots[] = {
+    0,1,2,3
+};
+
+//Square curve 0
+const double s_Square0CVs[][3] = {
+    {1,0,-1},{-1,0,-1},{-1,0,1},{1,0,1},
+    {1,0,-1}
+};
+const double s_Square0Knots[] = {
+    0,1,2,3,4
+};
+
+//Angle curve 0
+const double s_Angle0CVs[][3] = {
+    {-1,0,-3},{1,0,-3},{1,0,1},{-3,0,1},
+    {-3,0,-1},{-1,0,-1},{-1,0,-3}
+};
+const double s_Angle0Knots[] = {
+    0,1,2,3,4,5,6
+};
+
+//Cross curve 0
+const double s_Cross0CVs[][3] = {
+    {0.4,0,-0.4},{0.4,0,-2},{-0.4,0,-2},{-0.4,0,-0.4},
+    {-2,0,-0.4},{-2,0,0.4},{-0.4,0,0.4},{-0.4,0,2},
+    {0.4,0,2},{0.4,0,0.4},{2,0,0.4},{2,0,-0.4},
+    {0.4,0,-0.4}
+};
+const double s_Cross0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12
+};
+
+//FatCross curve 0
+const double s_FatCross0CVs[][3] = {
+    {2,0,1},{2,0,-1},{1,0,-1},{1,0,-2},
+    {-1,0,-2},{-1,0,-1},{-2,0,-1},{-2,0,1},
+    {-1,0,1},{-1,0,2},{1,0,2},{1,0,1},
+    {2,0,1}
+};
+const double s_FatCross0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12
+};
+
+//Circle curve 0
+const double s_Circle0CVs[][3] = {
+    {0.7836116249,0,-0.7836116249},{0,0,-1.108194188},{-0.7836116249,0,-0.7836116249},{-1.108194188,0,0},
+    {-0.7836116249,0,0.7836116249},{0,0,1.108194188},{0.7836116249,0,0.7836116249},{1.108194188,0,0},
+    {0.7836116249,0,-0.7836116249},{0,0,-1.108194188},{-0.7836116249,0,-0.7836116249}
+};
+const double s_Circle0Knots[] = {
+    -2,-1,0,1,2,3,4,5,6,7,8,9,
+    10
+};
+
+//270Arc curve 0
+const double s_270Arc0CVs[][3] = {
+    {-0.707107,0,-0.707107},{-0.570265,0,-0.843948},{-0.205819,0,-1.040044},{0.405223,0,-0.978634},
+    {0.881027,0,-0.588697},{1.059487,0,0},{0.881027,0,0.588697},{0.405223,0,0.978634},
+    {-0.205819,0,1.040044},{-0.570265,0,0.843948},{-0.707107,0,0.707107}
+};
+const double s_270Arc0Knots[] = {
+    0,0,0,1,2,3,4,5,6,7,8,8,
+    8
+};
+
+//Spiral curve 0
+const double s_Spiral0CVs[][3] = {
+    {0.474561,0,-1.241626},{0.171579,0,-1.214307},{-0.434384,0,-1.159672},{-1.124061,0,-0.419971},
+    {-1.169741,0,0.305922},{-0.792507,0,1.018176},{-0.0412486,0,1.262687},{0.915809,0,1.006098},
+    {1.258635,0,0.364883},{1.032378,0,-0.461231},{0.352527,0,-0.810017},{-0.451954,0,-0.43765},
+    {-0.634527,0,0.208919},{-0.0751226,0,0.696326},{0.292338,0,0.414161},{0.476068,0,0.273078}
+};
+const double s_Spiral0Knots[] = {
+    0,0,0,1,2,3,4,5,6,7,8,9,
+    10,11,12,13,13,13
+};
+
+//HalfPyramid curve 0
+const double s_12Pyramid0CVs[][3] = {
+    {-1,0,0},{0,0,1},{0,1,0},{-1,0,0},
+    {1,0,0},{0,1,0},{1,0,0},{0,0,1},
+    {0,1,0}
+};
+const double s_12Pyramid0Knots[] = {
+    0,1,2,3,4,5,6,7,8
+};
+
+//Pyramid curve 0
+const double s_Pyramid0CVs[][3] = {
+    {0,2,0},{1,0,-1},{-1,0,-1},{0,2,0},
+    {-1,0,1},{1,0,1},{0,2,0},{1,0,-1},
+    {1,0,1},{-1,0,1},{-1,0,-1}
+};
+const double s_Pyramid0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10
+};
+
+//HalfSpear curve 0
+const double s_12Spear0CVs[][3] = {
+    {0,2,0},{0,0,2},{0,0,-2},{0,2,0},
+    {-2,0,0},{2,0,0},{0,2,0}
+};
+const double s_12Spear0Knots[] = {
+    0,1,2,3,4,5,6
+};
+
+//Spear curve 0
+const double s_Spear0CVs[][3] = {
+    {0,2,0},{0,0,2},{0,-2,0},{0,0,-2},
+    {0,2,0},{0,-2,0},{0,0,0},{0,0,2},
+    {0,0,-2},{2,0,0},{0,0,2},{-2,0,0},
+    {0,0,-2},{0,0,2},{0,0,0},{-2,0,0},
+    {2,0,0}
+};
+const double s_Spear0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16
+};
+
+//Cube curve 0
+const double s_Cube0CVs[][3] = {
+    {0.5,0.5,0.5},{0.5,0.5,-0.5},{-0.5,0.5,-0.5},{-0.5,-0.5,-0.5},
+    {0.5,-0.5,-0.5},{0.5,0.5,-0.5},{-0.5,0.5,-0.5},{-0.5,0.5,0.5},
+    {0.5,0.5,0.5},{0.5,-0.5,0.5},{0.5,-0.5,-0.5},{-0.5,-0.5,-0.5},
+    {-0.5,-0.5,0.5},{0.5,-0.5,0.5},{-0.5,-0.5,0.5},{-0.5,0.5,0.5}
+};
+const double s_Cube0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15
+};
+
+//Sphere curve 0
+const double s_Sphere0CVs[][3] = {
+    {0,0,1},{0,0.5,0.866025},{0,0.866025,0.5},{0,1,0},
+    {0,0.866025,-0.5},{0,0.5,-0.866025},{0,0,-1},{0,-0.5,-0.866025},
+    {0,-0.866025,-0.5},{0,-1,0},{0,-0.866025,0.5},{0,-0.5,0.866025},
+    {0,0,1},{0.707107,0,0.707107},{1,0,0},{0.707107,0,-0.707107},
+    {0,0,-1},{-0.707107,0,-0.707107},{-1,0,0},{-0.866025,0.5,0},
+    {-0.5,0.866025,0},{0,1,0},{0.5,0.866025,0},{0.866025,0.5,0},
+    {1,0,0},{0.866025,-0.5,0},{0.5,-0.866025,0},{0,-1,0},
+    {-0.5,-0.866025,0},{-0.866025,-0.5,0},{-1,0,0},{-0.707107,0,0.707107},
+    {0,0,1}
+};
+const double s_Sphere0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32
+};
+
+//Hexagon curve 0
+const double s_Hexagon0CVs[][3] = {
+    {-0.5,1,0.866025},{0.5,1,0.866025},{0.5,-1,0.866025},{1,-1,0},
+    {1,1,0},{0.5,1,-0.866025},{0.5,-1,-0.866025},{-0.5,-1,-0.866026},
+    {-0.5,1,-0.866026},{-1,1,-1.5885e-07},{-1,-1,-1.5885e-07},{-0.5,-1,0.866025},
+    {-0.5,1,0.866025},{-1,1,-1.5885e-07},{-0.5,1,-0.866026},{0.5,1,-0.866025},
+    {1,1,0},{0.5,1,0.866025},{0.5,-1,0.866025},{-0.5,-1,0.866025},
+    {-1,-1,-1.5885e-07},{-0.5,-1,-0.866026},{0.5,-1,-0.866025},{1,-1,0}
+};
+const double s_Hexagon0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23
+};
+
+//Rombus curve 0
+const double s_Rombus0CVs[][3] = {
+    {0,1,0},{1,0,0},{0,0,1},{-1,0,0},
+    {0,0,-1},{0,1,0},{0,0,1},{0,-1,0},
+    {0,0,-1},{1,0,0},{0,1,0},{-1,0,0},
+    {0,-1,0},{1,0,0}
+};
+const double s_Rombus0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13
+};
+
+//Rombus2 curve 0
+const double s_Rombus20CVs[][3] = {
+    {0,0,2},{0,1,0},{0,0,-2},{0,-1,0},
+    {-1,0,0},{0,1,0},{1,0,0},{0,-1,0},
+    {0,0,2},{1,0,0},{0,0,-2},{-1,0,0},
+    {0,0,2}
+};
+const double s_Rombus20Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12
+};
+
+//Rombus3 curve 0
+const double s_Rombus30CVs[][3] = {
+    {0,0,2},{-0.707107,0.707107,0},{0,0,-2},{0.707107,0.707107,0},
+    {0,0,2},{0.707107,-0.707107,0},{0,0,-2},{-0.707107,-0.707107,0},
+    {0.707107,-0.707107,0},{0.707107,0.707107,0},{-0.707107,0.707107,0},{-0.707107,-0.707107,0},
+    {0,0,2}
+};
+const double s_Rombus30Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12
+};
+
+//Cone curve 0
+const double s_Cone0CVs[][3] = {
+    {0.5,-1,0.866025},{-0.5,-1,0.866025},{0,1,0},{0.5,-1,0.866025},
+    {1,-1,0},{0,1,0},{0.5,-1,-0.866025},{1,-1,0},
+    {0,1,0},{-0.5,-1,-0.866026},{0.5,-1,-0.866025},{0,1,0},
+    {-1,-1,-1.5885e-07},{-0.5,-1,-0.866026},{0,1,0},{-0.5,-1,0.866025},
+    {-1,-1,-1.5885e-07}
+};
+const double s_Cone0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16
+};
+
+//DirSingleThin curve 0
+const double s_DirSingleThin0CVs[][3] = {
+    {0,0,1},{0,0,-1},{-1,0,0},{0,0,-1},
+    {1,0,0}
+};
+const double s_DirSingleThin0Knots[] = {
+    0,1,2,3,4
+};
+
+//DirSingleNormal curve 0
+const double s_DirSingleNormal0CVs[][3] = {
+    {0,0,-1.32},{-0.99,0,0},{-0.33,0,0},{-0.33,0,0.99},
+    {0.33,0,0.99},{0.33,0,0},{0.99,0,0},{0,0,-1.32}
+};
+const double s_DirSingleNormal0Knots[] = {
+    0,1,2,3,4,5,6,7
+};
+
+//DirSingleFat curve 0
+const double s_DirSingleFat0CVs[][3] = {
+    {0,0,-0.99},{-0.66,0,0},{-0.33,0,0},{-0.33,0,0.66},
+    {0.33,0,0.66},{0.33,0,0},{0.66,0,0},{0,0,-0.99}
+};
+const double s_DirSingleFat0Knots[] = {
+    0,1,2,3,4,5,6,7
+};
+
+//DirDoubleThin curve 0
+const double s_DirDoubleThin0CVs[][3] = {
+    {1,0,1},{0,0,2},{-1,0,1},{0,0,2},
+    {0,0,-2},{-1,0,-1},{0,0,-2},{1,0,-1}
+};
+const double s_DirDoubleThin0Knots[] = {
+    0,1,2,3,4,5,6,7
+};
+
+//DirDoubleNormal curve 0
+const double s_DirDoubleNormal0CVs[][3] = {
+    {0,0,-2.31},{-0.99,0,-0.99},{-0.33,0,-0.99},{-0.33,0,0.99},
+    {-0.99,0,0.99},{0,0,2.31},{0.99,0,0.99},{0.33,0,0.99},
+    {0.33,0,-0.99},{0.99,0,-0.99},{0,0,-2.31}
+};
+const double s_DirDoubleNormal0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10
+};
+
+//DirDoubleFat curve 0
+const double s_DirDoubleFat0CVs[][3] = {
+    {0,0,-1.35},{-0.66,0,-0.36},{-0.33,0,-0.36},{-0.33,0,0.36},
+    {-0.66,0,0.36},{0,0,1.35},{0.66,0,0.36},{0.33,0,0.36},
+    {0.33,0,-0.36},{0.66,0,-0.36},{0,0,-1.35}
+};
+const double s_DirDoubleFat0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10
+};
+
+//DirFourThin curve 0
+const double s_DirFourThin0CVs[][3] = {
+    {1.25,0,-0.5},{1.75,0,0},{1.25,0,0.5},{1.75,0,0},
+    {-1.75,0,0},{-1.25,0,-0.5},{-1.75,0,0},{-1.25,0,0.5},
+    {-1.75,0,0},{0,0,0},{0,0,1.75},{-0.5,0,1.25},
+    {0,0,1.75},{0.5,0,1.25},{0,0,1.75},{0,0,-1.75},
+    {0.5,0,-1.25},{0,0,-1.75},{-0.5,0,-1.25},{0,0,-1.75}
+};
+const double s_DirFourThin0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19
+};
+
+//DirFourNormal curve 0
+const double s_DirFourNormal0CVs[][3] = {
+    {0,0,-1.98},{-0.495,0,-1.32},{-0.165,0,-1.32},{-0.165,0,-0.165},
+    {-1.32,0,-0.165},{-1.32,0,-0.495},{-1.98,0,0},{-1.32,0,0.495},
+    {-1.32,0,0.165},{-0.165,0,0.165},{-0.165,0,1.32},{-0.495,0,1.32},
+    {0,0,1.98},{0.495,0,1.32},{0.165,0,1.32},{0.165,0,0.165},
+    {1.32,0,0.165},{1.32,0,0.495},{1.98,0,0},{1.32,0,-0.495},
+    {1.32,0,-0.165},{0.165,0,-0.165},{0.165,0,-1.32},{0.495,0,-1.32},
+    {0,0,-1.98}
+};
+const double s_DirFourNormal0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24
+};
+
+//DirFourFat curve 0
+const double s_DirFourFat0CVs[][3] = {
+    {0,0,-1.1025},{-0.33,0,-0.6075},{-0.165,0,-0.6075},{-0.165,0,-0.165},
+    {-0.6075,0,-0.165},{-0.6075,0,-0.33},{-1.1025,0,0},{-0.6075,0,0.33},
+    {-0.6075,0,0.165},{-0.165,0,0.165},{-0.165,0,0.6075},{-0.33,0,0.6075},
+    {0,0,1.1025},{0.33,0,0.6075},{0.165,0,0.6075},{0.165,0,0.165},
+    {0.6075,0,0.165},{0.6075,0,0.33},{1.1025,0,0},{0.6075,0,-0.33},
+    {0.6075,0,-0.165},{0.165,0,-0.165},{0.165,0,-0.6075},{0.33,0,-0.6075},
+    {0,0,-1.1025}
+};
+const double s_DirFourFat0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24
+};
+
+//DirEight curve 0
+const double s_DirEight0CVs[][3] = {
+    {-1.8975,0,0},{-1.4025,0,0.37125},{-1.4025,0,0.12375},{-0.380966,0,0.157801},
+    {-1.079222,0,0.904213},{-1.254231,0,0.729204},{-1.341735,0,1.341735},{-0.729204,0,1.254231},
+    {-0.904213,0,1.079222},{-0.157801,0,0.380966},{-0.12375,0,1.4025},{-0.37125,0,1.4025},
+    {0,0,1.8975},{0.37125,0,1.4025},{0.12375,0,1.4025},{0.157801,0,0.380966},
+    {0.904213,0,1.079222},{0.729204,0,1.254231},{1.341735,0,1.341735},{1.254231,0,0.729204},
+    {1.079222,0,0.904213},{0.380966,0,0.157801},{1.4025,0,0.12375},{1.4025,0,0.37125},
+    {1.8975,0,0},{1.4025,0,-0.37125},{1.4025,0,-0.12375},{0.380966,0,-0.157801},
+    {1.079222,0,-0.904213},{1.254231,0,-0.729204},{1.341735,0,-1.341735},{0.729204,0,-1.254231},
+    {0.904213,0,-1.079222},{0.157801,0,-0.380966},{0.12375,0,-1.4025},{0.37125,0,-1.4025},
+    {0,0,-1.8975},{-0.37125,0,-1.4025},{-0.12375,0,-1.4025},{-0.157801,0,-0.380966},
+    {-0.904213,0,-1.079222},{-0.729204,0,-1.254231},{-1.341735,0,-1.341735},{-1.254231,0,-0.729204},
+    {-1.079222,0,-0.904213},{-0.380966,0,-0.157801},{-1.4025,0,-0.12375},{-1.4025,0,-0.37125},
+    {-1.8975,0,0}
+};
+const double s_DirEight0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32,33,34,35,
+    36,37,38,39,40,41,42,43,44,45,46,47,
+    48
+};
+
+//Rot90Thin curve 0
+const double s_Rot90Thin0CVs[][3] = {
+    {-1.026019,0,0},{-0.947961,0,0.392646},{-0.725413,0,0.725516},{-0.393028,0,0.947932},
+    {-0.13006,0,1},{0.0107043,0,1.001418},{-0.339542,0,0.5442},{0.0107043,0,1.001418},
+    {-0.446514,0,1.351664}
+};
+const double s_Rot90Thin0Knots[] = {
+    0,1,2,3,4,5,6,7,8
+};
+
+//Rot90Normal curve 0
+const double s_Rot90Normal0CVs[][3] = {
+    {-0.251045,0,1.015808},{-0.761834,0,0.979696},{-0.486547,0,0.930468},{-0.570736,0,0.886448},
+    {-0.72786,0,0.774834},{-0.909301,0,0.550655},{-1.023899,0,0.285854},{-1.063053,0,9.80765e-09},
+    {-0.961797,0,8.87346e-09},{-0.926399,0,0.258619},{-0.822676,0,0.498232},{-0.658578,0,0.701014},
+    {-0.516355,0,0.802034},{-0.440202,0,0.841857},{-0.498915,0,0.567734},{-0.251045,0,1.015808}
+};
+const double s_Rot90Normal0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15
+};
+
+//Rot90Fat curve 0
+const double s_Rot90Fat0CVs[][3] = {
+    {-0.923366,0,0},{-1.128672,0,0},{-1.042702,0,0.431934},{-0.798049,0,0.798033},
+    {-0.560906,0,0.946236},{-0.975917,0,1.036319},{-0.124602,0,1.096506},{-0.537718,0,0.349716},
+    {-0.440781,0,0.788659},{-0.652776,0,0.652998},{-0.853221,0,0.353358},{-0.923366,0,0}
+};
+const double s_Rot90Fat0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11
+};
+
+//Rot180Thin curve 0
+const double s_Rot180Thin0CVs[][3] = {
+    {-0.446514,0,-1.351664},{0.0107043,0,-1.001418},{-0.339542,0,-0.5442},{0.0107043,0,-1.001418},
+    {-0.13006,0,-1},{-0.393028,0,-0.947932},{-0.725413,0,-0.725516},{-0.947961,0,-0.392646},
+    {-1.026019,0,0},{-0.947961,0,0.392646},{-0.725413,0,0.725516},{-0.393028,0,0.947932},
+    {-0.13006,0,1},{0,0,1},{-0.339542,0,0.5442},{0,0,1},
+    {-0.446514,0,1.351664}
+};
+const double s_Rot180Thin0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16
+};
+
+//Rot180Normal curve 0
+const double s_Rot180Normal0CVs[][3] = {
+    {-0.251045,0,-1.015808},{-0.761834,0,-0.979696},{-0.486547,0,-0.930468},{-0.570736,0,-0.886448},
+    {-0.72786,0,-0.774834},{-0.909301,0,-0.550655},{-1.023899,0,-0.285854},{-1.063053,0,9.80765e-09},
+    {-1.023899,0,0.285854},{-0.909301,0,0.550655},{-0.72786,0,0.774834},{-0.570736,0,0.886448},
+    {-0.486547,0,0.930468},{-0.761834,0,0.979696},{-0.251045,0,1.015808},{-0.498915,0,0.567734},
+    {-0.440202,0,0.841857},{-0.516355,0,0.802034},{-0.658578,0,0.701014},{-0.822676,0,0.498232},
+    {-0.926399,0,0.258619},{-0.961797,0,8.87346e-09},{-0.926399,0,-0.258619},{-0.822676,0,-0.498232},
+    {-0.658578,0,-0.701014},{-0.516355,0,-0.802034},{-0.440202,0,-0.841857},{-0.498915,0,-0.567734},
+    {-0.251045,0,-1.015808}
+};
+const double s_Rot180Normal0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28
+};
+
+//Rot180Fat curve 0
+const double s_Rot180Fat0CVs[][3] = {
+    {-0.124602,0,-1.096506},{-0.975917,0,-1.036319},{-0.559059,0,-0.944259},{-0.798049,0,-0.798033},
+    {-1.042702,0,-0.431934},{-1.128672,0,0},{-1.042702,0,0.431934},{-0.798049,0,0.798033},
+    {-0.560906,0,0.946236},{-0.975917,0,1.036319},{-0.124602,0,1.096506},{-0.537718,0,0.349716},
+    {-0.440781,0,0.788659},{-0.652776,0,0.652998},{-0.853221,0,0.353358},{-0.923366,0,0},
+    {-0.853221,0,-0.353358},{-0.652776,0,-0.652998},{-0.439199,0,-0.785581},{-0.537718,0,-0.349716},
+    {-0.124602,0,-1.096506}
+};
+const double s_Rot180Fat0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20
+};
+
+//FootPrint curve 0
+const double s_FootPrint0CVs[][3] = {
+    {-0.081122,0,-1.11758},{0.390719,0,-0.921584},{0.514124,0,-0.616704},{0.412496,0,0.0293557},
+    {0.86256,0,0.552008},{0.920632,0,1.161772},{0.775452,0,1.669908},{0.38346,0,2.011088},
+    {-0.131936,0,2.330484},{-0.552964,0,2.308708},{-0.654588,0,1.691688},{-0.57474,0,0.63912},
+    {-0.364226,0,0.109206},{-0.531184,0,-0.39893},{-0.465852,0,-0.841736},{-0.081122,0,-1.11758}
+};
+const double s_FootPrint0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15
+};
+
+//ArrowsOnBall curve 0
+const double s_ArrowsOnBall0CVs[][3] = {
+    {0,0.35,-1.001567},{-0.336638,0.677886,-0.751175},{-0.0959835,0.677886,-0.751175},{-0.0959835,0.850458,-0.500783},
+    {-0.0959835,0.954001,-0.0987656},{-0.500783,0.850458,-0.0987656},{-0.751175,0.677886,-0.0987656},{-0.751175,0.677886,-0.336638},
+    {-1.001567,0.35,0},{-0.751175,0.677886,0.336638},{-0.751175,0.677886,0.0987656},{-0.500783,0.850458,0.0987656},
+    {-0.0959835,0.954001,0.0987656},{-0.0959835,0.850458,0.500783},{-0.0959835,0.677886,0.751175},{-0.336638,0.677886,0.751175},
+    {0,0.35,1.001567},{0.336638,0.677886,0.751175},{0.0959835,0.677886,0.751175},{0.0959835,0.850458,0.500783},
+    {0.0959835,0.954001,0.0987656},{0.500783,0.850458,0.0987656},{0.751175,0.677886,0.0987656},{0.751175,0.677886,0.336638},
+    {1.001567,0.35,0},{0.751175,0.677886,-0.336638},{0.751175,0.677886,-0.0987656},{0.500783,0.850458,-0.0987656},
+    {0.0959835,0.954001,-0.0987656},{0.0959835,0.850458,-0.500783},{0.0959835,0.677886,-0.751175},{0.336638,0.677886,-0.751175},
+    {0,0.35,-1.001567}
+};
+const double s_ArrowsOnBall0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32
+};
+
+//Pin curve 0
+const double s_Pin0CVs[][3] = {
+    {0,0,0},{0,0,-1},{0,0.5,-1},{0,0.5,-0.5},
+    {0,1.5,-0.5},{0,1.5,-1},{0,2.5,-1},{0,2.5,1},
+    {0,1.5,1},{0,1.5,0.5},{0,0.5,0.5},{0,0.5,1},
+    {0,0,1},{0,0,0},{1,0,0},{1,0.5,0},
+    {0.5,0.5,0},{0.5,1.5,0},{1,1.5,0},{1,2.5,0},
+    {-1,2.5,0},{-1,1.5,0},{-0.5,1.5,0},{-0.5,0.5,0},
+    {-1,0.5,0},{-1,0,0},{0,0,0}
+};
+const double s_Pin0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26
+};
+
+//Jack curve 0
+const double s_Jack0CVs[][3] = {
+    {0,0,0},{0.75,0,0},{1,0.25,0},{1.25,0,0},
+    {1,-0.25,0},{0.75,0,0},{1,0,0.25},{1.25,0,0},
+    {1,0,-0.25},{1,0.25,0},{1,0,0.25},{1,-0.25,0},
+    {1,0,-0.25},{0.75,0,0},{0,0,0},{-0.75,0,0},
+    {-1,0.25,0},{-1.25,0,0},{-1,-0.25,0},{-0.75,0,0},
+    {-1,0,0.25},{-1.25,0,0},{-1,0,-0.25},{-1,0.25,0},
+    {-1,0,0.25},{-1,-0.25,0},{-1,0,-0.25},{-0.75,0,0},
+    {0,0,0},{0,0.75,0},{0,1,-0.25},{0,1.25,0},
+    {0,1,0.25},{0,0.75,0},{-0.25,1,0},{0,1.25,0},
+    {0.25,1,0},{0,1,0.25},{-0.25,1,0},{0,1,-0.25},
+    {0.25,1,0},{0,0.75,0},{0,0,0},{0,-0.75,0},
+    {0,-1,-0.25},{0,-1.25,0},{0,-1,0.25},{0,-0.75,0},
+    {-0.25,-1,0},{0,-1.25,0},{0.25,-1,0},{0,-1,-0.25},
+    {-0.25,-1,0},{0,-1,0.25},{0.25,-1,0},{0,-0.75,0},
+    {0,0,0},{0,0,-0.75},{0,0.25,-1},{0,0,-1.25},
+    {0,-0.25,-1},{0,0,-0.75},{-0.25,0,-1},{0,0,-1.25},
+    {0.25,0,-1},{0,0.25,-1},{-0.25,0,-1},{0,-0.25,-1},
+    {0.25,0,-1},{0,0,-0.75},{0,0,0},{0,0,0.75},
+    {0,0.25,1},{0,0,1.25},{0,-0.25,1},{0,0,0.75},
+    {-0.25,0,1},{0,0,1.25},{0.25,0,1},{0,0.25,1},
+    {-0.25,0,1},{0,-0.25,1},{0.25,0,1},{0,0,0.75}
+};
+const double s_Jack0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32,33,34,35,
+    36,37,38,39,40,41,42,43,44,45,46,47,
+    48,49,50,51,52,53,54,55,56,57,58,59,
+    60,61,62,63,64,65,66,67,68,69,70,71,
+    72,73,74,75,76,77,78,79,80,81,82,83
+};
+
+//Nail curve 0
+const double s_Nail0CVs[][3] = {
+    {0,0,0},{-2,0,0},{-2.292893,0,0.707107},{-3,0,1},
+    {-3.707107,0,0.707107},{-4,0,0},{-3.707107,0,-0.707107},{-3,0,-1},
+    {-2.292893,0,-0.707107},{-2,0,0},{-2.292893,0,0.707107},{-3.707107,0,-0.707107},
+    {-4,0,0},{-3.707107,0,0.707107},{-2.292893,0,-0.707107}
+};
+const double s_Nail0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14
+};
+
+//2Nail curve 0
+const double s_2Nail0CVs[][3] = {
+    {0,0,0},{-2,0,0},{-2.292893,0,-0.707107},{-3,0,-1},
+    {-3.707107,0,-0.707107},{-4,0,0},{-3.707107,0,0.707107},{-3,0,1},
+    {-2.292893,0,0.707107},{-2,0,0},{-2.292893,0,0.707107},{-3.707107,0,-0.707107},
+    {-3,0,-1},{-2.292893,0,-0.707107},{-3.707107,0,0.707107},{-3,0,1},
+    {-2.292893,0,0.707107},{-2,0,0},{0,0,0},{2,0,0},
+    {2.292893,0,-0.707107},{3,0,-1},{3.707107,0,-0.707107},{4,0,0},
+    {3.707107,0,0.707107},{3,0,1},{2.292893,0,0.707107},{2,0,0},
+    {2.292893,0,0.707107},{3.707107,0,-0.707107},{3,0,-1},{2.292893,0,-0.707107},
+    {3.707107,0,0.707107}
+};
+const double s_2Nail0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32
+};
+
+//4Nail curve 0
+const double s_4Nail0CVs[][3] = {
+    {-2,0,0},{-2.292893,0,-0.707107},{-3,0,-1},{-3.707107,0,-0.707107},
+    {-4,0,0},{-3.707107,0,0.707107},{-3,0,1},{-2.292893,0,0.707107},
+    {-2,0,0},{-2.292893,0,0.707107},{-3.707107,0,-0.707107},{-4,0,0},
+    {-3.707107,0,0.707107},{-2.292893,0,-0.707107},{-2,0,0},{0,0,0},
+    {2,0,0},{2.292893,0,0.707107},{3,0,1},{3.707107,0,0.707107},
+    {4,0,0},{3.707107,0,-0.707107},{3,0,-1},{2.292893,0,-0.707107},
+    {2,0,0},{2.292893,0,0.707107},{3.707107,0,-0.707107},{4,0,0},
+    {3.707107,0,0.707107},{2.292893,0,-0.707107},{2,0,0},{0,0,0},
+    {0,0,2},{-0.707107,0,2.292893},{-1,0,3},{-0.707107,0,3.707107},
+    {0,0,4},{0.707107,0,3.707107},{1,0,3},{0.707107,0,2.292893},
+    {0,0,2},{0.707107,0,2.292893},{-0.707107,0,3.707107},{0,0,4},
+    {0.707107,0,3.707107},{-0.707107,0,2.292893},{0,0,2},{0,0,-2},
+    {-0.707107,0,-2.292893},{-1,0,-3},{-0.707107,0,-3.707107},{0,0,-4},
+    {0.707107,0,-3.707107},{1,0,-3},{0.707107,0,-2.292893},{0,0,-2},
+    {0.707107,0,-2.292893},{-0.707107,0,-3.707107},{0,0,-4},{0.707107,0,-3.707107},
+    {-0.707107,0,-2.292893}
+};
+const double s_4Nail0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32,33,34,35,
+    36,37,38,39,40,41,42,43,44,45,46,47,
+    48,49,50,51,52,53,54,55,56,57,58,59,
+    60
+};
+
+//Dumbell curve 0
+const double s_Dumbell0CVs[][3] = {
+    {-1.207536,0,0.0254483},{-1.123549,-0.202763,0.0254483},{-0.920786,-0.28675,0.0254483},{-0.718023,-0.202763,0.0254483},
+    {-0.63504,-0.00242492,0.0254483},{0.634091,0,0.0254483},{0.718023,-0.202763,0.0254483},{0.920786,-0.28675,0.0254483},
+    {1.123549,-0.202763,0.0254483},{1.207536,0,0.0254483},{1.123549,0.202763,0.0254483},{0.920786,0.28675,0.0254483},
+    {0.718023,0.202763,0.0254483},{0.634091,0,0.0254483},{-0.63504,-0.00242492,0.0254483},{-0.718023,0.202763,0.0254483},
+    {-0.920786,0.28675,0.0254483},{-1.123549,0.202763,0.0254483},{-1.207536,0,0.0254483}
+};
+const double s_Dumbell0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18
+};
+
+//Pointer curve 0
+const double s_Pointer0CVs[][3] = {
+    {-1.508537,0,0},{-1.059622,0,-0.316884},{-0.161791,0,-0.950653},{-0.231491,0,-0.132891},
+    {0.0199252,0,0.0238494},{0.843595,0,-0.46025},{1.7044,0,-1.130663},{1.00832,0,-0.442815},
+    {0.512875,0,-0.0222687},{1.031578,0,0.508979},{1.701544,0,1.119434},{0.831393,0,0.447942},
+    {0.018681,0,0.000680685},{-0.212893,0,0.0475119},{-0.15231,0,0.973132},{-1.056461,0,0.324377},
+    {-1.508537,0,0}
+};
+const double s_Pointer0Knots[] = {
+    0,0,0,1,2,3,4,5,6,7,8,9,
+    10,11,12,13,14,14,14
+};
+
+//Aim curve 0
+const double s_Aim0CVs[][3] = {
+    {0,0,1},{0,0,-1},{0,2,0},{0,-2,0},
+    {0,0,-1},{1,0,0},{-1,0,0},{0,0,-1}
+};
+const double s_Aim0Knots[] = {
+    0,1,2,3,4,5,6,7
+};
+
+//Aim2 curve 0
+const double s_Aim20CVs[][3] = {
+    {0,0,1},{0,0,-1},{0,2,0},{0,-2,0},
+    {0,0,-1},{2,0,0},{-2,0,0},{0,0,-1}
+};
+const double s_Aim20Knots[] = {
+    0,1,2,3,4,5,6,7
+};
+
+//DoublePlus curve 0
+const double s_DoublePlus0CVs[][3] = {
+    {0.07341396814,0.07442081968,1.666763448},{0.0724071166,0.2222556076,1.666763448},{-0.07542767123,0.221248756,1.666763448},{-0.07442081968,0.07341396814,1.666763448},
+    {-0.2222556076,0.0724071166,1.666763448},{-0.221248756,-0.07542767123,1.666763448},{-0.07341396814,-0.07442081968,1.666763448},{-0.0724071166,-0.2222556076,1.666763448},
+    {0.07542767123,-0.221248756,1.666763448},{0.07442081968,-0.07341396814,1.666763448},{0.2222556076,-0.0724071166,1.666763448},{0.221248756,0.07542767123,1.666763448},
+    {0.07341396814,0.07442081968,1.666763448},{-2.517541408e-16,-3.524557971e-15,1.666763448},{-2.170294317e-16,3.819717998e-16,-1.730125287},{0.07341396814,0.07442081968,-1.730125287},
+    {0.221248756,0.07542767123,-1.730125287},{0.2222556076,-0.0724071166,-1.730125287},{0.07442081968,-0.07341396814,-1.730125287},{0.07542767123,-0.221248756,-1.730125287},
+    {-0.0724071166,-0.2222556076,-1.730125287},{-0.07341396814,-0.07442081968,-1.730125287},{-0.221248756,-0.07542767123,-1.730125287},{-0.2222556076,0.0724071166,-1.730125287},
+    {-0.07442081968,0.07341396814,-1.730125287},{-0.07542767123,0.221248756,-1.730125287},{0.0724071166,0.2222556076,-1.730125287},{0.07341396814,0.07442081968,-1.730125287}
+};
+const double s_DoublePlus0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27
+};
+
+//Trapezoid curve 0
+const double s_Trapezoid0CVs[][3] = {
+    {2.181158451,0.8488326715,1.86602573},{2.181158451,0.8488326715,-1.86602573},{-2.181158451,0.8488326715,-1.86602573},{-2.473785113,-0.3886921252,-2.116373833},
+    {2.473785113,-0.3886921252,-2.116373833},{2.181158451,0.8488326715,-1.86602573},{-2.181158451,0.8488326715,-1.86602573},{-2.181158451,0.8488326715,1.86602573},
+    {2.181158451,0.8488326715,1.86602573},{2.473785113,-0.3886921252,2.116373833},{2.473785113,-0.3886921252,-2.116373833},{-2.473785113,-0.3886921252,-2.116373833},
+    {-2.473785113,-0.3886921252,2.116373833},{2.473785113,-0.3886921252,2.116373833},{-2.473785113,-0.3886921252,2.116373833},{-2.181158451,0.8488326715,1.86602573}
+};
+const double s_Trapezoid0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15
+};
+
+//FourArrowsCircular curve 0
+const double s_FourArrowsCircular0CVs[][3] = {
+    {1.985395228,0.1981922112,-2.283723437},{2.518976881,1.127400217,-1.712792008},{2.655250731,0.5958624808,-1.712792008},{3.036413478,0.6935836987,-1.141860578},
+    {3.265110684,0.7522163162,-0.2252004264},{2.807190312,1.587671322,-0.2252004264},{2.284239725,2.042995225,-0.2252004264},{2.284239725,2.042995225,-0.7675852843},
+    {1.418244432,2.410370484,0},{2.284239725,2.042995225,0.7675852843},{2.284239725,2.042995225,0.2252004264},{2.807190312,1.587671322,0.2252004264},
+    {3.265110684,0.7522163162,0.2252004264},{3.036413478,0.6935836987,1.141860578},{2.655250731,0.5958624808,1.712792008},{2.518976881,1.127400217,1.712792008},
+    {1.985395228,0.1981922112,2.283723437},{2.900228479,-0.3596760731,1.712792008},{2.763954629,0.1718616636,1.712792008},{3.145117376,0.2695828815,1.141860578},
+    {3.373814582,0.328215499,0.2252004264},{3.374340541,-0.6245047421,0.2252004264},{3.134965635,-1.27527108,0.2252004264},{3.134965635,-1.27527108,0.7675852843},
+    {2.552546023,-2.013986062,0},{3.134965635,-1.27527108,-0.7675852843},{3.134965635,-1.27527108,-0.2252004264},{3.374340541,-0.6245047421,-0.2252004264},
+    {3.373814582,0.328215499,-0.2252004264},{3.145117376,0.2695828815,-1.141860578},{2.763954629,0.1718616636,-1.712792008},{2.900228479,-0.3596760731,-1.712792008},
+    {1.985395228,0.1981922112,-2.283723437}
+};
+const double s_FourArrowsCircular0Knots[] = {
+    0,1,2,3,4,5,6,7,8,9,10,11,
+    12,13,14,15,16,17,18,19,20,21,22,23,
+    24,25,26,27,28,29,30,31,32
+};
+
+//HeadController curve 0
+const double s_HeadController0CVs[][3] = {
+    {9.604426478,15.89898318,-1.370315991},{3.271661017e-14,17.78205673,-1.370315991},{-9.604426478,15.89898318,-1.370315991},{-13.58271018,-1.125646119,-6.026476507},
+    {-9.604426478,-16.55665459,-0.1275503687},{3.017349933e-14,-16.55665459,12.11251514},{9.604426478,-16.55665459,-0.1275503687},{13.58271018,-1.125646119,-6.026476507},
+    {9.604426478,15.89898318,-1.370315991},{3.271661017e-14,17.78205673,-1.370315991},{-9.604426478,15.89898318,-1.370315991}
+};
+const double s_HeadController0Knots[] = {
+    -2,-1,0,1,2,3,4,5,6,7,8,9,
+    10
+};
+
+//NeckBaseController curve 0
+const double s_NeckBaseController0CVs[][3] = {
+    {12.38381632,10.5845713,-5.457855777},{-1.998401444e-15,19.55651013,-4.644766931},{-12.38381632,10.5845713,-5.457855777},{-17.513361,-2.065916848,-4.006489924},
+    {-12.38381632,-18.88536557,7.395694454},{-5.277028814e-15,-26.50061132,13.6648439},{12.38381632,-18.88536557,7.395694454},{17.513361,-2.065916848,-4.006489924},
+    {12.38381632,10.5845713,-5.457855777},{-1.998401444e-15,19.55651013,-4.644766931},{-12.38381632,10.5845713,-5.457855777}
+};
+const double s_NeckBaseController0Knots[] = {
+    -2,-1,0,1,2,3,4,5,6,7,8,9,
+    10
+};
+
+//JawController curve 0
+const double s_JawController0CVs[][3] = {
+    {9.833677222,-3.730979654,0.9644318626},{-1.197728397e-15,-19.76461574,18.43423155},{-9.833677222,-3.730979654,0.9644318626},{-10.49828156,-4.796913352,0.3294873472},
+    {-9.833677222,-5.86284705,-0.3054571681},{-3.163337119e-15,-23.27388255,18.43423155},{9.833677222,-5.86284705,-0.3054571681},{10.49828156,-4.796913352,0.3294873472},
+    {9.833677222,-3.730979654,0.9644318626},{-1.197728397e-15,-19.76461574,18.43423155},{-9.833677222,-3.730979654,0.9644318626}
+};
+const double s_JawController0Knots[] = {
+    -2,-1,0,1,2,3,4,5,6,7,8,9,
+    10
+};
+
+const ShapeCurveDef s_shapeCurves[] = {
+    {3, MFnNurbsCurve::kClosed, 92, s_FourArrowCircle0CVs, 94, s_FourArrowCircle0Knots},
+    {1, MFnNurbsCurve::kOpen, 4, s_Triangle0CVs, 4, s_Triangle0Knots},
+    {1, MFnNurbsCurve::kOpen, 5, s_Square0CVs, 5, s_Square0Knots},
+    {1, MFnNurbsCurve::kOpen, 7, s_Angle0CVs, 7, s_Angle0Knots},
+    {1, MFnNurbsCurve::kOpen, 13, s_Cross0CVs, 13, s_Cross0Knots},
+    {1, MFnNurbsCurve::kOpen, 13, s_FatCross0CVs, 13, s_FatCross0Knots},
+    {3, MFnNurbsCurve::kPeriodic, 11, s_Circle0CVs, 13, s_Circle0Knots},
+    {3, MFnNurbsCurve::kOpen, 11, s_270Arc0CVs, 13, s_270Arc0Knots},
+    {3, MFnNurbsCurve::kOpen, 16, s_Spiral0CVs, 18, s_Spiral0Knots},
+    {1, MFnNurbsCurve::kOpen, 9, s_12Pyramid0CVs, 9, s_12Pyramid0Knots},
+    {1, MFnNurbsCurve::kOpen, 11, s_Pyramid0CVs, 11, s_Pyramid0Knots},
+    {1, MFnNurbsCurve::kOpen, 7, s_12Spear0CVs, 7, s_12Spear0Knots},
+    {1, MFnNurbsCurve::kOpen, 17, s_Spear0CVs, 17, s_Spear0Knots},
+    {1, MFnNurbsCurve::kOpen, 16, s_Cube0CVs, 16, s_Cube0Knots},
+    {1, MFnNurbsCurve::kOpen, 33, s_Sphere0CVs, 33, s_Sphere0Knots},
+    {1, MFnNurbsCurve::kOpen, 24, s_Hexagon0CVs, 24, s_Hexagon0Knots},
+    {1, MFnNurbsCurve::kOpen, 14, s_Rombus0CVs, 14, s_Rombus0Knots},
+    {1, MFnNurbsCurve::kOpen, 13, s_Rombus20CVs, 13, s_Rombus20Knots},
+    {1, MFnNurbsCurve::kOpen, 13, s_Rombus30CVs, 13, s_Rombus30Knots},
+    {1, MFnNurbsCurve::kOpen, 17, s_Cone0CVs, 17, s_Cone0Knots},
+    {1, MFnNurbsCurve::kOpen, 5, s_DirSingleThin0CVs, 5, s_DirSingleThin0Knots},
+    {1, MFnNurbsCurve::kOpen, 8, s_DirSingleNormal0CVs, 8, s_DirSingleNormal0Knots},
+    {1, MFnNurbsCurve::kOpen, 8, s_DirSingleFat0CVs, 8, s_DirSingleFat0Knots},
+    {1, MFnNurbsCurve::kOpen, 8, s_DirDoubleThin0CVs, 8, s_DirDoubleThin0Knots},
+    {1, MFnNurbsCurve::kOpen, 11, s_DirDoubleNormal0CVs, 11, s_DirDoubleNormal0Knots},
+    {1, MFnNurbsCurve::kOpen, 11, s_DirDoubleFat0CVs, 11, s_DirDoubleFat0Knots},
+    {1, MFnNurbsCurve::kOpen, 20, s_DirFourThin0CVs, 20, s_DirFourThin0Knots},
+    {1, MFnNurbsCurve::kOpen, 25, s_DirFourNormal0CVs, 25, s_DirFourNormal0Knots},
+    {1, MFnNurbsCurve::kOpen, 25, s_DirFourFat0CVs, 25, s_DirFourFat0Knots},
+    {1, MFnNurbsCurve::kOpen, 49, s_DirEight0CVs, 49, s_DirEight0Knots},
+    {1, MFnNurbsCurve::kOpen, 9, s_Rot90Thin0CVs, 9, s_Rot90Thin0Knots},
+    {1, MFnNurbsCurve::kOpen, 16, s_Rot90Normal0CVs, 16, s_Rot90Normal0Knots},
+    {1, MFnNurbsCurve::kOpen, 12, s_Rot90Fat0CVs, 12, s_Rot90Fat0Knots},
+    {1, MFnNurbsCurve::kOpen, 17, s_Rot180Thin0CVs, 17, s_Rot180Thin0Knots},
+    {1, MFnNurbsCurve::kOpen, 29, s_Rot180Normal0CVs, 29, s_Rot180Normal0Knots},
+    {1, MFnNurbsCurve::kOpen, 21, s_Rot180Fat0CVs, 21, s_Rot180Fat0Knots},
+    {1, MFnNurbsCurve::kOpen, 16, s_FootPrint0CVs, 16, s_FootPrint0Knots},
+    {1, MFnNurbsCurve::kOpen, 33, s_ArrowsOnBall0CVs, 33, s_ArrowsOnBall0Knots},
+    {1, MFnNurbsCurve::kOpen, 27, s_Pin0CVs, 27, s_Pin0Knots},
+    {1, MFnNurbsCurve::kOpen, 84, s_Jack0CVs, 84, s_Jack0Knots},
+    {1, MFnNurbsCurve::kOpen, 15, s_Nail0CVs, 15, s_Nail0Knots},
+    {1, MFnNurbsCurve::kOpen, 33, s_2Nail0CVs, 33, s_2Nail0Knots},
+    {1, MFnNurbsCurve::kOpen, 61, s_4Nail0CVs, 61, s_4Nail0Knots},
+    {1, MFnNurbsCurve::kOpen, 19, s_Dumbell0CVs, 19, s_Dumbell0Knots},
+    {3, MFnNurbsCurve::kOpen, 17, s_Pointer0CVs, 19, s_Pointer0Knots},
+    {1, MFnNurbsCurve::kOpen, 8, s_Aim0CVs, 8, s_Aim0Knots},
+    {1, MFnNurbsCurve::kOpen, 8, s_Aim20CVs, 8, s_Aim20Knots},
+    {1, MFnNurbsCurve::kOpen, 28, s_DoublePlus0CVs, 28, s_DoublePlus0Knots},
+    {1, MFnNurbsCurve::kOpen, 16, s_Trapezoid0CVs, 16, s_Trapezoid0Knots},
+    {1, MFnNurbsCurve::kOpen, 33, s_FourArrowsCircular0CVs, 33, s_FourArrowsCircular0Knots},
+    {3, MFnNurbsCurve::kPeriodic, 11, s_HeadController0CVs, 13, s_HeadController0Knots},
+    {3, MFnNurbsCurve::kPeriodic, 11, s_NeckBaseController0CVs, 13, s_NeckBaseController0Knots},
+    {3, MFnNurbsCurve::kPeriodic, 11, s_JawController0CVs, 13, s_JawController0Knots},
+};
+
+const ShapeDef s_shapes[] = {
+    {"FourArrowCircle", 0, 1},
+    {"Triangle", 1, 1},
+    {"Square", 2, 1},
+    {"Angle", 3, 1},
+    {"Cross", 4, 1},
+    {"FatCross", 5, 1},
+    {"Circle", 6, 1},
+    {"270Arc", 7, 1},
+    {"Spiral", 8, 1},
+    {"HalfPyramid", 9, 1},
+    {"Pyramid", 10, 1},
+    {"HalfSpear", 11, 1},
+    {"Spear", 12, 1},
+    {"Cube", 13, 1},
+    {"Sphere", 14, 1},
+    {"Hexagon", 15, 1},
+    {"Rombus", 16, 1},
+    {"Rombus2", 17, 1},
+    {"Rombus3", 18, 1},
+    {"Cone", 19, 1},
+    {"DirSingleThin", 20, 1},
+    {"DirSingleNormal", 21, 1},
+    {"DirSingleFat", 22, 1},
+    {"DirDoubleThin", 23, 1},
+    {"DirDoubleNormal", 24, 1},
+    {"DirDoubleFat", 25, 1},
+    {"DirFourThin", 26, 1},
+    {"DirFourNormal", 27, 1},
+    {"DirFourFat", 28, 1},
+    {"DirEight", 29, 1},
+    {"Rot90Thin", 30, 1},
+    {"Rot90Normal", 31, 1},
+    {"Rot90Fat", 32, 1},
+    {"Rot180Thin", 33, 1},
+    {"Rot180Normal", 34, 1},
+    {"Rot180Fat", 35, 1},
+    {"FootPrint", 36, 1},
+    {"ArrowsOnBall", 37, 1},
+    {"Pin", 38, 1},
+    {"Jack", 39, 1},
+    {"Nail", 40, 1},
+    {"2Nail", 41, 1},
+    {"4Nail", 42, 1},
+    {"Dumbell", 43, 1},
+    {"Pointer", 44, 1},
+    {"Aim", 45, 1},
+    {"Aim2", 46, 1},
+    {"DoublePlus", 47, 1},
+    {"Trapezoid", 48, 1},
+    {"FourArrowsCircular", 49, 1},
+    {"HeadController", 50, 1},
+    {"NeckBaseController", 51, 1},
+    {"JawController", 52, 1},
+};
+
+const unsigned int s_numShapes = sizeof(s_shapes) / sizeof(s_shapes[0]);
+
+const ShapeDef * findShape(MString icon) {
+    for(unsigned int i = 0; i < s_numShapes; i++) {
+        if(strcmp(s_shapes[i].name, icon.asChar()) == 0)
+            return &s_shapes[i];
+    }
+    return NULL;
+}
+
+//geometry for one (icon, color) pair, stored as curve data outside of the scene
+struct ControllerPrototype
+{
+    std::vector<MObject> curveData;
+};
+typedef std::map<std::string, ControllerPrototype> PrototypeMap;
+PrototypeMap s_prototypes;
+unsigned int s_numControls = 0;
+
+MStatus createPythonController(MString icon, MString color, MObject & ctlObj) {
+    MStatus status = MS::kFailure;
+    //shapes that can't be described by CV tables are still built by rig101wireControllers.py
+    status = lrutils::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + icon + "')\");" );
+    status = lrutils::executeCommand( "python(\"Utils.setControllerColor(control, '" + color + "')\");" );
+    MString sResult;
+    status = lrutils::executeCommand( MString("python(\"control.fullPath()\");"), sResult );
+    MyCheckStatusReturn(status, "creating controller \"" + icon + "\" failed");
+    status = lrutils::getObjFromName(sResult, ctlObj);
+    MyCheckStatusReturn(status, "lrutils::getObjFromName() failed");
+    return status;
+}
+
+//copies the curve shapes of a controller into curve data. Controllers with child
+//transforms (Hand, Vision, Switch...) can't be rebuilt from their shapes and are left empty.
+void copyControllerShapes(MObject ctlObj, ControllerPrototype & prototype) {
+    MFnDagNode ctlFn( ctlObj );
+    std::vector<MObject> curveData;
+    for(unsigned int i = 0; i < ctlFn.childCount(); i++) {
+        MObject childObj = ctlFn.child(i);
+        if(childObj.hasFn(MFn::kTransform))
+            return;
+        if(!childObj.hasFn(MFn::kNurbsCurve))
+            continue;
+        MFnNurbsCurveData dataFn;
+        MObject dataObj = dataFn.create();
+        MFnNurbsCurve curveFn;
+        curveFn.copy(childObj, dataObj);
+        curveData.push_back(dataObj);
+    }
+    prototype.curveData = curveData;
+}
+
+//builds the prototype for an icon. For python shapes the controller built to read the
+//shapes from is returned in ctlObj so that it can be used as the first control.
+MStatus buildPrototype(MString icon, MString color, ControllerPrototype & prototype, MObject & ctlObj) {
+    MStatus status = MS::kFailure;
+    ctlObj = MObject::kNullObj;
+
+    const ShapeDef * shape = findShape(icon);
+    if(shape == NULL) {
+        status = createPythonController(icon, color, ctlObj);
+        MyCheckStatusReturn(status, "createPythonController() failed");
+        copyControllerShapes(ctlObj, prototype);
+        return status;
+    }
+
+    for(unsigned int i = 0; i < shape->numCurves; i++) {
+        const ShapeCurveDef & curve = s_shapeCurves[shape->firstCurve + i];
+        MPointArray cvs;
+        for(unsigned int j = 0; j < curve.numCVs; j++) {
+            cvs.append( MPoint(curve.cvs[j][0], curve.cvs[j][1], curve.cvs[j][2]) );
+        }
+        MDoubleArray knots(curve.knots, curve.numKnots);
+        MFnNurbsCurveData dataFn;
+        MObject dataObj = dataFn.create(&status);
+        MyCheckStatusReturn(status, "MFnNurbsCurveData.create() failed");
+        MFnNurbsCurve curveFn;
+        curveFn.create(cvs, knots, curve.degree, curve.form, false, false, dataObj, &status);
+        MyCheckStatusReturn(status, "MFnNurbsCurve.create() failed");
+        prototype.curveData.push_back(dataObj);
+    }
+
+    return MS::kSuccess;
+}
+
+}
+
+bool lrutils::hasNativeControllerShape(MString icon) {
+    return (findShape(icon) != NULL);
+}
+
+int lrutils::getControllerColorIndex(MString color) {
+    for(unsigned int i = 0; i < s_numColors; i++) {
+        if(strcmp(s_colorNames[i], color.asChar()) == 0)
+            return (int)i + 1;
+    }
+    return -1;
+}
+
+MStatus lrutils::setControllerColor(MObject ctlObj, MString color) {
+    RigProfileScope profileScope("lrutils::setControllerColor");
+    MStatus status = MS::kFailure;
+
+    //like Utils.setControllerColor, an empty or unknown color leaves the controller uncolored
+    int colorIndex = lrutils::getControllerColorIndex(color);
+    if(colorIndex < 0)
+        return MS::kSuccess;
+    MFnDagNode ctlFn( ctlObj, &status );
+    MyCheckStatusReturn(status, "invalid MObject provided for MFnDagNode");
+    //like Utils.setControllerColor, only the first shape is colored
+    for(unsigned int i = 0; i < ctlFn.childCount(); i++) {
+        MObject childObj = ctlFn.child(i);
+        if(!childObj.hasFn(MFn::kShape))
+            continue;
+        MFnDependencyNode shapeFn( childObj );
+        status = lrutils::findPlug(shapeFn, "overrideEnabled").setBool(true);
+        MyCheckStatusReturn(status, "setting overrideEnabled failed");
+        status = lrutils::findPlug(shapeFn, "overrideColor").setInt(colorIndex);
+        MyCheckStatusReturn(status, "setting overrideColor failed");
+        return status;
+    }
+
+    return MS::kFailure;
+}
+
+MStatus lrutils::createController(MString icon, MString color, MObject & ctlObj) {
+    RigProfileScope profileScope("lrutils::createController");
+    MStatus status = MS::kFailure;
+
+    s_numControls++;
+    std::string key = std::string(icon.asChar()) + "|" + color.asChar();
+    PrototypeMap::iterator itr = s_prototypes.find(key);
+    if(itr == s_prototypes.end()) {
+        ControllerPrototype prototype;
+        status = buildPrototype(icon, color, prototype, ctlObj);
+        MyCheckStatusReturn(status, "creating controller \"" + icon + "\" failed");
+        s_prototypes[key] = prototype;
+        //the first control of a prototype is the one it was built from
+        if(!ctlObj.isNull()) {
+            return status;
+        }
+        itr = s_prototypes.find(key);
+    }
+
+    //the prototype couldn't be stored as curve data, so every control goes through Python
+    if(itr->second.curveData.empty()) {
+        return createPythonController(icon, color, ctlObj);
+    }
+
+    ctlObj = MObject::kNullObj;
+    for(unsigned int i = 0; i < itr->second.curveData.size(); i++) {
+        MFnNurbsCurve curveFn;
+        //the first copy creates the controller transform, the rest are added under it
+        MObject curveObj = curveFn.copy(itr->second.curveData[i], ctlObj, &status);
+        MyCheckStatusReturn(status, "MFnNurbsCurve.copy() failed");
+        if(ctlObj.isNull()) {
+            ctlObj = curveObj;
+        }
+    }
+    MFnDependencyNode ctlFn( ctlObj );
+    ctlFn.setName("controller1_CTL");
+
+    status = lrutils::setControllerColor(ctlObj, color);
+    MyCheckStatusReturn(status, "lrutils::setControllerColor() failed");
+
+    return status;
+}
+
+void lrutils::beginControllerSession() {
+    s_prototypes.clear();
+    s_numControls = 0;
+}
+
+void lrutils::clearControllerPrototypes() {
+    s_prototypes.clear();
+}
+
+MString lrutils::getControllerSessionReport() {
+    unsigned int numPython = 0;
+    for(PrototypeMap::iterator itr = s_prototypes.begin(); itr != s_prototypes.end(); ++itr) {
+        if(itr->second.curveData.empty())
+            numPython++;
+    }
+    MString report;
+    report += "controller prototypes: "; report += (int)s_prototypes.size();
+    report += ", controls created: "; report += (int)s_numControls;
+    report += ", uncached python shapes: "; report += (int)numPython;
+    return report;
+}
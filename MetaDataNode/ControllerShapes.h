@@ -0,0 +1,36 @@
+/***************************************************************
+* Summary: Compiled library of controller shapes. The CV and   *
+*          knot tables are taken from rig101wireControllers.py *
+*          so that controllers can be built through the API    *
+*          without entering the Python interpreter.            *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _ControllerShapes
+#define _ControllerShapes
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+
+namespace lrutils {
+    //creates a controller transform with the shape named by icon (a ControllerShapes name from
+    //rig101wireControllers.py) and colors it. Shapes missing from the compiled library fall back to Python.
+    //Each (icon, color) pair is built once per session and copied for the controls after it.
+    MStatus createController(MString icon, MString color, MObject & ctlObj);
+    //starts a new build session, dropping the cached prototypes so that changes to the Python
+    //shape library are picked up by the next build
+    void beginControllerSession();
+    //releases the cached prototypes, called when the plugin is unloaded
+    void clearControllerPrototypes();
+    //unique prototypes built versus controls created in the current session
+    MString getControllerSessionReport();
+    //returns true if the shape named by icon can be built without Python
+    bool hasNativeControllerShape(MString icon);
+    //returns the overrideColor index for a color name from Utils.Colors, or -1 if it is unknown
+    int getControllerColorIndex(MString color);
+    //sets the override color of a controller's first shape node. An empty or unknown color leaves the override off
+    MStatus setControllerColor(MObject ctlObj, MString color);
+}
+
+#endif //_ControllerShapes
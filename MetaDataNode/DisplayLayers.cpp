@@ -0,0 +1,178 @@
+/***************************************************************
+* Summary: Utility functions for creating display layers       *
+*          through the API and assigning layer membership in   *
+*          batches while a rig is being built.                 *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "DisplayLayers.h"
+#include "LoadRigUtils.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MDGModifier.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MIntArray.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace {
+
+//nodes waiting to be added to one display layer
+struct LayerQueue
+{
+    MObjectHandle layer;
+    std::vector<MObjectHandle> members;
+};
+
+std::vector<LayerQueue> s_layerQueues;
+//layers already resolved by name during this session
+std::map<std::string, MObjectHandle> s_layersByName;
+unsigned int s_numLayersFlushed = 0;
+unsigned int s_numMembersFlushed = 0;
+
+LayerQueue & getLayerQueue(MObject layerObj) {
+    for(unsigned int i = 0; i < s_layerQueues.size(); i++) {
+        if(s_layerQueues[i].layer.object() == layerObj)
+            return s_layerQueues[i];
+    }
+    LayerQueue queue;
+    queue.layer = MObjectHandle(layerObj);
+    s_layerQueues.push_back(queue);
+    return s_layerQueues.back();
+}
+
+}
+
+MStatus lrutils::makeDisplayLayer(MString layerName, bool visible, MObject & layerObj) {
+    RigProfileScope profileScope("lrutils::makeDisplayLayer");
+    MStatus status = MS::kFailure;
+
+    //like Utils.makeDisplayLayer, reuse a layer that already exists, it is shown or hidden all the same
+    MObject existingObj;
+    if( lrutils::getObjFromName(layerName, existingObj) == MS::kSuccess && existingObj.hasFn(MFn::kDisplayLayer) ) {
+        layerObj = existingObj;
+        MFnDependencyNode layerFn( layerObj );
+        lrutils::findPlug(layerFn, "visibility").setBool(visible);
+        s_layersByName[layerName.asChar()] = MObjectHandle(layerObj);
+        return MS::kSuccess;
+    }
+
+    MDGModifier dgMod;
+    layerObj = dgMod.createNode("displayLayer", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(layerObj, layerName);
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    //register the layer with the layer manager so that it shows up in the layer editor
+    MItDependencyNodes managerIt(MFn::kDisplayLayerManager);
+    if(!managerIt.isDone()) {
+        MFnDependencyNode managerFn( managerIt.item() );
+        MPlug layerIdsPlug = lrutils::findPlug(managerFn, "displayLayerId");
+        MIntArray usedIds;
+        layerIdsPlug.getExistingArrayAttributeIndices(usedIds);
+        int nextId = 0;
+        for(unsigned int i = 0; i < usedIds.length(); i++) {
+            if(usedIds[i] >= nextId)
+                nextId = usedIds[i] + 1;
+        }
+        MFnDependencyNode layerFn( layerObj );
+        lrutils::findPlug(layerFn, "identification").setInt(nextId);
+        status = dgMod.connect( layerIdsPlug.elementByLogicalIndex(nextId), lrutils::findPlug(layerFn, "identification") );
+        MyCheckStatusReturn(status, "connect failed");
+        status = lrutils::doIt(dgMod);
+    }
+
+    MFnDependencyNode layerFn( layerObj );
+    lrutils::findPlug(layerFn, "visibility").setBool(visible);
+    s_layersByName[layerName.asChar()] = MObjectHandle(layerObj);
+
+    return status;
+}
+
+MStatus lrutils::addToDisplayLayer(MString layerName, MObject obj) {
+    MStatus status = MS::kFailure;
+    if(layerName.length() == 0)
+        return status;
+
+    MObject layerObj;
+    std::map<std::string, MObjectHandle>::iterator itr = s_layersByName.find(layerName.asChar());
+    if(itr != s_layersByName.end() && itr->second.isAlive()) {
+        layerObj = itr->second.object();
+    } else {
+        status = lrutils::getObjFromName(layerName, layerObj);
+        MyCheckStatusReturn(status, "lrutils::getObjFromName() failed");
+        s_layersByName[layerName.asChar()] = MObjectHandle(layerObj);
+    }
+
+    return lrutils::addToDisplayLayer(layerObj, obj);
+}
+
+MStatus lrutils::addToDisplayLayer(MObject layerObj, MObject obj) {
+    if(layerObj.isNull() || obj.isNull())
+        return MS::kFailure;
+    getLayerQueue(layerObj).members.push_back(MObjectHandle(obj));
+    return MS::kSuccess;
+}
+
+MStatus lrutils::flushDisplayLayers() {
+    RigProfileScope profileScope("lrutils::flushDisplayLayers");
+    MStatus status = MS::kSuccess;
+    MDGModifier dgMod;
+    s_numLayersFlushed = 0;
+    s_numMembersFlushed = 0;
+
+    for(unsigned int i = 0; i < s_layerQueues.size(); i++) {
+        LayerQueue & queue = s_layerQueues[i];
+        if(!queue.layer.isAlive() || queue.members.empty())
+            continue;
+        MFnDependencyNode layerFn( queue.layer.object() );
+        MPlug drawInfoPlug = lrutils::findPlug(layerFn, "drawInfo");
+        for(unsigned int j = 0; j < queue.members.size(); j++) {
+            if(!queue.members[j].isAlive())
+                continue;
+            //this is the connection editDisplayLayerMembers -noRecurse makes
+            MFnDependencyNode memberFn( queue.members[j].object() );
+            MPlug drawOverridePlug = lrutils::findPlug(memberFn, "drawOverride");
+            MPlugArray sources;
+            lrutils::connectedTo(drawOverridePlug, sources, true, false);
+            if(sources.length() > 0) {
+                if(sources[0] == drawInfoPlug)
+                    continue;
+                dgMod.disconnect(sources[0], drawOverridePlug);
+            }
+            dgMod.connect(drawInfoPlug, drawOverridePlug);
+            s_numMembersFlushed++;
+        }
+        s_numLayersFlushed++;
+    }
+    s_layerQueues.clear();
+
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return status;
+}
+
+MString lrutils::getDisplayLayerReport() {
+    MString report;
+    report += "display layers: "; report += (int)s_numLayersFlushed;
+    report += ", layer members: "; report += (int)s_numMembersFlushed;
+    return report;
+}
+
+lrutils::DisplayLayerBatch::DisplayLayerBatch() {
+    s_layerQueues.clear();
+}
+
+lrutils::DisplayLayerBatch::~DisplayLayerBatch() {
+    //the queue is empty if it was already flushed, flushing again would reset the report
+    if(!s_layerQueues.empty())
+        lrutils::flushDisplayLayers();
+}
@@ -0,0 +1,40 @@
+/***************************************************************
+* Summary: Utility functions for creating display layers       *
+*          through the API and assigning layer membership in   *
+*          batches while a rig is being built.                 *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _DisplayLayers
+#define _DisplayLayers
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+
+namespace lrutils {
+    //creates a display layer registered with the layer manager, or returns the existing layer of that name
+    MStatus makeDisplayLayer(MString layerName, bool visible, MObject & layerObj);
+    //queues a node to be added to a display layer, the membership is applied by flushDisplayLayers()
+    MStatus addToDisplayLayer(MString layerName, MObject obj);
+    MStatus addToDisplayLayer(MObject layerObj, MObject obj);
+    //applies every queued layer membership in a single modifier
+    MStatus flushDisplayLayers();
+    //number of layers and nodes applied by the last flush
+    MString getDisplayLayerReport();
+
+    //batches the layer membership queued while it exists. Memberships left over from an earlier batch are
+    //dropped when it starts, and whatever is still queued is flushed when it ends, so the queue is applied
+    //on every way out of a rig load or update, early error returns included
+    class DisplayLayerBatch
+    {
+    public:
+        DisplayLayerBatch();
+        ~DisplayLayerBatch();
+    private:
+        DisplayLayerBatch(const DisplayLayerBatch &);
+        DisplayLayerBatch & operator=(const DisplayLayerBatch &);
+    };
+}
+
+#endif //_DisplayLayers
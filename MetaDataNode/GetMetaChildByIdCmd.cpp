@@ -9,6 +9,7 @@
 #include "GetMetaChildByIdCmd.h"
 #include "LoadRigUtils.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include <maya/MFn.h>
 #include <maya/MFnDagNode.h>
 #include <maya/MArgList.h>
@@ -42,7 +43,7 @@ MStatus GetMetaChildByIdCmd::undoIt()
 
 MStatus GetMetaChildByIdCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
 
 MStatus GetMetaChildByIdCmd::parseArgs(const MArgList & args)
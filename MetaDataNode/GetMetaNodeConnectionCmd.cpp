@@ -9,6 +9,7 @@
 #include "GetMetaNodeConnectionCmd.h"
 #include "LoadRigUtils.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include <maya/MFn.h>
 #include <maya/MFnDagNode.h>
 #include <maya/MArgList.h>
@@ -49,7 +50,7 @@ MStatus GetMetaNodeConnectionCmd::undoIt()
 
 MStatus GetMetaNodeConnectionCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
 
 MStatus GetMetaNodeConnectionCmd::parseArgs(const MArgList & args)
@@ -7,11 +7,17 @@
 ***************************************************************/
 
 #include "GlobalComponent.h"
+#include "MetaRootNode.h"
+#include "MDGlobalNode.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include <string>
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 #include "LoadRigUtils.h"
+#include "ControllerShapes.h"
+#include "DisplayLayers.h"
+#include "Constraints.h"
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MPlug.h>
 #include <maya/MDagPath.h>
@@ -28,6 +34,8 @@ GlobalComponent::~GlobalComponent() {
 }
 
 MObject GlobalComponent::loadComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("GlobalComponent::loadComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status = MS::kFailure;
     this->m_metaDataNode = dgMod.createNode( "MDGlobalNode", &status );
     MyCheckStatus(status, "createNode failed");
@@ -38,26 +46,19 @@ MObject GlobalComponent::loadComponent(MDGModifier & dgMod) {
     dgMod.renameNode(this->m_metaDataNode, metaNodeName);
 
     MFnDependencyNode depMetaDataNodeFn(this->m_metaDataNode);
-    status = dgMod.newPlugValueFloat( depMetaDataNodeFn.findPlug("version"), this->m_pCompGuide->getVersion() );
+    status = dgMod.newPlugValueFloat( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion), this->m_pCompGuide->getVersion() );
     MyCheckStatus(status, "newPlugValueFloat() failed");
-    status = dgMod.newPlugValueString( depMetaDataNodeFn.findPlug("rigId"), this->m_pCompGuide->getRigId() );
+    status = dgMod.newPlugValueString( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kRigId), this->m_pCompGuide->getRigId() );
     MyCheckStatus(status, "newPlugValueInt() failed");
 
     GlobalComponentGuidePtr globalGuide = boost::dynamic_pointer_cast<GlobalComponentGuide>(this->m_pCompGuide);
     MString ctlColor = globalGuide->getColor();
     MString ctlIcon = globalGuide->getIcon();
 
-    status = MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + ctlIcon + "')\");" );
-    status = MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + ctlColor + "')\");" );
-    MCommandResult res;
-    status = MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), res );
-    int resType = res.resultType();
-    if( resType == MCommandResult::kString ) {
-        MString sResult;
-        res.getResult(sResult);
-        MObject ctlObj;
-        status = lrutils::getObjFromName(sResult, ctlObj);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    MObject ctlObj;
+    status = lrutils::createController(ctlIcon, ctlColor, ctlObj);
+    MyCheckStatus(status, "lrutils::createController() failed");
+    if( status == MS::kSuccess ) {
 
         MVectorArray ctlLocation = this->m_pCompGuide->getLocation(0);
         MFnTransform transformFn( ctlObj );
@@ -65,80 +66,79 @@ MObject GlobalComponent::loadComponent(MDGModifier & dgMod) {
 
         MString ctlName = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_CTL";
         dgMod.renameNode(ctlObj, ctlName);
-        dgMod.doIt();
+        lrutils::doIt(dgMod);
 
         //add the metaParent attribute to the controller
         MFnMessageAttribute mAttr;
         MObject transformAttr = mAttr.create("metaParent", "metaParent");
         transformFn.addAttribute(transformAttr);
         //connect the controller's metaParent to the MDGlobal node
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("controller"), transformFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDGlobalNode::controller), lrutils::findPlug(transformFn, "metaParent") );
 
-        MObject ctlGroupObj;
-        lrutils::makeHomeNull(ctlObj, MFnTransform(), ctlGroupObj);
-        lrutils::setLocation(ctlGroupObj, ctlLocation, MFnTransform::MFnTransform(), true, true, false);
-        MFnTransform ctlGroupFn( ctlGroupObj );
-        //add the metaParent attribute to the controller group
-        ctlGroupFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        //connect the controller group's metaParent to the MDGlobal node
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("controllerGroup"), ctlGroupFn.findPlug("metaParent") );
-        MyCheckStatus(status, "connect failed"); 
         MObject metaRootObj;
         status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
         MyCheckStatus(status, "lrutils::getMetaRootByName() failed");
         MObject rigCtlGroupObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, rigCtlGroupObj, "ctlGroup");
+        status = lrutils::getMetaNodeConnection(metaRootObj, rigCtlGroupObj, MetaRootNode::ctlGroup);
         MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
         MFnTransform rigCtlGroupFn( rigCtlGroupObj );
-        rigCtlGroupFn.addChild( ctlGroupObj );
+        //create the controller group in place under the rig's control group
+        MObject ctlGroupObj;
+        status = lrutils::makeHomeNull(ctlObj, this->getGuideTransforms()->getLocalMatrix(this->m_pCompGuide, 0), rigCtlGroupObj, ctlGroupObj);
+        MyCheckStatus(status, "lrutils::makeHomeNull() failed");
+        MFnTransform ctlGroupFn( ctlGroupObj );
+        //add the metaParent attribute to the controller group
+        ctlGroupFn.addAttribute(mAttr.create("metaParent", "metaParent"));
+        //connect the controller group's metaParent to the MDGlobal node
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDGlobalNode::controllerGrp), lrutils::findPlug(ctlGroupFn, "metaParent") );
+        MyCheckStatus(status, "connect failed"); 
 
         //add controller to controller display layer
         MObject controlLayerObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, controlLayerObj, "ctlLayer");
+        status = lrutils::getMetaNodeConnection(metaRootObj, controlLayerObj, MetaRootNode::ctlLayer);
         MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-        MFnDependencyNode controlLayerFn(controlLayerObj);
-        MString controlLayerName = controlLayerFn.name();
-        MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+controlLayerName+" "+rigCtlGroupFn.name()+";");
+        lrutils::addToDisplayLayer(controlLayerObj, rigCtlGroupFn.object());
         //create parent constraints from the global controller to the rig group
         MObject rigRigGroupObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, rigRigGroupObj, "rigGroup");
+        status = lrutils::getMetaNodeConnection(metaRootObj, rigRigGroupObj, MetaRootNode::rigGroup);
         MFnTransform rigRigGroupFn( rigRigGroupObj );
-        MGlobal::executeCommand("parentConstraint -mo "+transformFn.name()+" "+rigRigGroupFn.name()+";", res);
+        status = lrutils::createParentConstraint(transformFn.object(), rigRigGroupObj, this->m_rigParentConstraint);
+        MyCheckStatus(status, "lrutils::createParentConstraint() failed");
         //connect the parent constraint object to the component's metadata node
-        MStringArray sResults;
-        res.getResult(sResults);
-        status = lrutils::getObjFromName(sResults[0], this->m_rigParentConstraint);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
         MFnTransform rigParentConstraintFn( this->m_rigParentConstraint);
         rigParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("rigParentConstraint"), rigParentConstraintFn.findPlug("metaParent"));
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDGlobalNode::rigParentConstraint), lrutils::findPlug(rigParentConstraintFn, "metaParent"));
         //create the scale constraint from the global controller to the rig group
-        MGlobal::executeCommand("scaleConstraint -mo "+transformFn.name()+" "+rigRigGroupFn.name()+";", res);
+        MCommandResult res;
+        MStringArray sResults;
+        lrutils::executeCommand("scaleConstraint -mo "+transformFn.name()+" "+rigRigGroupFn.name()+";", res);
         //connect the scale constraint object to the component's metadata node
         res.getResult(sResults);
         status = lrutils::getObjFromName(sResults[0], this->m_rigScaleConstraint);
         MyCheckStatus(status, "lrutils::getObjFromName() failed");
         MFnTransform rigScaleConstraintFn( this->m_rigScaleConstraint );
         rigScaleConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("rigScaleConstraint"), rigScaleConstraintFn.findPlug("metaParent"));
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDGlobalNode::rigScaleConstraint), lrutils::findPlug(rigScaleConstraintFn, "metaParent"));
         //create scale constraint from the global controller to the noTransform group
         MObject rigNoTransformGroupObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, rigNoTransformGroupObj, "noTransformGroup");
+        status = lrutils::getMetaNodeConnection(metaRootObj, rigNoTransformGroupObj, MetaRootNode::noTransformGroup);
         MFnTransform rigNoTransformGroupFn( rigNoTransformGroupObj );
-        MGlobal::executeCommand("scaleConstraint -mo "+transformFn.name()+" "+rigNoTransformGroupFn.name()+";", res);
+        lrutils::executeCommand("scaleConstraint -mo "+transformFn.name()+" "+rigNoTransformGroupFn.name()+";", res);
         //connect the scale constraint object to the component's metadata node
         res.getResult(sResults);
         status = lrutils::getObjFromName(sResults[0], this->m_noTransformScaleConstraint);
         MyCheckStatus(status, "lrutils::getObjFromName() failed");
         MFnTransform noTransformScaleConstraintFn( this->m_noTransformScaleConstraint);
         noTransformScaleConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("noTransformScaleConstraint"), noTransformScaleConstraintFn.findPlug("metaParent"));
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDGlobalNode::noTransformScaleConstraint), lrutils::findPlug(noTransformScaleConstraintFn, "metaParent"));
     }
 
     return this->m_metaDataNode;
 }
 
 void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool globalPos) {
+    RigProfileScope profileScope("GlobalComponent::updateComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status;
     if( !this->m_metaDataNode.isNull() ) {
         //get the rig name
@@ -158,7 +158,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             metaDataNodeFn.setName(metaNodeName);
             //set controller object name
             MObject globalCtlObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, globalCtlObj, "controller");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, globalCtlObj, MDGlobalNode::controller);
             MFnDependencyNode globalCtlFn( globalCtlObj );
             MString globalCtlName = globalCtlFn.name();
             lrutils::stringReplaceAll(globalCtlName, rigName, this->m_rigName);
@@ -166,7 +166,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             globalCtlFn.setName(globalCtlName);
             //set controller group object name
             MObject globalCtlGroupObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, globalCtlGroupObj, "controllerGroup");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, globalCtlGroupObj, MDGlobalNode::controllerGrp);
             MFnDependencyNode globalCtlGroupFn( globalCtlGroupObj );
             MString globalCtlGroupName = globalCtlGroupFn.name();
             lrutils::stringReplaceAll(globalCtlGroupName, rigName, this->m_rigName);
@@ -174,7 +174,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             globalCtlGroupFn.setName(globalCtlGroupName);
             //set rigParentConstraint object name
             MObject rigParentConstraintObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, rigParentConstraintObj, "rigParentConstraint");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, rigParentConstraintObj, MDGlobalNode::rigParentConstraint);
             MFnDependencyNode rigParentConstraintFn( rigParentConstraintObj );
             MString rigParentConstraintName = rigParentConstraintFn.name();
             lrutils::stringReplaceAll(rigParentConstraintName, rigName, this->m_rigName);
@@ -182,7 +182,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             rigParentConstraintFn.setName(rigParentConstraintName);
             //set rigScaleConstraint object name
             MObject rigScaleConstraintObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, rigScaleConstraintObj, "rigScaleConstraint");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, rigScaleConstraintObj, MDGlobalNode::rigScaleConstraint);
             MFnDependencyNode rigScaleConstraintFn( rigScaleConstraintObj );
             MString rigScaleConstraintName = rigScaleConstraintFn.name();
             lrutils::stringReplaceAll(rigScaleConstraintName, rigName, this->m_rigName);
@@ -190,7 +190,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             rigScaleConstraintFn.setName(rigScaleConstraintName);
             //set noTransformScaleConstraint object name
             MObject noTransformScaleConstraintObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, noTransformScaleConstraintObj, "noTransformScaleConstraint");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, noTransformScaleConstraintObj, MDGlobalNode::noTransformScaleConstraint);
             MFnDependencyNode noTransformScaleConstraintFn( noTransformScaleConstraintObj );
             MString noTransformScaleConstraintName = noTransformScaleConstraintFn.name();
             lrutils::stringReplaceAll(noTransformScaleConstraintName, rigName, this->m_rigName);
@@ -199,7 +199,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
         }
         //update component settings, if the version increment is raised
         //or force update is true
-        MPlug versionPlug = metaDataNodeFn.findPlug( "version" );
+        MPlug versionPlug = MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion);
         float nodeVersion; 
         versionPlug.getValue(nodeVersion);
         if( (this->m_pCompGuide->getVersion() > nodeVersion) || forceUpdate ) {
@@ -209,15 +209,9 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             MString ctlColor = globalGuide->getColor();
             MString ctlIcon = globalGuide->getIcon();
 
-            MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + ctlIcon + "')\");" );
-            MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + ctlColor + "')\");" );
-            MCommandResult res;
-            MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), res );        
-            MString sResult;
-            res.getResult(sResult);
             MObject ctlObj;
-            MStatus status = lrutils::getObjFromName(sResult, ctlObj);
-            MyCheckStatus(status, "lrutils::getObjFromName() failed");
+            MStatus status = lrutils::createController(ctlIcon, ctlColor, ctlObj);
+            MyCheckStatus(status, "lrutils::createController() failed");
             //apply the scale of the controller location to the new shape
             MVectorArray ctlLocation = this->m_pCompGuide->getLocation(0);
             MFnTransform ctlFn( ctlObj );
@@ -226,7 +220,7 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
 
             //get the global transforms of the controller for all keyframes and save them for later use
             MObject oldCtlObj;
-            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlObj, "controller" );
+            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlObj, MDGlobalNode::controller );
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnTransform oldCtlFn( oldCtlObj );
             std::map<double, MMatrix> oldCtlWorldMatrices;
@@ -237,25 +231,25 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
 
             //get the shape node of the original controller object
             MStringArray sResults;
-            MGlobal::executeCommand( "listRelatives -s -fullPath "+oldCtlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -fullPath "+oldCtlFn.name()+";", sResults );
             MString oldCtlShapePath = sResults[0];
-            MGlobal::executeCommand( "listRelatives -s -path "+oldCtlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -path "+oldCtlFn.name()+";", sResults );
             MString oldCtlShapeName = sResults[0];
             MObject oldCtlShapeObj; lrutils::getObjFromName(oldCtlShapePath, oldCtlShapeObj);
             //delete the old shape node
             MGlobal::deleteNode( oldCtlShapeObj );
             //get the new shape node
-            MGlobal::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
             MString ctlShapePath = sResults[0];
             MObject ctlShapeObj; lrutils::getObjFromName(ctlShapePath, ctlShapeObj);
             //instance the new shape node under the old controller node
             MString command = "parent -s -add " + ctlShapePath + " " + oldCtlFn.name() + ";";
-            MGlobal::executeCommand( command );
+            lrutils::executeCommand( command );
             MFnDependencyNode ctlShapeFn( ctlShapeObj );
             ctlShapeFn.setName( oldCtlShapeName );
             //set the old controller group translation to the new location
             MObject oldCtlGroupObj;
-            lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlGroupObj, "controllerGroup" );
+            lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlGroupObj, MDGlobalNode::controllerGrp );
             MFnTransform oldCtlGroupFn( oldCtlGroupObj );
             //save the original old controller position
             MTransformationMatrix oldXForm = oldCtlGroupFn.transformation();
@@ -263,8 +257,9 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             //compute the inverse transformation matrix of the old control group
             MTransformationMatrix oldCtlGrpXform = oldCtlGroupFn.transformation();
             MTransformationMatrix inverseXform = MTransformationMatrix(oldCtlGrpXform.asMatrixInverse());
-            //set the target offset for the rigParentConstraint node
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, this->m_rigParentConstraint, "rigParentConstraint");
+            //set the target offset for the rigParentConstraint node. Rigs that had their rotation offset written
+            //as radians read in degrees get the corrected offset here
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, this->m_rigParentConstraint, MDGlobalNode::rigParentConstraint);
             lrutils::setParentConstraintOffset( this->m_rigParentConstraint, inverseXform );
             //delete the new controller transform
             MGlobal::deleteNode( ctlObj );
@@ -284,18 +279,20 @@ void GlobalComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
 }
 
 void GlobalComponent::removeComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("GlobalComponent::removeComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     //delete constraints
-    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_noTransformScaleConstraint, "noTransformScaleConstraint" );
+    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_noTransformScaleConstraint, MDGlobalNode::noTransformScaleConstraint );
     MGlobal::deleteNode(this->m_noTransformScaleConstraint);
-    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_rigParentConstraint, "rigParentConstraint" );
+    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_rigParentConstraint, MDGlobalNode::rigParentConstraint );
     MGlobal::deleteNode(this->m_rigParentConstraint);
-    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_rigScaleConstraint, "rigScaleConstraint" );
+    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_rigScaleConstraint, MDGlobalNode::rigScaleConstraint );
     MGlobal::deleteNode(this->m_rigScaleConstraint);
 
     //delete controller and controller group
-    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlObj, "controller" );
+    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlObj, MDGlobalNode::controller );
     MGlobal::deleteNode(this->m_ctlObj);
-    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlGroupObj, "controllerGroup" );
+    lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlGroupObj, MDGlobalNode::controllerGrp );
     MGlobal::deleteNode(this->m_ctlGroupObj);
 
 }
\ No newline at end of file
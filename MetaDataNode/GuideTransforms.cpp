@@ -0,0 +1,135 @@
+/***************************************************************
+* Summary: Computes the world and local matrices of every      *
+*          guide location in a rig in one pass over the        *
+*          component tree, so that components can write final *
+*          local transforms without reading the scene back.    *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "GuideTransforms.h"
+#include <maya/MTransformationMatrix.h>
+#include <maya/MEulerRotation.h>
+#include <sstream>
+#include <algorithm>
+
+GuideTransforms::GuideTransforms(boost::shared_ptr<ComponentGuide> rootGuide) {
+    if(rootGuide) {
+        this->build(rootGuide);
+    }
+}
+
+GuideTransforms::~GuideTransforms() {
+
+}
+
+MMatrix GuideTransforms::getLocationMatrix(MVectorArray location) {
+    if(location.length() < 2)
+        return MTransformationMatrix().asMatrix();
+    return getLocationMatrix(location[0], location[1]);
+}
+
+MMatrix GuideTransforms::getLocationMatrix(const MVector & translation, const MVector & rotation) {
+    MTransformationMatrix xform;
+    xform.setTranslation(translation, MSpace::kTransform);
+    xform.rotateTo( MEulerRotation(rotation*3.141592/180.0) );
+    return xform.asMatrix();
+}
+
+std::vector<MMatrix> GuideTransforms::getChainLocalMatrices(std::vector<MVectorArray> locations, MMatrix parentWorldMatrix) {
+    std::vector<MMatrix> localMatrices;
+    localMatrices.reserve(locations.size());
+    MMatrix parentInverse = parentWorldMatrix.inverse();
+    for(unsigned int i = 0; i < locations.size(); i++) {
+        MMatrix worldMatrix = getLocationMatrix(locations[i]);
+        localMatrices.push_back( worldMatrix * parentInverse );
+        parentInverse = worldMatrix.inverse();
+    }
+    return localMatrices;
+}
+
+void GuideTransforms::build(boost::shared_ptr<ComponentGuide> rootGuide) {
+    this->m_worldMatrices.clear();
+    this->m_localMatrices.clear();
+    this->m_parents.clear();
+    this->m_firstIndices.clear();
+    if(rootGuide) {
+        this->addGuide(rootGuide, -1);
+    }
+}
+
+void GuideTransforms::addGuide(boost::shared_ptr<ComponentGuide> guide, int parentIndex) {
+    unsigned int first = (unsigned int)this->m_worldMatrices.size();
+    this->m_firstIndices[guide.get()] = first;
+
+    //parents always come before their children, so every parent matrix is already known
+    unsigned int numLocations = guide->getNumLocations();
+    for(unsigned int i = 0; i < numLocations; i++) {
+        int parent = (i == 0) ? parentIndex : (int)(first + i - 1);
+        MMatrix worldMatrix = getLocationMatrix(guide->getLocation(i));
+        MMatrix parentMatrix = (parent < 0) ? MMatrix::identity : this->m_worldMatrices[parent];
+        this->m_worldMatrices.push_back(worldMatrix);
+        this->m_localMatrices.push_back( worldMatrix * parentMatrix.inverse() );
+        this->m_parents.push_back(parent);
+    }
+
+    int childParentIndex = (numLocations > 0) ? (int)first : parentIndex;
+    for(unsigned int i = 0; i < guide->getNumChildComps(); i++) {
+        this->addGuide(guide->getChildCompGuide(i), childParentIndex);
+    }
+}
+
+int GuideTransforms::getIndex(boost::shared_ptr<ComponentGuide> guide, unsigned int i) {
+    std::map<ComponentGuide*, unsigned int>::iterator it = this->m_firstIndices.find(guide.get());
+    if(it == this->m_firstIndices.end() || i >= guide->getNumLocations())
+        return -1;
+    return (int)(it->second + i);
+}
+
+MMatrix GuideTransforms::getWorldMatrix(boost::shared_ptr<ComponentGuide> guide, unsigned int i) {
+    int index = this->getIndex(guide, i);
+    if(index < 0)
+        return MMatrix::identity;
+    return this->m_worldMatrices[index];
+}
+
+MMatrix GuideTransforms::getLocalMatrix(boost::shared_ptr<ComponentGuide> guide, unsigned int i) {
+    int index = this->getIndex(guide, i);
+    if(index < 0)
+        return MMatrix::identity;
+    return this->m_localMatrices[index];
+}
+
+bool GuideTransforms::matches(const std::vector<MMatrix> & expected, double tolerance, unsigned int * firstMismatch) {
+    if(expected.size() != this->m_localMatrices.size()) {
+        if(firstMismatch != NULL)
+            *firstMismatch = (unsigned int)std::min(expected.size(), this->m_localMatrices.size());
+        return false;
+    }
+    //prefix product of the local matrices down the tree
+    std::vector<MMatrix> worldMatrices(this->m_localMatrices.size());
+    for(unsigned int i = 0; i < this->m_localMatrices.size(); i++) {
+        int parent = this->m_parents[i];
+        worldMatrices[i] = (parent < 0) ? this->m_localMatrices[i] : this->m_localMatrices[i] * worldMatrices[parent];
+        if(!worldMatrices[i].isEquivalent(expected[i], tolerance)) {
+            if(firstMismatch != NULL)
+                *firstMismatch = i;
+            return false;
+        }
+    }
+    return true;
+}
+
+MString GuideTransforms::toString() {
+    std::stringstream text;
+    for(unsigned int i = 0; i < this->m_worldMatrices.size(); i++) {
+        for(unsigned int row = 0; row < 4; row++) {
+            for(unsigned int col = 0; col < 4; col++) {
+                text << this->m_worldMatrices[i](row, col);
+                if(row < 3 || col < 3)
+                    text << " ";
+            }
+        }
+        text << "\n";
+    }
+    return MString(text.str().c_str());
+}
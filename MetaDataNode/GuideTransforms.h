@@ -0,0 +1,67 @@
+/***************************************************************
+* Summary: Computes the world and local matrices of every      *
+*          guide location in a rig in one pass over the        *
+*          component tree, so that components can write final *
+*          local transforms without reading the scene back.    *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _GuideTransforms
+#define _GuideTransforms
+
+#include <boost/shared_ptr.hpp>
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MMatrix.h>
+#include <maya/MVector.h>
+#include <maya/MVectorArray.h>
+#include <vector>
+#include <map>
+#include "ComponentGuide.h"
+
+class GuideTransforms
+{
+public:
+    GuideTransforms(boost::shared_ptr<ComponentGuide> rootGuide = boost::shared_ptr<ComponentGuide>());
+    ~GuideTransforms();
+
+    //computes the matrices of every location of rootGuide and the guides beneath it.
+    //Location i of a guide is parented to location i-1, and the first location to the
+    //first location of the parent guide, the same way the controllers are built.
+    void build(boost::shared_ptr<ComponentGuide> rootGuide);
+
+    //world matrix of a location (translate, rotate in degrees), the scale is baked into the controller shapes
+    static MMatrix getLocationMatrix(MVectorArray location);
+    static MMatrix getLocationMatrix(const MVector & translation, const MVector & rotation);
+    //local matrices of a chain of locations each parented to the one before it, the first under parentWorldMatrix
+    static std::vector<MMatrix> getChainLocalMatrices(std::vector<MVectorArray> locations, MMatrix parentWorldMatrix = MMatrix::identity);
+
+    unsigned int getNumMatrices() {return (unsigned int)m_worldMatrices.size();};
+    //world matrix of location i of guide, the identity if the guide is not in the table
+    MMatrix getWorldMatrix(boost::shared_ptr<ComponentGuide> guide, unsigned int i);
+    //local matrix of location i of guide under its parent location
+    MMatrix getLocalMatrix(boost::shared_ptr<ComponentGuide> guide, unsigned int i);
+    //world matrices of every location in component tree order
+    const std::vector<MMatrix> & getWorldMatrices() {return m_worldMatrices;};
+
+    //recomposes the world matrices from the local matrices and compares them with expected,
+    //which holds one matrix per location in component tree order
+    bool matches(const std::vector<MMatrix> & expected, double tolerance = 1.0e-6, unsigned int * firstMismatch = NULL);
+    //the world matrices as text, one location per line, for recording expected results
+    MString toString();
+
+private:
+    void addGuide(boost::shared_ptr<ComponentGuide> guide, int parentIndex);
+    int getIndex(boost::shared_ptr<ComponentGuide> guide, unsigned int i);
+
+    std::vector<MMatrix> m_worldMatrices;
+    std::vector<MMatrix> m_localMatrices;
+    //index of the parent location of each location, -1 for the world
+    std::vector<int> m_parents;
+    //index of the first location of each guide
+    std::map<ComponentGuide*, unsigned int> m_firstIndices;
+};
+
+typedef boost::shared_ptr<GuideTransforms> GuideTransformsPtr;
+
+#endif //_GuideTransforms
@@ -0,0 +1,181 @@
+/***************************************************************
+* Summary: Plans the final DAG parent and world transform of   *
+*          rig nodes so that every node is moved at most once  *
+*          and the moves are applied in a single modifier.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "HierarchyPlan.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MDagModifier.h>
+#include <maya/MDagPath.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnTransform.h>
+#include <maya/MFnIkJoint.h>
+#include <maya/MTransformationMatrix.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MQuaternion.h>
+
+HierarchyPlan::Report HierarchyPlan::s_sessionReport;
+
+HierarchyPlan::Report::Report() {
+    plannedMoves = 0;
+    reparents = 0;
+    elidedMoves = 0;
+    worldPlacements = 0;
+}
+
+void HierarchyPlan::Report::add(const Report & other) {
+    plannedMoves += other.plannedMoves;
+    reparents += other.reparents;
+    elidedMoves += other.elidedMoves;
+    worldPlacements += other.worldPlacements;
+}
+
+MString HierarchyPlan::Report::toString() const {
+    MString msg;
+    msg += "reparents: "; msg += (int)reparents;
+    msg += " (planned: "; msg += (int)plannedMoves;
+    msg += ", elided: "; msg += (int)elidedMoves;
+    msg += "), world placements: "; msg += (int)worldPlacements;
+    return msg;
+}
+
+HierarchyPlan::HierarchyPlan() {
+
+}
+
+HierarchyPlan::~HierarchyPlan() {
+
+}
+
+HierarchyPlan::PlannedNode & HierarchyPlan::getPlannedNode(MObject node) {
+    for(unsigned int i = 0; i < this->m_nodes.size(); i++) {
+        if(this->m_nodes[i].node == node)
+            return this->m_nodes[i];
+    }
+    PlannedNode planned;
+    planned.node = node;
+    planned.hasParent = false;
+    planned.hasWorldMatrix = false;
+    this->m_nodes.push_back(planned);
+    return this->m_nodes.back();
+}
+
+void HierarchyPlan::setParent(MObject node, MObject parent) {
+    if(node.isNull())
+        return;
+    PlannedNode & planned = this->getPlannedNode(node);
+    this->m_report.plannedMoves++;
+    //an earlier move of this node is never applied
+    if(planned.hasParent)
+        this->m_report.elidedMoves++;
+    planned.parent = parent;
+    planned.hasParent = true;
+}
+
+void HierarchyPlan::setWorldMatrix(MObject node, MMatrix worldMatrix) {
+    if(node.isNull())
+        return;
+    PlannedNode & planned = this->getPlannedNode(node);
+    planned.worldMatrix = worldMatrix;
+    planned.hasWorldMatrix = true;
+}
+
+void HierarchyPlan::setWorldLocation(MObject node, MVectorArray location) {
+    if(node.isNull())
+        return;
+    //keep the node's world scale, like moving it to the world and calling lrutils::setLocation
+    MTransformationMatrix worldXForm( this->getFinalWorldMatrix(node) );
+    worldXForm.setTranslation(location[0], MSpace::kTransform);
+    worldXForm.rotateTo( MEulerRotation(location[1]*3.141592/180.0) );
+    this->setWorldMatrix(node, worldXForm.asMatrix());
+}
+
+MMatrix HierarchyPlan::getFinalWorldMatrix(MObject node) {
+    if(node.isNull())
+        return MMatrix::identity;
+    for(unsigned int i = 0; i < this->m_nodes.size(); i++) {
+        if(this->m_nodes[i].node == node && this->m_nodes[i].hasWorldMatrix)
+            return this->m_nodes[i].worldMatrix;
+    }
+    //a node's world transform is unchanged by moving it, so the current one is final
+    MDagPath path;
+    MDagPath::getAPathTo(node, path);
+    return path.inclusiveMatrix();
+}
+
+MStatus HierarchyPlan::setLocalMatrix(MObject node, MMatrix localMatrix) {
+    MStatus status = MS::kFailure;
+    MTransformationMatrix localXForm( localMatrix );
+    if(node.hasFn(MFn::kJoint)) {
+        //the joint orient sits between the rotation and the parent, so only the remainder goes into rotate
+        MFnIkJoint jointFn( node );
+        MQuaternion jointOrient;
+        jointFn.getOrientation(jointOrient);
+        status = jointFn.setTranslation( localXForm.getTranslation(MSpace::kTransform), MSpace::kTransform );
+        MyCheckStatusReturn(status, "MFnIkJoint.setTranslation() failed");
+        status = jointFn.setRotation( localXForm.rotation() * jointOrient.inverse() );
+        MyCheckStatusReturn(status, "MFnIkJoint.setRotation() failed");
+    } else {
+        MFnTransform transformFn( node );
+        status = transformFn.set( localXForm );
+        MyCheckStatusReturn(status, "MFnTransform.set() failed");
+    }
+    return status;
+}
+
+MStatus HierarchyPlan::apply() {
+    RigProfileScope profileScope("HierarchyPlan::apply");
+    MStatus status = MS::kSuccess;
+    MDagModifier dagMod;
+    std::vector<MObject> localNodes;
+    std::vector<MMatrix> localMatrices;
+
+    //work out every local transform from the final world matrices before anything moves
+    for(unsigned int i = 0; i < this->m_nodes.size(); i++) {
+        PlannedNode & planned = this->m_nodes[i];
+        MFnDagNode dagFn( planned.node );
+        MObject currentParent = (dagFn.parentCount() > 0) ? dagFn.parent(0) : MObject::kNullObj;
+        if(currentParent.hasFn(MFn::kWorld))
+            currentParent = MObject::kNullObj;
+        bool move = planned.hasParent && !(currentParent == planned.parent);
+        if(planned.hasParent && !move)
+            this->m_report.elidedMoves++;
+        if(!move && !planned.hasWorldMatrix)
+            continue;
+
+        MObject finalParent = move ? planned.parent : currentParent;
+        MMatrix parentWorldMatrix = this->getFinalWorldMatrix(finalParent);
+        localNodes.push_back(planned.node);
+        localMatrices.push_back( this->getFinalWorldMatrix(planned.node) * parentWorldMatrix.inverse() );
+        if(move) {
+            dagMod.reparentNode(planned.node, planned.parent);
+            this->m_report.reparents++;
+        } else {
+            this->m_report.worldPlacements++;
+        }
+    }
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+
+    for(unsigned int i = 0; i < localNodes.size(); i++) {
+        MStatus nodeStatus = this->setLocalMatrix(localNodes[i], localMatrices[i]);
+        if(nodeStatus != MS::kSuccess)
+            status = nodeStatus;
+    }
+
+    s_sessionReport.add(this->m_report);
+    this->m_report = Report();
+    this->m_nodes.clear();
+
+    return status;
+}
+
+MStatus HierarchyPlan::reparent(MObject node, MObject parent) {
+    HierarchyPlan plan;
+    plan.setParent(node, parent);
+    return plan.apply();
+}
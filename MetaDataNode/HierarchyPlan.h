@@ -0,0 +1,74 @@
+/***************************************************************
+* Summary: Plans the final DAG parent and world transform of   *
+*          rig nodes so that every node is moved at most once  *
+*          and the moves are applied in a single modifier.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _HierarchyPlan
+#define _HierarchyPlan
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+#include <maya/MMatrix.h>
+#include <maya/MVectorArray.h>
+#include <vector>
+
+class HierarchyPlan
+{
+public:
+    //counts of the parenting work done while building
+    struct Report
+    {
+        Report();
+        void add(const Report & other);
+        MString toString() const;
+        unsigned int plannedMoves;      //setParent calls
+        unsigned int reparents;         //nodes actually moved to a new parent
+        unsigned int elidedMoves;       //moves replaced by a later move or already satisfied
+        unsigned int worldPlacements;   //world transforms applied without leaving the parent
+    };
+
+    HierarchyPlan();
+    ~HierarchyPlan();
+
+    //plans node to end up under parent (MObject::kNullObj for the world) keeping its world transform.
+    //Planning the same node again replaces the earlier parent.
+    void setParent(MObject node, MObject parent);
+    //plans a world matrix for node, applied as a local transform under the node's final parent
+    void setWorldMatrix(MObject node, MMatrix worldMatrix);
+    //plans the world position and rotation in location (translate, rotate in degrees) for node
+    void setWorldLocation(MObject node, MVectorArray location);
+
+    unsigned int getNumPlannedNodes() {return (unsigned int)m_nodes.size();};
+    //applies every planned move in one modifier, then sets the local transforms
+    MStatus apply();
+
+    //plans and applies a single move
+    static MStatus reparent(MObject node, MObject parent);
+
+    //totals of every plan applied since the last reset
+    static Report getSessionReport() {return s_sessionReport;};
+    static void resetSessionReport() {s_sessionReport = Report();};
+
+private:
+    struct PlannedNode
+    {
+        MObject node;
+        MObject parent;
+        bool hasParent;
+        MMatrix worldMatrix;
+        bool hasWorldMatrix;
+    };
+
+    PlannedNode & getPlannedNode(MObject node);
+    MMatrix getFinalWorldMatrix(MObject node);
+    MStatus setLocalMatrix(MObject node, MMatrix localMatrix);
+
+    std::vector<PlannedNode> m_nodes;
+    Report m_report;
+    static Report s_sessionReport;
+};
+
+#endif //_HierarchyPlan
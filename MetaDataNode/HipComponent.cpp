@@ -7,11 +7,18 @@
 ***************************************************************/
 
 #include "HipComponent.h"
+#include "MetaRootNode.h"
+#include "MDHipNode.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include <string>
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 #include "LoadRigUtils.h"
+#include "ControllerShapes.h"
+#include "DisplayLayers.h"
+#include "HierarchyPlan.h"
+#include "Constraints.h"
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MPlug.h>
 #include <maya/MDagPath.h>
@@ -29,10 +36,12 @@ HipComponent::~HipComponent() {
 }
 
 MObject HipComponent::loadComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("HipComponent::loadComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status = MS::kFailure;
     this->m_metaDataNode = dgMod.createNode( "MDHipNode", &status );
     MyCheckStatus(status, "createNode failed");
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
 
     MString metaNodeName = "MHN_";
     metaNodeName += this->m_rigName + "_";
@@ -40,26 +49,19 @@ MObject HipComponent::loadComponent(MDGModifier & dgMod) {
     dgMod.renameNode(this->m_metaDataNode, metaNodeName);
 
     MFnDependencyNode depMetaDataNodeFn(this->m_metaDataNode);
-    status = dgMod.newPlugValueFloat( depMetaDataNodeFn.findPlug("version"), this->m_pCompGuide->getVersion() );
+    status = dgMod.newPlugValueFloat( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion), this->m_pCompGuide->getVersion() );
     MyCheckStatus(status, "newPlugValueFloat() failed");
-    status = dgMod.newPlugValueString( depMetaDataNodeFn.findPlug("rigId"), this->m_pCompGuide->getRigId() );
+    status = dgMod.newPlugValueString( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kRigId), this->m_pCompGuide->getRigId() );
     MyCheckStatus(status, "newPlugValueString() failed");
 
     HipComponentGuidePtr hipGuide = boost::dynamic_pointer_cast<HipComponentGuide>(this->m_pCompGuide);
     MString ctlColor = hipGuide->getColor();
     MString ctlIcon = hipGuide->getIcon();
 
-    status = MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + ctlIcon + "')\");" );
-    status = MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + ctlColor + "')\");" );
-    MCommandResult res;
-    status = MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), res );
-    int resType = res.resultType();
-    if( resType == MCommandResult::kString ) {
-        MString sResult;
-        res.getResult(sResult);
-        MObject ctlObj;
-        status = lrutils::getObjFromName(sResult, ctlObj);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    MObject ctlObj;
+    status = lrutils::createController(ctlIcon, ctlColor, ctlObj);
+    MyCheckStatus(status, "lrutils::createController() failed");
+    if( status == MS::kSuccess ) {
 
         MVectorArray ctlLocation = this->m_pCompGuide->getLocation(0);
         MFnTransform transformFn( ctlObj );
@@ -67,101 +69,89 @@ MObject HipComponent::loadComponent(MDGModifier & dgMod) {
 
         MString ctlName = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_CTL";
         dgMod.renameNode(ctlObj, ctlName);
-        dgMod.doIt();
+        lrutils::doIt(dgMod);
 
         //add the metaParent attribute to the controller
         MFnMessageAttribute mAttr;
         MObject transformAttr = mAttr.create("metaParent", "metaParent");
         transformFn.addAttribute(transformAttr);
         //connect the controller's metaParent to the MDHip node
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("controller"), transformFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDHipNode::controller), lrutils::findPlug(transformFn, "metaParent") );
 
+        //the control group is created in place under the metadata parent's controller
+        MObject metaParentObj = this->m_pParentComp->getMetaDataNode();
+        MObject metaParentControllerObj;
+        if( !metaParentObj.isNull() ) {
+            status = lrutils::getMetaNodeConnection(metaParentObj, metaParentControllerObj, "controller");
+            MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
+        }
+        GuideTransformsPtr guideTransforms = this->getGuideTransforms();
+        MMatrix ctlGroupMatrix = guideTransforms->getLocalMatrix(this->m_pCompGuide, 0);
+        if( metaParentControllerObj.isNull() ) {
+            ctlGroupMatrix = guideTransforms->getWorldMatrix(this->m_pCompGuide, 0);
+        }
         MObject ctlGroupObj;
-        lrutils::makeHomeNull(ctlObj, MFnTransform(), ctlGroupObj);
-        lrutils::setLocation(ctlGroupObj, ctlLocation, MFnTransform::MFnTransform(), true, true, false);
+        status = lrutils::makeHomeNull(ctlObj, ctlGroupMatrix, metaParentControllerObj, ctlGroupObj);
+        MyCheckStatus(status, "lrutils::makeHomeNull() failed");
         MFnTransform ctlGroupFn( ctlGroupObj );
         //add the metaParent attribute to the controller group
         ctlGroupFn.addAttribute(mAttr.create("metaParent", "metaParent"));
         //connect the controller group's metaParent to the MDHip node
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("controllerGroup"), ctlGroupFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDHipNode::controllerGrp), lrutils::findPlug(ctlGroupFn, "metaParent") );
         MyCheckStatus(status, "connect failed");
-        //parent the control group object under the metadata parent's controller
-        MObject metaParentObj = this->m_pParentComp->getMetaDataNode();
-        if( !metaParentObj.isNull() ) {
-            MObject metaParentControllerObj;
-            status = lrutils::getMetaNodeConnection(metaParentObj, metaParentControllerObj, "controller");
-            MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-            MFnTransform metaParentControllerFn( metaParentControllerObj );
-            MString metaParentControllerPath = metaParentControllerFn.fullPathName();
-            MFnTransform ctlGroupFn( ctlGroupObj);
-            MString ctlGroupPath = ctlGroupFn.fullPathName();
-            MGlobal::executeCommand("parent " + ctlGroupPath + " " + metaParentControllerPath + ";");
-        }
+        HierarchyPlan hierarchy;
 
         //get the metaRoot node of this rig
         MObject metaRootObj;
         status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
         //add controller to controller display layer
         MObject controlLayerObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, controlLayerObj, "ctlLayer");
+        status = lrutils::getMetaNodeConnection(metaRootObj, controlLayerObj, MetaRootNode::ctlLayer);
         MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-        MFnDependencyNode controlLayerFn(controlLayerObj);
-        MString controlLayerName = controlLayerFn.name();
-        MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+controlLayerName+" "+ctlGroupFn.name()+";");
+        lrutils::addToDisplayLayer(controlLayerObj, ctlGroupFn.object());
 
         //create the hip joint
         MString prefix = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_BIND";
-        this->m_hipJointObj = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix).at(0);
+        this->m_hipJointObj = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, MPlug(), MObject(), "", this->getBuildPlan()).at(0);
         //add metaparent attribute to the joint
         MFnTransform hipJointFn( this->m_hipJointObj );
         MObject jointAttr = mAttr.create("metaParent", "metaParent");
         hipJointFn.addAttribute(jointAttr);
         //connect the metaparent attribute to the MDHip node
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("hipJoint"), hipJointFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDHipNode::hipJoint), lrutils::findPlug(hipJointFn, "metaParent") );
         MyCheckStatus(status, "connect failed");
 
         //add the hip joint to the skeleton display layer
         MObject skelLayerObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, skelLayerObj, "skelLayer");
+        status = lrutils::getMetaNodeConnection(metaRootObj, skelLayerObj, MetaRootNode::skelLayer);
         MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-        MFnDependencyNode skelLayerFn(skelLayerObj);
-        MString skelLayerName = skelLayerFn.name();
-        MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+skelLayerName+" "+hipJointFn.name()+";");
+        lrutils::addToDisplayLayer(skelLayerObj, hipJointFn.object());
 
         //check parent component for joints
         MObject metaParentJointObj;
         if( !metaParentObj.isNull() ) {
-            status = lrutils::getMetaNodeConnection(metaParentObj, metaParentJointObj, "hipJoint");
+            status = lrutils::getMetaNodeConnection(metaParentObj, metaParentJointObj, MDHipNode::hipJoint);
             //MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
         }
         if( !metaParentJointObj.isNull() ) {
-            MFnTransform metaParentJointFn( metaParentJointObj );
-            MString metaParentJointPath = metaParentJointFn.fullPathName();
-            MFnTransform hipJointFn( this->m_hipJointObj );
-            MString hipJointPath = hipJointFn.fullPathName();
-            MGlobal::executeCommand("parent " + hipJointPath + " " + metaParentJointPath + ";");
+            hierarchy.setParent(this->m_hipJointObj, metaParentJointObj);
         } else {
             //if no joints, move the hip joint to beneath the rig group
             MObject rigGroupObj;
-            status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, "rigGroup");
+            status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, MetaRootNode::rigGroup);
             MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-            MFnTransform rigGroupFn( rigGroupObj );
-            MString rigGroupPath = rigGroupFn.fullPathName();
-            MFnTransform hipJointFn( this->m_hipJointObj );
-            MString hipJointPath = hipJointFn.fullPathName();
-            MGlobal::executeCommand("parent " + hipJointPath + " " + rigGroupPath + ";");
+            hierarchy.setParent(this->m_hipJointObj, rigGroupObj);
         }
+        status = hierarchy.apply();
+        MyCheckStatus(status, "HierarchyPlan.apply() failed");
 
         //create parent constraint from the hip controller to the hip joint
-        MGlobal::executeCommand("parentConstraint -mo "+transformFn.name()+" "+hipJointFn.name()+";", res);
+        status = lrutils::createParentConstraint(transformFn.object(), this->m_hipJointObj, this->m_hipJointParentConstraint);
+        MyCheckStatus(status, "lrutils::createParentConstraint() failed");
         //connect the parent constraint object to the component's metadata node
-        MStringArray sResults;
-        res.getResult(sResults);
-        status = lrutils::getObjFromName(sResults[0], this->m_hipJointParentConstraint);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
         MFnTransform hipJointParentConstraintFn( this->m_hipJointParentConstraint);
         hipJointParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("hipJointParentConstraint"), hipJointParentConstraintFn.findPlug("metaParent"));
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDHipNode::hipJointParentConstraint), lrutils::findPlug(hipJointParentConstraintFn, "metaParent"));
 
 
     }
@@ -169,7 +159,14 @@ MObject HipComponent::loadComponent(MDGModifier & dgMod) {
     return this->m_metaDataNode;
 }
 
+void HipComponent::getPlanInput(ComponentPlan::Input & input) {
+    Component::getPlanInput(input);
+    input.chainPrefixes.push_back((this->m_rigName + "_" + this->m_pCompGuide->getName() + "_BIND").asChar());
+}
+
 void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool globalPos) {
+    RigProfileScope profileScope("HipComponent::updateComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status;
     if( !this->m_metaDataNode.isNull() ) {
         //get the rig name
@@ -189,7 +186,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             metaDataNodeFn.setName(metaNodeName);
             //set controller object name
             MObject hipCtlObj;
-            MStatus status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipCtlObj, "controller");
+            MStatus status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipCtlObj, MDHipNode::controller);
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnDependencyNode hipCtlFn( hipCtlObj );
             MString hipCtlName = hipCtlFn.name();
@@ -200,7 +197,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             hipCtlFn.setName(hipCtlName);
             //set controller group object name
             MObject hipCtlGroupObj;
-            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipCtlGroupObj, "controllerGroup");
+            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipCtlGroupObj, MDHipNode::controllerGrp);
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnDependencyNode hipCtlGroupFn( hipCtlGroupObj );
             MString hipCtlGroupName = hipCtlGroupFn.name();
@@ -209,7 +206,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             hipCtlGroupFn.setName(hipCtlGroupName);
             //set hipJoint object name
             MObject hipJointObj;
-            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipJointObj, "hipJoint");
+            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipJointObj, MDHipNode::hipJoint);
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnDependencyNode hipJointFn( hipJointObj );
             MString hipJointName = hipJointFn.name();
@@ -218,7 +215,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             hipJointFn.setName(hipJointName);
             //set hipJointParentConstraint object name
             MObject hipJointParentConstraintObj;
-            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipJointParentConstraintObj, "hipJointParentConstraint");
+            status = lrutils::getMetaNodeConnection(this->m_metaDataNode, hipJointParentConstraintObj, MDHipNode::hipJointParentConstraint);
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnDependencyNode hipJointParentConstraintFn( hipJointParentConstraintObj );
             MString hipJointParentConstraintName = hipJointParentConstraintFn.name();
@@ -228,7 +225,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
         }
         //update component settings, if the version increment is raised
         //or force update is true
-        MPlug versionPlug = metaDataNodeFn.findPlug( "version" );
+        MPlug versionPlug = MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion);
         float nodeVersion; 
         versionPlug.getValue(nodeVersion);
         if( (this->m_pCompGuide->getVersion() > nodeVersion) || forceUpdate ) {
@@ -238,15 +235,9 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             MString ctlColor = hipGuide->getColor();
             MString ctlIcon = hipGuide->getIcon();
 
-            MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + ctlIcon + "')\");" );
-            MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + ctlColor + "')\");" );
-            MCommandResult res;
-            MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), res );        
-            MString sResult;
-            res.getResult(sResult);
             MObject ctlObj;
-            status = lrutils::getObjFromName(sResult, ctlObj);
-            MyCheckStatus(status, "lrutils::getObjFromName() failed");
+            status = lrutils::createController(ctlIcon, ctlColor, ctlObj);
+            MyCheckStatus(status, "lrutils::createController() failed");
             //apply the scale of the controller location to the new shape
             MVectorArray ctlLocation = this->m_pCompGuide->getLocation(0);
             MFnTransform ctlFn( ctlObj );
@@ -255,7 +246,7 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
 
             //get the global transforms of the controller for all keyframes and save them for later use
             MObject oldCtlObj;
-            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlObj, "controller" );
+            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlObj, MDHipNode::controller );
             MFnTransform oldCtlFn(oldCtlObj);
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             std::map<double, MMatrix> oldCtlWorldMatrices;
@@ -266,9 +257,9 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
 
             //get the shape node of the original controller object
             MStringArray sResults;
-            MGlobal::executeCommand( "listRelatives -s -fullPath "+oldCtlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -fullPath "+oldCtlFn.name()+";", sResults );
             MString oldCtlShapePath = sResults[0];
-            MGlobal::executeCommand( "listRelatives -s -path "+oldCtlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -path "+oldCtlFn.name()+";", sResults );
             MString oldCtlShapeName = sResults[0];
             MObject oldCtlShapeObj; 
             status = lrutils::getObjFromName(oldCtlShapePath, oldCtlShapeObj);
@@ -276,27 +267,28 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
             //delete the old shape node
             MGlobal::deleteNode( oldCtlShapeObj );
             //get the new shape node
-            MGlobal::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
+            lrutils::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
             MString ctlShapePath = sResults[0];
             MObject ctlShapeObj; 
             status = lrutils::getObjFromName(ctlShapePath, ctlShapeObj);
             MyCheckStatus(status, "lrutils::getObjFromName() failed");
             //instance the new shape node under the old controller node
             MString command = "parent -s -add " + ctlShapePath + " " + oldCtlFn.name() + ";";
-            MGlobal::executeCommand( command );
+            lrutils::executeCommand( command );
             MFnDependencyNode ctlShapeFn( ctlShapeObj );
             ctlShapeFn.setName( oldCtlShapeName );
             //set the old controller group translation to the new location
             MObject oldCtlGroupObj;
-            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlGroupObj, "controllerGroup" );
+            status = lrutils::getMetaNodeConnection( this->m_metaDataNode, oldCtlGroupObj, MDHipNode::controllerGrp );
             MyCheckStatus(status, "getMetaNodeConnection() failed");
             MFnTransform oldCtlGroupFn( oldCtlGroupObj );
             //save the original old controller position
             MTransformationMatrix oldXForm = oldCtlGroupFn.transformation();
-            //move the controller group to world for absolute positioning
-            MString oldCtlGroupPath = oldCtlGroupFn.fullPathName();
-            MGlobal::executeCommand("parent -world " + oldCtlGroupPath + ";");            
-            lrutils::setLocation(oldCtlGroupObj, ctlLocation, oldCtlGroupFn, true, true, false);
+            //place the controller group in world space without taking it out of its parent
+            HierarchyPlan hierarchy;
+            hierarchy.setWorldLocation(oldCtlGroupObj, ctlLocation);
+            status = hierarchy.apply();
+            MyCheckStatus(status, "HierarchyPlan.apply() failed");
             //find the global transformation matrix of the controller group
             MDagPath groupPath;
             status = oldCtlGroupFn.getPath(groupPath);
@@ -324,61 +316,52 @@ void HipComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool gl
                 MObject metaParentControllerObj;
                 status = lrutils::getMetaNodeConnection(metaParentObj, metaParentControllerObj, "controller");
                 MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-                MFnTransform metaParentControllerFn( metaParentControllerObj );
-                MString metaParentControllerPath = metaParentControllerFn.fullPathName();
-                MFnTransform oldCtlGroupFn( oldCtlGroupObj );
-                MString oldCtlGroupPath = oldCtlGroupFn.fullPathName();
-                MGlobal::executeCommand("parent " + oldCtlGroupPath + " " + metaParentControllerPath + ";");
+                hierarchy.setParent(oldCtlGroupObj, metaParentControllerObj);
             }
             
             //update joint parenting, check parent component for joints
             MObject metaParentJointObj;
-            lrutils::getMetaNodeConnection(this->m_metaDataNode, this->m_hipJointObj, "hipJoint");
+            lrutils::getMetaNodeConnection(this->m_metaDataNode, this->m_hipJointObj, MDHipNode::hipJoint);
             if( !metaParentObj.isNull() ) {
-                status = lrutils::getMetaNodeConnection(metaParentObj, metaParentJointObj, "hipJoint");
+                status = lrutils::getMetaNodeConnection(metaParentObj, metaParentJointObj, MDHipNode::hipJoint);
                 //MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
             }
             if( !metaParentJointObj.isNull() ) {
-                MFnTransform metaParentJointFn( metaParentJointObj );
-                MString metaParentJointPath = metaParentJointFn.fullPathName();
-                MFnTransform hipJointFn( this->m_hipJointObj );
-                MString hipJointPath = hipJointFn.fullPathName();
-                MGlobal::executeCommand("parent " + hipJointPath + " " + metaParentJointPath + ";");
+                hierarchy.setParent(this->m_hipJointObj, metaParentJointObj);
             } else {
                 //if no joints, move the hip joint to beneath the rig group
                 //get the metaRoot node of this rig
                 MObject metaRootObj;
                 status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
                 MObject rigGroupObj;
-                status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, "rigGroup");
+                status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, MetaRootNode::rigGroup);
                 MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-                MFnTransform rigGroupFn( rigGroupObj );
-                MString rigGroupPath = rigGroupFn.fullPathName();
-                MFnTransform hipJointFn( this->m_hipJointObj );
-                MString hipJointPath = hipJointFn.fullPathName();
-
-                MGlobal::executeCommand("parent " + hipJointPath + " " + rigGroupPath + ";");
-            }            
+                hierarchy.setParent(this->m_hipJointObj, rigGroupObj);
+            }
+            status = hierarchy.apply();
+            MyCheckStatus(status, "HierarchyPlan.apply() failed");
         }
     }
 }
 
 void HipComponent::removeComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("HipComponent::removeComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     //delete constraints
-    MStatus status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_hipJointParentConstraint, "hipJointParentConstraint" );
+    MStatus status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_hipJointParentConstraint, MDHipNode::hipJointParentConstraint );
     MyCheckStatus(status, "getMetaNodeConnection() failed");
     MGlobal::deleteNode(this->m_hipJointParentConstraint);
 
     //delete joint
-    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_hipJointObj, "hipJoint" );
+    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_hipJointObj, MDHipNode::hipJoint );
     MyCheckStatus(status, "getMetaNodeConnection() failed");
     MGlobal::deleteNode(this->m_hipJointObj);
 
     //delete controller and controller group
-    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlObj, "controller" );
+    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlObj, MDHipNode::controller );
     MyCheckStatus(status, "getMetaNodeConnection() failed");
     MGlobal::deleteNode(this->m_ctlObj);
-    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlGroupObj, "controllerGroup" );
+    status = lrutils::getMetaNodeConnection( this->m_metaDataNode, this->m_ctlGroupObj, MDHipNode::controllerGrp );
     MyCheckStatus(status, "getMetaNodeConnection() failed");
     MGlobal::deleteNode(this->m_ctlGroupObj);
 
@@ -27,6 +27,7 @@ public:
     MObject loadComponent(MDGModifier & dgMod);
     void updateComponent(MDGModifier & dgMod, bool forceUpdate = false, bool globalPos = false);
     void removeComponent(MDGModifier & dgMod);
+    void getPlanInput(ComponentPlan::Input & input);
 
 private:
     MObject m_ctlObj;
@@ -0,0 +1,138 @@
+/***************************************************************
+* Summary: Analytic joint orient solver which computes xyz/yup *
+*          joint orients for a whole joint hierarchy from its  *
+*          world positions, replacing joint -e -oj in MEL.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "JointOrient.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnIkJoint.h>
+#include <maya/MDagPath.h>
+#include <maya/MPoint.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MTransformationMatrix.h>
+
+namespace {
+
+//bones shorter than this are treated as having no child to aim at
+const double kMinBoneLength = 1.0e-6;
+
+//builds the rotation whose rows are the given axes
+MQuaternion frameToQuaternion(const MVector & xAxis, const MVector & yAxis, const MVector & zAxis) {
+    MMatrix frame;
+    frame[0][0] = xAxis.x; frame[0][1] = xAxis.y; frame[0][2] = xAxis.z;
+    frame[1][0] = yAxis.x; frame[1][1] = yAxis.y; frame[1][2] = yAxis.z;
+    frame[2][0] = zAxis.x; frame[2][1] = zAxis.y; frame[2][2] = zAxis.z;
+    return MTransformationMatrix(frame).rotation();
+}
+
+}
+
+void lrutils::solveJointOrients(const std::vector<MVector> & positions, const std::vector<int> & parents, const MMatrix & rootParentMatrix,
+    std::vector<MQuaternion> & jointOrients, std::vector<MVector> & localTranslations) {
+    unsigned int numJoints = (unsigned int)positions.size();
+    jointOrients.assign(numJoints, MQuaternion::identity);
+    localTranslations.assign(numJoints, MVector::zero);
+    if(numJoints == 0)
+        return;
+
+    //find the first child of every joint in one pass
+    std::vector<int> firstChild(numJoints, -1);
+    for(unsigned int i = 0; i < numJoints; i++) {
+        int parent = parents[i];
+        if(parent >= 0 && firstChild[parent] == -1)
+            firstChild[parent] = (int)i;
+    }
+
+    MQuaternion rootParentOrient = MTransformationMatrix(rootParentMatrix).rotation();
+    std::vector<MQuaternion> worldOrients(numJoints);
+    for(unsigned int i = 0; i < numJoints; i++) {
+        int parent = parents[i];
+        MQuaternion parentOrient = (parent >= 0) ? worldOrients[parent] : rootParentOrient;
+
+        MVector aim = MVector::zero;
+        if(firstChild[i] != -1)
+            aim = positions[firstChild[i]] - positions[i];
+        if(aim.length() < kMinBoneLength) {
+            //end joints line up with their parent
+            worldOrients[i] = parentOrient;
+        } else {
+            MVector xAxis = aim.normal();
+            MVector zAxis = xAxis ^ MVector::yAxis;
+            if(zAxis.length() < kMinBoneLength) {
+                //the bone points straight up or down, keep the parent's Z axis as the reference
+                MVector yAxis = MVector::zAxis.rotateBy(parentOrient) ^ xAxis;
+                if(yAxis.length() < kMinBoneLength)
+                    yAxis = MVector::zAxis ^ xAxis;
+                zAxis = xAxis ^ yAxis.normal();
+            }
+            zAxis.normalize();
+            MVector yAxis = zAxis ^ xAxis;
+            worldOrients[i] = frameToQuaternion(xAxis, yAxis, zAxis);
+        }
+        //rotate is zeroed, so the joint orient carries the whole rotation relative to the parent
+        jointOrients[i] = worldOrients[i] * parentOrient.inverse();
+
+        //keep the joint where it is in world space under the re-oriented parent
+        if(parent >= 0) {
+            localTranslations[i] = (positions[i] - positions[parent]).rotateBy(worldOrients[parent].inverse());
+        } else {
+            localTranslations[i] = MPoint(positions[i]) * rootParentMatrix.inverse();
+        }
+    }
+}
+
+MStatus lrutils::orientJointChain(MObject topJointObj) {
+    RigProfileScope profileScope("lrutils::orientJointChain");
+    MStatus status = MS::kFailure;
+    if(topJointObj.isNull() || !topJointObj.hasFn(MFn::kJoint))
+        return status;
+
+    //gather the hierarchy with every parent ahead of its children
+    std::vector<MObject> joints;
+    std::vector<int> parents;
+    joints.push_back(topJointObj);
+    parents.push_back(-1);
+    for(unsigned int i = 0; i < joints.size(); i++) {
+        MFnDagNode dagFn( joints[i] );
+        for(unsigned int c = 0; c < dagFn.childCount(); c++) {
+            MObject childObj = dagFn.child(c);
+            if(childObj.hasFn(MFn::kJoint)) {
+                joints.push_back(childObj);
+                parents.push_back((int)i);
+            }
+        }
+    }
+
+    std::vector<MVector> positions(joints.size());
+    MMatrix rootParentMatrix;
+    for(unsigned int i = 0; i < joints.size(); i++) {
+        MDagPath jointPath;
+        status = MDagPath::getAPathTo(joints[i], jointPath);
+        MyCheckStatusReturn(status, "MDagPath::getAPathTo() failed");
+        MMatrix worldMatrix = jointPath.inclusiveMatrix();
+        positions[i] = MVector(worldMatrix[3][0], worldMatrix[3][1], worldMatrix[3][2]);
+        if(i == 0)
+            rootParentMatrix = jointPath.exclusiveMatrix();
+    }
+
+    std::vector<MQuaternion> jointOrients;
+    std::vector<MVector> localTranslations;
+    lrutils::solveJointOrients(positions, parents, rootParentMatrix, jointOrients, localTranslations);
+
+    for(unsigned int i = 0; i < joints.size(); i++) {
+        MFnIkJoint jointFn( joints[i] );
+        jointFn.setRotation( MEulerRotation(0, 0, 0) );
+        jointFn.setScaleOrientation( MQuaternion::identity );
+        status = jointFn.setOrientation( jointOrients[i] );
+        MyCheckStatusReturn(status, "MFnIkJoint.setOrientation() failed");
+        status = jointFn.setTranslation( localTranslations[i], MSpace::kTransform );
+        MyCheckStatusReturn(status, "MFnIkJoint.setTranslation() failed");
+    }
+
+    return status;
+}
@@ -0,0 +1,30 @@
+/***************************************************************
+* Summary: Analytic joint orient solver which computes xyz/yup *
+*          joint orients for a whole joint hierarchy from its  *
+*          world positions, replacing joint -e -oj in MEL.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _JointOrient
+#define _JointOrient
+
+#include <maya/MStatus.h>
+#include <maya/MObject.h>
+#include <maya/MVector.h>
+#include <maya/MQuaternion.h>
+#include <maya/MMatrix.h>
+#include <vector>
+
+namespace lrutils {
+    //computes the orients joint -e -zso -oj xyz -sao yup -ch would give a joint hierarchy. positions are the
+    //world positions of the joints, parents[i] is the index of joint i's parent (-1 for the root) and every
+    //parent must come before its children. rootParentMatrix is the world matrix of the root's parent.
+    //The X axis of each joint aims at its first child and the Y axis points as close to world up as possible,
+    //joints without children keep the orientation of their parent.
+    void solveJointOrients(const std::vector<MVector> & positions, const std::vector<int> & parents, const MMatrix & rootParentMatrix,
+        std::vector<MQuaternion> & jointOrients, std::vector<MVector> & localTranslations);
+    //orients topJointObj and every joint below it with solveJointOrients, writing the results with MFnIkJoint
+    MStatus orientJointChain(MObject topJointObj);
+}
+
+#endif //_JointOrient
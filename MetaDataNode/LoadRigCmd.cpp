@@ -15,6 +15,7 @@
 #include <maya/MFnTransform.h>
 #include <maya/MFnMessageAttribute.h>
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include "Rig.h"
 #include "LoadRigUtils.h"
 #include <boost/lexical_cast.hpp>
@@ -29,6 +30,7 @@ MStatus LoadRigCmd::doIt ( const MArgList &args )
     if(MS::kSuccess != status )
         return status;
 
+    RigTraceCapture traceCapture(this->m_tracePath);
     Rig* aRig = new Rig(m_xmlPath);
     aRig->load(dgMod); 
     setResult("MRN_"+aRig->getName());
@@ -75,6 +77,14 @@ MStatus LoadRigCmd::parseArgs(const MArgList & args )
         this->m_xmlPath = tmp;
     }
 
+    if (argData.isFlagSet(LoadRigCmd::TraceParam())) {
+        status = argData.getFlagArgument(LoadRigCmd::TraceParam(), 0, this->m_tracePath);
+        if (!status) {
+            status.perror("trace flag parsing failed");
+            return status;
+        }
+    }
+
     return MS::kSuccess;
 }
 
@@ -85,7 +95,7 @@ MStatus LoadRigCmd::undoIt()
 
 MStatus LoadRigCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
 
 MSyntax LoadRigCmd::newSyntax()
@@ -93,6 +103,7 @@ MSyntax LoadRigCmd::newSyntax()
     MSyntax syntax;
 
     syntax.addFlag(LoadRigCmd::FileParam(), LoadRigCmd::FileParamLong(), MSyntax::kString);
+    syntax.addFlag(LoadRigCmd::TraceParam(), LoadRigCmd::TraceParamLong(), MSyntax::kString);
 
     return syntax;
 }
\ No newline at end of file
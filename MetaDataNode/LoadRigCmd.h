@@ -30,10 +30,14 @@ public:
 
     static const char* FileParam() { return "-p"; }
     static const char* FileParamLong() { return "-path"; }
+    //write a Chrome trace-event timeline of the load to the given path
+    static const char* TraceParam() { return "-tr"; }
+    static const char* TraceParamLong() { return "-trace"; }
 
 private:
     MDGModifier dgMod;
     MString m_xmlPath;
+    MString m_tracePath;
 
 
 };
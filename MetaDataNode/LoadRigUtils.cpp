@@ -7,21 +7,31 @@
 
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MDagModifier.h>
-#include <maya/MItDependencyNodes.h>
 #include <maya/MEulerRotation.h>
 #include <maya/MTransformationMatrix.h>
 #include <maya/MFnAnimCurve.h>
 #include <maya/MMatrix.h>
+#include <maya/MAngle.h>
+#include <maya/MIntArray.h>
 #include "LoadRigUtils.h"
+#include "ControllerShapes.h"
+#include "HierarchyPlan.h"
+#include "Constraints.h"
+#include "GuideTransforms.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "NodeNameIndex.h"
+#include "MetaNetworkSnapshot.h"
 #include "MetaDataManagerNode.h"
+#include "MetaRootNode.h"
 #include "MDHipNode.h"
 #include "MDSpineNode.h"
 
 MStatus lrutils::loadGeoReference(MString geoFilePath, MString geoName, MString & name, MObject & geoObj) {
+    RigProfileScope profileScope("lrutils::loadGeoReference");
     MStatus status = MS::kFailure;
 
-    MString projPath = MGlobal::executeCommandStringResult(MString("workspace -q -rd;"),false,false);
+    MString projPath = lrutils::executeCommandStringResult(MString("workspace -q -rd;"),false,false);
     MString relativePath = geoFilePath.substring(2,geoFilePath.numChars() - 1);
 
     //assemble the full file path of the geometry file
@@ -55,7 +65,7 @@ MStatus lrutils::loadGeoReference(MString geoFilePath, MString geoName, MString
         stringstream tmp;
         tmp << "file -r -type \"mayaAscii\" -gl -loadReferenceDepth \"all\" -namespace \"" << fileNamespace.c_str() << "\" -options \"v=0\" \"" << fullGeoPath.asChar() << "\";";
         MString referenceCommand = MString(tmp.str().c_str());
-        MGlobal::executeCommand(referenceCommand);
+        lrutils::executeCommand(referenceCommand);
     }
     
     //get the referenced geometry transform node and add the metaParent
@@ -86,21 +96,12 @@ MStatus lrutils::loadGeoReference(MString geoFilePath, MString geoName, MString
 }
 
 MStatus lrutils::getObjFromName(MString name, MObject & obj) {
-    MStatus status;
-
-    MSelectionList selection;
-    status = selection.add( name, true );
-    MyCheckStatusReturn(status, "add node \""+name+"\" to selection failed.");
-
-    if(selection.length() ) {
-        selection.getDependNode(0, obj);
-        status = MS::kSuccess;
-    }
-
-    return status;
+    RigProfileScope profileScope("lrutils::getObjFromName");
+    return NodeNameIndex::getObj(name, obj);
 }
 
 MStatus lrutils::setLocation(MObject obj, MVectorArray location, MFnTransform& transformFn, bool translate, bool rotation, bool scale) {
+    RigProfileScope profileScope("lrutils::setLocation");
     MStatus status = MS::kFailure;
 
     status = transformFn.setObject(obj);
@@ -125,12 +126,13 @@ MStatus lrutils::setLocation(MObject obj, MVectorArray location, MFnTransform& t
         }
         if(scale) {
             MVector vScale = location[2];
-            double* scale = new double[3];
-            vScale.get(scale);
-            transformFn.setScale(scale);
-            //make the scale of the controller the identity
-            MGlobal::executeCommand("select -r "+transformFn.name()+";");
-            MGlobal::executeCommand("makeIdentity -s true -apply true;");
+            //make the scale of the controller the identity, the op list bakes it into the shapes
+            SceneOpList ops;
+            SceneOpList::NodeRef node = ops.addExisting(obj);
+            ops.setScale(node, vScale);
+            ops.makeIdentity(node);
+            status = ops.flush();
+            MyCheckStatusReturn(status, "SceneOpList.flush() failed");
         }
     }
 
@@ -138,30 +140,46 @@ MStatus lrutils::setLocation(MObject obj, MVectorArray location, MFnTransform& t
 }
 
 MStatus lrutils::setParentConstraintOffset(MObject constraintObj, MTransformationMatrix transform) {
+    std::vector<MObject> constraintObjs(1, constraintObj);
+    std::vector<MTransformationMatrix> transforms(1, transform);
+    return lrutils::setParentConstraintOffsets(constraintObjs, transforms);
+}
+
+MStatus lrutils::setParentConstraintOffsets(std::vector<MObject> constraintObjs, std::vector<MTransformationMatrix> transforms, unsigned int targetIndex) {
+    RigProfileScope profileScope("lrutils::setParentConstraintOffsets");
     MStatus status = MS::kFailure;
+    if(constraintObjs.size() != transforms.size())
+        return status;
 
-    MFnTransform constraintFn;
-    status = constraintFn.setObject( constraintObj );
-    MyCheckStatusReturn(status, "invalid MObject provided for MFnTransform.setObject()");
-    MString constraintName = constraintFn.name();
-
-    if ( status = MS::kSuccess ) {
-        MVector vTranslation = transform.getTranslation(MSpace::kTransform);
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetTranslateX\" "+vTranslation.x+";");
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetTranslateY\" "+vTranslation.y+";");
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetTranslateZ\" "+vTranslation.z+";");
-        double* rotation = new double[3];
+    MDGModifier dgMod;
+    for(unsigned int i = 0; i < constraintObjs.size(); i++) {
+        MFnDependencyNode constraintFn;
+        status = constraintFn.setObject( constraintObjs[i] );
+        MyCheckStatusReturn(status, "invalid MObject provided for MFnDependencyNode.setObject()");
+
+        //decompose the transformation once per constraint
+        MVector vTranslation = transforms[i].getTranslation(MSpace::kTransform);
+        double rotation[3];
         MTransformationMatrix::RotationOrder rotOrder = MTransformationMatrix::kXYZ;
-        transform.getRotation(rotation,rotOrder);
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetRotateX\" "+rotation[0]+";");
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetRotateY\" "+rotation[1]+";");
-        MGlobal::executeCommand( "setAttr \""+constraintName+".target[0].targetOffsetRotateZ\" "+rotation[2]+";");
+        transforms[i].getRotation(rotation,rotOrder);
+
+        MPlug targetPlug = lrutils::findPlug(constraintFn, "target").elementByLogicalIndex(targetIndex);
+        dgMod.newPlugValueDouble( targetPlug.child(constraintFn.attribute("targetOffsetTranslateX")), vTranslation.x );
+        dgMod.newPlugValueDouble( targetPlug.child(constraintFn.attribute("targetOffsetTranslateY")), vTranslation.y );
+        dgMod.newPlugValueDouble( targetPlug.child(constraintFn.attribute("targetOffsetTranslateZ")), vTranslation.z );
+        //getRotation gives radians, which are written as such so they don't depend on the UI angle unit
+        dgMod.newPlugValueMAngle( targetPlug.child(constraintFn.attribute("targetOffsetRotateX")), MAngle(rotation[0], MAngle::kRadians) );
+        dgMod.newPlugValueMAngle( targetPlug.child(constraintFn.attribute("targetOffsetRotateY")), MAngle(rotation[1], MAngle::kRadians) );
+        dgMod.newPlugValueMAngle( targetPlug.child(constraintFn.attribute("targetOffsetRotateZ")), MAngle(rotation[2], MAngle::kRadians) );
     }
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
 
     return status;
 }
 
 MStatus lrutils::makeHomeNull(MObject obj, MFnTransform& transformFn, MObject& groupObj) {
+    RigProfileScope profileScope("lrutils::makeHomeNull");
     MStatus status = MS::kFailure;
     
     status = transformFn.setObject(obj);
@@ -171,7 +189,7 @@ MStatus lrutils::makeHomeNull(MObject obj, MFnTransform& transformFn, MObject& g
         MDagModifier dagMod;
         groupObj = dagMod.createNode( "transform", MObject::kNullObj, &status );
         MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
-        dagMod.doIt();
+        lrutils::doIt(dagMod);
 
         MFnTransform groupFn;
         groupFn.setObject(groupObj);
@@ -188,13 +206,41 @@ MStatus lrutils::makeHomeNull(MObject obj, MFnTransform& transformFn, MObject& g
     return status;
 }
 
+MStatus lrutils::makeHomeNull(MObject obj, MMatrix localMatrix, MObject parent, MObject& groupObj) {
+    RigProfileScope profileScope("lrutils::makeHomeNull");
+    MStatus status = MS::kFailure;
+    MFnTransform transformFn;
+    status = transformFn.setObject(obj);
+    MyCheckStatusReturn(status, "invalid MObject provided for MFnTransform.setObject()");
+
+    //the group is created in place, so it never has to be moved after it is placed
+    MDagModifier dagMod;
+    groupObj = dagMod.createNode( "transform", parent, &status );
+    MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
+    status = dagMod.reparentNode( obj, groupObj );
+    MyCheckStatusReturn(status, "MDagModifier.reparentNode() failed");
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+
+    MFnTransform groupFn( groupObj );
+    status = groupFn.set( MTransformationMatrix(localMatrix) );
+    MyCheckStatusReturn(status, "MFnTransform.set() failed");
+
+    MString groupName = transformFn.name();
+    groupName = groupName.substring(0, groupName.numChars() - 4);
+    groupName += "GRP";
+    groupFn.setName(groupName);
+
+    return status;
+}
+
 MStatus lrutils::makeGroup(MObject & obj, MString name) {
     MStatus status = MS::kFailure;
 
     MDagModifier dagMod;
     MObject groupObj = dagMod.createNode( "transform", MObject::kNullObj, &status );
     MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
-    dagMod.doIt();
+    lrutils::doIt(dagMod);
 
     MFnTransform groupFn;
     groupFn.setObject(groupObj);
@@ -208,38 +254,15 @@ MStatus lrutils::makeGroup(MObject & obj, MString name) {
 }
 
 MStatus lrutils::getMetaRootByName(MObject & obj, MString name) {
+    RigProfileScope profileScope("lrutils::getMetaRootByName");
     MStatus status = MS::kFailure;
 
-    for( MItDependencyNodes nodeIt(MFn::kPluginDependNode);
-        !nodeIt.isDone(); nodeIt.next() ) {
-        MFnDependencyNode nodeFn( nodeIt.item() );
-        if(nodeFn.typeId() == MetaDataManagerNode::id) {
-            //Get the plug for the list of metaRoots
-            MPlug metaRootsPlug = nodeFn.findPlug(MString("metaRoots"),true,&status);
-            MyCheckStatusReturn(status,"findPlug failed");
-            //MGlobal::displayInfo( metaRootsPlug.name() );
-            
-            //follow its connection to all the plugs on connected metaRoots
-            MPlugArray rootPlugs;
-            metaRootsPlug.connectedTo(rootPlugs,false,true,&status);
-            MyCheckStatusReturn(status,"MPlug.connectedTo failed");
-            unsigned int numRootPlugs = rootPlugs.length();
-
-            for(unsigned int i = 0; i < numRootPlugs; i++) {
-                MObject rootNodeObj = rootPlugs[i].node(&status);
-                MyCheckStatusReturn(status,"MPlug.node() failed");
-                MFnDependencyNode rootNodeFn( rootNodeObj );
-
-                //get the name of the metaRoot node and compare it to the search string
-                MString rootName = rootNodeFn.name();
-                rootName = rootName.substring(4,rootName.numChars());
-                if( rootName == name ) {
-                    obj = rootNodeObj;
-                    status = MS::kSuccess;
-                    break;
-                }
-            }
-        }
+    MObject managerObj = MetaDataManagerNode::getManager();
+    if( !managerObj.isNull() ) {
+        MFnDependencyNode nodeFn( managerObj );
+        //the manager keeps a registry of its metaRoots by rig name
+        MetaDataManagerNode* manager = static_cast<MetaDataManagerNode*>( nodeFn.userNode() );
+        status = manager->findMetaRoot(name, obj);
     }
 
     if(status == MS::kFailure) {
@@ -250,18 +273,45 @@ MStatus lrutils::getMetaRootByName(MObject & obj, MString name) {
 }
 
 MStatus lrutils::getMetaNodeConnection(MObject metaNodeObj, MObject & connectedObj, MString name) {
+    RigProfileScope profileScope("lrutils::getMetaNodeConnection");
     MStatus status = MS::kFailure;
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    if(snapshot != NULL && snapshot->getConnection(metaNodeObj, name, connectedObj))
+        return MS::kSuccess;
+
     MFnDependencyNode metaNodeFn( metaNodeObj );
-    MPlug metaNodePlug = metaNodeFn.findPlug( name, true, &status );
+    MPlug metaNodePlug = lrutils::findPlug(metaNodeFn, name, true, &status );
     if( status != MS::kSuccess ) {
         return status;
     }
     //MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() '"+name+"' failed");
 
+    return lrutils::getMetaPlugConnection(metaNodePlug, connectedObj);
+}
+
+MStatus lrutils::getMetaNodeConnection(MObject metaNodeObj, MObject & connectedObj, const MObject & attr) {
+    RigProfileScope profileScope("lrutils::getMetaNodeConnection");
+    MStatus status = MS::kFailure;
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    if(snapshot != NULL && snapshot->getConnection(metaNodeObj, attr, connectedObj))
+        return MS::kSuccess;
+
+    MFnDependencyNode metaNodeFn( metaNodeObj );
+    MPlug metaNodePlug = lrutils::findPlug(metaNodeFn, attr, true, &status );
+    if( status != MS::kSuccess ) {
+        return status;
+    }
+
+    return lrutils::getMetaPlugConnection(metaNodePlug, connectedObj);
+}
+
+MStatus lrutils::getMetaPlugConnection(MPlug metaNodePlug, MObject & connectedObj) {
+    MStatus status = MS::kFailure;
+
     if (metaNodePlug.isSource()) {
         //follow the plug connection to the connected plug on the other object
         MPlugArray connectedPlugs;
-        metaNodePlug.connectedTo(connectedPlugs,false,true,&status);
+        lrutils::connectedTo(metaNodePlug, connectedPlugs,false,true,&status);
         MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
         MPlug connectedPlug = connectedPlugs[0];
 
@@ -272,7 +322,7 @@ MStatus lrutils::getMetaNodeConnection(MObject metaNodeObj, MObject & connectedO
     }
     if (metaNodePlug.isDestination()) {
         MPlugArray connectedPlugs;
-        metaNodePlug.connectedTo(connectedPlugs,true,false,&status);
+        lrutils::connectedTo(metaNodePlug, connectedPlugs,true,false,&status);
         MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
         MPlug connectedPlug = connectedPlugs[0];
 
@@ -320,27 +370,48 @@ MStatus lrutils::stringReplaceAll(MString &source, MString search, MString repla
     return status;
 }
 
-MStatus lrutils::getMetaChildByName(MObject metaNodeObj, MString name, MObject& metaChildObj) {
+MString lrutils::stripMetaNodePrefix(const MString & metaNodeName) {
+    //component metadata nodes are named <prefix>_<rig name>_<component name>, the rig and component
+    //names can hold underscores of their own but the prefix can't
+    std::string name = metaNodeName.asChar();
+    size_t namespaceEnd = name.rfind(':');
+    if(namespaceEnd != std::string::npos)
+        name = name.substr(namespaceEnd + 1);
+    size_t prefixEnd = name.find('_');
+    if(prefixEnd == std::string::npos)
+        return MString( name.c_str() );
+    return MString( name.substr(prefixEnd + 1).c_str() );
+}
+
+bool lrutils::isMetaNodeOfComponent(const MString & metaNodeName, const MString & rigName, const MString & compName) {
+    return lrutils::stripMetaNodePrefix(metaNodeName) == rigName + "_" + compName;
+}
+
+MStatus lrutils::getMetaChildByName(MObject metaNodeObj, MString rigName, MString name, MObject& metaChildObj) {
+    RigProfileScope profileScope("lrutils::getMetaChildByName");
     MStatus status = MS::kFailure;
 
-    MFnDependencyNode metaNodeFn( metaNodeObj );
-    MPlug metaChildrenPlug = metaNodeFn.findPlug( "metaChildren", true, &status );
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    bool found;
+    if(snapshot != NULL && snapshot->getMetaChildByName(metaNodeObj, rigName, name, metaChildObj, found))
+        return found ? MS::kSuccess : MS::kFailure;
+
+    MPlug metaChildrenPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren, &status);
     MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
 
     //follow the plug connection to the connected plug on the other object
     MPlugArray connectedChildPlugs;
-    metaChildrenPlug.connectedTo(connectedChildPlugs,false,true,&status);
+    lrutils::connectedTo(metaChildrenPlug, connectedChildPlugs,false,true,&status);
     MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+    //fails unless a child matches
+    status = MS::kFailure;
 
     for (unsigned int i = 0; i < connectedChildPlugs.length(); i++) {
         MPlug connectedPlug = connectedChildPlugs[i];
-        MObject connectedNodeObj = connectedPlug.node(&status);
-        MyCheckStatusReturn(status, "MPlug.node() failed");
-
+        MObject connectedNodeObj = connectedPlug.node();
         MFnDependencyNode connectedNodeFn( connectedNodeObj );
-        MString connectedNodeName = connectedNodeFn.name();
-        int index = connectedNodeName.indexW( name );
-        if( index != -1 ) {
+        //a component named "arm" must not match the metadata node of "arm2"
+        if( lrutils::isMetaNodeOfComponent(connectedNodeFn.name(), rigName, name) ) {
             metaChildObj = connectedNodeObj;
             status = MS::kSuccess;
             break;
@@ -351,35 +422,38 @@ MStatus lrutils::getMetaChildByName(MObject metaNodeObj, MString name, MObject&
 }
 
 MStatus lrutils::getMetaChildByRigId(MObject metaNodeObj, MString rigId, MObject& metaChildObj) {
+    RigProfileScope profileScope("lrutils::getMetaChildByRigId");
     MStatus status = MS::kFailure;
 
-    MFnDependencyNode metaNodeFn( metaNodeObj );
-    MPlug metaChildrenPlug = metaNodeFn.findPlug( "metaChildren", true, &status );
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    bool found;
+    if(snapshot != NULL && snapshot->getMetaChildByRigId(metaNodeObj, rigId, metaChildObj, found))
+        return found ? MS::kSuccess : MS::kFailure;
+
+    MPlug metaChildrenPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren, &status);
     MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
 
     //follow the plug connection to the connected plug on the other object
     MPlugArray connectedChildPlugs;
-    metaChildrenPlug.connectedTo(connectedChildPlugs,false,true,&status);
+    lrutils::connectedTo(metaChildrenPlug, connectedChildPlugs,false,true,&status);
     MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+    //fails unless a child matches
+    status = MS::kFailure;
 
     for (unsigned int i = 0; i < connectedChildPlugs.length(); i++) {
         MPlug connectedPlug = connectedChildPlugs[i];
-        MObject connectedNodeObj = connectedPlug.node(&status);
-        MyCheckStatusReturn(status, "MPlug.node() failed");
-
-        MFnDependencyNode connectedNodeFn( connectedNodeObj );
+        MObject connectedNodeObj = connectedPlug.node();
 
         //get the rigId number held in the rigId attribute
-        MPlug rigIdPlug = connectedNodeFn.findPlug(MString("rigId"),true,&status);
-        MyCheckStatusReturn(status,"findPlug failed");
+        MPlug rigIdPlug = MetaDataNode::getCommonPlug(connectedNodeObj, MetaDataNode::kRigId);
         MString childRigId;
         rigIdPlug.getValue(childRigId);
-        //if rigId is in childRigId then return the object
-        if( childRigId.indexW(rigId) != -1 ) {
+        //rigId "1" must not match "12" or "21"
+        if( childRigId == rigId ) {
             metaChildObj = connectedNodeObj;
             status = MS::kSuccess;
             break;
-        } 
+        }
     }
 
     return status;
@@ -389,13 +463,12 @@ MStatus lrutils::getNumMetaChildren(MObject metaNodeObj, int & num) {
     MStatus status = MS::kFailure;    
 
     if( !metaNodeObj.isNull() ) {
-        MFnDependencyNode metaNodeFn( metaNodeObj );
-        MPlug metaChildrenPlug = metaNodeFn.findPlug( "metaChildren", true, &status );
+        MPlug metaChildrenPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren, &status);
         MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
 
         //follow the plug connection to the connected plug on the other object
         MPlugArray connectedChildPlugs;
-        metaChildrenPlug.connectedTo(connectedChildPlugs,false,true,&status);
+        lrutils::connectedTo(metaChildrenPlug, connectedChildPlugs,false,true,&status);
         MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
 
         num = connectedChildPlugs.length();
@@ -405,15 +478,15 @@ MStatus lrutils::getNumMetaChildren(MObject metaNodeObj, int & num) {
 }
 
 MStatus lrutils::getMetaParent(MObject metaNodeObj, MObject & metaParentNodeObj) {
+    RigProfileScope profileScope("lrutils::getMetaParent");
     MStatus status = MS::kFailure;
 
-    MFnDependencyNode metaNodeFn( metaNodeObj );
-    MPlug metaParentPlug = metaNodeFn.findPlug( "metaParent", true, &status );
+    MPlug metaParentPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaParent, &status);
     MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
 
     //follow the plug connection to the connected metaChildren plug on the parent object
     MPlugArray connectedPlugs;
-    metaParentPlug.connectedTo(connectedPlugs,true,false,&status);
+    lrutils::connectedTo(metaParentPlug, connectedPlugs,true,false,&status);
     MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
     metaParentNodeObj = connectedPlugs[0].node(&status);
     MyCheckStatusReturn(status, "MPlug.node() failed");
@@ -437,6 +510,7 @@ MStatus lrutils::getMetaParent(MObject metaNodeObj, MObject & metaParentNodeObj)
 // a map of world position matrices for the controller are passed in as a parameter. The key for the map
 // is the time at which the associated world matrix was stored.
 MStatus lrutils::updateAnimCurves(MObject transformObj, std::map<double, MMatrix> ctlWorldMatrices, MMatrix ctlGroupMatrix) {
+    RigProfileScope profileScope("lrutils::updateAnimCurves");
     MStatus status = MS::kFailure;
     MFnTransform transformFn( transformObj, &status );
     MyCheckStatusReturn(status, status.errorString() );
@@ -448,7 +522,7 @@ MStatus lrutils::updateAnimCurves(MObject transformObj, std::map<double, MMatrix
     for(unsigned int i = 0; i < transformConnections.length(); i++) {
         //get all of the plugs this plug is connected to as a destination
         MPlugArray connectedPlugs;
-        transformConnections[i].connectedTo(connectedPlugs,true,false,&status);
+        lrutils::connectedTo(transformConnections[i], connectedPlugs,true,false,&status);
         MyCheckStatusReturn(status, status.errorString() );
         MString plugName = transformConnections[i].partialName(false,false,false,false,false,true);
         for(unsigned int j = 0; j < connectedPlugs.length(); j++) {
@@ -516,160 +590,206 @@ MStatus lrutils::updateAnimCurves(MObject transformObj, std::map<double, MMatrix
     return status;
 }
 
-std::vector<MObject> lrutils::buildSkeletonFromGuide(std::vector<MVectorArray> locations, MString prefix, MPlug metaDataPlug, MObject metaParentJoint, MString layerName) {
-    MDGModifier dgMod;
-    MStatus status;
+std::vector<MObject> lrutils::buildSkeletonFromGuide(std::vector<MVectorArray> locations, MString prefix, MPlug metaDataPlug, MObject metaParentJoint, MString layerName, const ComponentPlan * plan) {
+    RigProfileScope profileScope("lrutils::buildSkeletonFromGuide");
     std::vector<MObject> joints;
-    MFnMessageAttribute mAttr;
+    std::vector<SceneOpList::NodeRef> jointRefs;
+    //the whole chain is recorded and applied as one batch
+    SceneOpList ops;
 
-    MObject parentJoint;
+    SceneOpList::NodeRef parentJoint = SceneOpList::kWorld;
     unsigned int jointNum = 0;
 
     for (std::vector<MVectorArray>::iterator it = locations.begin(); it != locations.end(); ++it) {
         MVectorArray location = *it;
-        MObject joint = createJointFromLocation(location, prefix, jointNum, parentJoint);
-        joints.push_back(joint);
+        SceneOpList::NodeRef joint = createJointFromLocation(ops, location, prefix, jointNum, parentJoint, plan);
+        jointRefs.push_back(joint);
 
-        MFnTransform jointFn( joint );
         //add metaParent attributes to joint
         if(!metaDataPlug.isNull()) {
-            MObject jointAttr = mAttr.create("metaParent", "metaParent");
-            jointFn.addAttribute(jointAttr);
+            ops.addMetaParent(joint);
             //connect the metaparent attribute to the MDSpine node
-            status = dgMod.connect( metaDataPlug, jointFn.findPlug("metaParent") );
-            MyCheckStatus(status, "connect failed");
-            dgMod.doIt();
+            ops.connectMeta(metaDataPlug.isArray() ? metaDataPlug.elementByLogicalIndex(jointNum) : metaDataPlug, joint);
         }
 
         //if layer name is provided, add the joint to that display layer
         if(layerName != "") {
-            MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ layerName+" "+ jointFn.name()+";");
+            ops.addToLayer(layerName, joint);
         }
 
         parentJoint = joint;
         jointNum++;
     }
     //orient the joint chain
-    MFnTransform topJointFn(joints.at(0));
-    MGlobal::executeCommand("joint -e -zso -oj \"xyz\" -sao \"yup\" -ch " + topJointFn.fullPathName() + ";");
+    if(plan != NULL && plan->getJointOrients().size() == jointRefs.size()) {
+        for(unsigned int i = 0; i < jointRefs.size(); i++) {
+            ops.setJointOrient(jointRefs[i], plan->getJointOrients()[i], plan->getJointTranslations()[i]);
+        }
+    } else {
+        ops.orientJoint(jointRefs.at(0));
+    }
 
     //if meta parent joint is not null, parent first joint to it
     if(!metaParentJoint.isNull()) {
-        MFnTransform firstJointFn(joints.at(0));
-
-        MFnTransform metaParentJointFn(metaParentJoint);
-        MGlobal::executeCommand("parent " + firstJointFn.fullPathName() + " " + metaParentJointFn.fullPathName() + ";");
+        SceneOpList::NodeRef metaParentJointRef = ops.addExisting(metaParentJoint);
+        ops.parent(jointRefs.at(0), metaParentJointRef);
         //orient the parent joint
-        MGlobal::executeCommand("joint -e -zso -oj \"xyz\" -sao \"yup\" -ch " + metaParentJointFn.fullPathName() + ";");
+        ops.orientJoint(metaParentJointRef);
+    }
+
+    MStatus status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
+    for(unsigned int i = 0; i < jointRefs.size(); i++) {
+        joints.push_back(ops.getObject(jointRefs.at(i)));
     }
 
     return joints;
 }
 
-void lrutils::buildFKControls(std::vector<MObject> vFKCtls, std::vector<MObject> vFKCtlGroups, std::vector<MVectorArray> locations, std::vector<MObject> joints, MString prefix, MString icon, MString color, MObject metaDataNode, MObject parentController, MString layerName, bool createLastControl) {
+void lrutils::buildFKControls(std::vector<MObject> vFKCtls, std::vector<MObject> vFKCtlGroups, std::vector<MVectorArray> locations, std::vector<MObject> joints, MString prefix, MString icon, MString color, MObject metaDataNode, MObject parentController, MMatrix parentWorldMatrix, MString layerName, bool createLastControl, const ComponentPlan * plan) {
+    RigProfileScope profileScope("lrutils::buildFKControls");
+    //each controller group sits under the controller of the location before it
+    std::vector<MMatrix> localMatrices;
+    if(plan != NULL && plan->getControllerLocalMatrices().size() == locations.size() && plan->getParentWorldMatrix() == parentWorldMatrix)
+        localMatrices = plan->getControllerLocalMatrices();
+    else
+        localMatrices = GuideTransforms::getChainLocalMatrices(locations, parentWorldMatrix);
+    //the joint constraints of the whole chain are created together once the controls exist
+    std::vector<MObject> constrainedJoints;
+    std::vector<MObject> constrainingCtls;
     for(unsigned int i = 0; i < locations.size(); i++) {
         if(!createLastControl) {
             if(i == locations.size() - 1) {
-                return;
+                break;
             }
         }
         MVectorArray location = locations.at(i);
         MObject joint = joints.at(i);
         MObject fkCtlObj;
         MObject fkCtlGroupObj;
-        createFKCtlFromLocation(location, joint, prefix, i, icon, color, parentController, fkCtlObj, fkCtlGroupObj, layerName, metaDataNode);
+        createFKCtlFromLocation(location, localMatrices.at(i), joint, prefix, i, icon, color, parentController, fkCtlObj, fkCtlGroupObj, layerName, metaDataNode, false);
         parentController = fkCtlObj;
         vFKCtls.push_back(fkCtlObj);
         vFKCtlGroups.push_back(fkCtlGroupObj);
+        constrainingCtls.push_back(fkCtlObj);
+        constrainedJoints.push_back(joint);
+    }
+
+    std::vector<MObject> constraintObjs;
+    MStatus status = lrutils::createParentConstraints(constrainingCtls, constrainedJoints, constraintObjs);
+    MyCheckStatus(status, "lrutils::createParentConstraints() failed");
+    SceneOpList ops;
+    for(unsigned int i = 0; i < constraintObjs.size(); i++) {
+        SceneOpList::NodeRef jointParentConstraint = ops.addExisting(constraintObjs[i]);
+        ops.addMetaParent(jointParentConstraint);
+        ops.connectMeta(MPlug(metaDataNode, MDSpineNode::FKJointParentConstraintArray).elementByLogicalIndex(i), jointParentConstraint);
+    }
+    status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
+}
+
+void lrutils::createFKCtlFromLocation(MVectorArray location, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode, bool constrainJoint) {
+    //the parent is already in the scene, so its world matrix is read once to place the group under it
+    MMatrix parentWorldMatrix;
+    if(!parent.isNull()) {
+        MDagPath parentPath;
+        MDagPath::getAPathTo(parent, parentPath);
+        parentWorldMatrix = parentPath.inclusiveMatrix();
     }
+    MMatrix localMatrix = GuideTransforms::getLocationMatrix(location) * parentWorldMatrix.inverse();
+    lrutils::createFKCtlFromLocation(location, localMatrix, joint, prefix, num, icon, color, parent, fkCtlObj, fkCtlGroupObj, layerName, metaDataNode, constrainJoint);
 }
 
-void lrutils::createFKCtlFromLocation(MVectorArray location, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode) {
+void lrutils::createFKCtlFromLocation(MVectorArray location, MMatrix localMatrix, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode, bool constrainJoint) {
+    RigProfileScope profileScope("lrutils::createFKCtlFromLocation");
     MStatus status;
-    MDGModifier dgMod;
     //used for holding results from executed commands
     MStringArray result;
-    MFnDependencyNode depMetaDataNodeFn(metaDataNode);
-    //used for creating metaParent attributes for objects
-    MFnMessageAttribute mAttr;
     MFnTransform jointFn(joint);
+    SceneOpList ops;
     
     //create the control object and set its color
-    status = MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + icon + "')\");" );
-    status = MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + color + "')\");" );
-    status = MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), result );
-    //get the MObject for the controller
-    status = lrutils::getObjFromName(result[0], fkCtlObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-    MFnTransform fkCtlFn( fkCtlObj );
-    lrutils::setLocation(fkCtlObj, location, MFnTransform::MFnTransform(), false, false, true);
+    status = lrutils::createController(icon, color, fkCtlObj);
+    MyCheckStatus(status, "lrutils::createController() failed");
+    SceneOpList::NodeRef fkCtl = ops.addExisting(fkCtlObj);
+    //make the scale of the controller the identity
+    ops.setScale(fkCtl, location[2]);
+    ops.makeIdentity(fkCtl);
     //set controller name
     MString fkCtlName = prefix + "_FK_"+num+"_CTL";
-    dgMod.renameNode(fkCtlObj, fkCtlName);
-    //add the metaParent attribute to the controller
-    MObject controlAttr = mAttr.create("metaParent", "metaParent");
-    fkCtlFn.addAttribute(controlAttr);
-    //connect the controller's metaParent to the MDSpine node
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("FKControllers"), fkCtlFn.findPlug("metaParent") );
-    dgMod.doIt();
+    ops.rename(fkCtl, fkCtlName);
+    //add the metaParent attribute to the controller and connect it to the MDSpine node
+    ops.addMetaParent(fkCtl);
+    ops.connectMeta(MPlug(metaDataNode, MDSpineNode::FKControllerArray).elementByLogicalIndex(num), fkCtl);
+    status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
+    fkCtlObj = ops.getObject(fkCtl);
+    MFnTransform fkCtlFn( fkCtlObj );
     
-    //create the fk control null
-    lrutils::makeHomeNull(fkCtlObj, MFnTransform(), fkCtlGroupObj);
-    lrutils::setLocation(fkCtlGroupObj, location, MFnTransform::MFnTransform(), true, true, false);
+    //create the fk control null in place under its parent
+    status = lrutils::makeHomeNull(fkCtlObj, localMatrix, parent, fkCtlGroupObj);
+    MyCheckStatus(status, "lrutils::makeHomeNull() failed");
+    SceneOpList::NodeRef fkCtlGroup = ops.addExisting(fkCtlGroupObj);
+    //add the metaParent attribute to the controller group and connect it to the MDSpine node
+    ops.addMetaParent(fkCtlGroup);
+    ops.connectMeta(MPlug(metaDataNode, MDSpineNode::FKControllerGrpArray).elementByLogicalIndex(num), fkCtlGroup);
+    status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
     MFnTransform fkCtlGroupFn( fkCtlGroupObj );
-    if(!parent.isNull()) {
-        MFnTransform parentFn(parent);
-        MGlobal::executeCommand("parent " + fkCtlGroupFn.fullPathName() + " " + parentFn.fullPathName() + ";");
-    }
-    //add the metaParent attribute to the controller group
-    fkCtlGroupFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-    //connect the controller group's metaParent to the MDGlobal node
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("FKControllerGroups"), fkCtlGroupFn.findPlug("metaParent") );
-    MyCheckStatus(status, "connect failed"); 
-    dgMod.doIt();
-
-    MGlobal::executeCommand("parentConstraint -mo " + fkCtlFn.fullPathName() + " " + jointFn.fullPathName() + ";",result);
-    MObject jointParentConstraintObj;
-    status = lrutils::getObjFromName(result[0], jointParentConstraintObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-    MFnTransform jointParentConstraintFn(jointParentConstraintObj);
-    jointParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("FKJointParentConstraints"), jointParentConstraintFn.findPlug("metaParent"));
-    dgMod.doIt();
+
+    if(constrainJoint) {
+        MObject jointParentConstraintObj;
+        status = lrutils::createParentConstraint(fkCtlObj, joint, jointParentConstraintObj);
+        MyCheckStatus(status, "lrutils::createParentConstraint() failed");
+        SceneOpList::NodeRef jointParentConstraint = ops.addExisting(jointParentConstraintObj);
+        ops.addMetaParent(jointParentConstraint);
+        ops.connectMeta(MPlug(metaDataNode, MDSpineNode::FKJointParentConstraintArray).elementByLogicalIndex(num), jointParentConstraint);
+    }
 
     //set the display layers for the controller and controller group
-    MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ layerName+" "+ fkCtlFn.fullPathName()+";");
-    MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ layerName+" "+ fkCtlGroupFn.fullPathName()+";");
-    MGlobal::executeCommand("select -cl;");
+    ops.addToLayer(layerName, fkCtl);
+    ops.addToLayer(layerName, fkCtlGroup);
+    ops.selectClear();
+    status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
 }
 
 MObject lrutils::createJointFromLocation(MVectorArray location, MString prefix, unsigned int num, MObject parent) {
-    MStatus status = MS::kFailure;
-    MObject jointObj;
+    SceneOpList ops;
+    SceneOpList::NodeRef parentRef = SceneOpList::kWorld;
+    if(parent != MObject::kNullObj) {
+        parentRef = ops.addExisting(parent);
+    }
+    SceneOpList::NodeRef joint = createJointFromLocation(ops, location, prefix, num, parentRef);
+    MStatus status = ops.flush();
+    MyCheckStatus(status, "SceneOpList.flush() failed");
 
+    return ops.getObject(joint);
+}
+
+SceneOpList::NodeRef lrutils::createJointFromLocation(SceneOpList & ops, MVectorArray location, MString prefix, unsigned int num, SceneOpList::NodeRef parent, const ComponentPlan * plan) {
     //make joint object
-    MDagModifier dagMod;
-    jointObj = dagMod.createNode( "joint", MObject::kNullObj, &status );
-    MyCheckStatus(status, "MDagModifier.createNode() failed");
-    dagMod.doIt();
+    SceneOpList::NodeRef joint = ops.createNode("joint");
     //set position
-    lrutils::setLocation(jointObj, location, MFnTransform::MFnTransform(), true, false, false);
+    ops.setTranslation(joint, location[0]);
     //set name        
-    MString jointName = prefix + "_Skel" + boost::lexical_cast<string>(num).c_str() + "_JNT";
-    dagMod.renameNode(jointObj, jointName);
-    dagMod.doIt();
-    MFnTransform jointFn(jointObj);
+    MString jointName;
+    if(plan != NULL)
+        jointName = plan->getJointName(prefix, num);
+    else
+        jointName = prefix + "_Skel" + boost::lexical_cast<string>(num).c_str() + "_JNT";
+    ops.rename(joint, jointName);
     
     //parent the joint to its parent, if not null
-    if(parent != MObject::kNullObj) {
-        MFnTransform parentFn(parent);
-        MGlobal::executeCommand("parent " + jointFn.fullPathName() + " " + parentFn.fullPathName() + ";");
+    if(parent != SceneOpList::kWorld) {
+        ops.parent(joint, parent);
     }
 
-    return jointObj;
+    return joint;
 }
 
 MStatus lrutils::getAllWorldTransforms(MObject ctlObj, std::map<double, MMatrix>& ctlWorldMatrices) {
+    RigProfileScope profileScope("lrutils::getAllWorldTransforms");
     MStatus status = MS::kFailure;
     
     MFnTransform ctlFn( ctlObj );
@@ -677,11 +797,11 @@ MStatus lrutils::getAllWorldTransforms(MObject ctlObj, std::map<double, MMatrix>
     double nextKeyTime = 0;
     double prevKeyTime = -1;
     double currentTime;
-    MGlobal::executeCommand("currentTime -q;",currentTime);
+    lrutils::executeCommand("currentTime -q;",currentTime);
     MGlobal::viewFrame(1);
     while(nextKeyTime > prevKeyTime) {
         prevKeyTime = nextKeyTime;
-        MGlobal::executeCommand("findKeyframe -timeSlider -which next;",nextKeyTime);
+        lrutils::executeCommand("findKeyframe -timeSlider -which next;",nextKeyTime);
         MGlobal::viewFrame(nextKeyTime);
         MDagPath path;
         status = ctlFn.getPath(path);
@@ -697,38 +817,18 @@ MStatus lrutils::getAllWorldTransforms(MObject ctlObj, std::map<double, MMatrix>
 }
 
 MStatus lrutils::getJointByNum(MObject metaDataNode, unsigned int jointNum, MObject& jointObj) {
+    RigProfileScope profileScope("lrutils::getJointByNum");
     MStatus status;
 
     if(!metaDataNode.isNull()) {
         MFnDependencyNode metaDataFn(metaDataNode);
         if(metaDataFn.typeId() == MDHipNode::id) {
-            status = lrutils::getMetaNodeConnection(metaDataNode, jointObj, "hipJoint");
+            status = lrutils::getMetaNodeConnection(metaDataNode, jointObj, MDHipNode::hipJoint);
             MyCheckStatusReturn(status, "lrutils::getMetaNodeConnection() failed");
         } else if (metaDataFn.typeId() == MDSpineNode::id) {
-            MPlug bindJointsPlug = metaDataFn.findPlug( "BindJoints", true, &status );
-            MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
-
-            //follow the plug connection to the connected plug on the other object
-            MPlugArray connectedJointPlugs;
-            bindJointsPlug.connectedTo(connectedJointPlugs,false,true,&status);
-            MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
-            if( connectedJointPlugs.length() > 0) {
-                //for some reason when more than one plug is connected in an MPlugArray,
-                //the first object connected is in index 1 and the second object connected is
-                //in index 2. The following code simply reverses the joint number we are
-                //looking for since this is the case.
-                if( connectedJointPlugs.length() > 1) {
-                    if(jointNum == 1) {
-                        jointNum = 0;
-                    } else if (jointNum == 0) {
-                        jointNum = 1;
-                    }
-                }
-                MPlug jointPlug = connectedJointPlugs[jointNum];
-                //MPlug jointPlug = bindJointsPlug.connectionByPhysicalIndex(0);
-                jointObj = jointPlug.node(&status);
-                MyCheckStatusReturn(status, "MPlug.node() failed");
-            }
+            MPlug bindJointsPlug(metaDataNode, MDSpineNode::BindJointArray);
+            status = lrutils::getMetaArrayConnection(bindJointsPlug, jointNum, jointObj);
+            MyCheckStatusReturn(status, "lrutils::getMetaArrayConnection() failed");
         }
     }
 
@@ -736,44 +836,119 @@ MStatus lrutils::getJointByNum(MObject metaDataNode, unsigned int jointNum, MObj
 }
 
 MStatus lrutils::getFKControlByNum(MObject metaDataNode, unsigned int fkNum, MObject& fkCtlObj) {
+    RigProfileScope profileScope("lrutils::getFKControlByNum");
     MStatus status;
 
     if(!metaDataNode.isNull()) {
-        MFnDependencyNode metaDataFn(metaDataNode);
-        MPlug fkControlsPlug = metaDataFn.findPlug( "FKControllers", true, &status );
-        MyCheckStatusReturn(status, "MFnDependencyNode.findPlug() failed");
+        MPlug fkControlsPlug(metaDataNode, MDSpineNode::FKControllerArray);
+        status = lrutils::getMetaArrayConnection(fkControlsPlug, fkNum, fkCtlObj);
+        MyCheckStatusReturn(status, "lrutils::getMetaArrayConnection() failed");
+    }
 
-        //follow the plug connection to the connected plug on the other object
-        MPlugArray connectedControlPlugs;
-        fkControlsPlug.connectedTo(connectedControlPlugs,false,true,&status);
+    return status;
+}
+
+MStatus lrutils::getMetaArrayConnection(MPlug metaDataArrayPlug, unsigned int num, MObject& connectedObj) {
+    MStatus status;
+    MPlug elementPlug = metaDataArrayPlug.elementByLogicalIndex(num, &status);
+    MyCheckStatusReturn(status, "MPlug.elementByLogicalIndex() failed");
+
+    //follow the plug connection to the connected plug on the other object
+    MPlugArray connectedPlugs;
+    lrutils::connectedTo(elementPlug, connectedPlugs,false,true,&status);
+    MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+    if( connectedPlugs.length() == 0) {
+        MyError("nothing is connected to "+elementPlug.name());
+        return MS::kFailure;
+    }
+    connectedObj = connectedPlugs[0].node(&status);
+    MyCheckStatusReturn(status, "MPlug.node() failed");
+
+    return MS::kSuccess;
+}
+
+MStatus lrutils::getMetaArrayConnections(MPlug metaDataArrayPlug, MObjectArray& connectedObjs) {
+    RigProfileScope profileScope("lrutils::getMetaArrayConnections");
+    MStatus status;
+    connectedObjs.clear();
+
+    MIntArray indices;
+    metaDataArrayPlug.getExistingArrayAttributeIndices(indices, &status);
+    MyCheckStatusReturn(status, "MPlug.getExistingArrayAttributeIndices() failed");
+    for(unsigned int i = 0; i < indices.length(); i++) {
+        MPlug elementPlug = metaDataArrayPlug.elementByLogicalIndex(indices[i], &status);
+        MyCheckStatusReturn(status, "MPlug.elementByLogicalIndex() failed");
+        MPlugArray connectedPlugs;
+        lrutils::connectedTo(elementPlug, connectedPlugs,false,true,&status);
         MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
-        if( connectedControlPlugs.length() > 0) {
-            //for some reason when more than one plug is connected in an MPlugArray,
-            //the first object connected is in index 1 and the second object connected is
-            //in index 2. The following code simply reverses the number we are
-            //looking for since this is the case.
-            if( connectedControlPlugs.length() > 1) {
-                if(fkNum == 1) {
-                    fkNum = 0;
-                } else if (fkNum == 0) {
-                    fkNum = 1;
-                }
-            }
-            MPlug controlPlug = connectedControlPlugs[fkNum];
-            //MPlug jointPlug = fkControlsPlug.connectionByPhysicalIndex(0);
-            fkCtlObj = controlPlug.node(&status);
-            MyCheckStatusReturn(status, "MPlug.node() failed");
+        //elements stay in the array after the object connected to them is deleted
+        if( connectedPlugs.length() == 0)
+            continue;
+        unsigned int index = (unsigned int)indices[i];
+        if(index >= connectedObjs.length())
+            connectedObjs.setLength(index + 1);
+        connectedObjs[index] = connectedPlugs[0].node();
+    }
+
+    return MS::kSuccess;
+}
+
+MStatus lrutils::migrateMetaDataArrays(MObject metaDataNode) {
+    MStatus status = MS::kSuccess;
+    MFnDependencyNode metaDataFn(metaDataNode);
+    if(metaDataFn.typeId() != MDSpineNode::id)
+        return status;
+
+    const MObject legacyAttrs[] = { MDSpineNode::BindJoints, MDSpineNode::FKJoints, MDSpineNode::FKControllers, MDSpineNode::FKControllerGrps, MDSpineNode::FKJointParentConstraints, MDSpineNode::SplineIKClusters };
+    const MObject arrayAttrs[] = { MDSpineNode::BindJointArray, MDSpineNode::FKJointArray, MDSpineNode::FKControllerArray, MDSpineNode::FKControllerGrpArray, MDSpineNode::FKJointParentConstraintArray, MDSpineNode::SplineIKClusterArray };
+    const unsigned int numAttrs = sizeof(legacyAttrs) / sizeof(legacyAttrs[0]);
+
+    MDGModifier dgMod;
+    bool migrated = false;
+    for(unsigned int i = 0; i < numAttrs; i++) {
+        MPlug legacyPlug(metaDataNode, legacyAttrs[i]);
+        if(!legacyPlug.isConnected())
+            continue;
+        MPlug arrayPlug(metaDataNode, arrayAttrs[i]);
+        MPlugArray connectedPlugs;
+        lrutils::connectedTo(legacyPlug, connectedPlugs,false,true,&status);
+        MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+        for(unsigned int j = 0; j < connectedPlugs.length(); j++) {
+            //connectedTo lists the first two objects connected to the attribute in reverse
+            unsigned int num = j;
+            if( connectedPlugs.length() > 1 && j < 2 )
+                num = 1 - j;
+            status = dgMod.disconnect(legacyPlug, connectedPlugs[j]);
+            MyCheckStatusReturn(status, "MDGModifier.disconnect() failed");
+            status = dgMod.connect(arrayPlug.elementByLogicalIndex(num), connectedPlugs[j]);
+            MyCheckStatusReturn(status, "MDGModifier.connect() failed");
         }
+        migrated = true;
+    }
+    if(migrated) {
+        status = lrutils::doIt(dgMod);
+        MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
     }
 
     return status;
 }
 
 MStatus lrutils::deleteMetaDataPlugConnections(MPlug metaDataPlug) {
+    RigProfileScope profileScope("lrutils::deleteMetaDataPlugConnections");
     MStatus status;
+    if(metaDataPlug.isArray()) {
+        MObjectArray connectedObjs;
+        status = lrutils::getMetaArrayConnections(metaDataPlug, connectedObjs);
+        MyCheckStatusReturn(status, "lrutils::getMetaArrayConnections() failed");
+        for (unsigned int i = 0; i < connectedObjs.length(); i++) {
+            if(!connectedObjs[i].isNull())
+                MGlobal::deleteNode(connectedObjs[i]);
+        }
+        return MS::kSuccess;
+    }
     //follow the plug connection to the connected plug on the other object
     MPlugArray connectedPlugs;
-    metaDataPlug.connectedTo(connectedPlugs,false,true,&status);
+    lrutils::connectedTo(metaDataPlug, connectedPlugs,false,true,&status);
     MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
 
     for (unsigned int i = 0; i < connectedPlugs.length(); i++) {
@@ -786,17 +961,26 @@ MStatus lrutils::deleteMetaDataPlugConnections(MPlug metaDataPlug) {
 }
 
 MStatus lrutils::updateMetaDataObjectNames(MPlug metaDataPlug, MString oldRigName, MString rigName, MString oldCompName, MString compName) {
+    RigProfileScope profileScope("lrutils::updateMetaDataObjectNames");
     MStatus status;
-    //follow the plug connection to the connected plug on the other object
-    MPlugArray connectedPlugs;
-    metaDataPlug.connectedTo(connectedPlugs,false,true,&status);
-    MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+    MObjectArray connectedObjs;
+    if(metaDataPlug.isArray()) {
+        status = lrutils::getMetaArrayConnections(metaDataPlug, connectedObjs);
+        MyCheckStatusReturn(status, "lrutils::getMetaArrayConnections() failed");
+    } else {
+        //follow the plug connection to the connected plug on the other object
+        MPlugArray connectedPlugs;
+        lrutils::connectedTo(metaDataPlug, connectedPlugs,false,true,&status);
+        MyCheckStatusReturn(status,"MPlug.connectedTo() failed");
+        for (unsigned int i = 0; i < connectedPlugs.length(); i++) {
+            connectedObjs.append( connectedPlugs[i].node() );
+        }
+    }
 
-    for (unsigned int i = 0; i < connectedPlugs.length(); i++) {
-        MPlug connectedPlug = connectedPlugs[i];
-        MObject connectedNodeObj = connectedPlug.node(&status);
-        MyCheckStatusReturn(status, "MPlug.node() failed");
-        MFnDependencyNode connectedNodeFn( connectedNodeObj );
+    for (unsigned int i = 0; i < connectedObjs.length(); i++) {
+        if(connectedObjs[i].isNull())
+            continue;
+        MFnDependencyNode connectedNodeFn( connectedObjs[i] );
         MString connectedNodeName = connectedNodeFn.name();
         //set rig namespace
         lrutils::stringReplaceAll(connectedNodeName, oldRigName, rigName);
@@ -809,25 +993,22 @@ MStatus lrutils::updateMetaDataObjectNames(MPlug metaDataPlug, MString oldRigNam
 }
 
 MStatus lrutils::updateControllerShapeColor(MObject oldControllerObj, MString shape, MString color, MVectorArray ctlLocation) {
+    RigProfileScope profileScope("lrutils::updateControllerShapeColor");
     MStatus status;
     MFnTransform oldControllerFn(oldControllerObj);
     
-    MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + shape + "')\");" );
-    MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + color + "')\");" );
-    MString sResult;
-    MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), sResult ); 
     MObject ctlObj;
-    status = lrutils::getObjFromName(sResult, ctlObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    status = lrutils::createController(shape, color, ctlObj);
+    MyCheckStatus(status, "lrutils::createController() failed");
     //apply the scale of the controller location to the new shape
     MFnTransform ctlFn( ctlObj );
     lrutils::setLocation(ctlObj, ctlLocation, MFnTransform::MFnTransform(), false, false, true);
 
     //get the shape node of the original controller object
     MStringArray sResults;
-    MGlobal::executeCommand( "listRelatives -s -fullPath "+oldControllerFn.name()+";", sResults );
+    lrutils::executeCommand( "listRelatives -s -fullPath "+oldControllerFn.name()+";", sResults );
     MString oldCtlShapePath = sResults[0];
-    MGlobal::executeCommand( "listRelatives -s -path "+oldControllerFn.name()+";", sResults );
+    lrutils::executeCommand( "listRelatives -s -path "+oldControllerFn.name()+";", sResults );
     MString oldCtlShapeName = sResults[0];
     MObject oldCtlShapeObj; 
     status = lrutils::getObjFromName(oldCtlShapePath, oldCtlShapeObj);
@@ -835,14 +1016,14 @@ MStatus lrutils::updateControllerShapeColor(MObject oldControllerObj, MString sh
     //delete the old shape node
     MGlobal::deleteNode( oldCtlShapeObj );
     //get the new shape node
-    MGlobal::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
+    lrutils::executeCommand( "listRelatives -s -fullPath "+ctlFn.name()+";", sResults );
     MString ctlShapePath = sResults[0];
     MObject ctlShapeObj; 
     status = lrutils::getObjFromName(ctlShapePath, ctlShapeObj);
     MyCheckStatus(status, "lrutils::getObjFromName() failed");
     //instance the new shape node under the old controller node
     MString command = "parent -s -add " + ctlShapePath + " " + oldControllerFn.name() + ";";
-    MGlobal::executeCommand( command );
+    lrutils::executeCommand( command );
     MFnDependencyNode ctlShapeFn( ctlShapeObj );
     ctlShapeFn.setName( oldCtlShapeName );
     //delete the new controller transform
@@ -852,13 +1033,14 @@ MStatus lrutils::updateControllerShapeColor(MObject oldControllerObj, MString sh
 }
 
 MStatus lrutils::updateAnimationKeys(MObject ctlObj, MVectorArray ctlLocation) {
+    RigProfileScope profileScope("lrutils::updateAnimationKeys");
     MStatus status;
     MFnTransform ctlFn(ctlObj);
     //get the controller's group object
     //save the original controller parent path
     MString ctlGroupParentPath;
     MStringArray result;
-    MGlobal::executeCommand("listRelatives -p -f "+ctlFn.fullPathName()+";",result);
+    lrutils::executeCommand("listRelatives -p -f "+ctlFn.fullPathName()+";",result);
     ctlGroupParentPath = result[0];
     MObject ctlGroupObj;
     lrutils::getObjFromName(ctlGroupParentPath, ctlGroupObj);
@@ -886,22 +1068,14 @@ MStatus lrutils::updateAnimationKeys(MObject ctlObj, MVectorArray ctlLocation) {
 }
 
 MStatus lrutils::updateControlGroupLocation(MObject ctlObj, MVectorArray ctlLocation) {
+    RigProfileScope profileScope("lrutils::updateControlGroupLocation");
     MFnTransform ctlFn(ctlObj);
-
-    MString ctlGroupPath;
-    MStringArray result;
-    MGlobal::executeCommand("listRelatives -p -f "+ctlFn.fullPathName()+";",result);
-    ctlGroupPath = result[0];
-    MObject ctlGroupObj;
-    lrutils::getObjFromName(ctlGroupPath, ctlGroupObj);
-    MFnTransform ctlGroupFn(ctlGroupObj);
-    MString ctlGroupParentPath;
-    MGlobal::executeCommand("listRelatives -p -f "+ctlGroupFn.fullPathName()+";",result);
-    ctlGroupParentPath = result[0];
-    //move the controller group to world for absolute positioning
-    MGlobal::executeCommand("parent -world " + ctlGroupFn.fullPathName() + ";");            
-    lrutils::setLocation(ctlGroupObj, ctlLocation, ctlGroupFn, true, true, false);
-    MGlobal::executeCommand("parent " + ctlGroupFn.fullPathName() + " " + ctlGroupParentPath + ";");
+    MObject ctlGroupObj = ctlFn.parent(0);
+    //place the controller group in world space without taking it out of its parent
+    HierarchyPlan hierarchy;
+    hierarchy.setWorldLocation(ctlGroupObj, ctlLocation);
+    MStatus status = hierarchy.apply();
+    MyCheckStatusReturn(status, "HierarchyPlan.apply() failed");
     
     return MS::kSuccess;
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <maya/MFnTransform.h>
 #include <maya/MVectorArray.h>
 #include <maya/MPlug.h>
+#include <maya/MObjectArray.h>
 #include <maya/MString.h>
 #include <string>
 #include <sstream>
@@ -20,7 +21,10 @@
 #include <vector>
 #include <map>
 #include <maya/MDagPath.h>
+#include <maya/MMatrix.h>
 #include "ComponentGuide.h"
+#include "SceneOpList.h"
+#include "ComponentPlan.h"
 
 typedef boost::shared_ptr<ComponentGuide> ComponentGuidePtr;
 
@@ -38,44 +42,74 @@ namespace lrutils {
     MStatus setLocation(MObject obj, MVectorArray location, MFnTransform& transformFn = MFnTransform::MFnTransform(), bool translate = true, bool rotation = true, bool scale = true);
     //sets a parent constraint's target offsets using a transformation matrix
     MStatus setParentConstraintOffset(MObject constraintObj, MTransformationMatrix transform);
+    //sets the offsets of one target of many parent constraints in a single modifier
+    MStatus setParentConstraintOffsets(std::vector<MObject> constraintObjs, std::vector<MTransformationMatrix> transforms, unsigned int targetIndex = 0);
     //creates a group node with the same transformation as the given MObject and parents that MObject to the group
     MStatus makeHomeNull(MObject obj, MFnTransform& transformFn = MFnTransform::MFnTransform(), MObject & groupObj = MObject());
+    //creates the group node directly under parent with a precomputed local matrix and parents the MObject to it
+    MStatus makeHomeNull(MObject obj, MMatrix localMatrix, MObject parent, MObject & groupObj);
     //creates and returns an empty group node
     MStatus makeGroup(MObject & obj, MString name);
     //find a metaRoot node by name, if it exists
     MStatus getMetaRootByName(MObject & obj, MString name);
     //find an object connected to a metadata node by an attribute name
     MStatus getMetaNodeConnection(MObject metaNodeObj, MObject & connectedObj, MString name);
+    //find an object connected to a metadata node by the static attribute handle of its node type
+    MStatus getMetaNodeConnection(MObject metaNodeObj, MObject & connectedObj, const MObject & attr);
+    //find the object connected to a metadata node plug, the incoming connection if there is one
+    MStatus getMetaPlugConnection(MPlug metaNodePlug, MObject & connectedObj);
     //get a metadata node's parent
     MStatus getMetaParent(MObject metaNodeObj, MObject & metaParentNodeObj);
     //get the number of metachildren from this metanode
     MStatus getNumMetaChildren(MObject metaNodeObj, int & num);
     //search for and replace every instance of a search string with a replacement string in a given source string
     MStatus stringReplaceAll(MString &source, MString search, MString replace);
-    //find and return an MObject for a meta child node of a given meta data node by name
-    MStatus getMetaChildByName(MObject metaNodeObj, MString name, MObject& metaChildObj);
-    //find and return an MObject for a meta child node of a given meta data node by rigId
+    //a component metadata node name without its namespace and type prefix, i.e. "my_rig_spine" for MSN_my_rig_spine
+    MString stripMetaNodePrefix(const MString & metaNodeName);
+    //whether a metadata node is named <prefix>_<rig name>_<component name> for exactly this rig and component
+    bool isMetaNodeOfComponent(const MString & metaNodeName, const MString & rigName, const MString & compName);
+    //find and return an MObject for a meta child node of a given meta data node by its rig's name and exact component name
+    MStatus getMetaChildByName(MObject metaNodeObj, MString rigName, MString name, MObject& metaChildObj);
+    //find and return an MObject for a meta child node of a given meta data node by its exact rigId
     MStatus getMetaChildByRigId(MObject metaNodeObj, MString rigId, MObject& metaChildObj);
     //update an object's attached animation curves by transforming the key data from one transform to another
     MStatus updateAnimCurves(MObject transformObj, std::map<double, MMatrix> ctlWorldMatrices, MMatrix ctlGroupMatrix);
     //retrieve a map of all of the world transformation matrices of a controller object for all of its keyframes
     MStatus getAllWorldTransforms(MObject ctlObj, std::map<double, MMatrix>& ctlWorldMatrices);
-    //creates a skeletal joint chain from a given list of locations, and adds the prefix string to the joint names
-    std::vector<MObject> buildSkeletonFromGuide(std::vector<MVectorArray> locations, MString prefix, MPlug metaDataPlug = MPlug::MPlug(), MObject metaParentJoint = MObject(), MString layerName = "");
+    //creates a skeletal joint chain from a given list of locations, and adds the prefix string to the joint names.
+    //Each joint is connected to the element of an array metaDataPlug matching its joint number.
+    //With a plan of the locations the names and joint orients are taken from it instead of the scene
+    std::vector<MObject> buildSkeletonFromGuide(std::vector<MVectorArray> locations, MString prefix, MPlug metaDataPlug = MPlug::MPlug(), MObject metaParentJoint = MObject(), MString layerName = "", const ComponentPlan * plan = NULL);
     //creates FK controllers for a joint chain
-    void buildFKControls(std::vector<MObject> vFKCtls, std::vector<MObject> vFKCtlGroups, std::vector<MVectorArray> locations, std::vector<MObject> joints, MString prefix, MString icon, MString color, MObject metaDataNode, MObject parentController = MObject(), MString layerName = "", bool createLastControl = false);
+    //parentWorldMatrix is the guide placement of parentController, the controller groups are placed from it without reading the scene
+    //or taken from plan when it was planned with the same parentWorldMatrix
+    void buildFKControls(std::vector<MObject> vFKCtls, std::vector<MObject> vFKCtlGroups, std::vector<MVectorArray> locations, std::vector<MObject> joints, MString prefix, MString icon, MString color, MObject metaDataNode, MObject parentController = MObject(), MMatrix parentWorldMatrix = MMatrix::identity, MString layerName = "", bool createLastControl = false, const ComponentPlan * plan = NULL);
     //create a single joint from a location, with the given prefix, number, and sets the parent
     MObject createJointFromLocation(MVectorArray location, MString prefix, unsigned int num, MObject parent);
+    //records the creation of a single joint into an op list, the joint exists once the list is flushed
+    SceneOpList::NodeRef createJointFromLocation(SceneOpList & ops, MVectorArray location, MString prefix, unsigned int num, SceneOpList::NodeRef parent, const ComponentPlan * plan = NULL);
     //create a single FK controller with the given prefix, number, icon, color, and sets the parent.
     //Returns the MObject for the controller group
-    void createFKCtlFromLocation(MVectorArray location, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode);
+    void createFKCtlFromLocation(MVectorArray location, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode, bool constrainJoint = true);
+    //same as above, with the local matrix of the controller group under parent already known
+    void createFKCtlFromLocation(MVectorArray location, MMatrix localMatrix, MObject joint, MString prefix, unsigned int num, MString icon, MString color, MObject parent, MObject& fkCtlObj, MObject& fkCtlGroupObj, MString layerName, MObject metaDataNode, bool constrainJoint = true);
     //find a bind joint from a meta data node based upon its joint index number
     MStatus getJointByNum(MObject metaDataNode, unsigned int jointNum, MObject& jointObj);
     //find an FK controller from a meta data node based upon its index number
     MStatus getFKControlByNum(MObject metaDataNode, unsigned int fkNum, MObject& fkCtlObj);
-    //delete all objects connected to a particular meta data node plug
+    //find the object connected to an element of an array meta data plug by its logical index,
+    //fails when nothing is connected at that index
+    MStatus getMetaArrayConnection(MPlug metaDataArrayPlug, unsigned int num, MObject& connectedObj);
+    //find the objects connected to an array meta data plug ordered by logical index, up to the last
+    //connected element. Indices without a connection hold a null object
+    MStatus getMetaArrayConnections(MPlug metaDataArrayPlug, MObjectArray& connectedObjs);
+    //moves the connections of the single message attributes older MDSpine nodes kept their chains in
+    //onto the indexed array attributes, in the order getJointByNum used to read them. Does nothing
+    //for other node types or nodes that were already migrated
+    MStatus migrateMetaDataArrays(MObject metaDataNode);
+    //delete all objects connected to a particular meta data node plug, or to the elements of an array plug
     MStatus deleteMetaDataPlugConnections(MPlug metaDataPlug);
-    //update the names of all objects connected to the given meta data node plug
+    //update the names of all objects connected to the given meta data node plug or its elements
     //searches and replaces the names of the objects for the rigName and compName
     MStatus updateMetaDataObjectNames(MPlug metaDataPlug, MString oldRigName, MString rigName, MString oldCompName, MString compName);
     //update a controller with a new controller shape and color
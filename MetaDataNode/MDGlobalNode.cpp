@@ -86,6 +86,7 @@ MStatus MDGlobalNode::initialize()
     addAttribute( rigParentConstraint );
     addAttribute( rigScaleConstraint );
     addAttribute( noTransformScaleConstraint );
+    registerCommonAttributes(id, metaParent, metaChildren, version, rigId);
 
 	return MS::kSuccess;
 
@@ -83,6 +83,7 @@ MStatus MDHipNode::initialize()
     addAttribute( controllerGrp );
     addAttribute( hipJoint );
     addAttribute( hipJointParentConstraint );
+    registerCommonAttributes(id, metaParent, metaChildren, version, rigId);
 
 	return MS::kSuccess;
 
@@ -29,6 +29,12 @@ MObject     MDSpineNode::ShoulderControlConstraint;
 MObject     MDSpineNode::HipControlConstraint;
 MObject     MDSpineNode::MiddleClusterConstraint;
 MObject     MDSpineNode::KinematicType;
+MObject     MDSpineNode::BindJointArray;
+MObject     MDSpineNode::FKJointArray;
+MObject     MDSpineNode::FKControllerArray;
+MObject     MDSpineNode::FKControllerGrpArray;
+MObject     MDSpineNode::FKJointParentConstraintArray;
+MObject     MDSpineNode::SplineIKClusterArray;
 
 MDSpineNode::MDSpineNode() {}
 MDSpineNode::~MDSpineNode() {}
@@ -100,6 +106,18 @@ MStatus MDSpineNode::initialize()
     HipControlConstraint = mAttr.create("HipControlConstraint","HipControlConstraint");
     MiddleClusterConstraint = mAttr.create("MiddleClusterConstraint","MiddleClusterConstraint");
     KinematicType = tAttr.create("KinematicType","KinematicType", MFnData::kString);
+    BindJointArray = mAttr.create("BindJointArray", "BindJointArray");
+    mAttr.setArray(true);
+    FKJointArray = mAttr.create("FKJointArray", "FKJointArray");
+    mAttr.setArray(true);
+    FKControllerArray = mAttr.create("FKControllerArray", "FKControllerArray");
+    mAttr.setArray(true);
+    FKControllerGrpArray = mAttr.create("FKControllerGrpArray", "FKControllerGrpArray");
+    mAttr.setArray(true);
+    FKJointParentConstraintArray = mAttr.create("FKJointParentConstraintArray", "FKJointParentConstraintArray");
+    mAttr.setArray(true);
+    SplineIKClusterArray = mAttr.create("SplineIKClusterArray", "SplineIKClusterArray");
+    mAttr.setArray(true);
 
     addAttribute( metaParent );
     addAttribute( metaChildren );
@@ -122,6 +140,13 @@ MStatus MDSpineNode::initialize()
     addAttribute( HipControlConstraint );
     addAttribute( MiddleClusterConstraint );
     addAttribute( KinematicType );
+    addAttribute( BindJointArray );
+    addAttribute( FKJointArray );
+    addAttribute( FKControllerArray );
+    addAttribute( FKControllerGrpArray );
+    addAttribute( FKJointParentConstraintArray );
+    addAttribute( SplineIKClusterArray );
+    registerCommonAttributes(id, metaParent, metaChildren, version, rigId);
 
 	return MS::kSuccess;
 
@@ -39,6 +39,14 @@ public:
     static MObject MathNodes; //math nodes used for calculating stretchy spline IK
     static MObject SplineIKClusters; //cluster objects used for controlling the curve CVs of the spline IK
     static MObject KinematicType;
+    //indexed replacements for the attributes above that hold a chain, the logical index of an
+    //element is the number of the joint, controller or cluster connected to it
+    static MObject BindJointArray;
+    static MObject FKJointArray;
+    static MObject FKControllerArray;
+    static MObject FKControllerGrpArray;
+    static MObject FKJointParentConstraintArray;
+    static MObject SplineIKClusterArray;
 };
 
 #endif //_MDSpineNode
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MFnNumericAttribute.h>
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "MetaRootNode.h"
+#include "MetaDataManagerNode.h"
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 #include <string>
@@ -25,7 +28,7 @@ MStatus MakeMetaDataNodeCmd::doIt ( const MArgList &args )
 {
     MStatus stat;
 
-    MGlobal::executeCommand( MString("polyCube -ch on -o on -cuv 4 ;") );
+    lrutils::executeCommand( MString("polyCube -ch on -o on -cuv 4 ;") );
 
     // Get a list of currently selected objects
     MSelectionList selection;
@@ -67,7 +70,7 @@ MStatus MakeMetaDataNodeCmd::doIt ( const MArgList &args )
         MFnDependencyNode depRootNodeFn( metaRootNodeObj );
         MString rootNodeName = "MRN_";
         rootNodeName += name;
-        status = dgMod.newPlugValueString( depRootNodeFn.findPlug("xmlPath"), filePath );
+        status = dgMod.newPlugValueString( lrutils::findPlug(depRootNodeFn, MetaRootNode::xmlPath), filePath );
         dgMod.renameNode(metaRootNodeObj, rootNodeName);
         MyCheckStatusReturn(status, "newPlugValueString failed");
         //create MetaDataNode
@@ -80,11 +83,11 @@ MStatus MakeMetaDataNodeCmd::doIt ( const MArgList &args )
         
 
         //create meta data network connections
-        status = dgMod.connect( depManagerNodeFn.findPlug("metaRoots"), depRootNodeFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depManagerNodeFn, MetaDataManagerNode::metaRoots), MetaDataNode::getCommonPlug(metaRootNodeObj, MetaDataNode::kMetaParent) );
         MyCheckStatusReturn(status, "connect failed");
-        status = dgMod.connect( depRootNodeFn.findPlug("metaChildren"), depNodeFn.findPlug("metaParent") );
+        status = dgMod.connect( MetaDataNode::getCommonPlug(metaRootNodeObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(metaDataNodeObj, MetaDataNode::kMetaParent) );
         MyCheckStatusReturn(status, "connect failed");
-        status = dgMod.connect( depNodeFn.findPlug("metaChildren"), transformFn.findPlug("metaParent") );
+        status = dgMod.connect( MetaDataNode::getCommonPlug(metaDataNodeObj, MetaDataNode::kMetaChildren), lrutils::findPlug(transformFn, "metaParent") );
         MyCheckStatusReturn(status, "connect failed");
 
         status = dgMod.commandToExecute( MString("scriptNode -beforeScript \"updateMetaDataManager;\" -st 1 -n \"updateMDM\"; ") );
@@ -102,5 +105,5 @@ MStatus MakeMetaDataNodeCmd::undoIt()
 
 MStatus MakeMetaDataNodeCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
\ No newline at end of file
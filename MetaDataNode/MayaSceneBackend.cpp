@@ -0,0 +1,262 @@
+/***************************************************************
+* Summary: Scene backend that applies the SceneBackend         *
+*          operations to the Maya scene through the API.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "MayaSceneBackend.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MDGModifier.h>
+#include <maya/MDagModifier.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnMessageAttribute.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MSelectionList.h>
+#include <maya/MPlugArray.h>
+
+MayaSceneBackend::MayaSceneBackend() {
+
+}
+
+MayaSceneBackend::~MayaSceneBackend() {
+
+}
+
+SceneBackend::NodeId MayaSceneBackend::addExisting(MObject obj) {
+    if(obj.isNull())
+        return kNullNode;
+    MObjectHandle handle(obj);
+    std::pair<std::multimap<unsigned int, NodeId>::iterator, std::multimap<unsigned int, NodeId>::iterator> range = this->m_ids.equal_range(handle.hashCode());
+    for(std::multimap<unsigned int, NodeId>::iterator it = range.first; it != range.second; ++it) {
+        if(this->m_nodes[it->second] == handle)
+            return it->second;
+    }
+    NodeId id = (NodeId)this->m_nodes.size();
+    this->m_nodes.push_back(handle);
+    this->m_ids.insert( std::multimap<unsigned int, NodeId>::value_type(handle.hashCode(), id) );
+    return id;
+}
+
+MObject MayaSceneBackend::getObject(NodeId node) {
+    if(!this->isValid(node))
+        return MObject::kNullObj;
+    return this->m_nodes[node].object();
+}
+
+bool MayaSceneBackend::isValid(NodeId node) {
+    return node >= 0 && node < (NodeId)this->m_nodes.size() && this->m_nodes[node].isValid();
+}
+
+SceneBackend::NodeId MayaSceneBackend::createNode(const std::string & type, const std::string & name) {
+    MStatus status;
+    MDGModifier dgMod;
+    MObject obj = dgMod.createNode( MString(type.c_str()), &status );
+    MyCheckStatus(status, "MDGModifier.createNode() failed");
+    if(status != MS::kSuccess)
+        return kNullNode;
+    if(!name.empty()) {
+        dgMod.renameNode(obj, MString(name.c_str()));
+    }
+    status = lrutils::doIt(dgMod);
+    MyCheckStatus(status, "MDGModifier.doIt() failed");
+    if(status != MS::kSuccess)
+        return kNullNode;
+    return this->addExisting(obj);
+}
+
+SceneBackend::NodeId MayaSceneBackend::createDagNode(const std::string & type, const std::string & name, NodeId parent) {
+    MStatus status;
+    MDagModifier dagMod;
+    MObject obj = dagMod.createNode( MString(type.c_str()), this->getObject(parent), &status );
+    MyCheckStatus(status, "MDagModifier.createNode() failed");
+    if(status != MS::kSuccess)
+        return kNullNode;
+    if(!name.empty()) {
+        dagMod.renameNode(obj, MString(name.c_str()));
+    }
+    status = lrutils::doIt(dagMod);
+    MyCheckStatus(status, "MDagModifier.doIt() failed");
+    if(status != MS::kSuccess)
+        return kNullNode;
+    return this->addExisting(obj);
+}
+
+bool MayaSceneBackend::deleteNode(NodeId node) {
+    if(!this->isValid(node))
+        return false;
+    MStatus status = MGlobal::deleteNode( this->getObject(node) );
+    return status == MS::kSuccess;
+}
+
+std::string MayaSceneBackend::getName(NodeId node) {
+    if(!this->isValid(node))
+        return std::string();
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    return std::string(nodeFn.name().asChar());
+}
+
+bool MayaSceneBackend::setName(NodeId node, const std::string & name) {
+    if(!this->isValid(node) || name.empty())
+        return false;
+    MStatus status;
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    nodeFn.setName(MString(name.c_str()), false, &status);
+    return status == MS::kSuccess;
+}
+
+std::string MayaSceneBackend::getType(NodeId node) {
+    if(!this->isValid(node))
+        return std::string();
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    return std::string(nodeFn.typeName().asChar());
+}
+
+SceneBackend::NodeId MayaSceneBackend::findNode(const std::string & name) {
+    MSelectionList selection;
+    if(selection.add(MString(name.c_str())) != MS::kSuccess)
+        return kNullNode;
+    MObject obj;
+    selection.getDependNode(0, obj);
+    return this->addExisting(obj);
+}
+
+void MayaSceneBackend::listNodes(const std::string & type, std::vector<NodeId> & nodes) {
+    MString typeName(type.c_str());
+    for(MItDependencyNodes nodeIt; !nodeIt.isDone(); nodeIt.next()) {
+        MFnDependencyNode nodeFn( nodeIt.item() );
+        if(nodeFn.typeName() == typeName)
+            nodes.push_back( this->addExisting(nodeIt.item()) );
+    }
+}
+
+bool MayaSceneBackend::setParent(NodeId node, NodeId parent) {
+    if(!this->isValid(node))
+        return false;
+    MDagModifier dagMod;
+    MStatus status = dagMod.reparentNode( this->getObject(node), this->getObject(parent) );
+    MyCheckStatus(status, "MDagModifier.reparentNode() failed");
+    if(status != MS::kSuccess)
+        return false;
+    status = lrutils::doIt(dagMod);
+    return status == MS::kSuccess;
+}
+
+SceneBackend::NodeId MayaSceneBackend::getParent(NodeId node) {
+    MObject obj = this->getObject(node);
+    if(!obj.hasFn(MFn::kDagNode))
+        return kNullNode;
+    MFnDagNode dagFn( obj );
+    if(dagFn.parentCount() == 0)
+        return kNullNode;
+    MObject parentObj = dagFn.parent(0);
+    if(parentObj.hasFn(MFn::kWorld))
+        return kNullNode;
+    return this->addExisting(parentObj);
+}
+
+void MayaSceneBackend::getChildren(NodeId node, std::vector<NodeId> & children) {
+    MObject obj = this->getObject(node);
+    if(!obj.hasFn(MFn::kDagNode))
+        return;
+    MFnDagNode dagFn( obj );
+    for(unsigned int i = 0; i < dagFn.childCount(); i++) {
+        children.push_back( this->addExisting(dagFn.child(i)) );
+    }
+}
+
+bool MayaSceneBackend::addMessageAttribute(NodeId node, const std::string & attr) {
+    if(!this->isValid(node))
+        return false;
+    MFnMessageAttribute mAttr;
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    MStatus status = nodeFn.addAttribute( mAttr.create(MString(attr.c_str()), MString(attr.c_str())) );
+    return status == MS::kSuccess;
+}
+
+bool MayaSceneBackend::hasAttribute(NodeId node, const std::string & attr) {
+    if(!this->isValid(node))
+        return false;
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    return nodeFn.hasAttribute(MString(attr.c_str()));
+}
+
+MPlug MayaSceneBackend::findPlug(NodeId node, const std::string & attr) {
+    if(!this->isValid(node))
+        return MPlug();
+    MFnDependencyNode nodeFn( this->getObject(node) );
+    return lrutils::findPlug(nodeFn, MString(attr.c_str()), true);
+}
+
+bool MayaSceneBackend::setDouble(NodeId node, const std::string & attr, double value) {
+    MPlug plug = this->findPlug(node, attr);
+    if(plug.isNull())
+        return false;
+    return plug.setDouble(value) == MS::kSuccess;
+}
+
+bool MayaSceneBackend::getDouble(NodeId node, const std::string & attr, double & value) {
+    MPlug plug = this->findPlug(node, attr);
+    if(plug.isNull())
+        return false;
+    MStatus status;
+    value = plug.asDouble(&status);
+    return status == MS::kSuccess;
+}
+
+bool MayaSceneBackend::setString(NodeId node, const std::string & attr, const std::string & value) {
+    MPlug plug = this->findPlug(node, attr);
+    if(plug.isNull())
+        return false;
+    return plug.setString(MString(value.c_str())) == MS::kSuccess;
+}
+
+bool MayaSceneBackend::getString(NodeId node, const std::string & attr, std::string & value) {
+    MPlug plug = this->findPlug(node, attr);
+    if(plug.isNull())
+        return false;
+    MStatus status;
+    value = plug.asString(&status).asChar();
+    return status == MS::kSuccess;
+}
+
+bool MayaSceneBackend::connect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) {
+    MPlug srcPlug = this->findPlug(srcNode, srcAttr);
+    MPlug dstPlug = this->findPlug(dstNode, dstAttr);
+    if(srcPlug.isNull() || dstPlug.isNull())
+        return false;
+    MDGModifier dgMod;
+    MStatus status = dgMod.connect(srcPlug, dstPlug);
+    MyCheckStatus(status, "MDGModifier.connect() failed");
+    if(status != MS::kSuccess)
+        return false;
+    status = lrutils::doIt(dgMod);
+    return status == MS::kSuccess;
+}
+
+bool MayaSceneBackend::disconnect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) {
+    MPlug srcPlug = this->findPlug(srcNode, srcAttr);
+    MPlug dstPlug = this->findPlug(dstNode, dstAttr);
+    if(srcPlug.isNull() || dstPlug.isNull())
+        return false;
+    MDGModifier dgMod;
+    MStatus status = dgMod.disconnect(srcPlug, dstPlug);
+    MyCheckStatus(status, "MDGModifier.disconnect() failed");
+    if(status != MS::kSuccess)
+        return false;
+    status = lrutils::doIt(dgMod);
+    return status == MS::kSuccess;
+}
+
+void MayaSceneBackend::getConnectedNodes(NodeId node, const std::string & attr, bool asSource, std::vector<NodeId> & nodes) {
+    MPlug plug = this->findPlug(node, attr);
+    if(plug.isNull())
+        return;
+    MPlugArray connectedPlugs;
+    lrutils::connectedTo(plug, connectedPlugs, !asSource, asSource);
+    for(unsigned int i = 0; i < connectedPlugs.length(); i++) {
+        nodes.push_back( this->addExisting(connectedPlugs[i].node()) );
+    }
+}
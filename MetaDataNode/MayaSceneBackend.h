@@ -0,0 +1,62 @@
+/***************************************************************
+* Summary: Scene backend that applies the SceneBackend         *
+*          operations to the Maya scene through the API.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _MayaSceneBackend
+#define _MayaSceneBackend
+
+#include "SceneBackend.h"
+#include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
+#include <string>
+#include <vector>
+#include <map>
+
+class MayaSceneBackend : public SceneBackend
+{
+public:
+    MayaSceneBackend();
+    ~MayaSceneBackend();
+
+    //node ids for scene objects that were not created through this backend
+    NodeId addExisting(MObject obj);
+    //the scene object behind a node id, MObject::kNullObj if the id is unknown or the node was deleted
+    MObject getObject(NodeId node);
+
+    NodeId createNode(const std::string & type, const std::string & name);
+    NodeId createDagNode(const std::string & type, const std::string & name, NodeId parent = kNullNode);
+    bool deleteNode(NodeId node);
+    bool isValid(NodeId node);
+    std::string getName(NodeId node);
+    bool setName(NodeId node, const std::string & name);
+    std::string getType(NodeId node);
+    NodeId findNode(const std::string & name);
+    void listNodes(const std::string & type, std::vector<NodeId> & nodes);
+
+    bool setParent(NodeId node, NodeId parent);
+    NodeId getParent(NodeId node);
+    void getChildren(NodeId node, std::vector<NodeId> & children);
+
+    bool addMessageAttribute(NodeId node, const std::string & attr);
+    bool hasAttribute(NodeId node, const std::string & attr);
+    bool setDouble(NodeId node, const std::string & attr, double value);
+    bool getDouble(NodeId node, const std::string & attr, double & value);
+    bool setString(NodeId node, const std::string & attr, const std::string & value);
+    bool getString(NodeId node, const std::string & attr, std::string & value);
+
+    bool connect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr);
+    bool disconnect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr);
+    void getConnectedNodes(NodeId node, const std::string & attr, bool asSource, std::vector<NodeId> & nodes);
+
+private:
+    MPlug findPlug(NodeId node, const std::string & attr);
+
+    std::vector<MObjectHandle> m_nodes;
+    //node ids by MObjectHandle hash code, so scene objects map back to the same id
+    std::multimap<unsigned int, NodeId> m_ids;
+};
+
+#endif //_MayaSceneBackend
@@ -0,0 +1,299 @@
+/***************************************************************
+* Summary: Scene backend that keeps the node graph in plain    *
+*          C++ data structures, so that rig logic written      *
+*          against SceneBackend can be run and timed without   *
+*          Maya.                                               *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "MemorySceneBackend.h"
+#include <sstream>
+
+MemorySceneBackend::Attribute::Attribute() {
+    isMessage = false;
+    doubleValue = 0.0;
+}
+
+MemorySceneBackend::MemorySceneBackend() {
+    m_numNodes = 0;
+    m_numConnections = 0;
+}
+
+MemorySceneBackend::~MemorySceneBackend() {
+
+}
+
+void MemorySceneBackend::clear() {
+    this->m_nodes.clear();
+    this->m_connections.clear();
+    this->m_liveConnections.clear();
+    this->m_names.clear();
+    this->m_outgoing.clear();
+    this->m_incoming.clear();
+    this->m_numNodes = 0;
+    this->m_numConnections = 0;
+}
+
+std::string MemorySceneBackend::getUniqueName(const std::string & name) {
+    //like Maya, a name that is taken gets the next free number appended
+    if(this->m_names.find(name) == this->m_names.end())
+        return name;
+    for(unsigned int i = 1; ; i++) {
+        std::stringstream uniqueName; uniqueName << name << i;
+        if(this->m_names.find(uniqueName.str()) == this->m_names.end())
+            return uniqueName.str();
+    }
+}
+
+SceneBackend::NodeId MemorySceneBackend::addNode(const std::string & type, const std::string & name, bool isDag) {
+    Node node;
+    node.type = type;
+    node.name = this->getUniqueName(name.empty() ? type + "1" : name);
+    node.parent = kNullNode;
+    node.isDag = isDag;
+    node.alive = true;
+    NodeId id = (NodeId)this->m_nodes.size();
+    this->m_nodes.push_back(node);
+    this->m_names[node.name] = id;
+    this->m_numNodes++;
+    return id;
+}
+
+SceneBackend::NodeId MemorySceneBackend::createNode(const std::string & type, const std::string & name) {
+    return this->addNode(type, name, false);
+}
+
+SceneBackend::NodeId MemorySceneBackend::createDagNode(const std::string & type, const std::string & name, NodeId parent) {
+    if(parent != kNullNode && !this->isValid(parent))
+        return kNullNode;
+    NodeId id = this->addNode(type, name, true);
+    if(parent != kNullNode) {
+        this->m_nodes[id].parent = parent;
+        this->m_nodes[parent].children.push_back(id);
+    }
+    return id;
+}
+
+bool MemorySceneBackend::deleteNode(NodeId node) {
+    if(!this->isValid(node))
+        return false;
+    //deleting a dag node deletes everything beneath it
+    std::vector<NodeId> children = this->m_nodes[node].children;
+    for(unsigned int i = 0; i < children.size(); i++) {
+        this->deleteNode(children[i]);
+    }
+    //plugs of a node are adjacent in the indices, so its connections are one range in each
+    PlugIndex * indices[2] = { &this->m_outgoing, &this->m_incoming };
+    for(unsigned int i = 0; i < 2; i++) {
+        std::vector<unsigned int> connIdxs;
+        PlugIndex::iterator it = indices[i]->lower_bound( PlugKey(node, std::string()) );
+        for(; it != indices[i]->end() && it->first.first == node; ++it) {
+            connIdxs.push_back(it->second);
+        }
+        for(unsigned int j = 0; j < connIdxs.size(); j++) {
+            this->removeConnection(connIdxs[j]);
+        }
+    }
+    Node & deadNode = this->m_nodes[node];
+    if(deadNode.parent != kNullNode)
+        this->removeChild(deadNode.parent, node);
+    this->m_names.erase(deadNode.name);
+    deadNode.alive = false;
+    deadNode.children.clear();
+    deadNode.attributes.clear();
+    this->m_numNodes--;
+    return true;
+}
+
+bool MemorySceneBackend::isValid(NodeId node) {
+    return node >= 0 && node < (NodeId)this->m_nodes.size() && this->m_nodes[node].alive;
+}
+
+std::string MemorySceneBackend::getName(NodeId node) {
+    if(!this->isValid(node))
+        return std::string();
+    return this->m_nodes[node].name;
+}
+
+bool MemorySceneBackend::setName(NodeId node, const std::string & name) {
+    if(!this->isValid(node) || name.empty())
+        return false;
+    Node & renamed = this->m_nodes[node];
+    if(renamed.name == name)
+        return true;
+    this->m_names.erase(renamed.name);
+    renamed.name = this->getUniqueName(name);
+    this->m_names[renamed.name] = node;
+    return true;
+}
+
+std::string MemorySceneBackend::getType(NodeId node) {
+    if(!this->isValid(node))
+        return std::string();
+    return this->m_nodes[node].type;
+}
+
+SceneBackend::NodeId MemorySceneBackend::findNode(const std::string & name) {
+    std::map<std::string, NodeId>::iterator it = this->m_names.find(name);
+    if(it == this->m_names.end())
+        return kNullNode;
+    return it->second;
+}
+
+void MemorySceneBackend::listNodes(const std::string & type, std::vector<NodeId> & nodes) {
+    for(unsigned int i = 0; i < this->m_nodes.size(); i++) {
+        if(this->m_nodes[i].alive && this->m_nodes[i].type == type)
+            nodes.push_back((NodeId)i);
+    }
+}
+
+void MemorySceneBackend::removeChild(NodeId parent, NodeId child) {
+    std::vector<NodeId> & children = this->m_nodes[parent].children;
+    for(unsigned int i = 0; i < children.size(); i++) {
+        if(children[i] == child) {
+            children.erase(children.begin() + i);
+            return;
+        }
+    }
+}
+
+bool MemorySceneBackend::setParent(NodeId node, NodeId parent) {
+    if(!this->isValid(node) || !this->m_nodes[node].isDag)
+        return false;
+    if(parent != kNullNode && (!this->isValid(parent) || !this->m_nodes[parent].isDag))
+        return false;
+    //a node can't be moved beneath itself
+    for(NodeId ancestor = parent; ancestor != kNullNode; ancestor = this->m_nodes[ancestor].parent) {
+        if(ancestor == node)
+            return false;
+    }
+    Node & moved = this->m_nodes[node];
+    if(moved.parent == parent)
+        return true;
+    if(moved.parent != kNullNode)
+        this->removeChild(moved.parent, node);
+    moved.parent = parent;
+    if(parent != kNullNode)
+        this->m_nodes[parent].children.push_back(node);
+    return true;
+}
+
+SceneBackend::NodeId MemorySceneBackend::getParent(NodeId node) {
+    if(!this->isValid(node))
+        return kNullNode;
+    return this->m_nodes[node].parent;
+}
+
+void MemorySceneBackend::getChildren(NodeId node, std::vector<NodeId> & children) {
+    if(!this->isValid(node))
+        return;
+    children.insert(children.end(), this->m_nodes[node].children.begin(), this->m_nodes[node].children.end());
+}
+
+bool MemorySceneBackend::addMessageAttribute(NodeId node, const std::string & attr) {
+    if(!this->isValid(node))
+        return false;
+    std::map<std::string, Attribute> & attributes = this->m_nodes[node].attributes;
+    if(attributes.find(attr) != attributes.end())
+        return false;
+    attributes[attr].isMessage = true;
+    return true;
+}
+
+bool MemorySceneBackend::hasAttribute(NodeId node, const std::string & attr) {
+    if(!this->isValid(node))
+        return false;
+    std::map<std::string, Attribute> & attributes = this->m_nodes[node].attributes;
+    return attributes.find(attr) != attributes.end();
+}
+
+bool MemorySceneBackend::setDouble(NodeId node, const std::string & attr, double value) {
+    //there is no schema for static attributes, so setting a value defines the attribute
+    if(!this->isValid(node))
+        return false;
+    this->m_nodes[node].attributes[attr].doubleValue = value;
+    return true;
+}
+
+bool MemorySceneBackend::getDouble(NodeId node, const std::string & attr, double & value) {
+    if(!this->hasAttribute(node, attr))
+        return false;
+    value = this->m_nodes[node].attributes[attr].doubleValue;
+    return true;
+}
+
+bool MemorySceneBackend::setString(NodeId node, const std::string & attr, const std::string & value) {
+    if(!this->isValid(node))
+        return false;
+    this->m_nodes[node].attributes[attr].stringValue = value;
+    return true;
+}
+
+bool MemorySceneBackend::getString(NodeId node, const std::string & attr, std::string & value) {
+    if(!this->hasAttribute(node, attr))
+        return false;
+    value = this->m_nodes[node].attributes[attr].stringValue;
+    return true;
+}
+
+bool MemorySceneBackend::connect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) {
+    if(!this->isValid(srcNode) || !this->isValid(dstNode))
+        return false;
+    //a destination plug takes a single incoming connection
+    PlugKey dstKey(dstNode, dstAttr);
+    if(this->m_incoming.find(dstKey) != this->m_incoming.end())
+        return false;
+    Connection conn;
+    conn.srcNode = srcNode;
+    conn.srcAttr = srcAttr;
+    conn.dstNode = dstNode;
+    conn.dstAttr = dstAttr;
+    unsigned int connIdx = (unsigned int)this->m_connections.size();
+    this->m_connections.push_back(conn);
+    this->m_liveConnections.push_back(true);
+    this->m_outgoing.insert( PlugIndex::value_type(PlugKey(srcNode, srcAttr), connIdx) );
+    this->m_incoming.insert( PlugIndex::value_type(dstKey, connIdx) );
+    this->m_numConnections++;
+    return true;
+}
+
+void MemorySceneBackend::eraseIndex(PlugIndex & index, const PlugKey & key, unsigned int connIdx) {
+    std::pair<PlugIndex::iterator, PlugIndex::iterator> range = index.equal_range(key);
+    for(PlugIndex::iterator it = range.first; it != range.second; ++it) {
+        if(it->second == connIdx) {
+            index.erase(it);
+            return;
+        }
+    }
+}
+
+void MemorySceneBackend::removeConnection(unsigned int connIdx) {
+    if(!this->m_liveConnections[connIdx])
+        return;
+    Connection & conn = this->m_connections[connIdx];
+    eraseIndex(this->m_outgoing, PlugKey(conn.srcNode, conn.srcAttr), connIdx);
+    eraseIndex(this->m_incoming, PlugKey(conn.dstNode, conn.dstAttr), connIdx);
+    this->m_liveConnections[connIdx] = false;
+    this->m_numConnections--;
+}
+
+bool MemorySceneBackend::disconnect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) {
+    std::pair<PlugIndex::iterator, PlugIndex::iterator> range = this->m_outgoing.equal_range( PlugKey(srcNode, srcAttr) );
+    for(PlugIndex::iterator it = range.first; it != range.second; ++it) {
+        const Connection & conn = this->m_connections[it->second];
+        if(conn.dstNode == dstNode && conn.dstAttr == dstAttr) {
+            this->removeConnection(it->second);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MemorySceneBackend::getConnectedNodes(NodeId node, const std::string & attr, bool asSource, std::vector<NodeId> & nodes) {
+    PlugIndex & index = asSource ? this->m_outgoing : this->m_incoming;
+    std::pair<PlugIndex::iterator, PlugIndex::iterator> range = index.equal_range( PlugKey(node, attr) );
+    for(PlugIndex::iterator it = range.first; it != range.second; ++it) {
+        const Connection & conn = this->m_connections[it->second];
+        nodes.push_back(asSource ? conn.dstNode : conn.srcNode);
+    }
+}
@@ -0,0 +1,103 @@
+/***************************************************************
+* Summary: Scene backend that keeps the node graph in plain    *
+*          C++ data structures, so that rig logic written      *
+*          against SceneBackend can be run and timed without   *
+*          Maya.                                               *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _MemorySceneBackend
+#define _MemorySceneBackend
+
+#include "SceneBackend.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+
+class MemorySceneBackend : public SceneBackend
+{
+public:
+    MemorySceneBackend();
+    ~MemorySceneBackend();
+
+    NodeId createNode(const std::string & type, const std::string & name);
+    NodeId createDagNode(const std::string & type, const std::string & name, NodeId parent = kNullNode);
+    bool deleteNode(NodeId node);
+    bool isValid(NodeId node);
+    std::string getName(NodeId node);
+    bool setName(NodeId node, const std::string & name);
+    std::string getType(NodeId node);
+    NodeId findNode(const std::string & name);
+    void listNodes(const std::string & type, std::vector<NodeId> & nodes);
+
+    bool setParent(NodeId node, NodeId parent);
+    NodeId getParent(NodeId node);
+    void getChildren(NodeId node, std::vector<NodeId> & children);
+
+    bool addMessageAttribute(NodeId node, const std::string & attr);
+    bool hasAttribute(NodeId node, const std::string & attr);
+    bool setDouble(NodeId node, const std::string & attr, double value);
+    bool getDouble(NodeId node, const std::string & attr, double & value);
+    bool setString(NodeId node, const std::string & attr, const std::string & value);
+    bool getString(NodeId node, const std::string & attr, std::string & value);
+
+    bool connect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr);
+    bool disconnect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr);
+    void getConnectedNodes(NodeId node, const std::string & attr, bool asSource, std::vector<NodeId> & nodes);
+
+    //number of live nodes and connections
+    unsigned int getNumNodes() {return m_numNodes;};
+    unsigned int getNumConnections() {return m_numConnections;};
+    //removes every node and connection
+    void clear();
+
+private:
+    struct Attribute
+    {
+        Attribute();
+        bool isMessage;
+        double doubleValue;
+        std::string stringValue;
+    };
+
+    struct Node
+    {
+        std::string type;
+        std::string name;
+        NodeId parent;
+        bool isDag;
+        bool alive;
+        std::vector<NodeId> children;
+        std::map<std::string, Attribute> attributes;
+    };
+
+    struct Connection
+    {
+        NodeId srcNode;
+        std::string srcAttr;
+        NodeId dstNode;
+        std::string dstAttr;
+    };
+
+    //connections are indexed by the plug at either end
+    typedef std::pair<NodeId, std::string> PlugKey;
+    typedef std::multimap<PlugKey, unsigned int> PlugIndex;
+
+    NodeId addNode(const std::string & type, const std::string & name, bool isDag);
+    std::string getUniqueName(const std::string & name);
+    void removeChild(NodeId parent, NodeId child);
+    void removeConnection(unsigned int connIdx);
+    static void eraseIndex(PlugIndex & index, const PlugKey & key, unsigned int connIdx);
+
+    std::vector<Node> m_nodes;
+    std::vector<Connection> m_connections;
+    std::vector<bool> m_liveConnections;
+    std::map<std::string, NodeId> m_names;
+    PlugIndex m_outgoing;
+    PlugIndex m_incoming;
+    unsigned int m_numNodes;
+    unsigned int m_numConnections;
+};
+
+#endif //_MemorySceneBackend
@@ -13,13 +13,29 @@
 #include <maya/MDataHandle.h>
 
 #include <maya/MGlobal.h>
+#include <maya/MPlugArray.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MDGMessage.h>
+#include <maya/MSceneMessage.h>
+#include <maya/MItDependencyNodes.h>
+#include "RigProfiler.h"
 
 MTypeId     MetaDataManagerNode::id( 0x00335 );
 
 MObject     MetaDataManagerNode::metaRoots;
 
+MObjectHandle       MetaDataManagerNode::s_manager;
+bool                MetaDataManagerNode::s_hasManager = false;
+bool                MetaDataManagerNode::s_managerKnown = false;
+MCallbackIdArray    MetaDataManagerNode::s_callbacks;
+
 MetaDataManagerNode::MetaDataManagerNode() {}
-MetaDataManagerNode::~MetaDataManagerNode() {}
+MetaDataManagerNode::~MetaDataManagerNode() {
+    for(MetaRootMap::iterator it = m_metaRoots.begin(); it != m_metaRoots.end(); ++it) {
+        MMessage::removeCallback(it->second.nameChangedCallback);
+    }
+}
 
 MStatus MetaDataManagerNode::compute( const MPlug& plug, MDataBlock& data )
 {
@@ -39,6 +55,176 @@ MStatus MetaDataManagerNode::compute( const MPlug& plug, MDataBlock& data )
 	return MS::kSuccess;
 }
 
+MStatus MetaDataManagerNode::connectionMade( const MPlug& plug, const MPlug& otherPlug, bool asSrc )
+{
+    if( asSrc && plug == metaRoots ) {
+        MObject metaRootObj = otherPlug.node();
+        addMetaRoot(metaRootObj);
+    }
+    return MPxNode::connectionMade(plug, otherPlug, asSrc);
+}
+
+MStatus MetaDataManagerNode::connectionBroken( const MPlug& plug, const MPlug& otherPlug, bool asSrc )
+{
+    if( asSrc && plug == metaRoots ) {
+        removeMetaRoot(otherPlug.node());
+    }
+    return MPxNode::connectionBroken(plug, otherPlug, asSrc);
+}
+
+MStatus MetaDataManagerNode::findMetaRoot( const MString& rigName, MObject& metaRootObj )
+{
+    MetaRootMap::iterator it = m_metaRoots.find(rigName.asChar());
+    if( it == m_metaRoots.end() || !it->second.handle.isValid() ) {
+        //connections made before the registry existed, i.e. by an older version of the plugin
+        rebuildMetaRoots();
+        it = m_metaRoots.find(rigName.asChar());
+        if( it == m_metaRoots.end() || !it->second.handle.isValid() )
+            return MS::kFailure;
+    }
+    metaRootObj = it->second.handle.object();
+    return MS::kSuccess;
+}
+
+void MetaDataManagerNode::addMetaRoot( MObject& metaRootObj )
+{
+    MFnDependencyNode metaRootFn( metaRootObj );
+    std::string rigName = getRigName(metaRootFn.name());
+    MetaRootMap::iterator it = m_metaRoots.find(rigName);
+    if( it != m_metaRoots.end() ) {
+        if( it->second.handle == metaRootObj )
+            return;
+        MMessage::removeCallback(it->second.nameChangedCallback);
+    }
+    MetaRootEntry entry;
+    entry.handle = MObjectHandle(metaRootObj);
+    entry.nameChangedCallback = MNodeMessage::addNameChangedCallback(metaRootObj, MetaDataManagerNode::metaRootNameChanged, this);
+    m_metaRoots[rigName] = entry;
+}
+
+void MetaDataManagerNode::removeMetaRoot( const MObject& metaRootObj )
+{
+    //the node may have been renamed without the registry being told, so look for its handle
+    for(MetaRootMap::iterator it = m_metaRoots.begin(); it != m_metaRoots.end(); ++it) {
+        if( it->second.handle == metaRootObj ) {
+            MMessage::removeCallback(it->second.nameChangedCallback);
+            m_metaRoots.erase(it);
+            return;
+        }
+    }
+}
+
+void MetaDataManagerNode::rebuildMetaRoots()
+{
+    for(MetaRootMap::iterator it = m_metaRoots.begin(); it != m_metaRoots.end(); ++it) {
+        MMessage::removeCallback(it->second.nameChangedCallback);
+    }
+    m_metaRoots.clear();
+
+    MPlug metaRootsPlug( thisMObject(), metaRoots );
+    MPlugArray rootPlugs;
+    lrutils::connectedTo(metaRootsPlug, rootPlugs, false, true);
+    for(unsigned int i = 0; i < rootPlugs.length(); i++) {
+        MObject metaRootObj = rootPlugs[i].node();
+        addMetaRoot(metaRootObj);
+    }
+}
+
+std::string MetaDataManagerNode::getRigName( const MString& metaRootName )
+{
+    //metaRoot nodes are named MRN_<rig name>
+    if( metaRootName.numChars() <= 4 )
+        return std::string();
+    return metaRootName.substring(4, metaRootName.numChars() - 1).asChar();
+}
+
+void MetaDataManagerNode::metaRootNameChanged( MObject& node, const MString& prevName, void* clientData )
+{
+    MetaDataManagerNode* manager = static_cast<MetaDataManagerNode*>(clientData);
+    MetaRootMap::iterator it = manager->m_metaRoots.find(getRigName(prevName));
+    if( it == manager->m_metaRoots.end() || !(it->second.handle == node) )
+        return;
+    MetaRootEntry entry = it->second;
+    manager->m_metaRoots.erase(it);
+    MFnDependencyNode metaRootFn( node );
+    manager->m_metaRoots[getRigName(metaRootFn.name())] = entry;
+}
+
+MObject MetaDataManagerNode::getManager()
+{
+    if( s_managerKnown ) {
+        if( !s_hasManager )
+            return MObject::kNullObj;
+        if( s_manager.isValid() )
+            return s_manager.object();
+    }
+
+    s_hasManager = false;
+    for( MItDependencyNodes nodeIt(MFn::kPluginDependNode);
+        !nodeIt.isDone(); nodeIt.next() ) {
+        MFnDependencyNode nodeFn( nodeIt.item() );
+        if(nodeFn.typeId() == MetaDataManagerNode::id) {
+            s_manager = MObjectHandle( nodeIt.item() );
+            s_hasManager = true;
+            break;
+        }
+    }
+    //without the callbacks a manager created later wouldn't be noticed
+    s_managerKnown = s_callbacks.length() > 0;
+
+    return s_hasManager ? s_manager.object() : MObject::kNullObj;
+}
+
+MStatus MetaDataManagerNode::installCallbacks()
+{
+    MStatus status = MS::kSuccess;
+    if( s_callbacks.length() > 0 )
+        return status;
+
+    s_callbacks.append( MDGMessage::addNodeAddedCallback(MetaDataManagerNode::managerAdded, "MetaDataManagerNode", NULL, &status) );
+    if( !status ) return status;
+    s_callbacks.append( MDGMessage::addNodeRemovedCallback(MetaDataManagerNode::managerRemoved, "MetaDataManagerNode", NULL, &status) );
+    if( !status ) return status;
+    s_callbacks.append( MSceneMessage::addCallback(MSceneMessage::kBeforeNew, MetaDataManagerNode::sceneCleared, NULL, &status) );
+    if( !status ) return status;
+    s_callbacks.append( MSceneMessage::addCallback(MSceneMessage::kBeforeOpen, MetaDataManagerNode::sceneCleared, NULL, &status) );
+
+    return status;
+}
+
+void MetaDataManagerNode::removeCallbacks()
+{
+    if( s_callbacks.length() > 0 )
+        MMessage::removeCallbacks(s_callbacks);
+    s_callbacks.clear();
+    s_managerKnown = false;
+    s_hasManager = false;
+}
+
+void MetaDataManagerNode::managerAdded( MObject& node, void* clientData )
+{
+    //the first manager is the one the plugin uses
+    if( s_hasManager && s_manager.isValid() )
+        return;
+    s_manager = MObjectHandle( node );
+    s_hasManager = true;
+}
+
+void MetaDataManagerNode::managerRemoved( MObject& node, void* clientData )
+{
+    if( !s_hasManager || !(s_manager == node) )
+        return;
+    //another manager may still exist, the next lookup finds it
+    s_hasManager = false;
+    s_managerKnown = false;
+}
+
+void MetaDataManagerNode::sceneCleared( void* clientData )
+{
+    s_hasManager = false;
+    s_managerKnown = false;
+}
+
 void* MetaDataManagerNode::creator()
 {
 	return new MetaDataManagerNode();
@@ -14,6 +14,10 @@
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MTypeId.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MMessage.h>
+#include <boost/unordered_map.hpp>
+#include <string>
 
 class MetaDataManagerNode : public MPxNode
 {
@@ -22,6 +26,13 @@ public:
 	virtual				~MetaDataManagerNode(); 
 
 	virtual MStatus		compute( const MPlug& plug, MDataBlock& data );
+    //keep the metaRoot registry in step with the metaRoots connections
+    virtual MStatus     connectionMade( const MPlug& plug, const MPlug& otherPlug, bool asSrc );
+    virtual MStatus     connectionBroken( const MPlug& plug, const MPlug& otherPlug, bool asSrc );
+
+    //finds the connected MetaRootNode of the named rig, i.e. "myRig" for MRN_myRig
+    MStatus             findMetaRoot( const MString& rigName, MObject& metaRootObj );
+    unsigned int        getNumMetaRoots() const { return (unsigned int)m_metaRoots.size(); }
 
 	static  void*		creator();
 	static  MStatus		initialize();
@@ -30,6 +41,40 @@ public:
     static  MObject     metaRoots;
     static  MTypeId		id;
 
+    //the scene's MetaDataManagerNode, or a null object if there is none. The node is tracked
+    //by the callbacks below and only searched for when the tracked handle is no longer valid
+    static  MObject     getManager();
+    //registers the node added/removed and scene callbacks that track the manager node
+    static  MStatus     installCallbacks();
+    static  void        removeCallbacks();
+
+private:
+    struct MetaRootEntry
+    {
+        MObjectHandle handle;
+        MCallbackId nameChangedCallback;
+    };
+    typedef boost::unordered_map<std::string, MetaRootEntry> MetaRootMap;
+
+    void                addMetaRoot( MObject& metaRootObj );
+    void                removeMetaRoot( const MObject& metaRootObj );
+    //rebuilds the registry from the metaRoots connections
+    void                rebuildMetaRoots();
+    static std::string  getRigName( const MString& metaRootName );
+    static void         metaRootNameChanged( MObject& node, const MString& prevName, void* clientData );
+    static void         managerAdded( MObject& node, void* clientData );
+    static void         managerRemoved( MObject& node, void* clientData );
+    static void         sceneCleared( void* clientData );
+
+    //rig name -> MetaRootNode
+    MetaRootMap         m_metaRoots;
+
+    static  MObjectHandle       s_manager;
+    static  bool                s_hasManager;
+    //false until a scan or the callbacks establish whether a manager exists
+    static  bool                s_managerKnown;
+    static  MCallbackIdArray    s_callbacks;
+
 };
 
 #endif
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <maya/MDataHandle.h>
 
 #include <maya/MGlobal.h>
+#include <maya/MFnDependencyNode.h>
+#include "RigProfiler.h"
 
 // You MUST change this to a unique value!!!  The id is a 32bit value used
 // to identify this type of node in the binary file format.  
@@ -23,6 +25,12 @@ MObject     MetaDataNode::metaParent;
 MObject     MetaDataNode::metaChildren;
 MObject     MetaDataNode::version;
 MObject     MetaDataNode::rigId;
+std::vector<MetaDataNode::CommonAttributes> MetaDataNode::s_commonAttributes;
+
+namespace {
+    //in CommonAttribute order
+    const char * kCommonAttributeNames[MetaDataNode::kNumCommonAttributes] = { "metaParent", "metaChildren", "version", "rigId" };
+}
 
 MetaDataNode::MetaDataNode() {}
 MetaDataNode::~MetaDataNode() {}
@@ -92,8 +100,45 @@ MStatus MetaDataNode::initialize()
     addAttribute( metaChildren );
     addAttribute( version );
     addAttribute( rigId );
+    registerCommonAttributes(id, metaParent, metaChildren, version, rigId);
 
 	return MS::kSuccess;
 
 }
 
+void MetaDataNode::registerCommonAttributes(const MTypeId & typeId, const MObject & metaParentAttr, const MObject & metaChildrenAttr, const MObject & versionAttr, const MObject & rigIdAttr) {
+    CommonAttributes entry;
+    entry.typeId = typeId.id();
+    entry.attrs[kMetaParent] = metaParentAttr;
+    entry.attrs[kMetaChildren] = metaChildrenAttr;
+    entry.attrs[kVersion] = versionAttr;
+    entry.attrs[kRigId] = rigIdAttr;
+    //a type registered again after the plugin is reloaded replaces its old attributes
+    for(unsigned int i = 0; i < s_commonAttributes.size(); i++) {
+        if(s_commonAttributes[i].typeId == entry.typeId) {
+            s_commonAttributes[i] = entry;
+            return;
+        }
+    }
+    s_commonAttributes.push_back(entry);
+}
+
+MObject MetaDataNode::getCommonAttribute(const MObject & node, CommonAttribute attr) {
+    MFnDependencyNode nodeFn( node );
+    unsigned int typeId = nodeFn.typeId().id();
+    //one entry per metadata node type
+    for(unsigned int i = 0; i < s_commonAttributes.size(); i++) {
+        if(s_commonAttributes[i].typeId == typeId)
+            return s_commonAttributes[i].attrs[attr];
+    }
+    return MObject::kNullObj;
+}
+
+MPlug MetaDataNode::getCommonPlug(const MObject & node, CommonAttribute attr, MStatus * status) {
+    MObject attrObj = getCommonAttribute(node, attr);
+    MFnDependencyNode nodeFn( node );
+    if(attrObj.isNull())
+        return lrutils::findPlug(nodeFn, kCommonAttributeNames[attr], true, status);
+    return lrutils::findPlug(nodeFn, attrObj, true, status);
+}
+
@@ -23,6 +23,8 @@
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MTypeId.h> 
+#include <maya/MPlug.h>
+#include <vector>
 
  
 class MetaDataNode : public MPxNode
@@ -47,12 +49,37 @@ public:
     static  MObject version;
     static  MObject rigId;
 
+    //the attributes above are created again by every metadata node type, so the statics
+    //hold those of the type initialized last. Each type registers its own from initialize()
+    //and they are looked up by the type of the node they are used on
+    enum CommonAttribute {
+        kMetaParent,
+        kMetaChildren,
+        kVersion,
+        kRigId,
+        kNumCommonAttributes
+    };
+    static  void        registerCommonAttributes(const MTypeId & typeId, const MObject & metaParentAttr, const MObject & metaChildrenAttr, const MObject & versionAttr, const MObject & rigIdAttr);
+    //the attribute of a node of a registered type, a null object for any other node
+    static  MObject     getCommonAttribute(const MObject & node, CommonAttribute attr);
+    //the plug of the attribute on a node of a registered type. For other nodes, i.e. joints and
+    //controllers with a metaParent attribute added to them, it is found by its name
+    static  MPlug       getCommonPlug(const MObject & node, CommonAttribute attr, MStatus * status = NULL);
+
 
 	// The typeid is a unique 32bit indentifier that describes this node.
 	// It is used to save and retrieve nodes of this type from the binary
 	// file format.  If it is not unique, it will cause file IO problems.
 	//
 	static  MTypeId		id;
+
+private:
+    struct CommonAttributes
+    {
+        unsigned int typeId;
+        MObject attrs[kNumCommonAttributes];
+    };
+    static  std::vector<CommonAttributes> s_commonAttributes;
 };
 
 #endif
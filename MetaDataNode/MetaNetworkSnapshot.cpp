@@ -0,0 +1,359 @@
+/***************************************************************
+* Summary: Snapshot of a rig's metadata network, built by one  *
+*          traversal from its MetaRootNode, that answers the   *
+*          metaChild, rigId and named connection queries made  *
+*          while a command updates or removes the rig.         *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "MetaNetworkSnapshot.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "LoadRigUtils.h"
+#include "MetaDataNode.h"
+#include <maya/MGlobal.h>
+#include <maya/MPlugArray.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnAttribute.h>
+#include <maya/MDGMessage.h>
+
+namespace {
+    const char * kMetaChildren = "metaChildren";
+
+    //the connections of one attribute while a node is being read
+    struct SlotConnections
+    {
+        std::string name;
+        MObject attr;
+        std::vector<MObject> outgoing;
+        std::vector<MObject> incoming;
+    };
+}
+
+MetaNetworkSnapshot * MetaNetworkSnapshot::s_current = NULL;
+
+MetaNetworkSnapshot::MetaNetworkSnapshot() {
+
+}
+
+MetaNetworkSnapshot::~MetaNetworkSnapshot() {
+
+}
+
+void MetaNetworkSnapshot::clear() {
+    this->m_nodes.clear();
+    this->m_children.clear();
+    this->m_slots.clear();
+    this->m_connected.clear();
+    this->m_childIndices.clear();
+    this->m_nodeIndices.clear();
+}
+
+MStatus MetaNetworkSnapshot::build(const MObject & metaRootObj) {
+    RigProfileScope profileScope("MetaNetworkSnapshot::build");
+    MStatus status = MS::kFailure;
+    this->clear();
+    if(metaRootObj.isNull())
+        MyCheckStatusReturn(status, "MetaNetworkSnapshot::build() needs a metaRoot node");
+
+    //readNode adds the metaChildren of each node it reads, so this visits the whole network once
+    this->addNode(metaRootObj);
+    for(unsigned int i = 0; i < this->m_nodes.size(); i++) {
+        this->readNode(i);
+    }
+
+    return MS::kSuccess;
+}
+
+bool MetaNetworkSnapshot::getConnection(const MObject & metaNodeObj, const MString & attrName, MObject & connectedObj) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    return this->getSlotConnection(this->findSlot(this->m_nodes[node], attrName), connectedObj);
+}
+
+bool MetaNetworkSnapshot::getConnection(const MObject & metaNodeObj, const MObject & attr, MObject & connectedObj) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    return this->getSlotConnection(this->findSlot(this->m_nodes[node], attr), connectedObj);
+}
+
+bool MetaNetworkSnapshot::getSlotConnection(const Slot * slot, MObject & connectedObj) const {
+    if(slot == NULL || slot->numIncoming + slot->numOutgoing == 0)
+        return false;
+    //the same precedence lrutils::getMetaNodeConnection gives the scene's connections
+    if(slot->numIncoming > 0)
+        connectedObj = this->m_connected[slot->firstIncoming].object();
+    else
+        connectedObj = this->m_connected[slot->firstOutgoing].object();
+    return true;
+}
+
+bool MetaNetworkSnapshot::getOutgoingConnections(const MObject & metaNodeObj, const MString & attrName, MObjectArray & connectedObjs) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    const Slot * slot = this->findSlot(this->m_nodes[node], attrName);
+    if(slot == NULL || slot->numOutgoing == 0)
+        return false;
+    connectedObjs.clear();
+    for(unsigned int i = 0; i < slot->numOutgoing; i++) {
+        connectedObjs.append( this->m_connected[slot->firstOutgoing + i].object() );
+    }
+    return true;
+}
+
+bool MetaNetworkSnapshot::getMetaChildren(const MObject & metaNodeObj, MObjectArray & metaChildObjs) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    const Node & record = this->m_nodes[node];
+    metaChildObjs.clear();
+    for(unsigned int i = 0; i < record.numChildren; i++) {
+        metaChildObjs.append( this->m_nodes[ this->m_children[record.firstChild + i] ].handle.object() );
+    }
+    return true;
+}
+
+bool MetaNetworkSnapshot::getRigId(const MObject & metaNodeObj, MString & rigId) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    rigId = this->m_nodes[node].rigId;
+    return true;
+}
+
+bool MetaNetworkSnapshot::getMetaChildByRigId(const MObject & metaNodeObj, const MString & rigId, MObject & metaChildObj, bool & found) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    ChildIndex & index = this->getChildIndex(node);
+    ChildMap::const_iterator it = index.byRigId.find(rigId.asChar());
+    found = it != index.byRigId.end() && this->m_nodes[it->second].handle.isValid();
+    if(found)
+        metaChildObj = this->m_nodes[it->second].handle.object();
+    return true;
+}
+
+bool MetaNetworkSnapshot::getMetaChildByName(const MObject & metaNodeObj, const MString & rigName, const MString & compName, MObject & metaChildObj, bool & found) {
+    int node = this->getNode(metaNodeObj);
+    if(node < 0)
+        return false;
+    //children are renamed during an update without their connections changing, so a
+    //result is checked against the child's current name and the index rebuilt on a mismatch
+    for(unsigned int attempt = 0; attempt < 2; attempt++) {
+        ChildIndex & index = this->getChildIndex(node, attempt > 0);
+        ChildMap::const_iterator it = index.byName.find((rigName + "_" + compName).asChar());
+        if(it != index.byName.end() && this->m_nodes[it->second].handle.isValid()) {
+            MObject childObj = this->m_nodes[it->second].handle.object();
+            MFnDependencyNode childFn( childObj );
+            if(lrutils::isMetaNodeOfComponent(childFn.name(), rigName, compName)) {
+                metaChildObj = childObj;
+                found = true;
+                return true;
+            }
+        }
+    }
+    found = false;
+    return true;
+}
+
+int MetaNetworkSnapshot::findNode(const MObject & obj) const {
+    if(obj.isNull())
+        return -1;
+    MObjectHandle handle( obj );
+    std::pair<NodeIndexMap::const_iterator, NodeIndexMap::const_iterator> range = this->m_nodeIndices.equal_range(handle.hashCode());
+    for(NodeIndexMap::const_iterator it = range.first; it != range.second; ++it) {
+        if(this->m_nodes[it->second].handle == obj)
+            return (int)it->second;
+    }
+    return -1;
+}
+
+int MetaNetworkSnapshot::getNode(const MObject & obj) {
+    int node = this->findNode(obj);
+    if(node < 0 || !this->m_nodes[node].handle.isValid())
+        return -1;
+    if(this->m_nodes[node].stale) {
+        //new metaChildren are appended behind the nodes already recorded
+        unsigned int numNodes = (unsigned int)this->m_nodes.size();
+        this->readNode(node);
+        for(unsigned int i = numNodes; i < this->m_nodes.size(); i++) {
+            this->readNode(i);
+        }
+    }
+    return node;
+}
+
+unsigned int MetaNetworkSnapshot::addNode(const MObject & obj) {
+    Node node;
+    node.handle = MObjectHandle(obj);
+    node.stale = true;
+    node.firstChild = 0;
+    node.numChildren = 0;
+    node.firstSlot = 0;
+    node.numSlots = 0;
+    node.childIndex = -1;
+    unsigned int index = (unsigned int)this->m_nodes.size();
+    this->m_nodes.push_back(node);
+    this->m_nodeIndices.insert( NodeIndexMap::value_type(node.handle.hashCode(), index) );
+    return index;
+}
+
+void MetaNetworkSnapshot::readNode(unsigned int node) {
+    MStatus status;
+    //copied, adding metaChildren below can reallocate m_nodes
+    MObject obj = this->m_nodes[node].handle.object();
+    MFnDependencyNode nodeFn( obj );
+
+    //a node connected several times through one attribute lists the attribute once per plug
+    std::vector<SlotConnections> slots;
+    MPlugArray plugs;
+    nodeFn.getConnections(plugs);
+    for(unsigned int i = 0; i < plugs.length(); i++) {
+        MObject attr = plugs[i].attribute();
+        MFnAttribute attrFn( attr );
+        std::string name = attrFn.name().asChar();
+        unsigned int s = 0;
+        while(s < slots.size() && slots[s].name != name) s++;
+        if(s == slots.size()) {
+            slots.push_back(SlotConnections());
+            slots.back().name = name;
+            slots.back().attr = attr;
+        }
+        MPlugArray connectedPlugs;
+        if(plugs[i].isSource()) {
+            lrutils::connectedTo(plugs[i], connectedPlugs, false, true);
+            for(unsigned int j = 0; j < connectedPlugs.length(); j++) {
+                slots[s].outgoing.push_back( connectedPlugs[j].node() );
+            }
+        }
+        if(plugs[i].isDestination()) {
+            lrutils::connectedTo(plugs[i], connectedPlugs, true, false);
+            for(unsigned int j = 0; j < connectedPlugs.length(); j++) {
+                slots[s].incoming.push_back( connectedPlugs[j].node() );
+            }
+        }
+    }
+
+    //the previous ranges of a node that is re-read are left unused
+    unsigned int firstSlot = (unsigned int)this->m_slots.size();
+    std::vector<unsigned int> children;
+    for(unsigned int s = 0; s < slots.size(); s++) {
+        Slot slot;
+        slot.name = slots[s].name;
+        slot.attr = slots[s].attr;
+        slot.firstOutgoing = (unsigned int)this->m_connected.size();
+        slot.numOutgoing = (unsigned int)slots[s].outgoing.size();
+        for(unsigned int j = 0; j < slots[s].outgoing.size(); j++) {
+            this->m_connected.push_back( MObjectHandle(slots[s].outgoing[j]) );
+        }
+        slot.firstIncoming = (unsigned int)this->m_connected.size();
+        slot.numIncoming = (unsigned int)slots[s].incoming.size();
+        for(unsigned int j = 0; j < slots[s].incoming.size(); j++) {
+            this->m_connected.push_back( MObjectHandle(slots[s].incoming[j]) );
+        }
+        this->m_slots.push_back(slot);
+
+        if(slot.name == kMetaChildren) {
+            for(unsigned int j = 0; j < slots[s].outgoing.size(); j++) {
+                int child = this->findNode(slots[s].outgoing[j]);
+                if(child < 0)
+                    child = (int)this->addNode(slots[s].outgoing[j]);
+                children.push_back((unsigned int)child);
+            }
+        }
+    }
+
+    MString rigId;
+    MPlug rigIdPlug = MetaDataNode::getCommonPlug(obj, MetaDataNode::kRigId, &status);
+    if(status == MS::kSuccess)
+        rigIdPlug.getValue(rigId);
+
+    Node & record = this->m_nodes[node];
+    record.rigId = rigId;
+    record.firstSlot = firstSlot;
+    record.numSlots = (unsigned int)slots.size();
+    record.firstChild = (unsigned int)this->m_children.size();
+    record.numChildren = (unsigned int)children.size();
+    this->m_children.insert(this->m_children.end(), children.begin(), children.end());
+    record.stale = false;
+    if(record.childIndex >= 0) {
+        this->m_childIndices[record.childIndex].byRigId.clear();
+        this->m_childIndices[record.childIndex].byName.clear();
+    }
+}
+
+MetaNetworkSnapshot::ChildIndex & MetaNetworkSnapshot::getChildIndex(unsigned int node, bool rebuild) {
+    Node & record = this->m_nodes[node];
+    if(record.childIndex < 0) {
+        record.childIndex = (int)this->m_childIndices.size();
+        this->m_childIndices.push_back(ChildIndex());
+    }
+    ChildIndex & index = this->m_childIndices[record.childIndex];
+    //an empty index with children was cleared when the node was re-read
+    if(!rebuild && (record.numChildren == 0 || !index.byRigId.empty()))
+        return index;
+
+    index.byRigId.clear();
+    index.byName.clear();
+    for(unsigned int i = 0; i < record.numChildren; i++) {
+        unsigned int child = this->m_children[record.firstChild + i];
+        if(!this->m_nodes[child].handle.isValid())
+            continue;
+        //the first child wins, as it did for the linear search
+        index.byRigId.insert( ChildMap::value_type(this->m_nodes[child].rigId.asChar(), child) );
+        MFnDependencyNode childFn( this->m_nodes[child].handle.object() );
+        index.byName.insert( ChildMap::value_type(lrutils::stripMetaNodePrefix(childFn.name()).asChar(), child) );
+    }
+    return index;
+}
+
+const MetaNetworkSnapshot::Slot * MetaNetworkSnapshot::findSlot(const Node & node, const MString & attrName) const {
+    std::string name = attrName.asChar();
+    for(unsigned int i = 0; i < node.numSlots; i++) {
+        const Slot & slot = this->m_slots[node.firstSlot + i];
+        if(slot.name == name)
+            return &slot;
+    }
+    return NULL;
+}
+
+const MetaNetworkSnapshot::Slot * MetaNetworkSnapshot::findSlot(const Node & node, const MObject & attr) const {
+    for(unsigned int i = 0; i < node.numSlots; i++) {
+        const Slot & slot = this->m_slots[node.firstSlot + i];
+        if(slot.attr == attr)
+            return &slot;
+    }
+    return NULL;
+}
+
+void MetaNetworkSnapshot::connectionChanged(MPlug & srcPlug, MPlug & dstPlug, bool made, void * clientData) {
+    MetaNetworkSnapshot * snapshot = static_cast<MetaNetworkSnapshot*>(clientData);
+    int node = snapshot->findNode(srcPlug.node());
+    if(node >= 0)
+        snapshot->m_nodes[node].stale = true;
+    node = snapshot->findNode(dstPlug.node());
+    if(node >= 0)
+        snapshot->m_nodes[node].stale = true;
+}
+
+MetaNetworkScope::MetaNetworkScope(const MObject & metaRootObj) {
+    MStatus status;
+    this->m_previous = MetaNetworkSnapshot::s_current;
+    this->m_connectionCallback = 0;
+    if(this->m_snapshot.build(metaRootObj) != MS::kSuccess)
+        return;
+    this->m_connectionCallback = MDGMessage::addConnectionCallback(MetaNetworkSnapshot::connectionChanged, &this->m_snapshot, &status);
+    //without the callback the snapshot can't tell when it goes out of date
+    if(status != MS::kSuccess)
+        return;
+    MetaNetworkSnapshot::s_current = &this->m_snapshot;
+}
+
+MetaNetworkScope::~MetaNetworkScope() {
+    if(MetaNetworkSnapshot::s_current == &this->m_snapshot)
+        MMessage::removeCallback(this->m_connectionCallback);
+    MetaNetworkSnapshot::s_current = this->m_previous;
+}
@@ -0,0 +1,125 @@
+/***************************************************************
+* Summary: Snapshot of a rig's metadata network, built by one  *
+*          traversal from its MetaRootNode, that answers the   *
+*          metaChild, rigId and named connection queries made  *
+*          while a command updates or removes the rig.         *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _MetaNetworkSnapshot
+#define _MetaNetworkSnapshot
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+#include <maya/MObjectArray.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MMessage.h>
+#include <maya/MPlug.h>
+#include <boost/unordered_map.hpp>
+#include <string>
+#include <vector>
+
+class MetaNetworkSnapshot
+{
+public:
+    MetaNetworkSnapshot();
+    ~MetaNetworkSnapshot();
+
+    //traverses the metaChildren connections down from the metaRoot, recording every
+    //metadata node's rigId, children and connected attributes
+    MStatus build(const MObject & metaRootObj);
+    void clear();
+    unsigned int getNumNodes() const {return (unsigned int)m_nodes.size();};
+
+    //every query returns false when it can't be answered from the snapshot, i.e. for a node
+    //outside the rig or an attribute without connections, and the caller asks the scene instead.
+    //Nodes whose connections changed since they were recorded are re-read before answering
+
+    //the node connected to the attribute, the incoming connection if there is one
+    bool getConnection(const MObject & metaNodeObj, const MString & attrName, MObject & connectedObj);
+    bool getConnection(const MObject & metaNodeObj, const MObject & attr, MObject & connectedObj);
+    //the nodes the attribute connects to, in the order MPlug::connectedTo lists them
+    bool getOutgoingConnections(const MObject & metaNodeObj, const MString & attrName, MObjectArray & connectedObjs);
+    bool getMetaChildren(const MObject & metaNodeObj, MObjectArray & metaChildObjs);
+    bool getRigId(const MObject & metaNodeObj, MString & rigId);
+    //exact matches among a node's metaChildren through a hashed index of their rigIds and component
+    //names, built the first time the node's children are searched. metaChildObj is only set when found
+    bool getMetaChildByRigId(const MObject & metaNodeObj, const MString & rigId, MObject & metaChildObj, bool & found);
+    bool getMetaChildByName(const MObject & metaNodeObj, const MString & rigName, const MString & compName, MObject & metaChildObj, bool & found);
+
+    //the snapshot the metadata queries are answered from, NULL outside a MetaNetworkScope
+    static MetaNetworkSnapshot * getCurrent() {return s_current;};
+
+private:
+    struct Node
+    {
+        MObjectHandle handle;
+        MString rigId;
+        bool stale; //its connections changed since they were recorded
+        unsigned int firstChild;
+        unsigned int numChildren;
+        unsigned int firstSlot;
+        unsigned int numSlots;
+        int childIndex; //into m_childIndices, -1 until the children are searched
+    };
+    typedef boost::unordered_map<std::string, unsigned int> ChildMap;
+    //the metaChildren of one node by rigId and by name without the type prefix, <rig name>_<component name>
+    struct ChildIndex
+    {
+        ChildMap byRigId;
+        ChildMap byName;
+    };
+    //the connections of one attribute of a node
+    struct Slot
+    {
+        std::string name;
+        MObject attr;
+        unsigned int firstOutgoing;
+        unsigned int numOutgoing;
+        unsigned int firstIncoming;
+        unsigned int numIncoming;
+    };
+    typedef boost::unordered_multimap<unsigned int, unsigned int> NodeIndexMap;
+
+    int findNode(const MObject & obj) const;
+    //the current record of a node in the snapshot, re-read if it went stale
+    int getNode(const MObject & obj);
+    unsigned int addNode(const MObject & obj);
+    //records a node's connections and adds the metaChildren it finds, appending to the flat arrays
+    void readNode(unsigned int node);
+    const Slot * findSlot(const Node & node, const MString & attrName) const;
+    const Slot * findSlot(const Node & node, const MObject & attr) const;
+    bool getSlotConnection(const Slot * slot, MObject & connectedObj) const;
+    //the child index of a node, built from its current children if it has none
+    ChildIndex & getChildIndex(unsigned int node, bool rebuild = false);
+
+    static void connectionChanged(MPlug & srcPlug, MPlug & dstPlug, bool made, void * clientData);
+
+    std::vector<Node> m_nodes;
+    std::vector<unsigned int> m_children;
+    std::vector<Slot> m_slots;
+    std::vector<MObjectHandle> m_connected;
+    std::vector<ChildIndex> m_childIndices;
+    //MObjectHandle hash code -> node
+    NodeIndexMap m_nodeIndices;
+
+    static MetaNetworkSnapshot * s_current;
+    friend class MetaNetworkScope;
+};
+
+//builds a snapshot of a rig's metadata network and answers metadata queries from it while it
+//exists. Connection changes made in the meantime mark the nodes involved to be re-read
+class MetaNetworkScope
+{
+public:
+    MetaNetworkScope(const MObject & metaRootObj);
+    ~MetaNetworkScope();
+
+private:
+    MetaNetworkSnapshot m_snapshot;
+    MetaNetworkSnapshot * m_previous;
+    MCallbackId m_connectionCallback;
+};
+
+#endif //_MetaNetworkSnapshot
@@ -97,6 +97,7 @@ MStatus MetaRootNode::initialize()
     addAttribute( skelLayer );
     addAttribute( ctlLayer );
     addAttribute( extrasLayer );
+    registerCommonAttributes(id, metaParent, metaChildren, version, MObject::kNullObj);
 
 	return MS::kSuccess;
 
@@ -0,0 +1,196 @@
+/***************************************************************
+* Summary: Index from node names to MObjectHandles of the      *
+*          nodes the rig code looks up by name, kept current   *
+*          by scene callbacks so that resolving a name is a    *
+*          hash probe instead of a selection list query.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "NodeNameIndex.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MSelectionList.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MDGMessage.h>
+#include <maya/MNodeMessage.h>
+#include <maya/MSceneMessage.h>
+
+bool NodeNameIndex::s_installed = false;
+NodeNameIndex::EntryMap NodeNameIndex::s_entries;
+MCallbackIdArray NodeNameIndex::s_callbacks;
+
+MStatus NodeNameIndex::install() {
+    MStatus status = MS::kSuccess;
+    if(s_installed)
+        return status;
+
+    s_callbacks.append( MDGMessage::addNodeAddedCallback(NodeNameIndex::nodeAdded, "dependNode", NULL, &status) );
+    MyCheckStatusReturn(status, "MDGMessage::addNodeAddedCallback() failed");
+    s_callbacks.append( MDGMessage::addNodeRemovedCallback(NodeNameIndex::nodeRemoved, "dependNode", NULL, &status) );
+    MyCheckStatusReturn(status, "MDGMessage::addNodeRemovedCallback() failed");
+    //a null node registers the callback for every node in the scene
+    MObject allNodes;
+    s_callbacks.append( MNodeMessage::addNameChangedCallback(allNodes, NodeNameIndex::nameChanged, NULL, &status) );
+    MyCheckStatusReturn(status, "MNodeMessage::addNameChangedCallback() failed");
+    s_callbacks.append( MSceneMessage::addCallback(MSceneMessage::kBeforeNew, NodeNameIndex::sceneCleared, NULL, &status) );
+    MyCheckStatusReturn(status, "MSceneMessage::addCallback() failed");
+    s_callbacks.append( MSceneMessage::addCallback(MSceneMessage::kBeforeOpen, NodeNameIndex::sceneCleared, NULL, &status) );
+    MyCheckStatusReturn(status, "MSceneMessage::addCallback() failed");
+
+    s_installed = true;
+    return status;
+}
+
+void NodeNameIndex::uninstall() {
+    if(s_callbacks.length() > 0)
+        MMessage::removeCallbacks(s_callbacks);
+    s_callbacks.clear();
+    s_entries.clear();
+    s_installed = false;
+}
+
+MStatus NodeNameIndex::getObj(const MString & name, MObject & obj) {
+    std::string key = name.asChar();
+    if(s_installed) {
+        EntryMap::iterator it = s_entries.find(key);
+        if(it != s_entries.end()) {
+            if(isCurrent(key, it->second)) {
+                obj = it->second.handle.object();
+                return MS::kSuccess;
+            }
+            s_entries.erase(it);
+        }
+    }
+
+    MStatus status;
+    RigProfiler::count(RigProfiler::kNameLookup);
+    MSelectionList selection;
+    status = selection.add( name, true );
+    MyCheckStatusReturn(status, "add node \""+name+"\" to selection failed.");
+
+    if(selection.length() ) {
+        selection.getDependNode(0, obj);
+        status = MS::kSuccess;
+    }
+    //wildcards and ambiguous short names can match more than one node
+    if(s_installed && selection.length() == 1)
+        insert(key, obj);
+
+    return status;
+}
+
+MStatus NodeNameIndex::resolve(const MString & name, MObject & obj) {
+    MStatus status;
+    RigProfiler::count(RigProfiler::kNameLookup);
+    MSelectionList selection;
+    status = selection.add( name, true );
+    if(status != MS::kSuccess)
+        return status;
+    if(selection.length() == 0)
+        return MS::kFailure;
+    return selection.getDependNode(0, obj);
+}
+
+void NodeNameIndex::add(const MObject & obj) {
+    if(!s_installed || obj.isNull())
+        return;
+    MFnDependencyNode nodeFn( obj );
+    insert(nodeFn.name().asChar(), obj);
+}
+
+void NodeNameIndex::clear() {
+    s_entries.clear();
+}
+
+MStringArray NodeNameIndex::getNames() {
+    MStringArray names;
+    for(EntryMap::const_iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+        names.append(MString(it->first.c_str()));
+    }
+    return names;
+}
+
+MStringArray NodeNameIndex::check() {
+    MStringArray problems;
+    for(EntryMap::const_iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+        //stale entries are dropped by the next lookup, only entries a lookup would return can be wrong
+        if(!isCurrent(it->first, it->second))
+            continue;
+        MString name = it->first.c_str();
+        MObject sceneObj;
+        if(resolve(name, sceneObj) != MS::kSuccess) {
+            problems.append(name + ": indexed but no longer resolves in the scene");
+        } else if(!(it->second.handle == sceneObj)) {
+            MFnDependencyNode sceneFn( sceneObj );
+            problems.append(name + ": indexed node differs from the scene's " + sceneFn.name());
+        }
+    }
+    return problems;
+}
+
+bool NodeNameIndex::isCurrent(const std::string & name, const Entry & entry) {
+    if(!entry.handle.isValid())
+        return false;
+    if(!entry.isPath)
+        return true;
+    MFnDagNode dagFn( entry.handle.object() );
+    return name == dagFn.fullPathName().asChar();
+}
+
+void NodeNameIndex::insert(const std::string & name, const MObject & obj) {
+    if(name.empty())
+        return;
+    Entry entry;
+    entry.handle = MObjectHandle(obj);
+    entry.isPath = name[0] == '|';
+    if(entry.isPath) {
+        if(!obj.hasFn(MFn::kDagNode))
+            return;
+    } else {
+        //partial DAG paths aren't indexed, the callbacks only track a node's own name
+        MFnDependencyNode nodeFn( obj );
+        if(name != nodeFn.name().asChar())
+            return;
+    }
+    s_entries[name] = entry;
+}
+
+void NodeNameIndex::nodeAdded(MObject & node, void * clientData) {
+    MFnDependencyNode nodeFn( node );
+    //a DAG node that takes the short name of an indexed node makes the name ambiguous
+    EntryMap::iterator it = s_entries.find(nodeFn.name().asChar());
+    if(it != s_entries.end() && !(it->second.handle == node))
+        s_entries.erase(it);
+}
+
+void NodeNameIndex::nodeRemoved(MObject & node, void * clientData) {
+    MFnDependencyNode nodeFn( node );
+    EntryMap::iterator it = s_entries.find(nodeFn.name().asChar());
+    if(it != s_entries.end() && it->second.handle == node)
+        s_entries.erase(it);
+}
+
+void NodeNameIndex::nameChanged(MObject & node, const MString & prevName, void * clientData) {
+    if(s_entries.empty())
+        return;
+    MFnDependencyNode nodeFn( node );
+    std::string name = nodeFn.name().asChar();
+
+    bool indexed = false;
+    EntryMap::iterator it = s_entries.find(prevName.asChar());
+    if(it != s_entries.end() && it->second.handle == node) {
+        s_entries.erase(it);
+        indexed = true;
+    }
+    it = s_entries.find(name);
+    if(it != s_entries.end() && !(it->second.handle == node))
+        s_entries.erase(it);
+    if(indexed)
+        insert(name, node);
+}
+
+void NodeNameIndex::sceneCleared(void * clientData) {
+    s_entries.clear();
+}
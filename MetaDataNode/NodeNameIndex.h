@@ -0,0 +1,68 @@
+/***************************************************************
+* Summary: Index from node names to MObjectHandles of the      *
+*          nodes the rig code looks up by name, kept current   *
+*          by scene callbacks so that resolving a name is a    *
+*          hash probe instead of a selection list query.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _NodeNameIndex
+#define _NodeNameIndex
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MStringArray.h>
+#include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MMessage.h>
+#include <boost/unordered_map.hpp>
+#include <string>
+
+class NodeNameIndex
+{
+public:
+    //registers the node added, removed and renamed callbacks that keep the index current.
+    //Until it is installed every lookup goes through a selection list
+    static MStatus install();
+    static void uninstall();
+    static bool isInstalled() {return s_installed;};
+
+    //resolves a node name or an absolute DAG path, names that aren't indexed yet are resolved
+    //through a selection list and added when they match exactly one node
+    static MStatus getObj(const MString & name, MObject & obj);
+    //resolves a name through a selection list without consulting or updating the index
+    static MStatus resolve(const MString & name, MObject & obj);
+    //indexes a node under its current name, i.e. right after the rig creates it
+    static void add(const MObject & obj);
+
+    static void clear();
+    static unsigned int size() {return (unsigned int)s_entries.size();};
+    static MStringArray getNames();
+    //resolves every indexed name through a selection list and describes each entry that
+    //doesn't match, an empty result means the index is consistent with the scene
+    static MStringArray check();
+
+private:
+    //absolute DAG paths aren't kept current by the callbacks since renaming or reparenting
+    //any ancestor changes them, they are compared against the node's path on every hit instead
+    struct Entry
+    {
+        MObjectHandle handle;
+        bool isPath;
+    };
+    typedef boost::unordered_map<std::string, Entry> EntryMap;
+
+    static bool isCurrent(const std::string & name, const Entry & entry);
+    static void insert(const std::string & name, const MObject & obj);
+
+    static void nodeAdded(MObject & node, void * clientData);
+    static void nodeRemoved(MObject & node, void * clientData);
+    static void nameChanged(MObject & node, const MString & prevName, void * clientData);
+    static void sceneCleared(void * clientData);
+
+    static bool s_installed;
+    static EntryMap s_entries;
+    static MCallbackIdArray s_callbacks;
+};
+
+#endif //_NodeNameIndex
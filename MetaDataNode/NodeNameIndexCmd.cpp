@@ -0,0 +1,49 @@
+/************************************************************
+* Summary: Checks the node name index against the scene,    *
+*          clears it, or returns the number of names it     *
+*          holds.                                           *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#include <maya/MGlobal.h>
+#include "NodeNameIndexCmd.h"
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include "NodeNameIndex.h"
+
+MStatus NodeNameIndexCmd::doIt ( const MArgList &args )
+{
+    MStatus status;
+    MArgDatabase argData(syntax(), args, &status);
+    if (!status) {
+        status.perror("nodeNameIndex flag parsing failed");
+        return status;
+    }
+
+    if (argData.isFlagSet(NodeNameIndexCmd::ClearParam())) {
+        NodeNameIndex::clear();
+    }
+
+    if (argData.isFlagSet(NodeNameIndexCmd::CheckParam())) {
+        MStringArray problems = NodeNameIndex::check();
+        for(unsigned int i = 0; i < problems.length(); i++) {
+            MGlobal::displayWarning("[MetaDataRigging] node name index: "+problems[i]);
+        }
+        setResult(problems);
+        return MS::kSuccess;
+    }
+
+    setResult((int)NodeNameIndex::size());
+
+    return MS::kSuccess;
+}
+
+MSyntax NodeNameIndexCmd::newSyntax()
+{
+    MSyntax syntax;
+
+    syntax.addFlag(NodeNameIndexCmd::CheckParam(), NodeNameIndexCmd::CheckParamLong());
+    syntax.addFlag(NodeNameIndexCmd::ClearParam(), NodeNameIndexCmd::ClearParamLong());
+
+    return syntax;
+}
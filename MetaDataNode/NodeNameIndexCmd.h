@@ -0,0 +1,33 @@
+/************************************************************
+* Summary: Checks the node name index against the scene,    *
+*          clears it, or returns the number of names it     *
+*          holds.                                           *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#ifndef _NodeNameIndexCmd
+#define _NodeNameIndexCmd
+
+#include <maya/MStatus.h>
+#include <maya/MSyntax.h>
+#include <maya/MPxCommand.h>
+
+class NodeNameIndexCmd : public MPxCommand
+{
+public:
+    virtual MStatus doIt ( const MArgList& );
+    virtual bool isUndoable() const { return false; }
+
+    static void *creator() { return new NodeNameIndexCmd; }
+    static MSyntax newSyntax();
+
+    //compare every indexed name with the scene and return the entries that don't match
+    static const char* CheckParam() { return "-c"; }
+    static const char* CheckParamLong() { return "-check"; }
+    //drop every indexed name
+    static const char* ClearParam() { return "-cl"; }
+    static const char* ClearParamLong() { return "-clear"; }
+
+};
+
+#endif
@@ -6,6 +6,7 @@
 ************************************************************/
 
 #include "MetaDataManagerNode.h"
+#include "MetaRootNode.h"
 #include <maya/MGlobal.h>
 #include "RemoveRigCmd.h"
 #include <maya/MArgList.h>
@@ -16,6 +17,7 @@
 #include <maya/MFnTransform.h>
 #include <maya/MFnMessageAttribute.h>
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include "XmlGuide.h"
 #include "LoadRigUtils.h"
 #include "Rig.h"
@@ -37,7 +39,7 @@ MStatus RemoveRigCmd::doIt ( const MArgList &args )
     MFnDependencyNode rootNodeFn(  rootNodeObj );
 
     //get the xml path string held in the xmlPath attribute
-    MPlug rootXmlPath = rootNodeFn.findPlug(MString("xmlPath"),true,&status);
+    MPlug rootXmlPath = lrutils::findPlug(rootNodeFn, MetaRootNode::xmlPath,true,&status);
     MyCheckStatusReturn(status,"findPlug failed");
     MString xmlString;
     rootXmlPath.getValue(xmlString);
@@ -99,7 +101,7 @@ MStatus RemoveRigCmd::undoIt()
 
 MStatus RemoveRigCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
 
 MSyntax RemoveRigCmd::newSyntax()
@@ -116,10 +118,10 @@ MStatus RemoveRigCmd::removeGeoNodes(MObject rootNode) {
 
     MFnDependencyNode rootNodeFn( rootNode );
     
-    MPlug geometryPlug = rootNodeFn.findPlug(MString("geometry"),true,&status);
+    MPlug geometryPlug = lrutils::findPlug(rootNodeFn, MetaRootNode::geometry,true,&status);
     MyCheckStatusReturn(status,"findPlug geometry failed");
     MPlugArray geometryPlugs;
-    geometryPlug.connectedTo(geometryPlugs,false,true,&status);
+    lrutils::connectedTo(geometryPlug, geometryPlugs,false,true,&status);
     MyCheckStatusReturn(status, "MPlug.connectedTo failed");
     for(unsigned int j = 0; j < geometryPlugs.length(); j++) {
         MObject geoObj = geometryPlugs[j].node(&status);
@@ -140,7 +142,7 @@ MStatus RemoveRigCmd::removeGeoNodes(MObject rootNode) {
             stringstream tmp;
             tmp << "file -removeReference -referenceNode \"" << sNamespace.c_str() << "\";";
             MString referenceCommand = MString(tmp.str().c_str());
-            MGlobal::executeCommand(referenceCommand);
+            lrutils::executeCommand(referenceCommand);
         }
     }
 
@@ -7,27 +7,53 @@
 ***************************************************************/
 
 #include <maya/MGlobal.h>
-#include <maya/MItDependencyNodes.h>
 #include "MetaDataManagerNode.h"
+#include "MetaRootNode.h"
 #include "Rig.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include "LoadRigUtils.h"
+#include "SceneOpList.h"
+#include "ControllerShapes.h"
+#include "DisplayLayers.h"
+#include "HierarchyPlan.h"
+#include "MayaSceneBackend.h"
+#include "RigScaffold.h"
+#include "MetaNetworkSnapshot.h"
+#include "ComponentPlan.h"
+#include "WorkerPool.h"
 #include <sstream>
 
 Rig::Rig(MString xmlPath, MObject metaRootNodeObj) {
+    this->m_planned = false;
     if(xmlPath.length() > 0) {
         this->readXml(xmlPath);
-        this->m_metaRootNodeObj = metaRootNodeObj;
-        if (!this->m_metaRootNodeObj.isNull()) {
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_topGroupObj, "topGroup");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_rigGroupObj, "rigGroup");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlGroupObj, "ctlGroup");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_noTransformGroupObj, "noTransformGroup");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_skelLayerObj, "skelLayer");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlLayerObj, "ctlLayer");
-            lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_extrasLayerObj, "extrasLayer");
-        }
+        this->setMetaRootNode(metaRootNodeObj);
         this->createComponentsFromXML();
+        if(this->m_errors.length() > 0) {
+            MString errors = this->m_errors;
+            MyError(errors);
+        }
+    }
+}
+
+Rig::Rig(XmlGuidePtr xmlGuide) {
+    this->m_planned = false;
+    this->m_pXmlGuide = xmlGuide;
+    this->m_pXmlGuide->getName(this->m_name);
+    this->createComponentsFromXML();
+}
+
+void Rig::setMetaRootNode(MObject metaRootNodeObj) {
+    this->m_metaRootNodeObj = metaRootNodeObj;
+    if (!this->m_metaRootNodeObj.isNull()) {
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_topGroupObj, MetaRootNode::topGroup);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_rigGroupObj, MetaRootNode::rigGroup);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlGroupObj, MetaRootNode::ctlGroup);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_noTransformGroupObj, MetaRootNode::noTransformGroup);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_skelLayerObj, MetaRootNode::skelLayer);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlLayerObj, MetaRootNode::ctlLayer);
+        lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_extrasLayerObj, MetaRootNode::extrasLayer);
     }
 }
 
@@ -60,8 +86,8 @@ ComponentPtr Rig::createComponent(ComponentGuidePtr guide, ComponentPtr parentCo
         return component;
     }
     else {
-        stringstream msg; msg << "component guide type " << type.asChar() << " is invalid";
-        MGlobal::displayError(msg.str().c_str());
+        stringstream msg; msg << "component guide type " << type.asChar() << " is invalid\n";
+        this->m_errors += msg.str().c_str();
         return ComponentPtr();
     }
 
@@ -69,6 +95,9 @@ ComponentPtr Rig::createComponent(ComponentGuidePtr guide, ComponentPtr parentCo
 
 ComponentPtr Rig::recursiveComponentCreate(ComponentGuidePtr guide, ComponentPtr parentComp) {
     ComponentPtr comp = createComponent(guide, parentComp);
+    if(comp) {
+        comp->setGuideTransforms(this->m_pGuideTransforms);
+    }
     //iterate through child component guides and call recursive create for them
     unsigned int numGuides = guide->getNumChildComps();
     for(unsigned int i = 0; i < numGuides; i++) {
@@ -84,12 +113,20 @@ void Rig::createComponentsFromXML() {
     ComponentGuidePtr rootGuide = this->m_pXmlGuide->getRootComponent();
     if(rootGuide) {
         MString type = rootGuide->getType();
+        //every guide location is placed up front, before any component touches the scene
+        this->m_pGuideTransforms.reset( new GuideTransforms(rootGuide) );
         this->m_pRootComponent = recursiveComponentCreate(rootGuide,ComponentPtr());
     }
 }
 
 MStatus Rig::load(MDGModifier & dgMod) {
+    RigProfileScope profileScope("Rig::load", RigProfiler::kRigCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_name);
     MStatus status = MS::kFailure;
+    SceneOpList::resetSessionReport();
+    HierarchyPlan::resetSessionReport();
+    lrutils::beginControllerSession();
+    lrutils::DisplayLayerBatch layerBatch;
 
    //get info from the xml file  
     MString m_name;
@@ -105,143 +142,105 @@ MStatus Rig::load(MDGModifier & dgMod) {
     status = m_pXmlGuide->getGeoName(geoName);
     //MyCheckStatus(status, "getGeoName failed");
 
-    //create groups used for scene organization
-    status = lrutils::makeGroup(m_topGroupObj, this->m_name);
-    MyCheckStatusReturn(status, "lrutils::makeGroup failed");
-    MFnTransform topGroupFn;
-    topGroupFn.setObject(m_topGroupObj);
+    //find the MetaDataManager node if it exists
+    MayaSceneBackend scene;
+    SceneBackend::NodeId managerNode = SceneBackend::kNullNode;
+    MObject managerObj = MetaDataManagerNode::getManager();
+    if(!managerObj.isNull()) {
+        managerNode = scene.addExisting(managerObj);
+    }
+    //the manager node wasn't found, so make it
+    if(managerNode == SceneBackend::kNullNode) {
+        managerNode = scene.createNode("MetaDataManagerNode", "");
+    }
+
+    //create the metaRoot and the groups used for scene organization
+    MString xmlPath;
+    status = this->m_pXmlGuide->getFilePath(xmlPath);
+    MyCheckStatusReturn(status, "get xml file path failed");
+    lrutils::RigScaffold scaffold;
+    if(!lrutils::buildRigScaffold(scene, m_name.asChar(), xmlPath.asChar(), version, managerNode, scaffold)) {
+        status = MS::kFailure;
+        MyCheckStatusReturn(status, "lrutils::buildRigScaffold() failed");
+    }
+    this->m_topGroupObj = scene.getObject(scaffold.topGroup);
+    this->m_rigGroupObj = scene.getObject(scaffold.rigGroup);
+    this->m_ctlGroupObj = scene.getObject(scaffold.ctlGroup);
+    this->m_noTransformGroupObj = scene.getObject(scaffold.noTransformGroup);
+    MObject metaRootNodeObj = scene.getObject(scaffold.metaRoot);
+    MFnDependencyNode depRootNodeFn( metaRootNodeObj );
+    MFnTransform rigGroupFn( this->m_rigGroupObj );
     MFnMessageAttribute mAttr;
-    MObject transformAttr = mAttr.create("metaParent", "metaParent");
-    topGroupFn.addAttribute(transformAttr);
-    MString rigGroupName = this->m_name+"_Rig";
-    status = lrutils::makeGroup(m_rigGroupObj, rigGroupName);
-    MFnTransform rigGroupFn; rigGroupFn.setObject( m_rigGroupObj );
-    rigGroupFn.addAttribute( mAttr.create("metaParent", "metaParent") );
-    MString ctlGroupName = this->m_name+"_Control";
-    status = lrutils::makeGroup(m_ctlGroupObj, ctlGroupName);
-    MFnTransform ctlGroupFn; ctlGroupFn.setObject( m_ctlGroupObj );
-    ctlGroupFn.addAttribute( mAttr.create("metaParent", "metaParent") );
-    MString noTransformName = this->m_name+"_NoTransform";
-    status = lrutils::makeGroup(m_noTransformGroupObj, noTransformName);
-    MFnTransform noTransformGroupFn; noTransformGroupFn.setObject( m_noTransformGroupObj );
-    noTransformGroupFn.addAttribute( mAttr.create("metaParent", "metaParent") );
-    topGroupFn.addChild(m_rigGroupObj);
-    topGroupFn.addChild(m_ctlGroupObj);
-    topGroupFn.addChild(m_noTransformGroupObj);
 
     //create display layers used to organize the rig
     //skeleton layer
-    status = MGlobal::executeCommand( "python(\"layer = Utils.makeDisplayLayer('"+this->m_name+"_Skeleton_LYR')\");" );
-    status = MGlobal::executeCommand( "python(\"layer.setAttr('visibility',False)\");" );
-    MCommandResult res;
-    status = MGlobal::executeCommand( MString("python(\"layer.name()\");"), res );
-    MString sResult;
-    res.getResult(sResult);
-    lrutils::getObjFromName(sResult, m_skelLayerObj);
+    status = lrutils::makeDisplayLayer(this->m_name+"_Skeleton_LYR", false, m_skelLayerObj);
+    MyCheckStatus(status, "lrutils::makeDisplayLayer() failed");
     MFnDependencyNode skelLayerFn( m_skelLayerObj );
     skelLayerFn.addAttribute( mAttr.create("metaParent", "metaParent") );
     //controllers layer
-    status = MGlobal::executeCommand( "python(\"layer = Utils.makeDisplayLayer('"+this->m_name+"_Controllers_LYR')\");" );
-    status = MGlobal::executeCommand( MString("python(\"layer.name()\");"), res );
-    res.getResult(sResult);
-    lrutils::getObjFromName(sResult, m_ctlLayerObj);
+    status = lrutils::makeDisplayLayer(this->m_name+"_Controllers_LYR", true, m_ctlLayerObj);
+    MyCheckStatus(status, "lrutils::makeDisplayLayer() failed");
     MFnDependencyNode ctlLayerFn( m_ctlLayerObj );
     ctlLayerFn.addAttribute( mAttr.create("metaParent", "metaParent") );
     //extras layer
-    status = MGlobal::executeCommand( "python(\"layer = Utils.makeDisplayLayer('"+this->m_name+"_ExtraStuff_DONOTUNHIDE_LYR')\");" );
-    status = MGlobal::executeCommand( "python(\"layer.setAttr('visibility',False)\");" );
-    status = MGlobal::executeCommand( MString("python(\"layer.name()\");"), res );
-    res.getResult(sResult);
-    lrutils::getObjFromName(sResult, m_extrasLayerObj);
+    status = lrutils::makeDisplayLayer(this->m_name+"_ExtraStuff_DONOTUNHIDE_LYR", false, m_extrasLayerObj);
+    MyCheckStatus(status, "lrutils::makeDisplayLayer() failed");
     MFnDependencyNode extrasLayerFn( m_extrasLayerObj );
     extrasLayerFn.addAttribute( mAttr.create("metaParent", "metaParent") );
 
-
     //load referenced geometry into scene
     MObject geoObj;
     MFnTransform transformFn;
     if(geoFilePath != "" && geoName != "") {
         lrutils::loadGeoReference(geoFilePath, geoName, m_name, geoObj);
         transformFn.setObject(geoObj);
-        //noTransformGroupFn.setObject(m_noTransformGroupObj);
-        //noTransformGroupFn.addChild(geoObj);
         rigGroupFn.addChild(geoObj);
     }
-    
-    //find the MetaDataManager node if it exists
-    MObject metaDataManagerNodeObj;
-    bool MDMexists = false;
-    for( MItDependencyNodes nodeIt(MFn::kPluginDependNode);
-        !nodeIt.isDone(); nodeIt.next() ) {
-        MFnDependencyNode nodeFn( nodeIt.item() );
-        if(nodeFn.typeId() == MetaDataManagerNode::id) {
-            MDMexists = true;
-            metaDataManagerNodeObj = nodeIt.thisNode();
-            break;
-        }
-    }
-    //the manager node wasn't found, so make it
-    if(!MDMexists) {
-        metaDataManagerNodeObj = dgMod.createNode( "MetaDataManagerNode", &status );
-        MyCheckStatusReturn(status, "createNode failed");
-    }    
-    MFnDependencyNode depManagerNodeFn( metaDataManagerNodeObj );
-    
-    //create and set up root node
-    MObject metaRootNodeObj = dgMod.createNode( "MetaRootNode", &status );
-    MyCheckStatusReturn(status, "createNode failed");
-    MFnDependencyNode depRootNodeFn( metaRootNodeObj );
-    MString rootNodeName = "MRN_";
-    rootNodeName += m_name;
-    MString xmlPath;
-    status = this->m_pXmlGuide->getFilePath(xmlPath);
-    MyCheckStatusReturn(status, "get xml file path failed");
-    status = dgMod.newPlugValueString( depRootNodeFn.findPlug("xmlPath"), xmlPath );
-    dgMod.renameNode(metaRootNodeObj, rootNodeName);
-    MyCheckStatusReturn(status, "newPlugValueString failed");
-    status = dgMod.newPlugValueFloat( depRootNodeFn.findPlug("version"), version );
 
     //create meta data network connections
-    status = dgMod.connect( depManagerNodeFn.findPlug("metaRoots"), depRootNodeFn.findPlug("metaParent") );
-    MyCheckStatusReturn(status, "connect failed");
     if(transformFn.object() != MObject::kNullObj) {
-        status = dgMod.connect( depRootNodeFn.findPlug("geometry"), transformFn.findPlug("metaParent") );
+        status = dgMod.connect( lrutils::findPlug(depRootNodeFn, MetaRootNode::geometry), lrutils::findPlug(transformFn, "metaParent") );
         MyCheckStatusReturn(status, "connect failed");
     }
-    status = dgMod.connect( depRootNodeFn.findPlug("topGroup"), topGroupFn.findPlug("metaParent") );
+    status = dgMod.connect( lrutils::findPlug(depRootNodeFn, MetaRootNode::skelLayer), lrutils::findPlug(skelLayerFn, "metaParent") );
     MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("rigGroup"), rigGroupFn.findPlug("metaParent") );
+    status = dgMod.connect( lrutils::findPlug(depRootNodeFn, MetaRootNode::ctlLayer), lrutils::findPlug(ctlLayerFn, "metaParent") );
     MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("ctlGroup"), ctlGroupFn.findPlug("metaParent") );
-    MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("noTransformGroup"), noTransformGroupFn.findPlug("metaParent") );
-    MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("skelLayer"), skelLayerFn.findPlug("metaParent") );
-    MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("ctlLayer"), ctlLayerFn.findPlug("metaParent") );
-    MyCheckStatusReturn(status, "connect failed");
-    status = dgMod.connect( depRootNodeFn.findPlug("extrasLayer"), extrasLayerFn.findPlug("metaParent") );
+    status = dgMod.connect( lrutils::findPlug(depRootNodeFn, MetaRootNode::extrasLayer), lrutils::findPlug(extrasLayerFn, "metaParent") );
     MyCheckStatusReturn(status, "connect failed");
     //the rig connections must be made before the rest of the components are loaded
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
     
     //load the rest of the components needed for the rig
     if(m_pRootComponent) {
+        std::vector<ComponentPtr> comps;
+        this->recursiveGetComponents(m_pRootComponent, comps);
+        this->planComponents(comps);
         MObject metaNodeObj = this->recursiveLoadComponents(m_pRootComponent, dgMod);
-        MFnDependencyNode depNodeFn( metaNodeObj );
-        status = dgMod.connect( depRootNodeFn.findPlug("metaChildren"), depNodeFn.findPlug("metaParent") );
+        status = dgMod.connect( MetaDataNode::getCommonPlug(depRootNodeFn.object(), MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaParent) );
     }
     //MyCheckStatusReturn(status, "connect failed");
+    lrutils::flushDisplayLayers();
+    this->storeBuildReport();
 
     return status;   
 }
 
 MStatus Rig::update(bool forceUpdate, bool globalPos) {
+    RigProfileScope profileScope("Rig::update", RigProfiler::kRigCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_name);
     this->m_pRigIdManager.reset( new RigIdManager() );
+    SceneOpList::resetSessionReport();
+    HierarchyPlan::resetSessionReport();
+    lrutils::beginControllerSession();
+    lrutils::DisplayLayerBatch layerBatch;
 
     MStatus status = MS::kFailure;
     if(this->m_metaRootNodeObj.isNull())
         MyCheckStatusReturn(status, "Rig->m_metaRootNodeObj has not been set to a valid MObject.");
+    //the metadata queries made while updating are answered from one traversal of the network
+    MetaNetworkScope networkScope(this->m_metaRootNodeObj);
 
     MFnDependencyNode metaRootNodeFn(this->m_metaRootNodeObj);
     MDGModifier dgMod;
@@ -250,7 +249,7 @@ MStatus Rig::update(bool forceUpdate, bool globalPos) {
     MString xmlPath;
     status = this->m_pXmlGuide->getFilePath(xmlPath);
     MyCheckStatusReturn(status, "get xml file path failed");
-    status = dgMod.newPlugValueString( metaRootNodeFn.findPlug("xmlPath"), xmlPath );
+    status = dgMod.newPlugValueString( lrutils::findPlug(metaRootNodeFn, MetaRootNode::xmlPath), xmlPath );
 
     status = this->updateNodeNames();
     status = this->updateGeoNodes();
@@ -264,7 +263,7 @@ MStatus Rig::update(bool forceUpdate, bool globalPos) {
     this->recursiveGetComponentIds(this->m_pRootComponent);
     //get the first component of the rig
     MObject firstMetaChildObj;
-    status = lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, firstMetaChildObj, MString("metaChildren"));
+    status = lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, firstMetaChildObj, MetaDataNode::getCommonAttribute(this->m_metaRootNodeObj, MetaDataNode::kMetaChildren));
     if(status == MS::kFailure) {
         return status;
     }
@@ -272,25 +271,34 @@ MStatus Rig::update(bool forceUpdate, bool globalPos) {
     if(!firstMetaChildObj.isNull()) {
         this->recursiveGetMetaDataIds(firstMetaChildObj);
     }
-    MString idManagerString = this->m_pRigIdManager->toString();
     //MGlobal::displayInfo(this->m_pRigIdManager->toString());
     //this->recursiveUpdateComponents(metaRootCompObj, this->m_pRootComponent, dgMod);
+    //only the components that are new get built, the ones already in the scene are updated in place
+    RigIdManager::WorkLists lists;
+    this->m_pRigIdManager->classify(lists);
+    std::vector<ComponentPtr> loadComps;
+    for(unsigned int i = 0; i < lists.loads.size(); i++) {
+        loadComps.push_back( this->m_pRigIdManager->getEntryComponent(lists.loads[i]) );
+    }
+    this->planComponents(loadComps);
     this->m_pRigIdManager->updateComponents(dgMod,forceUpdate,globalPos);
-
+    lrutils::flushDisplayLayers();
+    this->storeBuildReport();
 
     return status;
 }
 
 MStatus Rig::updateGeoNodes() {
+    RigProfileScope profileScope("Rig::updateGeoNodes", RigProfiler::kRigCategory);
     MStatus status = MS::kFailure;
     MDGModifier dgMod;
 
     MFnDependencyNode metaRootNodeFn( this->m_metaRootNodeObj );
 
-    MPlug geometryPlug = metaRootNodeFn.findPlug(MString("geometry"),true,&status);
+    MPlug geometryPlug = lrutils::findPlug(metaRootNodeFn, MetaRootNode::geometry,true,&status);
     MyCheckStatusReturn(status,"findPlug geometry failed");
     MPlugArray geometryPlugs;
-    geometryPlug.connectedTo(geometryPlugs,false,true,&status);
+    lrutils::connectedTo(geometryPlug, geometryPlugs,false,true,&status);
     MyCheckStatusReturn(status, "MPlug.connectedTo failed");
     for(unsigned int j = 0; j < geometryPlugs.length(); j++) {
         MObject geoObj = geometryPlugs[j].node(&status);
@@ -315,7 +323,7 @@ MStatus Rig::updateGeoNodes() {
             stringstream tmp;
             tmp << "file -removeReference -referenceNode \"" << sNamespace.c_str() << "\";";
             MString referenceCommand = MString(tmp.str().c_str());
-            MGlobal::executeCommand(referenceCommand);
+            lrutils::executeCommand(referenceCommand);
 
             //get info from the xml file      
             MString geoFilePath;
@@ -335,9 +343,9 @@ MStatus Rig::updateGeoNodes() {
             MFnTransform transformFn(geoObj);
             transformFn.set(origGeoTransMat);
 
-            status = dgMod.connect( metaRootNodeFn.findPlug("geometry"), transformFn.findPlug("metaParent") );
+            status = dgMod.connect( lrutils::findPlug(metaRootNodeFn, MetaRootNode::geometry), lrutils::findPlug(transformFn, "metaParent") );
             MyCheckStatusReturn(status, "connect failed");
-            dgMod.doIt();
+            lrutils::doIt(dgMod);
         }
 
     }
@@ -345,7 +353,7 @@ MStatus Rig::updateGeoNodes() {
     if(geometryPlugs.length() == 0) {
         //get info from the xml file      
         MString geoFilePath;
-        status = lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, m_rigGroupObj, MString("rigGroup"));
+        status = lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, m_rigGroupObj, MetaRootNode::rigGroup);
         MFnTransform rigGroupFn; 
         rigGroupFn.setObject( m_rigGroupObj );
         status = m_pXmlGuide->getGeoFilePath(geoFilePath);
@@ -366,9 +374,9 @@ MStatus Rig::updateGeoNodes() {
             rigGroupFn.addChild(geoObj);
 
             if(transformFn.object() != MObject::kNullObj) {
-                status = dgMod.connect( metaRootNodeFn.findPlug("geometry"), transformFn.findPlug("metaParent") );
+                status = dgMod.connect( lrutils::findPlug(metaRootNodeFn, MetaRootNode::geometry), lrutils::findPlug(transformFn, "metaParent") );
                 MyCheckStatusReturn(status, "connect failed");
-                dgMod.doIt();
+                lrutils::doIt(dgMod);
             }
         }
     }
@@ -377,6 +385,7 @@ MStatus Rig::updateGeoNodes() {
 }
 
 MStatus Rig::updateNodeNames() {
+    RigProfileScope profileScope("Rig::updateNodeNames", RigProfiler::kRigCategory);
     MStatus status = MS::kFailure;
 
     MString xmlName = this->m_name;
@@ -437,16 +446,69 @@ MStatus Rig::updateNodeNames() {
     return status;
 }
 
+void Rig::planComponents(const std::vector<ComponentPtr> & comps) {
+    if(this->m_planned)
+        return;
+    RigProfileScope profileScope("Rig::planComponents", RigProfiler::kRigCategory);
+    std::vector<ComponentPlan::Input> inputs;
+    this->getPlanInputs(comps, inputs);
+    std::vector<ComponentPlanPtr> plans;
+    lrutils::computePlans(inputs, plans, WorkerPool::getShared());
+    for(unsigned int i = 0; i < comps.size(); i++) {
+        comps[i]->setBuildPlan(plans[i]);
+    }
+    this->m_planned = true;
+}
+
+void Rig::computeBuildPlans() {
+    std::vector<ComponentPtr> comps;
+    if(this->m_pRootComponent)
+        this->recursiveGetComponents(this->m_pRootComponent, comps);
+    std::vector<ComponentPlan::Input> inputs;
+    this->getPlanInputs(comps, inputs);
+    for(unsigned int i = 0; i < comps.size(); i++) {
+        ComponentPlanPtr plan( new ComponentPlan() );
+        plan->compute(inputs[i]);
+        comps[i]->setBuildPlan(plan);
+    }
+    this->m_planned = true;
+}
+
+void Rig::getPlanInputs(const std::vector<ComponentPtr> & comps, std::vector<ComponentPlan::Input> & inputs) {
+    //the guides are only read here, the workers get copies
+    inputs.resize(comps.size());
+    for(unsigned int i = 0; i < comps.size(); i++) {
+        comps[i]->getPlanInput(inputs[i]);
+    }
+}
+
+void Rig::storeBuildReport() {
+    MStringArray report;
+    report.append("scene ops for "+this->m_name+": "+SceneOpList::getSessionReport().toString());
+    report.append(HierarchyPlan::getSessionReport().toString());
+    report.append(lrutils::getControllerSessionReport());
+    report.append(lrutils::getDisplayLayerReport());
+    RigProfiler::setBuildReport(report);
+}
+
+void Rig::recursiveGetComponents(ComponentPtr comp, std::vector<ComponentPtr> & comps) {
+    comps.push_back(comp);
+    for(unsigned int i = 0; i < comp->getNumChildComps(); i++) {
+        ComponentPtr childComp = comp->getChildComp(i);
+        if( childComp ) {
+            this->recursiveGetComponents(childComp, comps);
+        }
+    }
+}
+
 MObject Rig::recursiveLoadComponents(ComponentPtr comp, MDGModifier & dgMod) {
     MStatus status = MS::kFailure;
 
     MObject metaNodeObj = comp->loadComponent(dgMod);
-    MFnDependencyNode metaNodeFn( metaNodeObj );
     for(unsigned int i = 0; i < comp->getNumChildComps(); i++) {
         ComponentPtr childComp = comp->getChildComp(i);
         MObject childMetaNodeObj = this->recursiveLoadComponents(childComp, dgMod);
-        MFnDependencyNode childMetaNodeFn( childMetaNodeObj );
-        status = dgMod.connect( metaNodeFn.findPlug("metaChildren"), childMetaNodeFn.findPlug("metaParent") );
+        status = dgMod.connect( MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(childMetaNodeObj, MetaDataNode::kMetaParent) );
         MyCheckStatus(status, "connect failed");
     }
 
@@ -478,27 +540,45 @@ void Rig::recursiveUpdateComponents(MObject metaNodeObj, ComponentPtr comp, MDGM
 }
 
 void Rig::recursiveGetComponentIds(ComponentPtr comp) {
+    //parents are added ahead of their children, new components are loaded in the order they were added
+    //so a new child finds the metadata node of a new parent
+    ComponentGuidePtr guide = comp->getCompGuide();
+    MString id = guide->getRigId();
+    this->m_pRigIdManager->addId(id, comp, MObject::kNullObj);
     for(unsigned int i = 0; i < comp->getNumChildComps(); i++) {
         ComponentPtr childComp = comp->getChildComp(i);
         if( childComp ) {
             this->recursiveGetComponentIds(childComp);
         }
     }
-    ComponentGuidePtr guide = comp->getCompGuide();
-    MString id = guide->getRigId();
-    this->m_pRigIdManager->addId(id, comp, MObject::kNullObj);    
 }
 
 void Rig::recursiveGetMetaDataIds(MObject metaNodeObj) {
     MStatus status = MS::kFailure;
+    //every node is visited before any component is updated, so nodes from older scenes are
+    //migrated to the indexed joint and controller attributes before anything reads them
+    status = lrutils::migrateMetaDataArrays(metaNodeObj);
+    MyCheckStatus(status, "lrutils::migrateMetaDataArrays() failed");
+
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    MObjectArray metaChildObjs;
+    if(snapshot != NULL && snapshot->getMetaChildren(metaNodeObj, metaChildObjs)) {
+        for(unsigned int i = 0; i < metaChildObjs.length(); i++) {
+            this->recursiveGetMetaDataIds(metaChildObjs[i]);
+        }
+        MString metaId;
+        snapshot->getRigId(metaNodeObj, metaId);
+        this->m_pRigIdManager->addId(metaId, ComponentPtr(), metaNodeObj );
+        return;
+    }
 
     MFnDependencyNode metaNodeFn( metaNodeObj );
-    MPlug metaChildrenPlug = metaNodeFn.findPlug( "metaChildren", true, &status );
+    MPlug metaChildrenPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren, &status);
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
 
     //follow the plug connection to the connected plug on the other object
     MPlugArray connectedChildPlugs;
-    metaChildrenPlug.connectedTo(connectedChildPlugs,false,true,&status);
+    lrutils::connectedTo(metaChildrenPlug, connectedChildPlugs,false,true,&status);
     MyCheckStatus(status,"MPlug.connectedTo() failed");
 
     for (unsigned int i = 0; i < connectedChildPlugs.length(); i++) {
@@ -510,7 +590,7 @@ void Rig::recursiveGetMetaDataIds(MObject metaNodeObj) {
     }
     //get the rigId number held in the rigId attribute
     MString metaNodeName = metaNodeFn.name();
-    MPlug rigIdPlug = metaNodeFn.findPlug(MString("rigId"),true,&status);
+    MPlug rigIdPlug = MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kRigId, &status);
     MyCheckStatus(status,"findPlug failed");
     MString metaId;
     rigIdPlug.getValue(metaId);
@@ -518,35 +598,25 @@ void Rig::recursiveGetMetaDataIds(MObject metaNodeObj) {
 }
 
 MStatus Rig::remove(MDGModifier &dgMod) {
+    RigProfileScope profileScope("Rig::remove", RigProfiler::kRigCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_name);
     MStatus status = MS::kFailure;
     if(this->m_metaRootNodeObj.isNull())
         MyCheckStatusReturn(status, "Rig->m_metaRootNodeObj has not been set to a valid MObject.");
+    MetaNetworkScope networkScope(this->m_metaRootNodeObj);
 
     //remove the components of the rig
     MObject metaRootCompObj;
-    lrutils::getMetaChildByName(this->m_metaRootNodeObj, this->m_pRootComponent->getCompGuide()->getName(), metaRootCompObj);
+    lrutils::getMetaChildByName(this->m_metaRootNodeObj, this->m_name, this->m_pRootComponent->getCompGuide()->getName(), metaRootCompObj);
     this->recursiveRemoveComponents(metaRootCompObj, this->m_pRootComponent, dgMod);
 
     //remove the geometry nodes
     this->removeGeoNodes();
 
-    //delete the top level rig nodes
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_noTransformGroupObj, "noTransformGroup" );
-    MGlobal::deleteNode( this->m_noTransformGroupObj );
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlGroupObj, "ctlGroup" );
-    MGlobal::deleteNode( this->m_ctlGroupObj );
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_rigGroupObj, "rigGroup" );
-    MGlobal::deleteNode( this->m_rigGroupObj );
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_topGroupObj, "topGroup" );
-    MGlobal::deleteNode( this->m_topGroupObj );
-
-    //delete the display layers for the rig
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_ctlLayerObj, "ctlLayer" );
-    MGlobal::deleteNode( this->m_ctlLayerObj );
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_skelLayerObj, "skelLayer" );
-    MGlobal::deleteNode( this->m_skelLayerObj );
-    lrutils::getMetaNodeConnection(this->m_metaRootNodeObj, this->m_extrasLayerObj, "extrasLayer" );
-    MGlobal::deleteNode( this->m_extrasLayerObj );
+    //delete the top level rig nodes and the display layers for the rig
+    MayaSceneBackend scene;
+    MStatus scaffoldStatus = lrutils::removeRigScaffold(scene, scene.addExisting(this->m_metaRootNodeObj)) ? MS::kSuccess : MS::kFailure;
+    MyCheckStatus(scaffoldStatus, "lrutils::removeRigScaffold() failed");
 
     return status;
 }
@@ -556,10 +626,10 @@ MStatus Rig::removeGeoNodes() {
 
     MFnDependencyNode metaRootNodeFn( this->m_metaRootNodeObj );
 
-    MPlug geometryPlug = metaRootNodeFn.findPlug( "geometry", true, &status );
+    MPlug geometryPlug = lrutils::findPlug(metaRootNodeFn, MetaRootNode::geometry, true, &status );
     MyCheckStatusReturn(status,"findPlug geometry failed");
     MPlugArray geometryPlugs;
-    geometryPlug.connectedTo(geometryPlugs,false,true,&status);
+    lrutils::connectedTo(geometryPlug, geometryPlugs,false,true,&status);
     MyCheckStatusReturn(status, "MPlug.connectedTo failed");
     for(unsigned int j = 0; j < geometryPlugs.length(); j++) {
         MObject geoObj = geometryPlugs[j].node(&status);
@@ -578,7 +648,7 @@ MStatus Rig::removeGeoNodes() {
             stringstream tmp;
             tmp << "file -removeReference -referenceNode \"" << sNamespace.c_str() << "\";";
             MString referenceCommand = MString(tmp.str().c_str());
-            MGlobal::executeCommand(referenceCommand);
+            lrutils::executeCommand(referenceCommand);
         }
     }
 
@@ -590,7 +660,7 @@ void Rig::recursiveRemoveComponents(MObject metaNodeObj, ComponentPtr comp, MDGM
         ComponentPtr childComp = comp->getChildComp(i);
         MString childCompName = (childComp->getCompGuide())->getName();
         MObject metaChildNodeObj;
-        lrutils::getMetaChildByName(metaNodeObj, childCompName, metaChildNodeObj);
+        lrutils::getMetaChildByName(metaNodeObj, this->m_name, childCompName, metaChildNodeObj);
         this->recursiveRemoveComponents(metaChildNodeObj, childComp, dgMod);
     }
     comp->setMetaDataNode(metaNodeObj);
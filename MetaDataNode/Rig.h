@@ -19,7 +19,6 @@
 #include "SpineComponent.h"
 
 typedef boost::shared_ptr<RigIdManager> RigIdManagerPtr;
-typedef boost::shared_ptr<XmlGuide> XmlGuidePtr;
 typedef boost::shared_ptr<ComponentGuide> ComponentGuidePtr;
 typedef boost::shared_ptr<Component> ComponentPtr;
 typedef boost::shared_ptr<GlobalComponent> GlobalComponentPtr;
@@ -28,6 +27,10 @@ class Rig
 {
 public:
     Rig(MString xmlPath = "", MObject metaRootNodeObj = MObject());
+    //creates the components of an xml guide that was already parsed. Doesn't call into Maya, so the rig
+    //can be set up and planned off the main thread and handed its metaRoot node later. Problems are kept
+    //for getErrors() instead of being displayed
+    Rig(XmlGuidePtr xmlGuide);
     ~Rig();
     MStatus load(MDGModifier & dgMod); //loads the rig into the scene based upon the guide information
     MStatus update(bool forceUpdate = false, bool globalPos = false); //updates a rig already loaded into the scene based upon its guide information
@@ -36,6 +39,13 @@ public:
     MStatus updateNodeNames(); //update the names of all the nodes attached to the metadata network of this rig
     MStatus remove(MDGModifier & dgMod); //removes the rig from the scene
     MString getName() {return m_name;};
+    //problems found while creating the components, one per line, empty if there were none
+    MString getErrors() {return m_errors;};
+    //finds the group and display layer nodes of the rig connected to its metaRoot node
+    void setMetaRootNode(MObject metaRootNodeObj);
+    //computes the build plans of all the components on the calling thread, which may be a worker thread.
+    //A rig planned up front isn't planned again when it is loaded or updated
+    void computeBuildPlans();
     ComponentPtr createComponent(ComponentGuidePtr guide, ComponentPtr parentComp);
     ComponentPtr recursiveComponentCreate(ComponentGuidePtr guide, ComponentPtr parentComp); //recursively creates components based upon guide and child guide objects
     MObject recursiveLoadComponents(ComponentPtr comp, MDGModifier & dgMod); //load every rig component into the scene
@@ -47,6 +57,13 @@ public:
 private:
     void readXml(MString xmlPath);
     void createComponentsFromXML();
+    //computes the build plans of the given components on the shared worker pool before any of them is built
+    void planComponents(const std::vector<ComponentPtr> & comps);
+    void recursiveGetComponents(ComponentPtr comp, std::vector<ComponentPtr> & comps);
+    //hands the optimizer and batching reports of this load or update to the profiler
+    void storeBuildReport();
+    //copies the plan inputs of the components out of their guides
+    void getPlanInputs(const std::vector<ComponentPtr> & comps, std::vector<ComponentPlan::Input> & inputs);
     XmlGuidePtr m_pXmlGuide; //contains information loaded from xml file
     MObject m_metaRootNodeObj; //the corresponding meta root node for this rig in the DG
     //group nodes
@@ -59,8 +76,11 @@ private:
     MObject m_ctlLayerObj;
     MObject m_extrasLayerObj;
     MString m_name;
+    MString m_errors; //problems found while creating the components
     ComponentPtr m_pRootComponent; //the root component of the rig, usually the global component
     RigIdManagerPtr m_pRigIdManager;
+    GuideTransformsPtr m_pGuideTransforms; //world and local matrices of every guide location, computed once per rig
+    bool m_planned; //the components' build plans have been computed
 
 };
 
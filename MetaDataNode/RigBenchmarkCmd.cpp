@@ -0,0 +1,589 @@
+/************************************************************
+* Summary: Builds, updates and removes synthetic rigs and   *
+*          writes how long each phase took as JSON, checked *
+*          against regression thresholds.                   *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#include <maya/MGlobal.h>
+#include "RigBenchmarkCmd.h"
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include <maya/MDGModifier.h>
+#include <maya/MTimer.h>
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "LoadRigUtils.h"
+#include "NodeNameIndex.h"
+#include "Rig.h"
+#include "MDSpineNode.h"
+#include "RigIdManager.h"
+#include "GlobalComponent.h"
+#include "ComponentPlan.h"
+#include "WorkerPool.h"
+#include <maya/MObjectArray.h>
+#include <maya/MIntArray.h>
+#include <maya/MPlugArray.h>
+#include <sstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace {
+    const double kBenchmarkVersion = 1.0;
+    //size of the rig the ids are classified for and the number of times they are
+    const unsigned int kIdComponents = 2000;
+    const unsigned int kIdSamples = 10;
+    //size of the crowd rig that is planned, the thread counts and the number of times it is planned on each
+    const unsigned int kPlanComponents = 200;
+    const unsigned int kPlanThreads[] = {1, 2, 4, 8};
+    const unsigned int kPlanSamples = 10;
+
+    MString getRigName(unsigned int rigNum) {
+        std::stringstream name; name << "benchRig" << rigNum;
+        return MString(name.str().c_str());
+    }
+
+    //the MDSpine nodes below a metadata node
+    void getSpineNodes(MObject metaNodeObj, MObjectArray & spineObjs) {
+        MFnDependencyNode metaNodeFn( metaNodeObj );
+        if(metaNodeFn.typeId() == MDSpineNode::id)
+            spineObjs.append(metaNodeObj);
+        MPlugArray connectedChildPlugs;
+        lrutils::connectedTo(MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren), connectedChildPlugs, false, true);
+        for(unsigned int i = 0; i < connectedChildPlugs.length(); i++) {
+            getSpineNodes(connectedChildPlugs[i].node(), spineObjs);
+        }
+    }
+
+    //moves the connections of a spine's indexed bind joint and FK controller arrays back onto the single
+    //message attributes older MDSpine nodes kept them in, in index order. lrutils::migrateMetaDataArrays
+    //moves them back
+    MStatus demoteChains(MObject spineObj) {
+        MStatus status;
+        const MObject legacyAttrs[] = { MDSpineNode::BindJoints, MDSpineNode::FKControllers };
+        const MObject arrayAttrs[] = { MDSpineNode::BindJointArray, MDSpineNode::FKControllerArray };
+        MDGModifier dgMod;
+        for(unsigned int i = 0; i < 2; i++) {
+            MPlug legacyPlug(spineObj, legacyAttrs[i]);
+            MPlug arrayPlug(spineObj, arrayAttrs[i]);
+            MIntArray indices;
+            arrayPlug.getExistingArrayAttributeIndices(indices, &status);
+            MyCheckStatusReturn(status, "MPlug.getExistingArrayAttributeIndices() failed");
+            for(unsigned int j = 0; j < indices.length(); j++) {
+                MPlug elementPlug = arrayPlug.elementByLogicalIndex(indices[j]);
+                MPlugArray connectedPlugs;
+                lrutils::connectedTo(elementPlug, connectedPlugs, false, true);
+                if(connectedPlugs.length() == 0)
+                    continue;
+                status = dgMod.disconnect(elementPlug, connectedPlugs[0]);
+                MyCheckStatusReturn(status, "MDGModifier.disconnect() failed");
+                status = dgMod.connect(legacyPlug, connectedPlugs[0]);
+                MyCheckStatusReturn(status, "MDGModifier.connect() failed");
+            }
+        }
+        return lrutils::doIt(dgMod);
+    }
+
+    //the lookup getJointByNum and getFKControlByNum made before the chains were indexed. The whole
+    //chain hangs off one message attribute, and connectedTo lists its first two objects in reverse
+    MObject getLegacyChainObj(MObject spineObj, const MObject & legacyAttr, unsigned int num) {
+        MPlugArray connectedPlugs;
+        lrutils::connectedTo(MPlug(spineObj, legacyAttr), connectedPlugs, false, true);
+        if(connectedPlugs.length() > 1 && num < 2)
+            num = 1 - num;
+        if(num >= connectedPlugs.length())
+            return MObject::kNullObj;
+        return connectedPlugs[num].node();
+    }
+
+    //the classification the RigIdManager made with a std::map, walking it for each kind of work.
+    //Returns the number of entries that would be loaded, updated and removed
+    unsigned int classifyIdsWithMap(const MStringArray & ids, const std::vector<ComponentPtr> & comps, const MObjectArray & metaNodeObjs) {
+        typedef std::pair<ComponentPtr, MObject> CompNodes;
+        typedef std::map<std::string, boost::shared_ptr<CompNodes> > IdMap;
+        IdMap idMap;
+        for(unsigned int i = 0; i < ids.length(); i++) {
+            boost::shared_ptr<CompNodes> & cp = idMap[std::string(ids[i].asChar())];
+            if(!cp)
+                cp.reset( new CompNodes() );
+            if(!cp->first && comps[i])
+                cp->first = comps[i];
+            if(cp->second.isNull() && !metaNodeObjs[i].isNull())
+                cp->second = metaNodeObjs[i];
+        }
+
+        unsigned int numWork = 0;
+        for(unsigned int pass = 0; pass < 4; pass++) {
+            for(IdMap::iterator itr = idMap.begin(); itr != idMap.end(); itr++) {
+                ComponentPtr comp = itr->second->first;
+                MObject metaNodeObj = itr->second->second;
+                MFnDependencyNode metaNodeFn(metaNodeObj);
+                if(pass == 1 && metaNodeObj.isNull() && comp)
+                    numWork++;
+                else if(pass == 2 && !metaNodeObj.isNull() && comp)
+                    numWork++;
+                else if(pass == 3 && !metaNodeObj.isNull() && !comp)
+                    numWork++;
+            }
+        }
+        return numWork;
+    }
+}
+
+MStatus RigBenchmarkCmd::doIt ( const MArgList &args )
+{
+    MStatus status;
+
+    status = parseArgs(args);
+
+    if(MS::kSuccess != status )
+        return status;
+
+    BenchmarkReport report("rigBenchmark");
+    report.setConfig("rigs", this->m_numRigs);
+    report.setConfig("components", this->m_spec.numComponents);
+    report.setConfig("joints", this->m_spec.numJoints);
+    report.setConfig("fkWeight", this->m_spec.fkWeight);
+    report.setConfig("splineIKWeight", this->m_spec.splineIKWeight);
+    report.setConfig("stretchySplineIKWeight", this->m_spec.stretchySplineIKWeight);
+    if(this->m_thresholdsPath.length() > 0) {
+        if(!report.readThresholds(this->m_thresholdsPath.asChar()))
+            MGlobal::displayWarning("could not read the benchmark thresholds file: "+this->m_thresholdsPath);
+    }
+
+    //each update differs from the guide before it by exactly one kind of change
+    unsigned int renamed = lrutils::kSyntheticRenamed;
+    unsigned int moved = renamed | lrutils::kSyntheticMoved;
+    unsigned int resized = moved | lrutils::kSyntheticResized;
+
+    status = this->loadRigs(report);
+    MyCheckStatusReturn(status, "loading the benchmark rigs failed");
+    this->lookupNames(report);
+    status = this->accessChains(report);
+    MyCheckStatusReturn(status, "chain access of the benchmark rigs failed");
+    status = this->classifyIds(report);
+    MyCheckStatusReturn(status, "id classification failed");
+    status = this->planComponents(report);
+    MyCheckStatusReturn(status, "component planning failed");
+    status = this->updateRigs(report, "update_noop", lrutils::kSyntheticBase);
+    MyCheckStatusReturn(status, "no-op update of the benchmark rigs failed");
+    status = this->updateRigs(report, "update_rename", renamed);
+    MyCheckStatusReturn(status, "rename update of the benchmark rigs failed");
+    status = this->updateRigs(report, "update_location", moved);
+    MyCheckStatusReturn(status, "location update of the benchmark rigs failed");
+    status = this->updateRigs(report, "update_jointCount", resized);
+    MyCheckStatusReturn(status, "joint count update of the benchmark rigs failed");
+    //the updates rename and rebuild nodes, which is what the index's callbacks have to keep up with
+    MStringArray indexProblems = NodeNameIndex::check();
+    report.setConfig("nameIndexProblems", indexProblems.length());
+    for(unsigned int i = 0; i < indexProblems.length(); i++) {
+        MGlobal::displayWarning("[MetaDataRigging] node name index: "+indexProblems[i]);
+    }
+    status = this->removeRigs(report, resized);
+    MyCheckStatusReturn(status, "removing the benchmark rigs failed");
+
+    //the synthetic guides are only needed while the rigs exist
+    unsigned int changes[] = { lrutils::kSyntheticBase, renamed, moved, resized };
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        for(unsigned int j = 0; j < sizeof(changes) / sizeof(changes[0]); j++) {
+            ::remove( this->getXmlPath(i, changes[j]).asChar() );
+        }
+    }
+
+    if(!report.writeJson(this->m_outputPath.asChar())) {
+        status = MS::kFailure;
+        MyCheckStatusReturn(status, "could not write the benchmark results: "+this->m_outputPath);
+    }
+
+    const std::vector<BenchmarkReport::Phase> & phases = report.getPhases();
+    for(unsigned int i = 0; i < phases.size(); i++) {
+        std::stringstream msg;
+        msg << "[MetaDataRigging] benchmark " << phases[i].name << ": mean " << phases[i].mean() << "s over " << phases[i].count << " samples";
+        if(phases[i].passed()) {
+            MGlobal::displayInfo(msg.str().c_str());
+        } else {
+            msg << ", threshold " << phases[i].threshold << "s exceeded";
+            MGlobal::displayWarning(msg.str().c_str());
+        }
+    }
+    MGlobal::displayInfo("[MetaDataRigging] benchmark results written to "+this->m_outputPath);
+    setResult(report.passed() && indexProblems.length() == 0);
+
+    return status;
+}
+
+MString RigBenchmarkCmd::getXmlPath(unsigned int rigNum, unsigned int changes) {
+    std::stringstream path;
+    path << this->m_dir.asChar() << getRigName(rigNum).asChar() << "_" << changes << ".xml";
+    return MString(path.str().c_str());
+}
+
+MStatus RigBenchmarkCmd::loadRigs(BenchmarkReport & report) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        MString xmlPath = this->getXmlPath(i, lrutils::kSyntheticBase);
+        if(!lrutils::writeSyntheticRigXml(xmlPath.asChar(), getRigName(i).asChar(), kBenchmarkVersion, this->m_spec)) {
+            status = MS::kFailure;
+            MyCheckStatusReturn(status, "could not write the synthetic rig guide: "+xmlPath);
+        }
+
+        timer.beginTimer();
+        Rig* aRig = new Rig(xmlPath);
+        timer.endTimer();
+        report.addSample("parse_load", timer.elapsedTime());
+
+        MDGModifier dgMod;
+        timer.beginTimer();
+        status = aRig->load(dgMod);
+        lrutils::doIt(dgMod);
+        timer.endTimer();
+        report.addSample("load", timer.elapsedTime());
+        delete aRig;
+        MyCheckStatusReturn(status, "Rig::load() failed for "+getRigName(i));
+    }
+
+    return status;
+}
+
+void RigBenchmarkCmd::lookupNames(BenchmarkReport & report) {
+    MTimer timer;
+    //every node the rigs were built with or looked up while building
+    MStringArray names = NodeNameIndex::getNames();
+    MObject obj;
+
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        timer.beginTimer();
+        for(unsigned int j = 0; j < names.length(); j++) {
+            NodeNameIndex::resolve(names[j], obj);
+        }
+        timer.endTimer();
+        report.addSample("lookup_selectionList", timer.elapsedTime());
+
+        timer.beginTimer();
+        for(unsigned int j = 0; j < names.length(); j++) {
+            NodeNameIndex::getObj(names[j], obj);
+        }
+        timer.endTimer();
+        report.addSample("lookup_index", timer.elapsedTime());
+    }
+}
+
+MStatus RigBenchmarkCmd::accessChains(BenchmarkReport & report) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        MObject metaRootObj;
+        status = lrutils::getMetaRootByName(metaRootObj, getRigName(i));
+        MyCheckStatusReturn(status, "lrutils::getMetaRootByName() failed for "+getRigName(i));
+        MObjectArray spineObjs;
+        getSpineNodes(metaRootObj, spineObjs);
+
+        timer.beginTimer();
+        for(unsigned int j = 0; j < spineObjs.length(); j++) {
+            for(unsigned int num = 0; num < this->m_spec.numJoints; num++) {
+                MObject obj;
+                lrutils::getJointByNum(spineObjs[j], num, obj);
+                lrutils::getFKControlByNum(spineObjs[j], num, obj);
+            }
+        }
+        timer.endTimer();
+        report.addSample("chain_indexed", timer.elapsedTime());
+
+        //the same chains on the single message attributes, where every access reads the whole chain
+        for(unsigned int j = 0; j < spineObjs.length(); j++) {
+            status = demoteChains(spineObjs[j]);
+            MyCheckStatusReturn(status, "demoteChains() failed");
+        }
+        timer.beginTimer();
+        for(unsigned int j = 0; j < spineObjs.length(); j++) {
+            for(unsigned int num = 0; num < this->m_spec.numJoints; num++) {
+                getLegacyChainObj(spineObjs[j], MDSpineNode::BindJoints, num);
+                getLegacyChainObj(spineObjs[j], MDSpineNode::FKControllers, num);
+            }
+        }
+        timer.endTimer();
+        report.addSample("chain_scan", timer.elapsedTime());
+        for(unsigned int j = 0; j < spineObjs.length(); j++) {
+            status = lrutils::migrateMetaDataArrays(spineObjs[j]);
+            MyCheckStatusReturn(status, "lrutils::migrateMetaDataArrays() failed");
+        }
+    }
+
+    return status;
+}
+
+MStatus RigBenchmarkCmd::classifyIds(BenchmarkReport & report) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+    report.setConfig("idComponents", kIdComponents);
+
+    //any metadata node will do, the components are never loaded or updated
+    MObject metaNodeObj;
+    status = lrutils::getMetaRootByName(metaNodeObj, getRigName(0));
+    MyCheckStatusReturn(status, "lrutils::getMetaRootByName() failed for "+getRigName(0));
+
+    //the ids as Rig::update adds them, every component first and then every metadata node. One in six
+    //components is new and one in six metadata nodes belongs to a removed component
+    MStringArray ids;
+    std::vector<ComponentPtr> comps;
+    MObjectArray metaNodeObjs;
+    for(unsigned int i = 0; i < kIdComponents; i++) {
+        if(i % 6 == 1)
+            continue;
+        ids.append(MString() + (int)(i + 1));
+        comps.push_back(ComponentPtr( new GlobalComponent() ));
+        metaNodeObjs.append(MObject::kNullObj);
+    }
+    for(unsigned int i = 0; i < kIdComponents; i++) {
+        if(i % 6 == 0)
+            continue;
+        ids.append(MString() + (int)(i + 1));
+        comps.push_back(ComponentPtr());
+        metaNodeObjs.append(metaNodeObj);
+    }
+
+    unsigned int numWork = 0;
+    for(unsigned int i = 0; i < kIdSamples; i++) {
+        timer.beginTimer();
+        RigIdManager idManager;
+        for(unsigned int j = 0; j < ids.length(); j++) {
+            idManager.addId(ids[j], comps[j], metaNodeObjs[j]);
+        }
+        RigIdManager::WorkLists lists;
+        idManager.classify(lists);
+        timer.endTimer();
+        report.addSample("ids_flat", timer.elapsedTime());
+        numWork = (unsigned int)(lists.loads.size() + lists.updates.size() + lists.removes.size());
+
+        timer.beginTimer();
+        unsigned int numMapWork = classifyIdsWithMap(ids, comps, metaNodeObjs);
+        timer.endTimer();
+        report.addSample("ids_map", timer.elapsedTime());
+        if(numMapWork != numWork) {
+            status = MS::kFailure;
+            MyCheckStatusReturn(status, "the RigIdManager and the map classified the ids differently");
+        }
+    }
+
+    return status;
+}
+
+MStatus RigBenchmarkCmd::planComponents(BenchmarkReport & report) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+    report.setConfig("planComponents", kPlanComponents);
+
+    //a crowd of spines standing in a grid, each bending a little differently
+    std::vector<ComponentPlan::Input> inputs(kPlanComponents);
+    for(unsigned int i = 0; i < kPlanComponents; i++) {
+        ComponentPlan::Input & input = inputs[i];
+        std::stringstream name; name << "crowd" << i;
+        input.name = name.str();
+        MVector base((i % 20) * 10.0, 0.0, (i / 20) * 10.0);
+        for(unsigned int j = 0; j < this->m_spec.numJoints; j++) {
+            input.translations.push_back(base + MVector(0.1 * (i % 7) * j, 2.0 * j, 0.05 * (i % 5) * j * j));
+            input.rotations.push_back(MVector(0.0, 3.0 * j, 1.5 * (i % 3)));
+        }
+        input.parentWorldMatrix = GuideTransforms::getLocationMatrix(base, MVector(0.0, 0.0, 0.0));
+        input.chainPrefixes.push_back(input.name + "_FK_BIND");
+        input.chainPrefixes.push_back(input.name + "_FK");
+    }
+
+    std::vector<ComponentPlanPtr> singlePlans;
+    double singleTime = 0.0;
+    unsigned int numThreadCounts = sizeof(kPlanThreads) / sizeof(kPlanThreads[0]);
+    for(unsigned int t = 0; t < numThreadCounts; t++) {
+        WorkerPool pool(kPlanThreads[t]);
+        std::stringstream phase; phase << "plan_threads" << kPlanThreads[t];
+        double bestTime = -1.0;
+        std::vector<ComponentPlanPtr> plans;
+        for(unsigned int i = 0; i < kPlanSamples; i++) {
+            timer.beginTimer();
+            lrutils::computePlans(inputs, plans, pool);
+            timer.endTimer();
+            report.addSample(phase.str(), timer.elapsedTime());
+            if(bestTime < 0.0 || timer.elapsedTime() < bestTime)
+                bestTime = timer.elapsedTime();
+        }
+        if(t == 0) {
+            singlePlans = plans;
+            singleTime = bestTime;
+        }
+        //the plans don't depend on which thread computed them
+        for(unsigned int i = 0; i < kPlanComponents; i++) {
+            if(plans[i]->getWorldMatrices() != singlePlans[i]->getWorldMatrices() ||
+               plans[i]->getJointOrients() != singlePlans[i]->getJointOrients()) {
+                status = MS::kFailure;
+                MyCheckStatusReturn(status, "the plans of "+MString(phase.str().c_str())+" differ from a single thread's");
+            }
+        }
+        std::stringstream speedupKey; speedupKey << "planSpeedup_threads" << pool.getNumThreads();
+        report.setConfig(speedupKey.str(), bestTime > 0.0 ? singleTime / bestTime : 0.0);
+        std::stringstream stealsKey; stealsKey << "planSteals_threads" << pool.getNumThreads();
+        report.setConfig(stealsKey.str(), (double)pool.getNumSteals());
+    }
+    report.setConfig("hardwareThreads", WorkerPool::getHardwareThreads());
+
+    return status;
+}
+
+MStatus RigBenchmarkCmd::updateRigs(BenchmarkReport & report, const std::string & phase, unsigned int changes) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        MString xmlPath = this->getXmlPath(i, changes);
+        if(changes != lrutils::kSyntheticBase && !lrutils::writeSyntheticRigXml(xmlPath.asChar(), getRigName(i).asChar(), kBenchmarkVersion, this->m_spec, changes)) {
+            status = MS::kFailure;
+            MyCheckStatusReturn(status, "could not write the synthetic rig guide: "+xmlPath);
+        }
+        MObject rootNodeObj;
+        status = lrutils::getObjFromName("MRN_"+getRigName(i), rootNodeObj);
+        MyCheckStatusReturn(status, "could not find the metaRoot of "+getRigName(i));
+
+        timer.beginTimer();
+        Rig* aRig = new Rig(xmlPath, rootNodeObj);
+        timer.endTimer();
+        report.addSample("parse_update", timer.elapsedTime());
+
+        timer.beginTimer();
+        status = aRig->update(true, false);
+        timer.endTimer();
+        report.addSample(phase, timer.elapsedTime());
+        delete aRig;
+        MyCheckStatusReturn(status, "Rig::update() failed for "+getRigName(i));
+    }
+
+    return status;
+}
+
+MStatus RigBenchmarkCmd::removeRigs(BenchmarkReport & report, unsigned int changes) {
+    MStatus status = MS::kSuccess;
+    MTimer timer;
+
+    for(unsigned int i = 0; i < this->m_numRigs; i++) {
+        MObject rootNodeObj;
+        status = lrutils::getObjFromName("MRN_"+getRigName(i), rootNodeObj);
+        MyCheckStatusReturn(status, "could not find the metaRoot of "+getRigName(i));
+
+        //the rig is removed through the guide it was last updated from, so the component names match
+        timer.beginTimer();
+        Rig* aRig = new Rig(this->getXmlPath(i, changes), rootNodeObj);
+        timer.endTimer();
+        report.addSample("parse_remove", timer.elapsedTime());
+
+        MDGModifier dgMod;
+        timer.beginTimer();
+        aRig->remove(dgMod);
+        status = lrutils::doIt(dgMod);
+        timer.endTimer();
+        report.addSample("remove", timer.elapsedTime());
+        delete aRig;
+        MyCheckStatusReturn(status, "Rig::remove() failed for "+getRigName(i));
+    }
+
+    return status;
+}
+
+MStatus RigBenchmarkCmd::parseArgs(const MArgList & args )
+{
+    MStatus status;
+    MArgDatabase argData(syntax(), args);
+
+    this->m_numRigs = 1;
+    if (argData.isFlagSet(RigBenchmarkCmd::RigsParam())) {
+        int tmp;
+        status = argData.getFlagArgument(RigBenchmarkCmd::RigsParam(), 0, tmp);
+        if (!status || tmp < 1) {
+            status = MS::kFailure;
+            status.perror("rigs flag parsing failed");
+            return status;
+        }
+        this->m_numRigs = (unsigned int)tmp;
+    }
+
+    if (argData.isFlagSet(RigBenchmarkCmd::ComponentsParam())) {
+        int tmp;
+        status = argData.getFlagArgument(RigBenchmarkCmd::ComponentsParam(), 0, tmp);
+        //every rig has a global and a hip component ahead of its spines
+        if (!status || tmp < 3) {
+            status = MS::kFailure;
+            status.perror("components flag parsing failed, at least 3 components are required");
+            return status;
+        }
+        this->m_spec.numComponents = (unsigned int)tmp;
+    }
+
+    if (argData.isFlagSet(RigBenchmarkCmd::JointsParam())) {
+        int tmp;
+        status = argData.getFlagArgument(RigBenchmarkCmd::JointsParam(), 0, tmp);
+        //spline IK spines drive a start, middle and end cluster
+        if (!status || tmp < 3) {
+            status = MS::kFailure;
+            status.perror("joints flag parsing failed, at least 3 joints are required");
+            return status;
+        }
+        this->m_spec.numJoints = (unsigned int)tmp;
+    }
+
+    if (argData.isFlagSet(RigBenchmarkCmd::MixParam())) {
+        MString tmp;
+        status = argData.getFlagArgument(RigBenchmarkCmd::MixParam(), 0, tmp);
+        if (!status || !lrutils::parseKinematicMix(tmp.asChar(), this->m_spec)) {
+            status = MS::kFailure;
+            status.perror("mix flag parsing failed, expected fk:splineIK:stretchySplineIK weights");
+            return status;
+        }
+    }
+
+    this->m_dir = lrutils::executeCommandStringResult(MString("internalVar -userTmpDir;"),false,false);
+    if (argData.isFlagSet(RigBenchmarkCmd::DirParam())) {
+        status = argData.getFlagArgument(RigBenchmarkCmd::DirParam(), 0, this->m_dir);
+        if (!status) {
+            status.perror("dir flag parsing failed");
+            return status;
+        }
+    }
+    if (this->m_dir.length() > 0 && this->m_dir.substring(this->m_dir.length() - 1, this->m_dir.length() - 1) != "/") {
+        this->m_dir += "/";
+    }
+
+    this->m_outputPath = this->m_dir + "rigBenchmark.json";
+    if (argData.isFlagSet(RigBenchmarkCmd::OutputParam())) {
+        status = argData.getFlagArgument(RigBenchmarkCmd::OutputParam(), 0, this->m_outputPath);
+        if (!status) {
+            status.perror("output flag parsing failed");
+            return status;
+        }
+    }
+
+    if (argData.isFlagSet(RigBenchmarkCmd::ThresholdsParam())) {
+        status = argData.getFlagArgument(RigBenchmarkCmd::ThresholdsParam(), 0, this->m_thresholdsPath);
+        if (!status) {
+            status.perror("thresholds flag parsing failed");
+            return status;
+        }
+    }
+
+    return MS::kSuccess;
+}
+
+MSyntax RigBenchmarkCmd::newSyntax()
+{
+    MSyntax syntax;
+
+    syntax.addFlag(RigBenchmarkCmd::RigsParam(), RigBenchmarkCmd::RigsParamLong(), MSyntax::kLong);
+    syntax.addFlag(RigBenchmarkCmd::ComponentsParam(), RigBenchmarkCmd::ComponentsParamLong(), MSyntax::kLong);
+    syntax.addFlag(RigBenchmarkCmd::JointsParam(), RigBenchmarkCmd::JointsParamLong(), MSyntax::kLong);
+    syntax.addFlag(RigBenchmarkCmd::MixParam(), RigBenchmarkCmd::MixParamLong(), MSyntax::kString);
+    syntax.addFlag(RigBenchmarkCmd::DirParam(), RigBenchmarkCmd::DirParamLong(), MSyntax::kString);
+    syntax.addFlag(RigBenchmarkCmd::OutputParam(), RigBenchmarkCmd::OutputParamLong(), MSyntax::kString);
+    syntax.addFlag(RigBenchmarkCmd::ThresholdsParam(), RigBenchmarkCmd::ThresholdsParamLong(), MSyntax::kString);
+
+    return syntax;
+}
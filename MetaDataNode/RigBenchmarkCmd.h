@@ -0,0 +1,76 @@
+/************************************************************
+* Summary: Builds, updates and removes synthetic rigs and   *
+*          writes how long each phase took as JSON, checked *
+*          against regression thresholds.                   *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#ifndef _RigBenchmarkCmd
+#define _RigBenchmarkCmd
+
+#include <maya/MStatus.h>
+#include <maya/MSyntax.h>
+#include <maya/MPxCommand.h>
+#include <maya/MString.h>
+#include "SyntheticRig.h"
+#include "BenchmarkReport.h"
+
+class RigBenchmarkCmd : public MPxCommand
+{
+public:
+    virtual MStatus doIt ( const MArgList& );
+    virtual MStatus parseArgs(const MArgList& );
+    //the benchmark cleans up every rig it builds, so there is nothing to undo
+    virtual bool isUndoable() const { return false; }
+
+    static void *creator() { return new RigBenchmarkCmd; }
+    static MSyntax newSyntax();
+
+    //number of rigs to build
+    static const char* RigsParam() { return "-r"; }
+    static const char* RigsParamLong() { return "-rigs"; }
+    //number of components in every rig
+    static const char* ComponentsParam() { return "-c"; }
+    static const char* ComponentsParamLong() { return "-components"; }
+    //number of joints in every spine, 100 for the chain access timings
+    static const char* JointsParam() { return "-j"; }
+    static const char* JointsParamLong() { return "-joints"; }
+    //kinematic mix of the spines as "fk:splineIK:stretchySplineIK" weights
+    static const char* MixParam() { return "-m"; }
+    static const char* MixParamLong() { return "-mix"; }
+    //directory the synthetic xml files and the results are written to
+    static const char* DirParam() { return "-d"; }
+    static const char* DirParamLong() { return "-dir"; }
+    //path of the JSON results file
+    static const char* OutputParam() { return "-o"; }
+    static const char* OutputParamLong() { return "-output"; }
+    //path of a file of "phase seconds" regression thresholds
+    static const char* ThresholdsParam() { return "-t"; }
+    static const char* ThresholdsParamLong() { return "-thresholds"; }
+
+private:
+    MString getXmlPath(unsigned int rigNum, unsigned int changes);
+    MStatus loadRigs(BenchmarkReport & report);
+    //resolves the names of the loaded rigs' nodes through a selection list and through the node name index
+    void lookupNames(BenchmarkReport & report);
+    //reads every joint and FK controller of the loaded rigs' spines by number, through the indexed
+    //attributes and by scanning all of a chain's connections for each one as the single attributes required
+    MStatus accessChains(BenchmarkReport & report);
+    //adds and classifies the ids of a rig of kIdComponents components through the RigIdManager and
+    //through a map walked once per kind of work as the RigIdManager used to
+    MStatus classifyIds(BenchmarkReport & report);
+    //computes the build plans of a crowd rig of kPlanComponents spines on worker pools of 1, 2, 4 and 8
+    //threads, checking that every pool plans the same as a single thread
+    MStatus planComponents(BenchmarkReport & report);
+    MStatus updateRigs(BenchmarkReport & report, const std::string & phase, unsigned int changes);
+    MStatus removeRigs(BenchmarkReport & report, unsigned int changes);
+
+    lrutils::SyntheticRigSpec m_spec;
+    unsigned int m_numRigs;
+    MString m_dir;
+    MString m_outputPath;
+    MString m_thresholdsPath;
+
+};
+
+#endif
@@ -8,86 +8,163 @@
 
 #include "RigIdManager.h"
 #include <string>
+#include <cstring>
 #include <maya/MGlobal.h>
 #include "GlobalComponent.h"
 #include "HipComponent.h"
 #include "LoadRigUtils.h"
+#include "MetaDataNode.h"
+#include "MDGlobalNode.h"
+#include "MDHipNode.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "MetaNetworkSnapshot.h"
+#include <maya/MPlugArray.h>
 
 typedef boost::shared_ptr<HipComponent> HipComponentPtr;
 typedef boost::shared_ptr<GlobalComponent> GlobalComponentPtr;
 
-RigIdManager::RigIdManager() {
+namespace {
+    const unsigned int kInitialSlots = 64;
+
+    //what a component of type reads from its parent component of type parentType
+    unsigned int getParentDependencies(const MString & type, const MString & parentType) {
+        unsigned int dependencies = UpdateSchedule::kParentJoint | UpdateSchedule::kParentController;
+        if(type == "spine") {
+            if(parentType == "hip")
+                dependencies |= UpdateSchedule::kHipJointCopy;
+            else if(parentType == "spine")
+                dependencies |= UpdateSchedule::kShoulderControl;
+        }
+        return dependencies;
+    }
 
+    //the rigIds of a metadata node's metaChildren
+    void getMetaChildIds(MObject metaNodeObj, MStringArray & childIds) {
+        MObjectArray metaChildObjs;
+        MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+        if(snapshot == NULL || !snapshot->getMetaChildren(metaNodeObj, metaChildObjs)) {
+            MPlugArray connectedChildPlugs;
+            lrutils::connectedTo(MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaChildren), connectedChildPlugs, false, true);
+            for(unsigned int i = 0; i < connectedChildPlugs.length(); i++) {
+                metaChildObjs.append(connectedChildPlugs[i].node());
+            }
+        }
+        for(unsigned int i = 0; i < metaChildObjs.length(); i++) {
+            MString childId;
+            if(snapshot == NULL || !snapshot->getRigId(metaChildObjs[i], childId))
+                MetaDataNode::getCommonPlug(metaChildObjs[i], MetaDataNode::kRigId).getValue(childId);
+            childIds.append(childId);
+        }
+    }
+}
+
+RigIdManager::RigIdManager() {
+    this->m_slots.assign(kInitialSlots, -1);
 }
 
 RigIdManager::~RigIdManager() {
-    this->m_IdDictionary.clear();
+    this->m_entries.clear();
+    this->m_slots.clear();
+}
+
+unsigned int RigIdManager::hashId(const char * id) {
+    //FNV-1a
+    unsigned int hash = 2166136261u;
+    for(const char * c = id; *c != '\0'; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-void RigIdManager::addId( MString id, ComponentPtr pComp, MObject metaNodeObj ) {
-    std::string idString (id.asChar());
-    CompNodesPtr cp;
-    //if id already exists, grab its existing content
-    if (checkIdExists(id) ) {
-        cp = this->getCompNodes(id);
+unsigned int RigIdManager::findSlot(const char * id, unsigned int hash) const {
+    unsigned int mask = (unsigned int)this->m_slots.size() - 1;
+    unsigned int slot = hash & mask;
+    //linear probing, the table always has empty slots
+    while(this->m_slots[slot] != -1) {
+        const Entry & entry = this->m_entries[this->m_slots[slot]];
+        if(entry.hash == hash && strcmp(entry.id.c_str(), id) == 0)
+            break;
+        slot = (slot + 1) & mask;
     }
-    //if it doesn't, make a new set of nodes
-    else {
-        cp.reset( new CompNodes() );
+    return slot;
+}
+
+int RigIdManager::findId(const char * id) const {
+    return this->m_slots[this->findSlot(id, hashId(id))];
+}
+
+void RigIdManager::grow() {
+    this->m_slots.assign(this->m_slots.size() * 2, -1);
+    unsigned int mask = (unsigned int)this->m_slots.size() - 1;
+    for(unsigned int i = 0; i < this->m_entries.size(); i++) {
+        unsigned int slot = this->m_entries[i].hash & mask;
+        while(this->m_slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+        this->m_slots[slot] = (int)i;
     }
+}
+
+unsigned int RigIdManager::addId( MString id, ComponentPtr pComp, MObject metaNodeObj ) {
+    const char * idChars = id.asChar();
+    unsigned int hash = hashId(idChars);
+    unsigned int slot = this->findSlot(idChars, hash);
+    //if id doesn't exist yet, make a new entry for it
+    if(this->m_slots[slot] == -1) {
+        if((this->m_entries.size() + 1) * 2 > this->m_slots.size()) {
+            this->grow();
+            slot = this->findSlot(idChars, hash);
+        }
+        Entry entry;
+        entry.id = idChars;
+        entry.hash = hash;
+        this->m_slots[slot] = (int)this->m_entries.size();
+        this->m_entries.push_back(entry);
+    }
+    unsigned int index = (unsigned int)this->m_slots[slot];
+    Entry & entry = this->m_entries[index];
     //if it currently doesn't have a component and the argument component isn't null,
     //add the new argument component
-    if( !cp->pComponent && pComp ) {
-        cp->pComponent = pComp;
+    if( !entry.pComponent && pComp ) {
+        entry.pComponent = pComp;
     }
     //if it currently doesn't have a metadata node and the argument metadata node isn't null,
     //add the new argument metadata node
-    if( cp->metaNodeObj.isNull() && !metaNodeObj.isNull() ) {
-        cp->metaNodeObj = metaNodeObj;
+    if( entry.metaNodeObj.isNull() && !metaNodeObj.isNull() ) {
+        entry.metaNodeObj = metaNodeObj;
     }
-    this->m_IdDictionary[idString] = cp;
+    return index;
 }
 
 bool RigIdManager::checkIdExists(MString id) {
-    std::string idString(id.asChar());
-    int count = (int)this->m_IdDictionary.count(idString);
-
-    if ( count > 0 ) 
-        return true;
-    else 
-        return false;
+    return this->findId(id.asChar()) != -1;
 }
 
 ComponentPtr RigIdManager::getComponent( MString id ) {
-    std::string idString(id.asChar());
-    CompNodesPtr cp = this->m_IdDictionary[idString];
-    return cp->pComponent;
+    int index = this->findId(id.asChar());
+    if(index == -1)
+        return ComponentPtr();
+    return this->m_entries[index].pComponent;
 }
 
 MObject RigIdManager::getMetaDataNode( MString id ) {
-    std::string idString(id.asChar());
-    CompNodesPtr cp = this->m_IdDictionary[idString];
-    return cp->metaNodeObj;
-}
-
-RigIdManager::CompNodesPtr RigIdManager::getCompNodes( MString id ) {
-    std::string idString(id.asChar());
-    CompNodesPtr cp = this->m_IdDictionary[idString];
-    return cp;
+    int index = this->findId(id.asChar());
+    if(index == -1)
+        return MObject::kNullObj;
+    return this->m_entries[index].metaNodeObj;
 }
 
 MString RigIdManager::toString() {
     MString printMsg;
-    std::map<std::string, RigIdManager::CompNodesPtr>::iterator itr;
 
-    for( itr = this->m_IdDictionary.begin(); itr != this->m_IdDictionary.end(); itr++ ) {
-        RigIdManager::CompNodesPtr compNodes( (*itr).second );
-        ComponentPtr comp = compNodes->pComponent;
-        MObject metaNodeObj = compNodes->metaNodeObj;
-        MFnDependencyNode metaNodeFn(metaNodeObj);
+    for(unsigned int i = 0; i < this->m_entries.size(); i++) {
+        const Entry & entry = this->m_entries[i];
+        ComponentPtr comp = entry.pComponent;
+        MFnDependencyNode metaNodeFn(entry.metaNodeObj);
 
-        printMsg += "Id: " + MString((*itr).first.c_str()) + " CompName: ";
+        printMsg += "Id: " + MString(entry.id.c_str()) + " CompName: ";
         MString compName;
         if( comp ) {
             compName = comp->getCompGuide()->getName();
@@ -102,99 +179,136 @@ MString RigIdManager::toString() {
     return printMsg;
 }
 
-void RigIdManager::updateComponents(MDGModifier & dgMod, bool forceUpdate, bool globalPos) {
-    std::map<std::string, RigIdManager::CompNodesPtr>::iterator itr;
-
-    //pre-processing stuff, the metadata nodes need to be set before
-    //updating can proceed correctly
-    for( itr = this->m_IdDictionary.begin(); itr != this->m_IdDictionary.end(); itr++ ) {
-        RigIdManager::CompNodesPtr compNodes( (*itr).second );
-        ComponentPtr comp = compNodes->pComponent;
-        MObject metaNodeObj = compNodes->metaNodeObj;
-        MFnDependencyNode metaNodeFn(metaNodeObj);
-
-        //if both the metadata node and the component exist, add the meta data node to the component object
-        if( !metaNodeObj.isNull() && comp ) {
-            comp->setMetaDataNode(metaNodeObj);
+void RigIdManager::classify(WorkLists & lists) {
+    lists.loads.clear();
+    lists.updates.clear();
+    lists.removes.clear();
+
+    for(unsigned int i = 0; i < this->m_entries.size(); i++) {
+        const Entry & entry = this->m_entries[i];
+        bool hasMetaNode = !entry.metaNodeObj.isNull();
+        //if both the metadata node and the component exist, add the meta data node to the component
+        //object, the metadata nodes need to be set before updating can proceed correctly
+        if( hasMetaNode && entry.pComponent ) {
+            entry.pComponent->setMetaDataNode(entry.metaNodeObj);
+            lists.updates.push_back(i);
+        }
+        //if only the component exists but not the metadata node, the component is new
+        else if( entry.pComponent ) {
+            lists.loads.push_back(i);
+        }
+        //if only the metadata node exists, the component was removed from the guide
+        else if( hasMetaNode ) {
+            lists.removes.push_back(i);
         }
     }
+}
 
-    //load new nodes before updating existing nodes
-    //this will allow existing nodes to be updated and parented
-    //under nodes that have just been added
-    for( itr = this->m_IdDictionary.begin(); itr != this->m_IdDictionary.end(); itr++ ) {
-        RigIdManager::CompNodesPtr compNodes( (*itr).second );
-        ComponentPtr comp = compNodes->pComponent;
-        MObject metaNodeObj = compNodes->metaNodeObj;
-        MFnDependencyNode metaNodeFn(metaNodeObj);
-
-        //if only the component exists but not the metadata node, add the component to the scene
-        if ( metaNodeObj.isNull() && comp ) {
-            MStatus status;
-            MObject metaNodeObj = comp->loadComponent(dgMod);
-            MFnDependencyNode metaNodeFn( metaNodeObj );
-            MString metaNodeName = metaNodeFn.name();
-            MObject parentMetaNodeObj = comp->getMetaParentNode();
-            //if the parent meta data node is found, connect the child meta data node to it
-            if( !parentMetaNodeObj.isNull() ) {
-                MFnDependencyNode parentMetaNodeFn( parentMetaNodeObj );
-                MString parentMetaNodeName = parentMetaNodeFn.name();
-
-                status = dgMod.connect( parentMetaNodeFn.findPlug("metaChildren"), metaNodeFn.findPlug("metaParent") );
-                MyCheckStatus(status, "dgMod.connect() failed: " + status.errorString() );
-                dgMod.doIt();
-            }
-            //if this is a global component, its metaParent attribute needs to be set to the meta root node
-            GlobalComponentPtr globalComp = boost::dynamic_pointer_cast<GlobalComponent>(comp);
-            if(globalComp) {
-                MObject metaRootObj;
-                lrutils::getObjFromName("MRN_"+comp->getRigName(),metaRootObj);
-                MFnDependencyNode metaRootFn( metaRootObj );
-
-                status = dgMod.connect( metaRootFn.findPlug("metaChildren"), metaNodeFn.findPlug("metaParent") );
-                MyCheckStatus(status, "dgMod.connect() failed: " + status.errorString() );
-                dgMod.doIt();
+void RigIdManager::buildSchedule(const WorkLists & lists, UpdateSchedule & schedule, std::vector<unsigned int> & itemEntries) {
+    itemEntries.clear();
+    //schedule item of every entry in the work lists, -1 for the rest
+    std::vector<int> entryItems(this->m_entries.size(), -1);
+    const std::vector<unsigned int> * work[] = { &lists.loads, &lists.updates, &lists.removes };
+    for(unsigned int w = 0; w < 3; w++) {
+        for(unsigned int i = 0; i < work[w]->size(); i++) {
+            unsigned int index = (*work[w])[i];
+            entryItems[index] = (int)schedule.addItem();
+            itemEntries.push_back(index);
+        }
+    }
+
+    for(unsigned int item = 0; item < itemEntries.size(); item++) {
+        const Entry & entry = this->m_entries[itemEntries[item]];
+        if(entry.pComponent) {
+            //a loaded or updated component reads its parent component's final joints and controllers
+            ComponentPtr parentComp = entry.pComponent->getParentComp();
+            if(!parentComp)
+                continue;
+            int parentIndex = this->findId(parentComp->getCompGuide()->getRigId().asChar());
+            if(parentIndex == -1 || entryItems[parentIndex] == -1)
+                continue;
+            unsigned int dependencies = getParentDependencies(entry.pComponent->getCompGuide()->getType(), parentComp->getCompGuide()->getType());
+            schedule.addDependency((unsigned int)entryItems[parentIndex], item, dependencies);
+        } else {
+            //a removed component deletes its nodes, its children have to be moved to their new
+            //parents or removed first
+            MStringArray childIds;
+            getMetaChildIds(entry.metaNodeObj, childIds);
+            for(unsigned int i = 0; i < childIds.length(); i++) {
+                int childIndex = this->findId(childIds[i].asChar());
+                if(childIndex == -1 || entryItems[childIndex] == -1)
+                    continue;
+                schedule.addDependency((unsigned int)entryItems[childIndex], item, UpdateSchedule::kMetaChild);
             }
         }
     }
+}
 
-    //update all nodes before proceeding with removing old ones
-    //this will fix dependencies in cases where a node used to be parented under a node
-    //that was just deleted
-    for( itr = this->m_IdDictionary.begin(); itr != this->m_IdDictionary.end(); itr++ ) {
-        RigIdManager::CompNodesPtr compNodes( (*itr).second );
-        ComponentPtr comp = compNodes->pComponent;
-        MObject metaNodeObj = compNodes->metaNodeObj;
-        MFnDependencyNode metaNodeFn(metaNodeObj);
+void RigIdManager::updateComponents(MDGModifier & dgMod, bool forceUpdate, bool globalPos) {
+    RigProfileScope profileScope("RigIdManager::updateComponents", RigProfiler::kRigCategory);
+    WorkLists lists;
+    this->classify(lists);
 
-        //if both the metadata node and the component exist, update the component in the scene
-        if( !metaNodeObj.isNull() && comp ) {
-            comp->updateComponent(dgMod, forceUpdate, globalPos);
-            dgMod.doIt();
-        }
+    //every component is done once, after the components it depends on
+    UpdateSchedule schedule;
+    std::vector<unsigned int> itemEntries;
+    this->buildSchedule(lists, schedule, itemEntries);
+    if(!schedule.build())
+        MGlobal::displayWarning("[MetaDataRigging] the component dependencies have a cycle, the components waiting on it are done last, new components first, then updated and removed ones");
+    if(profileScope.isTracing()) profileScope.setDetail(schedule.toString());
+
+    const std::vector<unsigned int> & order = schedule.getOrder();
+    for(unsigned int i = 0; i < order.size(); i++) {
+        unsigned int index = itemEntries[order[i]];
+        const Entry & entry = this->m_entries[index];
+        if(entry.pComponent && entry.metaNodeObj.isNull())
+            this->loadEntry(index, dgMod);
+        else if(entry.pComponent)
+            this->updateEntry(index, dgMod, forceUpdate, globalPos);
+        else
+            this->removeEntry(index, dgMod);
     }
+}
 
-    //nodes can now be removed since nodes that might have been dependent on them
-    //are updated and moved to their new parent nodes
-    for( itr = this->m_IdDictionary.begin(); itr != this->m_IdDictionary.end(); itr++ ) {
-        RigIdManager::CompNodesPtr compNodes( (*itr).second );
-        ComponentPtr comp = compNodes->pComponent;
-        MObject metaNodeObj = compNodes->metaNodeObj;
-        MFnDependencyNode metaNodeFn(metaNodeObj);
-
-        //if only the metadata node exists, remove the component from the scene
-        if( !metaNodeObj.isNull() && !comp ) {
-            MString nodeType = metaNodeFn.typeName();
-            if( nodeType == "MDGlobalNode" ) {
-                GlobalComponentPtr gComp( new GlobalComponent() );
-                gComp->setMetaDataNode(metaNodeObj);
-                gComp->removeComponent(dgMod);
-            } else if( nodeType == "MDHipNode" ) {
-                HipComponentPtr hComp( new HipComponent() );
-                hComp->setMetaDataNode(metaNodeObj);
-                hComp->removeComponent(dgMod);
-            }
-            dgMod.doIt();
-        }
-    }    
-}
\ No newline at end of file
+void RigIdManager::loadEntry(unsigned int index, MDGModifier & dgMod) {
+    ComponentPtr comp = this->m_entries[index].pComponent;
+    MStatus status;
+    MObject metaNodeObj = comp->loadComponent(dgMod);
+    MObject parentMetaNodeObj = comp->getMetaParentNode();
+    //if the parent meta data node is found, connect the child meta data node to it
+    if( !parentMetaNodeObj.isNull() ) {
+        status = dgMod.connect( MetaDataNode::getCommonPlug(parentMetaNodeObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaParent) );
+        MyCheckStatus(status, "dgMod.connect() failed: " + status.errorString() );
+        lrutils::doIt(dgMod);
+    }
+    //if this is a global component, its metaParent attribute needs to be set to the meta root node
+    GlobalComponentPtr globalComp = boost::dynamic_pointer_cast<GlobalComponent>(comp);
+    if(globalComp) {
+        MObject metaRootObj;
+        lrutils::getObjFromName("MRN_"+comp->getRigName(),metaRootObj);
+
+        status = dgMod.connect( MetaDataNode::getCommonPlug(metaRootObj, MetaDataNode::kMetaChildren), MetaDataNode::getCommonPlug(metaNodeObj, MetaDataNode::kMetaParent) );
+        MyCheckStatus(status, "dgMod.connect() failed: " + status.errorString() );
+        lrutils::doIt(dgMod);
+    }
+}
+
+void RigIdManager::updateEntry(unsigned int index, MDGModifier & dgMod, bool forceUpdate, bool globalPos) {
+    this->m_entries[index].pComponent->updateComponent(dgMod, forceUpdate, globalPos);
+    lrutils::doIt(dgMod);
+}
+
+void RigIdManager::removeEntry(unsigned int index, MDGModifier & dgMod) {
+    MObject metaNodeObj = this->m_entries[index].metaNodeObj;
+    MFnDependencyNode metaNodeFn(metaNodeObj);
+    if( metaNodeFn.typeId() == MDGlobalNode::id ) {
+        GlobalComponentPtr gComp( new GlobalComponent() );
+        gComp->setMetaDataNode(metaNodeObj);
+        gComp->removeComponent(dgMod);
+    } else if( metaNodeFn.typeId() == MDHipNode::id ) {
+        HipComponentPtr hComp( new HipComponent() );
+        hComp->setMetaDataNode(metaNodeObj);
+        hComp->removeComponent(dgMod);
+    }
+    lrutils::doIt(dgMod);
+}
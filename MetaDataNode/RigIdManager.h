@@ -9,37 +9,70 @@
 #ifndef _RigIdManager
 #define _RigIdManager
 
-#include <map>
+#include <vector>
 #include <string>
 #include <boost/lexical_cast.hpp>
 #include "MetaDataNode.h"
 #include "Component.h"
+#include "UpdateSchedule.h"
 
 typedef boost::shared_ptr<Component> ComponentPtr;
 
 class RigIdManager
 {
 public:
+    //indices of the entries updateComponents loads, updates and removes, in the order the ids were added
+    struct WorkLists
+    {
+        std::vector<unsigned int> loads;
+        std::vector<unsigned int> updates;
+        std::vector<unsigned int> removes;
+    };
+
     RigIdManager();
     ~RigIdManager();
-    void addId( MString id, ComponentPtr pComp, MObject metaNodeObj );
+    //interns the id, returns the index of its entry
+    unsigned int addId( MString id, ComponentPtr pComp, MObject metaNodeObj );
     bool checkIdExists( MString id );
     ComponentPtr getComponent( MString id );
+    //the component of the entry at index, as the work lists give it
+    ComponentPtr getEntryComponent( unsigned int index ) {return m_entries[index].pComponent;};
     MObject getMetaDataNode( MString id );
+    unsigned int getNumIds() const {return (unsigned int)m_entries.size();};
     MString toString();
+    //sorts every entry into the work lists in one pass, giving the components that have a
+    //metadata node their node
+    void classify(WorkLists & lists);
+    //adds an item to the schedule for every entry in the work lists, itemEntries[item] being its
+    //entry, and the dependencies between them: components come after the parent component they
+    //read joints and controllers from, removed components after their metaChildren
+    void buildSchedule(const WorkLists & lists, UpdateSchedule & schedule, std::vector<unsigned int> & itemEntries);
     //updates all components listed within the rigIdManager
     void updateComponents(MDGModifier & dgMod, bool forceUpdate = false, bool globalPos = false);
-    
+
 private:
-    struct CompNodes
+    struct Entry
     {
+        std::string id;
+        unsigned int hash;
         ComponentPtr pComponent;
         MObject metaNodeObj;
     };
-    typedef boost::shared_ptr<CompNodes> CompNodesPtr;
-    std::map<std::string, CompNodesPtr> m_IdDictionary;
 
-    CompNodesPtr getCompNodes( MString id );
+    void loadEntry(unsigned int index, MDGModifier & dgMod);
+    void updateEntry(unsigned int index, MDGModifier & dgMod, bool forceUpdate, bool globalPos);
+    void removeEntry(unsigned int index, MDGModifier & dgMod);
+
+    static unsigned int hashId(const char * id);
+    //the slot holding the id's entry, or the empty slot it would go in
+    unsigned int findSlot(const char * id, unsigned int hash) const;
+    int findId(const char * id) const;
+    void grow();
+
+    std::vector<Entry> m_entries;
+    //open addressing table of entry indices, -1 marks an empty slot. The size is a power of two
+    //kept at least twice the number of entries
+    std::vector<int> m_slots;
 };
 
-#endif
\ No newline at end of file
+#endif
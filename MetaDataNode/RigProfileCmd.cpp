@@ -0,0 +1,109 @@
+/************************************************************
+* Summary: Turns the rig profiler and tracing on or off,   *
+*          resets them, writes the trace and returns the    *
+*          per-phase table of timings and call counts.      *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#include <maya/MGlobal.h>
+#include "RigProfileCmd.h"
+#include <maya/MArgList.h>
+#include <maya/MArgDatabase.h>
+#include "RigProfiler.h"
+
+MStatus RigProfileCmd::doIt ( const MArgList &args )
+{
+    MStatus status;
+    MArgDatabase argData(syntax(), args, &status);
+    if (!status) {
+        status.perror("rigProfile flag parsing failed");
+        return status;
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::ResetParam())) {
+        RigProfiler::reset();
+        RigProfiler::getTraceBuffer().clear();
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::TraceBufferSizeParam())) {
+        int size;
+        status = argData.getFlagArgument(RigProfileCmd::TraceBufferSizeParam(), 0, size);
+        if (!status || size < 1) {
+            status = MS::kFailure;
+            status.perror("traceBufferSize flag parsing failed");
+            return status;
+        }
+        RigProfiler::getTraceBuffer().setCapacity((unsigned int)size);
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::TraceCategoriesParam())) {
+        MString names;
+        unsigned int categories;
+        status = argData.getFlagArgument(RigProfileCmd::TraceCategoriesParam(), 0, names);
+        if (!status || !RigProfiler::parseTraceCategories(names, categories)) {
+            status = MS::kFailure;
+            status.perror("traceCategories flag parsing failed, expected a comma separated list of rig, component, helper, mel or all");
+            return status;
+        }
+        RigProfiler::setTraceFilter(categories);
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::TraceParam())) {
+        bool trace;
+        status = argData.getFlagArgument(RigProfileCmd::TraceParam(), 0, trace);
+        if (!status) {
+            status.perror("trace flag parsing failed");
+            return status;
+        }
+        RigProfiler::setTracing(trace);
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::EnableParam())) {
+        bool enable;
+        status = argData.getFlagArgument(RigProfileCmd::EnableParam(), 0, enable);
+        if (!status) {
+            status.perror("enable flag parsing failed");
+            return status;
+        }
+        RigProfiler::setEnabled(enable);
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::DumpTraceParam())) {
+        MString path;
+        status = argData.getFlagArgument(RigProfileCmd::DumpTraceParam(), 0, path);
+        if (!status) {
+            status.perror("dumpTrace flag parsing failed");
+            return status;
+        }
+        if (!RigProfiler::writeTrace(path)) {
+            status = MS::kFailure;
+            status.perror("could not write the trace file "+path);
+            return status;
+        }
+    }
+
+    if (argData.isFlagSet(RigProfileCmd::BuildReportParam())) {
+        setResult(RigProfiler::getBuildReport());
+        return MS::kSuccess;
+    }
+
+    //the table is returned whatever the other flags, so "rigProfile" alone queries it
+    setResult(RigProfiler::getTable());
+
+    return MS::kSuccess;
+}
+
+MSyntax RigProfileCmd::newSyntax()
+{
+    MSyntax syntax;
+
+    syntax.addFlag(RigProfileCmd::EnableParam(), RigProfileCmd::EnableParamLong(), MSyntax::kBoolean);
+    syntax.addFlag(RigProfileCmd::ResetParam(), RigProfileCmd::ResetParamLong());
+    syntax.addFlag(RigProfileCmd::TraceParam(), RigProfileCmd::TraceParamLong(), MSyntax::kBoolean);
+    syntax.addFlag(RigProfileCmd::TraceCategoriesParam(), RigProfileCmd::TraceCategoriesParamLong(), MSyntax::kString);
+    syntax.addFlag(RigProfileCmd::TraceBufferSizeParam(), RigProfileCmd::TraceBufferSizeParamLong(), MSyntax::kLong);
+    syntax.addFlag(RigProfileCmd::DumpTraceParam(), RigProfileCmd::DumpTraceParamLong(), MSyntax::kString);
+    syntax.addFlag(RigProfileCmd::BuildReportParam(), RigProfileCmd::BuildReportParamLong());
+
+    return syntax;
+}
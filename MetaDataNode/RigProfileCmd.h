@@ -0,0 +1,48 @@
+/************************************************************
+* Summary: Turns the rig profiler and tracing on or off,   *
+*          resets them, writes the trace and returns the    *
+*          per-phase table of timings and call counts.      *
+*    Date: 10/19/26                                         *
+************************************************************/
+
+#ifndef _RigProfileCmd
+#define _RigProfileCmd
+
+#include <maya/MStatus.h>
+#include <maya/MSyntax.h>
+#include <maya/MPxCommand.h>
+
+class RigProfileCmd : public MPxCommand
+{
+public:
+    virtual MStatus doIt ( const MArgList& );
+    virtual bool isUndoable() const { return false; }
+
+    static void *creator() { return new RigProfileCmd; }
+    static MSyntax newSyntax();
+
+    //turn profiling on or off
+    static const char* EnableParam() { return "-e"; }
+    static const char* EnableParamLong() { return "-enable"; }
+    //clear every phase recorded so far
+    static const char* ResetParam() { return "-r"; }
+    static const char* ResetParamLong() { return "-reset"; }
+    //turn trace event recording on or off
+    static const char* TraceParam() { return "-t"; }
+    static const char* TraceParamLong() { return "-trace"; }
+    //comma separated trace categories: rig, component, helper, mel or all
+    static const char* TraceCategoriesParam() { return "-tc"; }
+    static const char* TraceCategoriesParamLong() { return "-traceCategories"; }
+    //number of events the trace ring buffer holds, resizing clears it
+    static const char* TraceBufferSizeParam() { return "-tbs"; }
+    static const char* TraceBufferSizeParamLong() { return "-traceBufferSize"; }
+    //write the recorded events as Chrome trace-event JSON to the given path
+    static const char* DumpTraceParam() { return "-dt"; }
+    static const char* DumpTraceParamLong() { return "-dumpTrace"; }
+    //return the optimizer and batching report of the last rig load or update instead of the phase table
+    static const char* BuildReportParam() { return "-br"; }
+    static const char* BuildReportParamLong() { return "-buildReport"; }
+
+};
+
+#endif
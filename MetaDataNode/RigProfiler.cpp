@@ -0,0 +1,248 @@
+/***************************************************************
+* Summary: Scoped timers and call counters compiled into the   *
+*          rig build, update and remove paths, optionally      *
+*          recorded as a timeline of trace events. While the   *
+*          profiler and tracing are off a timer or counter     *
+*          costs one branch.                                   *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "RigProfiler.h"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+namespace {
+    const char * kOutsidePhases = "(outside phases)";
+    const char * kCounterNames[RigProfiler::kNumCounters] = { "executeCommand", "python", "findPlug", "connectedTo", "doIt", "nameLookup", "plugByName" };
+    //in category bit order
+    const char * kCategoryNames[] = { "rig", "component", "helper", "mel" };
+    const unsigned int kNumCategories = sizeof(kCategoryNames) / sizeof(kCategoryNames[0]);
+
+    bool isPythonCommand(const MString & command) {
+        return command.length() >= 7 && command.substring(0, 6) == "python(";
+    }
+
+    unsigned int getPhaseIndex(const std::string & name, std::vector<RigProfiler::Phase> & phases, std::map<std::string, unsigned int> & phaseIndices) {
+        std::map<std::string, unsigned int>::iterator it = phaseIndices.find(name);
+        if(it != phaseIndices.end())
+            return it->second;
+        unsigned int index = (unsigned int)phases.size();
+        phaseIndices[name] = index;
+        phases.push_back(RigProfiler::Phase());
+        phases.back().name = name;
+        return index;
+    }
+}
+
+bool RigProfiler::s_active = false;
+bool RigProfiler::s_enabled = false;
+unsigned int RigProfiler::s_traceCategories = 0;
+unsigned int RigProfiler::s_traceFilter = RigProfiler::kAllCategories;
+bool RigProfiler::s_tracingBeforeCapture = false;
+TraceBuffer RigProfiler::s_traceBuffer;
+std::vector<RigProfiler::Phase> RigProfiler::s_phases;
+std::map<std::string, unsigned int> RigProfiler::s_phaseIndices;
+std::vector<RigProfiler::OpenPhase> RigProfiler::s_openPhases;
+MStringArray RigProfiler::s_buildReport;
+
+RigProfiler::Phase::Phase() {
+    calls = 0;
+    total = 0.0;
+    self = 0.0;
+    max = 0.0;
+    for(unsigned int i = 0; i < kNumCounters; i++) {
+        counts[i] = 0;
+    }
+}
+
+void RigProfiler::setEnabled(bool enabled) {
+    //phases still open when the profiler is turned off would never be closed
+    if(!enabled)
+        s_openPhases.clear();
+    s_enabled = enabled;
+    updateActive();
+}
+
+void RigProfiler::reset() {
+    s_phases.clear();
+    s_phaseIndices.clear();
+    s_openPhases.clear();
+}
+
+double RigProfiler::now() {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    if(frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    timeval time;
+    gettimeofday(&time, NULL);
+    return (double)time.tv_sec + (double)time.tv_usec * 1.0e-6;
+#endif
+}
+
+void RigProfiler::beginPhase(const char * name, Category category) {
+    double start = now();
+    if(s_traceCategories & category)
+        s_traceBuffer.record(TraceBuffer::kBegin, category, start, name);
+    if(!s_enabled)
+        return;
+    OpenPhase open;
+    open.name = name;
+    open.phase = getPhaseIndex(name, s_phases, s_phaseIndices);
+    open.nested = 0.0;
+    open.start = start;
+    s_openPhases.push_back(open);
+}
+
+void RigProfiler::endPhase(const char * name, Category category, const char * detail) {
+    double end = now();
+    if(s_traceCategories & category)
+        s_traceBuffer.record(TraceBuffer::kEnd, category, end, name, detail);
+    //the phase isn't open if profiling was turned on inside it
+    if(s_openPhases.empty() || s_openPhases.back().name != name)
+        return;
+    double elapsed = end - s_openPhases.back().start;
+    Phase & phase = s_phases[s_openPhases.back().phase];
+    phase.calls++;
+    phase.total += elapsed;
+    phase.self += elapsed - s_openPhases.back().nested;
+    if(elapsed > phase.max)
+        phase.max = elapsed;
+    s_openPhases.pop_back();
+    if(!s_openPhases.empty())
+        s_openPhases.back().nested += elapsed;
+}
+
+void RigProfiler::addCount(Counter counter) {
+    if(!s_enabled)
+        return;
+    unsigned int phase;
+    if(s_openPhases.empty())
+        phase = getPhaseIndex(kOutsidePhases, s_phases, s_phaseIndices);
+    else
+        phase = s_openPhases.back().phase;
+    s_phases[phase].counts[counter]++;
+}
+
+MStringArray RigProfiler::getTable() {
+    MStringArray table;
+    std::stringstream header;
+    header << std::left << std::setw(48) << "phase" << std::right << std::setw(8) << "calls"
+           << std::setw(12) << "total ms" << std::setw(12) << "self ms" << std::setw(12) << "mean ms" << std::setw(12) << "max ms";
+    for(unsigned int i = 0; i < kNumCounters; i++) {
+        header << std::setw(16) << kCounterNames[i];
+    }
+    table.append(MString(header.str().c_str()));
+
+    for(unsigned int i = 0; i < s_phases.size(); i++) {
+        const Phase & phase = s_phases[i];
+        double mean = phase.calls > 0 ? phase.total / phase.calls : 0.0;
+        std::stringstream row;
+        row << std::fixed << std::setprecision(3);
+        row << std::left << std::setw(48) << phase.name << std::right << std::setw(8) << phase.calls
+            << std::setw(12) << phase.total * 1000.0 << std::setw(12) << phase.self * 1000.0
+            << std::setw(12) << mean * 1000.0 << std::setw(12) << phase.max * 1000.0;
+        for(unsigned int j = 0; j < kNumCounters; j++) {
+            row << std::setw(16) << phase.counts[j];
+        }
+        table.append(MString(row.str().c_str()));
+    }
+    return table;
+}
+
+void RigProfiler::beginCommand(const MString & command) {
+    bool python = isPythonCommand(command);
+    addCount(kExecuteCommand);
+    if(python)
+        addCount(kPythonCall);
+    if(s_traceCategories & kCommandCategory)
+        s_traceBuffer.record(TraceBuffer::kBegin, kCommandCategory, now(), python ? "python" : "mel", command.asChar());
+}
+
+void RigProfiler::endCommand(const MString & command) {
+    if(s_traceCategories & kCommandCategory)
+        s_traceBuffer.record(TraceBuffer::kEnd, kCommandCategory, now(), isPythonCommand(command) ? "python" : "mel");
+}
+
+void RigProfiler::setTracing(bool tracing) {
+    s_traceCategories = tracing ? s_traceFilter : 0;
+    updateActive();
+}
+
+void RigProfiler::setTraceFilter(unsigned int categories) {
+    s_traceFilter = categories;
+    if(s_traceCategories != 0)
+        s_traceCategories = categories;
+    updateActive();
+}
+
+bool RigProfiler::parseTraceCategories(const MString & names, unsigned int & categories) {
+    MStringArray splitNames;
+    names.split(',', splitNames);
+    categories = 0;
+    for(unsigned int i = 0; i < splitNames.length(); i++) {
+        MString name = splitNames[i];
+        if(name == "all") {
+            categories |= kAllCategories;
+            continue;
+        }
+        bool found = false;
+        for(unsigned int bit = 0; bit < kNumCategories; bit++) {
+            if(name == kCategoryNames[bit]) {
+                categories |= 1u << bit;
+                found = true;
+            }
+        }
+        if(!found)
+            return false;
+    }
+    return true;
+}
+
+bool RigProfiler::writeTrace(const MString & filePath) {
+    std::vector<std::string> categoryNames(kCategoryNames, kCategoryNames + kNumCategories);
+    return s_traceBuffer.writeChromeJson(filePath.asChar(), categoryNames);
+}
+
+void RigProfiler::beginTraceCapture() {
+    s_tracingBeforeCapture = isTracing();
+    s_traceBuffer.clear();
+    setTracing(true);
+}
+
+bool RigProfiler::endTraceCapture(const MString & filePath) {
+    setTracing(s_tracingBeforeCapture);
+    return writeTrace(filePath);
+}
+
+void RigProfileScope::setDetail(const MString & detail) {
+    if(!m_active)
+        return;
+    strncpy(m_detail, detail.asChar(), TraceBuffer::kDetailLength - 1);
+    m_detail[TraceBuffer::kDetailLength - 1] = '\0';
+}
+
+RigTraceCapture::RigTraceCapture(const MString & filePath) {
+    m_filePath = filePath;
+    if(m_filePath.length() > 0)
+        RigProfiler::beginTraceCapture();
+}
+
+RigTraceCapture::~RigTraceCapture() {
+    if(m_filePath.length() == 0)
+        return;
+    if(RigProfiler::endTraceCapture(m_filePath))
+        MGlobal::displayInfo("[MetaDataRigging] trace written to "+m_filePath);
+    else
+        MGlobal::displayWarning("[MetaDataRigging] could not write the trace file "+m_filePath);
+}
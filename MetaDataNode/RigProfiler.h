@@ -0,0 +1,220 @@
+/***************************************************************
+* Summary: Scoped timers and call counters compiled into the   *
+*          rig build, update and remove paths, optionally      *
+*          recorded as a timeline of trace events. While the   *
+*          profiler and tracing are off a timer or counter     *
+*          costs one branch.                                   *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _RigProfiler
+#define _RigProfiler
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MStringArray.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+#include <maya/MPlugArray.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MDGModifier.h>
+#include <maya/MGlobal.h>
+#include "TraceBuffer.h"
+#include <string>
+#include <vector>
+#include <map>
+
+//the phases and counters are kept for the main thread only, without locks. Work on other threads is
+//traced by recording its events straight into getTraceBuffer(), which any thread may do
+class RigProfiler
+{
+public:
+    //scene calls counted against the innermost open phase
+    enum Counter {
+        kExecuteCommand,    //MEL commands run through MGlobal, python calls included
+        kPythonCall,        //MEL commands that call into python
+        kFindPlug,
+        kConnectedTo,
+        kDoIt,              //MDGModifier and MDagModifier doIt
+        kNameLookup,        //node names resolved through a selection list
+        kPlugByName,        //findPlug calls given an attribute name instead of its MObject
+        kNumCounters
+    };
+
+    //trace event categories, combinable as bit flags
+    enum Category {
+        kRigCategory = 1,           //Rig load, update and remove
+        kComponentCategory = 2,     //component load, update and remove
+        kHelperCategory = 4,        //lrutils helpers and batched scene edits
+        kCommandCategory = 8,       //MEL and python commands
+        kAllCategories = 15
+    };
+
+    struct Phase
+    {
+        Phase();
+        std::string name;
+        unsigned int calls;
+        double total;   //seconds, including nested phases
+        double self;    //seconds, excluding nested phases
+        double max;
+        unsigned int counts[kNumCounters];
+    };
+
+    //true while either profiling or tracing is on
+    static bool isActive() {return s_active;};
+    static bool isEnabled() {return s_enabled;};
+    static void setEnabled(bool enabled);
+    static void reset();
+
+    static void count(Counter counter) { if(s_active) addCount(counter); };
+    //two counters behind the one branch
+    static void count(Counter first, Counter second) { if(s_active) { addCount(first); addCount(second); } };
+    static void beginPhase(const char * name, Category category);
+    static void endPhase(const char * name, Category category, const char * detail = NULL);
+    //counts a MEL command and traces it as a command event
+    static void beginCommand(const MString & command);
+    static void endCommand(const MString & command);
+
+    //records events of the trace filter's categories into the trace buffer
+    static void setTracing(bool tracing);
+    static bool isTracing() {return s_traceCategories != 0;};
+    static bool isTracing(Category category) {return (s_traceCategories & category) != 0;};
+    static unsigned int getTraceFilter() {return s_traceFilter;};
+    static void setTraceFilter(unsigned int categories);
+    //reads a comma separated list of category names, i.e. "rig,component", "all" selects every category
+    static bool parseTraceCategories(const MString & names, unsigned int & categories);
+    static TraceBuffer & getTraceBuffer() {return s_traceBuffer;};
+    static bool writeTrace(const MString & filePath);
+    //traces a single command invocation into a cleared buffer and restores the previous trace state afterwards
+    static void beginTraceCapture();
+    static bool endTraceCapture(const MString & filePath);
+
+    //the phases in the order they were first entered. Calls made outside every phase
+    //are counted in a phase named "(outside phases)"
+    static const std::vector<Phase> & getPhases() {return s_phases;};
+    //one row per phase, the first row names the columns
+    static MStringArray getTable();
+    //seconds since an arbitrary fixed point, at the resolution of the system's high resolution clock
+    static double now();
+    //what the scene op optimizer, hierarchy planner, controller cache and display layer batching did during
+    //the last rig load or update, one line each. Queried with rigProfile -buildReport
+    static void setBuildReport(const MStringArray & report) {s_buildReport = report;};
+    static const MStringArray & getBuildReport() {return s_buildReport;};
+
+private:
+    struct OpenPhase
+    {
+        const char * name;
+        unsigned int phase;
+        double start;
+        double nested; //seconds spent in phases opened inside this one
+    };
+
+    static void addCount(Counter counter);
+    static void updateActive() {s_active = s_enabled || s_traceCategories != 0;};
+
+    static bool s_active;
+    static bool s_enabled;
+    static unsigned int s_traceCategories; //categories being recorded, 0 while tracing is off
+    static unsigned int s_traceFilter; //categories recorded while tracing is on
+    static bool s_tracingBeforeCapture;
+    static TraceBuffer s_traceBuffer;
+    static std::vector<Phase> s_phases;
+    static std::map<std::string, unsigned int> s_phaseIndices;
+    static std::vector<OpenPhase> s_openPhases;
+    static MStringArray s_buildReport;
+};
+
+//times the enclosing block as the named phase
+class RigProfileScope
+{
+public:
+    RigProfileScope(const char * name, RigProfiler::Category category = RigProfiler::kHelperCategory) : m_active(RigProfiler::isActive()) {
+        if(m_active) {
+            m_name = name;
+            m_category = category;
+            m_detail[0] = '\0';
+            RigProfiler::beginPhase(name, category);
+        }
+    };
+    ~RigProfileScope() { if(m_active) RigProfiler::endPhase(m_name, m_category, m_detail); };
+
+    bool isTracing() const { return m_active && RigProfiler::isTracing(m_category); };
+    //extra information shown with the trace event, i.e. the name of the component being built
+    void setDetail(const MString & detail);
+
+private:
+    bool m_active; //a scope opened while inactive doesn't close a phase if the profiler is enabled inside it
+    //only set while active, so an inactive scope costs nothing to construct
+    const char * m_name;
+    RigProfiler::Category m_category;
+    char m_detail[TraceBuffer::kDetailLength];
+};
+
+//counts and traces one MEL command
+class RigCommandScope
+{
+public:
+    RigCommandScope(const MString & command) : m_active(RigProfiler::isActive()), m_command(command) { if(m_active) RigProfiler::beginCommand(command); };
+    ~RigCommandScope() { if(m_active) RigProfiler::endCommand(m_command); };
+
+private:
+    bool m_active;
+    const MString & m_command;
+};
+
+//traces everything done while it exists into the Chrome trace-event file at filePath,
+//an empty path records nothing
+class RigTraceCapture
+{
+public:
+    RigTraceCapture(const MString & filePath);
+    ~RigTraceCapture();
+
+private:
+    MString m_filePath;
+};
+
+//counted versions of the scene calls tracked by the profiler
+namespace lrutils {
+    inline MPlug findPlug(const MFnDependencyNode & nodeFn, const MString & attrName, bool wantNetworkedPlug, MStatus * status = NULL) {
+        RigProfiler::count(RigProfiler::kFindPlug, RigProfiler::kPlugByName);
+        return nodeFn.findPlug(attrName, wantNetworkedPlug, status);
+    }
+    inline MPlug findPlug(const MFnDependencyNode & nodeFn, const MString & attrName, MStatus * status = NULL) {
+        RigProfiler::count(RigProfiler::kFindPlug, RigProfiler::kPlugByName);
+        return nodeFn.findPlug(attrName, status);
+    }
+    inline MPlug findPlug(const MFnDependencyNode & nodeFn, const MObject & attr, bool wantNetworkedPlug, MStatus * status = NULL) {
+        RigProfiler::count(RigProfiler::kFindPlug);
+        return nodeFn.findPlug(attr, wantNetworkedPlug, status);
+    }
+    inline MPlug findPlug(const MFnDependencyNode & nodeFn, const MObject & attr, MStatus * status = NULL) {
+        RigProfiler::count(RigProfiler::kFindPlug);
+        return nodeFn.findPlug(attr, status);
+    }
+    inline bool connectedTo(const MPlug & plug, MPlugArray & plugs, bool asDst, bool asSrc, MStatus * status = NULL) {
+        RigProfiler::count(RigProfiler::kConnectedTo);
+        return plug.connectedTo(plugs, asDst, asSrc, status);
+    }
+    inline MStatus doIt(MDGModifier & dgMod) {
+        RigProfiler::count(RigProfiler::kDoIt);
+        return dgMod.doIt();
+    }
+    inline MStatus executeCommand(const MString & command, bool displayEnabled = false, bool undoEnabled = false) {
+        RigCommandScope commandScope(command);
+        return MGlobal::executeCommand(command, displayEnabled, undoEnabled);
+    }
+    //covers every MGlobal::executeCommand overload that returns a result
+    template<class T> inline MStatus executeCommand(const MString & command, T & result, bool displayEnabled = false, bool undoEnabled = false) {
+        RigCommandScope commandScope(command);
+        return MGlobal::executeCommand(command, result, displayEnabled, undoEnabled);
+    }
+    inline MString executeCommandStringResult(const MString & command, bool displayEnabled = false, bool undoEnabled = false, MStatus * status = NULL) {
+        RigCommandScope commandScope(command);
+        return MGlobal::executeCommandStringResult(command, displayEnabled, undoEnabled, status);
+    }
+}
+
+#endif //_RigProfiler
@@ -0,0 +1,57 @@
+/***************************************************************
+* Summary: Creates and removes the metaRoot node and the       *
+*          groups that organize a rig in the scene, written    *
+*          against SceneBackend so it runs on any backend.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "RigScaffold.h"
+
+lrutils::RigScaffold::RigScaffold() {
+    metaRoot = SceneBackend::kNullNode;
+    topGroup = SceneBackend::kNullNode;
+    rigGroup = SceneBackend::kNullNode;
+    ctlGroup = SceneBackend::kNullNode;
+    noTransformGroup = SceneBackend::kNullNode;
+}
+
+bool lrutils::buildRigScaffold(SceneBackend & scene, const std::string & rigName, const std::string & xmlPath, double version, SceneBackend::NodeId managerNode, RigScaffold & scaffold) {
+    //create groups used for scene organization
+    scaffold.topGroup = scene.createDagNode("transform", rigName + "_GRP");
+    if(scaffold.topGroup == SceneBackend::kNullNode)
+        return false;
+    scaffold.rigGroup = scene.createDagNode("transform", rigName + "_Rig_GRP", scaffold.topGroup);
+    scaffold.ctlGroup = scene.createDagNode("transform", rigName + "_Control_GRP", scaffold.topGroup);
+    scaffold.noTransformGroup = scene.createDagNode("transform", rigName + "_NoTransform_GRP", scaffold.topGroup);
+
+    //create and set up root node
+    scaffold.metaRoot = scene.createNode("MetaRootNode", "MRN_" + rigName);
+    if(scaffold.metaRoot == SceneBackend::kNullNode)
+        return false;
+    bool ok = scene.setString(scaffold.metaRoot, "xmlPath", xmlPath);
+    ok = scene.setDouble(scaffold.metaRoot, "version", version) && ok;
+
+    //create meta data network connections
+    if(managerNode != SceneBackend::kNullNode)
+        ok = scene.connect(managerNode, "metaRoots", scaffold.metaRoot, "metaParent") && ok;
+    ok = scene.connectMeta(scaffold.metaRoot, "topGroup", scaffold.topGroup) && ok;
+    ok = scene.connectMeta(scaffold.metaRoot, "rigGroup", scaffold.rigGroup) && ok;
+    ok = scene.connectMeta(scaffold.metaRoot, "ctlGroup", scaffold.ctlGroup) && ok;
+    ok = scene.connectMeta(scaffold.metaRoot, "noTransformGroup", scaffold.noTransformGroup) && ok;
+
+    return ok;
+}
+
+bool lrutils::removeRigScaffold(SceneBackend & scene, SceneBackend::NodeId metaRoot) {
+    if(!scene.isValid(metaRoot))
+        return false;
+    //children are deleted before the groups above them
+    const char * connections[] = { "noTransformGroup", "ctlGroup", "rigGroup", "topGroup", "ctlLayer", "skelLayer", "extrasLayer" };
+    bool ok = true;
+    for(unsigned int i = 0; i < sizeof(connections) / sizeof(connections[0]); i++) {
+        SceneBackend::NodeId node = scene.getMetaNodeConnection(metaRoot, connections[i]);
+        if(node != SceneBackend::kNullNode)
+            ok = scene.deleteNode(node) && ok;
+    }
+    return ok;
+}
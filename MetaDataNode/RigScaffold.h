@@ -0,0 +1,32 @@
+/***************************************************************
+* Summary: Creates and removes the metaRoot node and the       *
+*          groups that organize a rig in the scene, written    *
+*          against SceneBackend so it runs on any backend.     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _RigScaffold
+#define _RigScaffold
+
+#include "SceneBackend.h"
+#include <string>
+
+namespace lrutils {
+    //the nodes every rig is built into
+    struct RigScaffold
+    {
+        RigScaffold();
+        SceneBackend::NodeId metaRoot;
+        SceneBackend::NodeId topGroup;
+        SceneBackend::NodeId rigGroup;
+        SceneBackend::NodeId ctlGroup;
+        SceneBackend::NodeId noTransformGroup;
+    };
+
+    //creates the metaRoot and organization groups of a rig, connected under the metadata manager node
+    bool buildRigScaffold(SceneBackend & scene, const std::string & rigName, const std::string & xmlPath, double version, SceneBackend::NodeId managerNode, RigScaffold & scaffold);
+    //deletes the organization groups and display layers connected to a rig's metaRoot
+    bool removeRigScaffold(SceneBackend & scene, SceneBackend::NodeId metaRoot);
+}
+
+#endif //_RigScaffold
@@ -0,0 +1,251 @@
+/***************************************************************
+* Summary: Updates a list of rigs as a two stage pipeline.     *
+*          Worker threads parse the xml guides of the rigs     *
+*          ahead and plan their components while the main      *
+*          thread applies the rig before them to the scene.    *
+*          Rigs are applied in the order they were added.      *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "RigUpdatePipeline.h"
+#include "Rig.h"
+#include "RigProfiler.h"
+#include "Threading.h"
+#include "WorkerPool.h"
+#include <sstream>
+
+namespace {
+    const char * kPreparePhase = "RigUpdatePipeline::prepare";
+}
+
+struct RigUpdatePipeline::State
+{
+    lrutils::Mutex lock;
+    lrutils::Condition jobPrepared; //signalled when a job is prepared
+    lrutils::Condition queueSpace; //signalled when the main thread takes a job
+    std::vector<lrutils::Thread*> threads;
+    std::vector<bool> prepared;
+    unsigned int numStarted; //jobs a prepare thread has started on
+    unsigned int numTaken; //jobs returned by next
+    bool stopping;
+    double prepareTime; //seconds spent preparing, over all the prepare threads
+    double prepareWaitTime; //seconds the prepare threads waited for space in the queue
+};
+
+RigUpdatePipeline::Job::Job() {
+    this->nodeVersion = 0.0f;
+    this->status = MS::kSuccess;
+    this->xmlVersion = 0.0f;
+    this->prepareTime = 0.0;
+}
+
+RigUpdatePipeline::Report::Report() {
+    this->numJobs = 0;
+    this->numPrepareThreads = 0;
+    this->capacity = 0;
+    this->wallTime = 0.0;
+    this->prepareTime = 0.0;
+    this->prepareWaitTime = 0.0;
+    this->prepareUtilization = 0.0;
+    this->applyTime = 0.0;
+    this->applyWaitTime = 0.0;
+    this->applyUtilization = 0.0;
+}
+
+MString RigUpdatePipeline::Report::toString() const {
+    std::stringstream report;
+    report.setf(std::ios::fixed);
+    report.precision(3);
+    report << "rig pipeline: " << this->numJobs << " rigs, " << this->numPrepareThreads
+           << " prepare threads, queue of " << this->capacity << ", wall " << this->wallTime << "s";
+    report << "; prepare " << this->prepareTime << "s busy, " << this->prepareWaitTime << "s waiting for queue space, "
+           << this->prepareUtilization * 100.0 << "% utilized";
+    report << "; apply " << this->applyTime << "s busy, " << this->applyWaitTime << "s waiting for plans, "
+           << this->applyUtilization * 100.0 << "% utilized";
+    return MString(report.str().c_str());
+}
+
+RigUpdatePipeline::RigUpdatePipeline(bool forceUpdate, unsigned int numPrepareThreads, unsigned int capacity) {
+    this->m_forceUpdate = forceUpdate;
+    if(numPrepareThreads == 0)
+        numPrepareThreads = WorkerPool::getHardwareThreads() > 1 ? WorkerPool::getHardwareThreads() - 1 : 1;
+    this->m_numPrepareThreads = numPrepareThreads;
+    this->m_capacity = capacity > 0 ? capacity : 1;
+    this->m_state = new State();
+    this->m_state->numStarted = 0;
+    this->m_state->numTaken = 0;
+    this->m_state->stopping = false;
+    this->m_state->prepareTime = 0.0;
+    this->m_state->prepareWaitTime = 0.0;
+    this->m_startTime = 0.0;
+    this->m_endTime = -1.0;
+    this->m_takenTime = 0.0;
+    this->m_applyTime = 0.0;
+    this->m_applyWaitTime = 0.0;
+}
+
+RigUpdatePipeline::~RigUpdatePipeline() {
+    {
+        lrutils::ScopedLock lock(this->m_state->lock);
+        this->m_state->stopping = true;
+        this->m_state->queueSpace.notifyAll();
+    }
+    for(unsigned int i = 0; i < this->m_state->threads.size(); i++) {
+        //joined on deletion
+        delete this->m_state->threads[i];
+    }
+    for(unsigned int i = 0; i < this->m_jobs.size(); i++) {
+        delete this->m_jobs[i];
+    }
+    delete this->m_state;
+}
+
+void RigUpdatePipeline::addJob(MObject rootNodeObj, MString xmlPath, float nodeVersion) {
+    Job * job = new Job();
+    job->rootNodeObj = rootNodeObj;
+    job->xmlPath = xmlPath;
+    job->nodeVersion = nodeVersion;
+    this->m_jobs.push_back(job);
+}
+
+void RigUpdatePipeline::start() {
+    this->m_startTime = RigProfiler::now();
+    this->m_state->prepared.assign(this->m_jobs.size(), false);
+    //more threads than jobs or than the queue holds would only wait
+    unsigned int numThreads = this->m_numPrepareThreads;
+    if(numThreads > this->m_jobs.size())
+        numThreads = (unsigned int)this->m_jobs.size();
+    if(numThreads > this->m_capacity)
+        numThreads = this->m_capacity;
+    for(unsigned int i = 0; i < numThreads; i++) {
+        lrutils::Thread * thread = new lrutils::Thread();
+        if(!thread->start(prepareThreadMain, this)) {
+            delete thread;
+            break;
+        }
+        this->m_state->threads.push_back(thread);
+    }
+    //without any prepare threads next prepares each job itself
+    this->m_numPrepareThreads = (unsigned int)this->m_state->threads.size();
+}
+
+RigUpdatePipeline::Job * RigUpdatePipeline::next() {
+    State & state = *this->m_state;
+    double askedTime = RigProfiler::now();
+    unsigned int jobNum;
+    {
+        lrutils::ScopedLock lock(state.lock);
+        if(state.numTaken > 0) {
+            this->m_applyTime += askedTime - this->m_takenTime;
+            //the applied rig and its guide aren't needed anymore
+            Job & doneJob = *this->m_jobs[state.numTaken - 1];
+            doneJob.pRig.reset();
+            doneJob.pXmlGuide.reset();
+        }
+        if(state.numTaken >= this->m_jobs.size()) {
+            if(this->m_endTime < 0.0)
+                this->m_endTime = askedTime;
+            return NULL;
+        }
+        jobNum = state.numTaken;
+        if(state.threads.empty()) {
+            state.numStarted++;
+        } else {
+            while(!state.prepared[jobNum]) {
+                state.jobPrepared.wait(state.lock);
+            }
+        }
+    }
+    if(state.threads.empty()) {
+        this->prepare(*this->m_jobs[jobNum]);
+        state.prepareTime += this->m_jobs[jobNum]->prepareTime;
+    }
+    {
+        lrutils::ScopedLock lock(state.lock);
+        state.numTaken++;
+        state.queueSpace.notifyAll();
+    }
+    this->m_takenTime = RigProfiler::now();
+    if(!state.threads.empty())
+        this->m_applyWaitTime += this->m_takenTime - askedTime;
+    return this->m_jobs[jobNum];
+}
+
+RigUpdatePipeline::Report RigUpdatePipeline::getReport() const {
+    Report report;
+    double endTime = this->m_endTime >= 0.0 ? this->m_endTime : RigProfiler::now();
+    report.numJobs = (unsigned int)this->m_jobs.size();
+    report.numPrepareThreads = this->m_numPrepareThreads;
+    report.capacity = this->m_capacity;
+    report.wallTime = endTime - this->m_startTime;
+    {
+        lrutils::ScopedLock lock(this->m_state->lock);
+        report.prepareTime = this->m_state->prepareTime;
+        report.prepareWaitTime = this->m_state->prepareWaitTime;
+    }
+    report.applyTime = this->m_applyTime;
+    report.applyWaitTime = this->m_applyWaitTime;
+    //a pipeline without prepare threads prepares on the main thread
+    unsigned int numThreads = this->m_numPrepareThreads > 0 ? this->m_numPrepareThreads : 1;
+    if(report.wallTime > 0.0) {
+        report.prepareUtilization = report.prepareTime / (report.wallTime * numThreads);
+        report.applyUtilization = report.applyTime / report.wallTime;
+    }
+    return report;
+}
+
+void RigUpdatePipeline::prepareThreadMain(void * pipeline) {
+    ((RigUpdatePipeline*)pipeline)->prepareLoop();
+}
+
+void RigUpdatePipeline::prepareLoop() {
+    State & state = *this->m_state;
+    lrutils::ScopedLock lock(state.lock);
+    while(true) {
+        //jobs are started in order, so the queue holds the next capacity jobs to be applied
+        double waitStart = RigProfiler::now();
+        while(!state.stopping && state.numStarted < this->m_jobs.size() && state.numStarted >= state.numTaken + this->m_capacity) {
+            state.queueSpace.wait(state.lock);
+        }
+        state.prepareWaitTime += RigProfiler::now() - waitStart;
+        if(state.stopping || state.numStarted >= this->m_jobs.size())
+            return;
+        unsigned int jobNum = state.numStarted++;
+        state.lock.unlock();
+        this->prepare(*this->m_jobs[jobNum]);
+        state.lock.lock();
+        state.prepareTime += this->m_jobs[jobNum]->prepareTime;
+        state.prepared[jobNum] = true;
+        state.jobPrepared.notifyAll();
+    }
+}
+
+void RigUpdatePipeline::prepare(Job & job) {
+    double start = RigProfiler::now();
+    bool tracing = RigProfiler::isTracing(RigProfiler::kRigCategory);
+    if(tracing)
+        RigProfiler::getTraceBuffer().record(TraceBuffer::kBegin, RigProfiler::kRigCategory, start, kPreparePhase);
+    try {
+        job.pXmlGuide.reset( new XmlGuide() );
+        job.status = job.pXmlGuide->parseXmlFile(job.xmlPath);
+        job.errors = job.pXmlGuide->getErrors();
+        if(job.status) {
+            job.pXmlGuide->getVersion(job.xmlVersion);
+            //only a rig whose version doesn't match its xml file is updated
+            if(job.xmlVersion != job.nodeVersion || this->m_forceUpdate) {
+                job.pRig.reset( new Rig(job.pXmlGuide) );
+                job.errors += job.pRig->getErrors();
+                job.pRig->computeBuildPlans();
+            }
+        }
+    }
+    catch (...) {
+        job.status = MS::kFailure;
+        job.errors += "Could not prepare the rig of "+job.xmlPath+"\n";
+        job.pRig.reset();
+    }
+    double end = RigProfiler::now();
+    if(tracing)
+        RigProfiler::getTraceBuffer().record(TraceBuffer::kEnd, RigProfiler::kRigCategory, end, kPreparePhase, job.xmlPath.asChar());
+    job.prepareTime = end - start;
+}
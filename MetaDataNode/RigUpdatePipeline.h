@@ -0,0 +1,98 @@
+/***************************************************************
+* Summary: Updates a list of rigs as a two stage pipeline.     *
+*          Worker threads parse the xml guides of the rigs     *
+*          ahead and plan their components while the main      *
+*          thread applies the rig before them to the scene.    *
+*          Rigs are applied in the order they were added.      *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _RigUpdatePipeline
+#define _RigUpdatePipeline
+
+#include <boost/shared_ptr.hpp>
+#include <maya/MObject.h>
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <vector>
+#include "XmlGuide.h"
+
+class Rig;
+
+class RigUpdatePipeline
+{
+public:
+    struct Job
+    {
+        Job();
+        //set on the main thread when the job is added
+        MObject rootNodeObj; //the rig's metaRoot node
+        MString xmlPath; //full path of the rig's xml file
+        float nodeVersion; //version held by the metaRoot node
+        //set by the prepare stage
+        MStatus status; //kFailure if the xml file couldn't be parsed
+        MString errors; //problems found while preparing, to be displayed by the main thread
+        XmlGuidePtr pXmlGuide;
+        float xmlVersion;
+        boost::shared_ptr<Rig> pRig; //planned rig, NULL when the rig is up to date or the xml is invalid
+        double prepareTime; //seconds
+    };
+
+    //per stage busy and waiting times, in seconds, and their utilization over the wall time of the pipeline
+    struct Report
+    {
+        Report();
+        MString toString() const;
+        unsigned int numJobs;
+        unsigned int numPrepareThreads;
+        unsigned int capacity;
+        double wallTime;            //from start until next returned NULL, or until now while running
+        double prepareTime;         //spent preparing, over all the prepare threads
+        double prepareWaitTime;     //prepare threads waiting for space in the queue
+        double prepareUtilization;  //prepareTime over the wall time of every prepare thread
+        double applyTime;           //main thread between getting a job and asking for the next
+        double applyWaitTime;       //main thread waiting for jobs to be prepared
+        double applyUtilization;    //applyTime over the wall time
+    };
+
+    //numPrepareThreads 0 uses one thread fewer than the hardware has, leaving one to the main thread.
+    //At most capacity rigs are prepared ahead of the one being applied
+    RigUpdatePipeline(bool forceUpdate, unsigned int numPrepareThreads = 0, unsigned int capacity = 4);
+    //stops the prepare threads, dropping the jobs that weren't applied
+    ~RigUpdatePipeline();
+
+    //adds a rig to update, in the order they are to be applied. Jobs must all be added before start
+    void addJob(MObject rootNodeObj, MString xmlPath, float nodeVersion);
+    void start();
+    //waits for the next job to be prepared and returns it, NULL once every job was returned.
+    //The job before it is done with, its rig is released. Main thread only
+    Job * next();
+
+    unsigned int getNumJobs() const {return (unsigned int)m_jobs.size();};
+    unsigned int getNumPrepareThreads() const {return m_numPrepareThreads;};
+    Report getReport() const;
+
+private:
+    RigUpdatePipeline(const RigUpdatePipeline &);
+    RigUpdatePipeline & operator=(const RigUpdatePipeline &);
+
+    //the queue, threads and locks, kept out of the header with the platform's threading
+    struct State;
+    static void prepareThreadMain(void * pipeline);
+    void prepareLoop();
+    void prepare(Job & job);
+
+    bool m_forceUpdate;
+    unsigned int m_numPrepareThreads;
+    unsigned int m_capacity;
+    std::vector<Job*> m_jobs;
+    State * m_state;
+    //main thread bookkeeping
+    double m_startTime;
+    double m_endTime;
+    double m_takenTime; //when the job being applied was returned
+    double m_applyTime; //seconds the main thread spent between getting a job and asking for the next
+    double m_applyWaitTime; //seconds the main thread waited for jobs to be prepared
+};
+
+#endif //_RigUpdatePipeline
@@ -0,0 +1,38 @@
+/***************************************************************
+* Summary: Narrow interface to the scene a rig is built in,    *
+*          covering node creation, connections, plug values,   *
+*          DAG parenting and metadata queries. It uses no Maya *
+*          types so that the rig logic written against it can *
+*          run outside of a Maya session.                      *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "SceneBackend.h"
+
+SceneBackend::NodeId SceneBackend::getMetaNodeConnection(NodeId metaNode, const std::string & attr) {
+    std::vector<NodeId> nodes;
+    this->getConnectedNodes(metaNode, attr, true, nodes);
+    if(nodes.empty())
+        return kNullNode;
+    return nodes[0];
+}
+
+SceneBackend::NodeId SceneBackend::getMetaParent(NodeId metaNode) {
+    std::vector<NodeId> nodes;
+    this->getConnectedNodes(metaNode, "metaParent", false, nodes);
+    if(nodes.empty())
+        return kNullNode;
+    return nodes[0];
+}
+
+void SceneBackend::getMetaChildren(NodeId metaNode, std::vector<NodeId> & metaChildren) {
+    this->getConnectedNodes(metaNode, "metaChildren", true, metaChildren);
+}
+
+bool SceneBackend::connectMeta(NodeId metaNode, const std::string & attr, NodeId node) {
+    if(!this->hasAttribute(node, "metaParent")) {
+        if(!this->addMessageAttribute(node, "metaParent"))
+            return false;
+    }
+    return this->connect(metaNode, attr, node, "metaParent");
+}
@@ -0,0 +1,68 @@
+/***************************************************************
+* Summary: Narrow interface to the scene a rig is built in,    *
+*          covering node creation, connections, plug values,   *
+*          DAG parenting and metadata queries. It uses no Maya *
+*          types so that the rig logic written against it can *
+*          run outside of a Maya session.                      *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _SceneBackend
+#define _SceneBackend
+
+#include <string>
+#include <vector>
+
+class SceneBackend
+{
+public:
+    //handle to a node owned by the backend
+    typedef int NodeId;
+    static const NodeId kNullNode = -1;
+
+    virtual ~SceneBackend() {};
+
+    //node creation and naming
+    virtual NodeId createNode(const std::string & type, const std::string & name) = 0;
+    //creates a dag node under parent (kNullNode for the world)
+    virtual NodeId createDagNode(const std::string & type, const std::string & name, NodeId parent = kNullNode) = 0;
+    virtual bool deleteNode(NodeId node) = 0;
+    virtual bool isValid(NodeId node) = 0;
+    virtual std::string getName(NodeId node) = 0;
+    virtual bool setName(NodeId node, const std::string & name) = 0;
+    virtual std::string getType(NodeId node) = 0;
+    //returns kNullNode if no node has the name
+    virtual NodeId findNode(const std::string & name) = 0;
+    virtual void listNodes(const std::string & type, std::vector<NodeId> & nodes) = 0;
+
+    //dag parenting
+    virtual bool setParent(NodeId node, NodeId parent) = 0;
+    virtual NodeId getParent(NodeId node) = 0;
+    virtual void getChildren(NodeId node, std::vector<NodeId> & children) = 0;
+
+    //attributes and plug values
+    virtual bool addMessageAttribute(NodeId node, const std::string & attr) = 0;
+    virtual bool hasAttribute(NodeId node, const std::string & attr) = 0;
+    virtual bool setDouble(NodeId node, const std::string & attr, double value) = 0;
+    virtual bool getDouble(NodeId node, const std::string & attr, double & value) = 0;
+    virtual bool setString(NodeId node, const std::string & attr, const std::string & value) = 0;
+    virtual bool getString(NodeId node, const std::string & attr, std::string & value) = 0;
+
+    //connections
+    virtual bool connect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) = 0;
+    virtual bool disconnect(NodeId srcNode, const std::string & srcAttr, NodeId dstNode, const std::string & dstAttr) = 0;
+    //nodes connected to node.attr, the destinations of its outgoing connections when asSource is true,
+    //otherwise the sources of its incoming connections
+    virtual void getConnectedNodes(NodeId node, const std::string & attr, bool asSource, std::vector<NodeId> & nodes) = 0;
+
+    //metadata queries, built on the connections above
+    //the first node whose metaParent is connected to metaNode.attr
+    NodeId getMetaNodeConnection(NodeId metaNode, const std::string & attr);
+    //the meta data node whose metaChildren connects to metaNode
+    NodeId getMetaParent(NodeId metaNode);
+    void getMetaChildren(NodeId metaNode, std::vector<NodeId> & metaChildren);
+    //adds a metaParent attribute to node and connects it to metaNode.attr
+    bool connectMeta(NodeId metaNode, const std::string & attr, NodeId node);
+};
+
+#endif //_SceneBackend
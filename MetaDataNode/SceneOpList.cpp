@@ -0,0 +1,635 @@
+/***************************************************************
+* Summary: Records the scene operations issued while building  *
+*          a rig so that redundant work can be optimized away  *
+*          as a batch before the operations are applied to the *
+*          Maya scene.                                         *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "SceneOpList.h"
+#include "LoadRigUtils.h"
+#include "DisplayLayers.h"
+#include "JointOrient.h"
+#include "HierarchyPlan.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "NodeNameIndex.h"
+#include <maya/MGlobal.h>
+#include <maya/MDagModifier.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnTransform.h>
+#include <maya/MFnIkJoint.h>
+#include <maya/MFnNurbsCurve.h>
+#include <maya/MFnMessageAttribute.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MPointArray.h>
+#include <maya/MPoint.h>
+#include <maya/MDagPath.h>
+#include <map>
+
+SceneOpList::Report SceneOpList::s_sessionReport;
+
+SceneOpList::Report::Report() {
+    opsIn = 0;
+    opsOut = 0;
+    fusedCreates = 0;
+    fusedScales = 0;
+    droppedIdentityScales = 0;
+    mergedLookups = 0;
+    droppedDeadStores = 0;
+    droppedDuplicates = 0;
+    droppedSelects = 0;
+    coalescedParents = 0;
+    fusedParents = 0;
+}
+
+void SceneOpList::Report::add(const Report & other) {
+    opsIn += other.opsIn;
+    opsOut += other.opsOut;
+    fusedCreates += other.fusedCreates;
+    fusedScales += other.fusedScales;
+    droppedIdentityScales += other.droppedIdentityScales;
+    mergedLookups += other.mergedLookups;
+    droppedDeadStores += other.droppedDeadStores;
+    droppedDuplicates += other.droppedDuplicates;
+    droppedSelects += other.droppedSelects;
+    coalescedParents += other.coalescedParents;
+    fusedParents += other.fusedParents;
+}
+
+MString SceneOpList::Report::toString() const {
+    MString msg;
+    msg += "ops in: "; msg += (int)opsIn;
+    msg += ", ops out: "; msg += (int)opsOut;
+    msg += " (create+rename fused: "; msg += (int)fusedCreates;
+    msg += ", scale+makeIdentity fused: "; msg += (int)fusedScales;
+    msg += ", identity scales: "; msg += (int)droppedIdentityScales;
+    msg += ", lookups merged: "; msg += (int)mergedLookups;
+    msg += ", dead stores: "; msg += (int)droppedDeadStores;
+    msg += ", duplicates: "; msg += (int)droppedDuplicates;
+    msg += ", selects: "; msg += (int)droppedSelects;
+    msg += ", reparents coalesced: "; msg += (int)coalescedParents;
+    msg += ", created under final parent: "; msg += (int)fusedParents;
+    msg += ")";
+    return msg;
+}
+
+SceneOpList::SceneOpList() {
+
+}
+
+SceneOpList::~SceneOpList() {
+    this->m_ops.clear();
+    this->m_nodes.clear();
+}
+
+SceneOpList::NodeRef SceneOpList::addExisting(MObject obj) {
+    this->m_nodes.push_back(obj);
+    return (NodeRef)this->m_nodes.size() - 1;
+}
+
+SceneOpList::NodeRef SceneOpList::createNode(MString type, NodeRef parent) {
+    NodeRef node = this->addExisting(MObject::kNullObj);
+    Op & op = this->record(kCreate, node, parent);
+    op.text = type;
+    return node;
+}
+
+SceneOpList::NodeRef SceneOpList::lookup(MString name) {
+    NodeRef node = this->addExisting(MObject::kNullObj);
+    Op & op = this->record(kLookup, node);
+    op.text = name;
+    return node;
+}
+
+MObject SceneOpList::getObject(NodeRef node) {
+    if( node < 0 || node >= (NodeRef)this->m_nodes.size() ) {
+        return MObject::kNullObj;
+    }
+    return this->m_nodes.at(node);
+}
+
+SceneOpList::Op & SceneOpList::record(OpType type, NodeRef node, NodeRef target) {
+    Op op;
+    op.type = type;
+    op.node = node;
+    op.target = target;
+    op.world = false;
+    op.live = true;
+    this->m_ops.push_back(op);
+    return this->m_ops.back();
+}
+
+void SceneOpList::rename(NodeRef node, MString name) {
+    this->record(kRename, node).name = name;
+}
+
+void SceneOpList::selectClear() {
+    this->record(kSelectClear, kWorld);
+}
+
+void SceneOpList::setTranslation(NodeRef node, MVector translation) {
+    this->record(kSetTranslation, node).vec = translation;
+}
+
+void SceneOpList::setRotation(NodeRef node, MVector rotation) {
+    this->record(kSetRotation, node).vec = rotation;
+}
+
+void SceneOpList::setScale(NodeRef node, MVector scale) {
+    this->record(kSetScale, node).vec = scale;
+}
+
+void SceneOpList::makeIdentity(NodeRef node) {
+    this->record(kMakeIdentity, node);
+}
+
+void SceneOpList::parent(NodeRef node, NodeRef parentNode) {
+    this->record(kParent, node, parentNode);
+}
+
+void SceneOpList::addMetaParent(NodeRef node) {
+    this->record(kAddMetaParent, node);
+}
+
+void SceneOpList::connectMeta(MPlug metaDataPlug, NodeRef node) {
+    this->record(kConnectMeta, node).plug = metaDataPlug;
+}
+
+void SceneOpList::addToLayer(MString layerName, NodeRef node) {
+    this->record(kAddToLayer, node).text = layerName;
+}
+
+void SceneOpList::orientJoint(NodeRef node) {
+    this->record(kOrientJoint, node);
+}
+
+void SceneOpList::setJointOrient(NodeRef node, MQuaternion orient, MVector translation) {
+    Op & op = this->record(kSetJointOrient, node);
+    op.orient = orient;
+    op.vec = translation;
+}
+
+void SceneOpList::command(MString mel) {
+    this->record(kCommand, kWorld).text = mel;
+}
+
+unsigned int SceneOpList::numLiveOps() {
+    unsigned int num = 0;
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        if(this->m_ops[i].live)
+            num++;
+    }
+    return num;
+}
+
+bool SceneOpList::touches(const Op & op, NodeRef node) {
+    if( node == kWorld )
+        return false;
+    return (op.node == node || op.target == node);
+}
+
+bool SceneOpList::definedBefore(NodeRef node, unsigned int index) {
+    if( node == kWorld || !this->getObject(node).isNull() )
+        return true;
+    for(unsigned int i = 0; i < index && i < this->m_ops.size(); i++) {
+        const Op & op = this->m_ops[i];
+        if(op.live && op.node == node && (op.type == kCreate || op.type == kLookup))
+            return true;
+    }
+    return false;
+}
+
+void SceneOpList::replaceRef(unsigned int start, NodeRef oldRef, NodeRef newRef) {
+    for(unsigned int i = start; i < this->m_ops.size(); i++) {
+        if(this->m_ops[i].node == oldRef)
+            this->m_ops[i].node = newRef;
+        if(this->m_ops[i].target == oldRef)
+            this->m_ops[i].target = newRef;
+    }
+}
+
+SceneOpList::Report SceneOpList::optimize() {
+    Report report;
+    report.opsIn = this->numLiveOps();
+
+    this->mergeLookups(report);
+    this->fuseCreateRename(report);
+    this->fuseScaleIdentity(report);
+    this->dropDeadStores(report);
+    this->coalesceParents(report);
+    this->fuseCreateParent(report);
+    this->dropDuplicates(report);
+    this->dropDeadSelects(report);
+
+    report.opsOut = this->numLiveOps();
+    return report;
+}
+
+// A lookup of a name that was already looked up is answered by the first lookup,
+// as long as no rename or MEL command in between could have changed what the name
+// refers to.
+void SceneOpList::mergeLookups(Report & report) {
+    std::map<std::string, NodeRef> seen;
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & op = this->m_ops[i];
+        if(!op.live)
+            continue;
+        if(op.type == kRename || op.type == kCommand || op.type == kCreate) {
+            seen.clear();
+        } else if(op.type == kLookup) {
+            std::string name(op.text.asChar());
+            std::map<std::string, NodeRef>::iterator itr = seen.find(name);
+            if(itr != seen.end()) {
+                op.live = false;
+                this->replaceRef(i+1, op.node, itr->second);
+                report.mergedLookups++;
+            } else {
+                seen[name] = op.node;
+            }
+        }
+    }
+}
+
+// A node that is created and then renamed is created with its final name.
+// Names are read by MEL commands and by lookups, so the search stops at either.
+void SceneOpList::fuseCreateRename(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & create = this->m_ops[i];
+        if(!create.live || create.type != kCreate)
+            continue;
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & op = this->m_ops[j];
+            if(!op.live)
+                continue;
+            if(op.type == kCommand || op.type == kLookup)
+                break;
+            if(op.type == kRename && op.node == create.node) {
+                create.name = op.name;
+                op.live = false;
+                report.fusedCreates++;
+            }
+        }
+    }
+}
+
+// setScale followed by makeIdentity on the same node is a scale baked into the
+// node's shapes, which can be done directly on the CVs without touching the
+// selection or going through MEL.
+void SceneOpList::fuseScaleIdentity(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & identity = this->m_ops[i];
+        if(!identity.live || identity.type != kMakeIdentity)
+            continue;
+        for(int j = (int)i-1; j >= 0; j--) {
+            Op & op = this->m_ops[j];
+            if(!op.live)
+                continue;
+            if(op.type == kCommand)
+                break;
+            if(op.type == kSetScale && op.node == identity.node) {
+                identity.type = kBakeScale;
+                identity.vec = op.vec;
+                op.live = false;
+                report.fusedScales++;
+                //an identity scale leaves nothing to bake
+                if(identity.vec == MVector(1.0,1.0,1.0)) {
+                    identity.live = false;
+                    report.droppedIdentityScales++;
+                }
+                break;
+            }
+            //any other use of the node's transform ends the search
+            if(this->touches(op, identity.node) && op.type != kRename && op.type != kAddMetaParent
+                && op.type != kConnectMeta && op.type != kAddToLayer)
+                break;
+        }
+    }
+}
+
+// A rename or transform write that is overwritten by a later write of the same kind,
+// with nothing in between that could observe it, is dead.
+void SceneOpList::dropDeadStores(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & store = this->m_ops[i];
+        if(!store.live)
+            continue;
+        if(store.type != kRename && store.type != kSetTranslation && store.type != kSetRotation && store.type != kSetScale)
+            continue;
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & op = this->m_ops[j];
+            if(!op.live)
+                continue;
+            if(op.type == kCommand)
+                break;
+            if(op.type == store.type && op.node == store.node) {
+                store.live = false;
+                report.droppedDeadStores++;
+                break;
+            }
+            //a lookup finds nodes by the names they have when it runs
+            if(store.type == kRename && op.type == kLookup)
+                break;
+            //transform values are read by any op that computes world space positions
+            if(store.type != kRename) {
+                if(op.type == kParent || op.type == kOrientJoint || op.type == kSetJointOrient || op.type == kMakeIdentity || op.type == kBakeScale)
+                    break;
+            }
+        }
+    }
+}
+
+// Parenting a node and then parenting it again is a single parent to the final
+// parent, as long as nothing moved in between. Parenting a node under the parent it
+// already has is dropped.
+void SceneOpList::coalesceParents(Report & report) {
+    std::map<NodeRef, NodeRef> knownParents;
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & op = this->m_ops[i];
+        if(!op.live)
+            continue;
+        if(op.type == kCreate) {
+            knownParents[op.node] = op.target;
+            continue;
+        }
+        if(op.type != kParent)
+            continue;
+        std::map<NodeRef, NodeRef>::iterator itr = knownParents.find(op.node);
+        if(itr != knownParents.end() && itr->second == op.target) {
+            op.live = false;
+            report.coalescedParents++;
+            continue;
+        }
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & next = this->m_ops[j];
+            if(!next.live)
+                continue;
+            if(next.type == kCommand || next.type == kOrientJoint || next.type == kSetJointOrient || next.type == kBakeScale || next.type == kMakeIdentity)
+                break;
+            if(next.type == kSetTranslation || next.type == kSetRotation || next.type == kSetScale)
+                break;
+            if(next.type == kParent && next.node == op.node) {
+                op.live = false;
+                report.coalescedParents++;
+                break;
+            }
+            //another node being parented under or around this one reads its world matrix
+            if(next.type == kParent && this->touches(next, op.node))
+                break;
+        }
+        if(op.live)
+            knownParents[op.node] = op.target;
+    }
+}
+
+// A node created at the world and later parented is created directly under its
+// final parent instead. Translations set in between were world positions, since
+// parent keeps the world transform, so they are marked to be applied in world space.
+// Only nodes without rotation or scale set before the parent can be fused, and
+// the parent must already exist and hold still until the parent op.
+void SceneOpList::fuseCreateParent(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & create = this->m_ops[i];
+        if(!create.live || create.type != kCreate || create.target != kWorld)
+            continue;
+        std::vector<unsigned int> translations;
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & op = this->m_ops[j];
+            if(!op.live)
+                continue;
+            if(op.type == kCommand || op.type == kOrientJoint || op.type == kSetJointOrient)
+                break;
+            if(op.type == kParent && op.node == create.node) {
+                if(op.target != kWorld && this->definedBefore(op.target, i)) {
+                    create.target = op.target;
+                    op.live = false;
+                    for(unsigned int k = 0; k < translations.size(); k++)
+                        this->m_ops[translations[k]].world = true;
+                    report.fusedParents++;
+                }
+                break;
+            }
+            if(op.node == create.node) {
+                if(op.type == kSetTranslation) {
+                    translations.push_back(j);
+                    continue;
+                }
+                if(op.type == kRename || op.type == kAddMetaParent || op.type == kConnectMeta || op.type == kAddToLayer)
+                    continue;
+                break;
+            }
+            //anything moving another node could be moving the future parent
+            if(op.type == kParent || op.type == kSetTranslation || op.type == kSetRotation || op.type == kSetScale ||
+                op.type == kMakeIdentity || op.type == kBakeScale || op.target == create.node)
+                break;
+        }
+    }
+}
+
+// Membership, attribute and connection ops are idempotent, so repeats are dropped.
+void SceneOpList::dropDuplicates(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & op = this->m_ops[i];
+        if(!op.live)
+            continue;
+        if(op.type != kAddToLayer && op.type != kAddMetaParent && op.type != kConnectMeta)
+            continue;
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & dup = this->m_ops[j];
+            if(!dup.live || dup.type != op.type || dup.node != op.node)
+                continue;
+            if(op.type == kAddToLayer && dup.text != op.text)
+                continue;
+            if(op.type == kConnectMeta && dup.plug != op.plug)
+                continue;
+            dup.live = false;
+            report.droppedDuplicates++;
+        }
+    }
+}
+
+// Only MEL commands can read or change the selection, so a selection clear that is
+// followed by another clear before any command is dead.
+void SceneOpList::dropDeadSelects(Report & report) {
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        Op & op = this->m_ops[i];
+        if(!op.live || op.type != kSelectClear)
+            continue;
+        for(unsigned int j = i+1; j < this->m_ops.size(); j++) {
+            Op & next = this->m_ops[j];
+            if(!next.live)
+                continue;
+            if(next.type == kCommand)
+                break;
+            if(next.type == kSelectClear) {
+                op.live = false;
+                report.droppedSelects++;
+                break;
+            }
+        }
+    }
+}
+
+MStatus SceneOpList::flush() {
+    RigProfileScope profileScope("SceneOpList::flush");
+    MStatus status = MS::kSuccess;
+
+    Report report = this->optimize();
+    this->m_report.add(report);
+    s_sessionReport.add(report);
+
+    for(unsigned int i = 0; i < this->m_ops.size(); i++) {
+        if(!this->m_ops[i].live)
+            continue;
+        MStatus opStatus = this->applyOp(this->m_ops[i]);
+        if(opStatus != MS::kSuccess)
+            status = opStatus;
+    }
+    this->m_ops.clear();
+
+    return status;
+}
+
+MStatus SceneOpList::applyOp(const Op & op) {
+    MStatus status = MS::kSuccess;
+    MObject obj = this->getObject(op.node);
+
+    switch(op.type) {
+    case kCreate: {
+        MDagModifier dagMod;
+        MObject parentObj = this->getObject(op.target);
+        obj = dagMod.createNode( op.text, parentObj, &status );
+        MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
+        if(op.name.length() > 0) {
+            dagMod.renameNode(obj, op.name);
+        }
+        status = lrutils::doIt(dagMod);
+        this->m_nodes[op.node] = obj;
+        NodeNameIndex::add(obj);
+        break;
+    }
+    case kLookup:
+        status = lrutils::getObjFromName(op.text, this->m_nodes[op.node]);
+        break;
+    case kRename: {
+        MFnDependencyNode nodeFn( obj );
+        nodeFn.setName( op.name, false, &status );
+        break;
+    }
+    case kSelectClear:
+        status = MGlobal::clearSelectionList();
+        break;
+    case kSetTranslation: {
+        MFnTransform transformFn( obj );
+        MVector translation = op.vec;
+        if(op.world) {
+            MDagPath path;
+            MDagPath::getAPathTo(obj, path);
+            translation = MPoint(op.vec) * path.exclusiveMatrixInverse();
+        }
+        status = transformFn.setTranslation(translation, MSpace::kTransform);
+        break;
+    }
+    case kSetRotation: {
+        MFnTransform transformFn( obj );
+        status = transformFn.setRotation( MEulerRotation(op.vec) );
+        break;
+    }
+    case kSetScale: {
+        MFnTransform transformFn( obj );
+        double scale[3];
+        op.vec.get(scale);
+        status = transformFn.setScale(scale);
+        break;
+    }
+    case kMakeIdentity: {
+        MFnDagNode dagFn( obj );
+        status = lrutils::executeCommand("makeIdentity -s true -apply true "+dagFn.fullPathName()+";");
+        break;
+    }
+    case kBakeScale:
+        status = this->bakeScale(obj, op.vec);
+        break;
+    case kParent: {
+        status = HierarchyPlan::reparent(obj, this->getObject(op.target));
+        break;
+    }
+    case kAddMetaParent: {
+        MFnMessageAttribute mAttr;
+        MFnDependencyNode nodeFn( obj );
+        status = nodeFn.addAttribute( mAttr.create("metaParent", "metaParent") );
+        break;
+    }
+    case kConnectMeta: {
+        MDGModifier dgMod;
+        MFnDependencyNode nodeFn( obj );
+        status = dgMod.connect( op.plug, lrutils::findPlug(nodeFn, "metaParent") );
+        MyCheckStatusReturn(status, "connect failed");
+        status = lrutils::doIt(dgMod);
+        break;
+    }
+    case kAddToLayer: {
+        if(op.text.length() == 0)
+            break;
+        status = lrutils::addToDisplayLayer(op.text, obj);
+        break;
+    }
+    case kOrientJoint: {
+        status = lrutils::orientJointChain(obj);
+        break;
+    }
+    case kSetJointOrient: {
+        MFnIkJoint jointFn( obj );
+        jointFn.setRotation( MEulerRotation(0, 0, 0) );
+        jointFn.setScaleOrientation( MQuaternion::identity );
+        status = jointFn.setOrientation( op.orient );
+        MyCheckStatusReturn(status, "MFnIkJoint.setOrientation() failed");
+        status = jointFn.setTranslation( op.vec, MSpace::kTransform );
+        break;
+    }
+    case kCommand:
+        status = lrutils::executeCommand(op.text);
+        break;
+    }
+
+    return status;
+}
+
+MStatus SceneOpList::bakeScale(MObject obj, MVector scale) {
+    MStatus status = MS::kSuccess;
+    MFnDagNode dagFn( obj, &status );
+    MyCheckStatusReturn(status, "invalid MObject provided for MFnDagNode");
+
+    //makeIdentity also pushes the scale down into child transforms and freezes every kind
+    //of shape, only curve CVs are scaled here, so fall back to the command for anything else
+    for(unsigned int i = 0; i < dagFn.childCount(); i++) {
+        MObject childObj = dagFn.child(i);
+        if(!childObj.hasFn(MFn::kNurbsCurve)) {
+            MFnTransform transformFn( obj );
+            double dScale[3];
+            scale.get(dScale);
+            transformFn.setScale(dScale);
+            return lrutils::executeCommand("makeIdentity -s true -apply true "+dagFn.fullPathName()+";");
+        }
+    }
+
+    for(unsigned int i = 0; i < dagFn.childCount(); i++) {
+        MObject childObj = dagFn.child(i);
+        if(!childObj.hasFn(MFn::kNurbsCurve))
+            continue;
+        MFnNurbsCurve curveFn( childObj );
+        MPointArray cvs;
+        status = curveFn.getCVs(cvs, MSpace::kObject);
+        MyCheckStatusReturn(status, "MFnNurbsCurve.getCVs() failed");
+        for(unsigned int j = 0; j < cvs.length(); j++) {
+            cvs[j].x *= scale.x;
+            cvs[j].y *= scale.y;
+            cvs[j].z *= scale.z;
+        }
+        status = curveFn.setCVs(cvs, MSpace::kObject);
+        MyCheckStatusReturn(status, "MFnNurbsCurve.setCVs() failed");
+        curveFn.updateCurve();
+    }
+
+    return status;
+}
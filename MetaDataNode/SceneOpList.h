@@ -0,0 +1,145 @@
+/***************************************************************
+* Summary: Records the scene operations issued while building  *
+*          a rig so that redundant work can be optimized away  *
+*          as a batch before the operations are applied to the *
+*          Maya scene.                                         *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _SceneOpList
+#define _SceneOpList
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+#include <maya/MVector.h>
+#include <maya/MQuaternion.h>
+#include <maya/MPlug.h>
+#include <vector>
+
+class SceneOpList
+{
+public:
+    //reference to a node used by the op list, either an existing scene node
+    //or a node that will be created or looked up when the list is applied
+    typedef int NodeRef;
+    static const NodeRef kWorld = -1;
+
+    enum OpType {
+        kCreate,            //create a dag node of type text under target, named name
+        kLookup,            //find an existing node by the name held in text
+        kRename,            //rename node to name
+        kSelectClear,       //clear the active selection list
+        kSetTranslation,    //set the local translation of node to vec
+        kSetRotation,       //set the rotation of node to vec (radians)
+        kSetScale,          //set the scale of node to vec
+        kMakeIdentity,      //freeze the scale of node into its shapes
+        kBakeScale,         //setScale + makeIdentity fused, scales the shape CVs of node by vec
+        kParent,            //parent node under target (kWorld for the scene root)
+        kAddMetaParent,     //add a metaParent message attribute to node
+        kConnectMeta,       //connect plug to the metaParent attribute of node
+        kAddToLayer,        //add node to the display layer named text
+        kOrientJoint,       //orient the joint chain starting at node
+        kSetJointOrient,    //zero the rotation of joint node, set its orient to orient and its local translation to vec
+        kCommand            //arbitrary MEL command held in text, treated as a barrier
+    };
+
+    struct Op
+    {
+        OpType type;
+        NodeRef node;
+        NodeRef target;
+        MString text;
+        MString name;
+        MVector vec;
+        MQuaternion orient;
+        MPlug plug;
+        bool world;         //vec of a kSetTranslation is in world space
+        bool live;
+    };
+
+    //summary of the work done by the optimizer
+    struct Report
+    {
+        Report();
+        void add(const Report & other);
+        MString toString() const;
+        unsigned int opsIn;
+        unsigned int opsOut;
+        unsigned int fusedCreates;
+        unsigned int fusedScales;
+        unsigned int droppedIdentityScales; //fused scales of 1 that left nothing to bake
+        unsigned int mergedLookups;
+        unsigned int droppedDeadStores;
+        unsigned int droppedDuplicates;
+        unsigned int droppedSelects;
+        unsigned int coalescedParents;
+        unsigned int fusedParents;
+    };
+
+    SceneOpList();
+    ~SceneOpList();
+
+    //node references
+    NodeRef addExisting(MObject obj);
+    NodeRef createNode(MString type, NodeRef parent = kWorld);
+    NodeRef lookup(MString name);
+    //returns the scene object for a node reference, valid once the op creating it has been flushed
+    MObject getObject(NodeRef node);
+
+    //recorded operations
+    void rename(NodeRef node, MString name);
+    void selectClear();
+    void setTranslation(NodeRef node, MVector translation);
+    void setRotation(NodeRef node, MVector rotation);
+    void setScale(NodeRef node, MVector scale);
+    void makeIdentity(NodeRef node);
+    void parent(NodeRef node, NodeRef parentNode);
+    void addMetaParent(NodeRef node);
+    void connectMeta(MPlug metaDataPlug, NodeRef node);
+    void addToLayer(MString layerName, NodeRef node);
+    void orientJoint(NodeRef node);
+    //sets an orient lrutils::solveJointOrients computed ahead of time
+    void setJointOrient(NodeRef node, MQuaternion orient, MVector translation);
+    void command(MString mel);
+
+    unsigned int getNumPendingOps() {return (unsigned int)m_ops.size();};
+    //the ops recorded since the last flush, as the optimizer left them
+    const std::vector<Op> & getPendingOps() const {return m_ops;};
+    //runs the peephole optimizer over the pending ops without applying them
+    Report optimize();
+    //optimizes the pending ops, applies them to the scene, and clears them
+    MStatus flush();
+    //totals of every flush made by this list
+    Report getReport() {return m_report;};
+
+    //totals of every flush made by any list since the last reset
+    static Report getSessionReport() {return s_sessionReport;};
+    static void resetSessionReport() {s_sessionReport = Report();};
+
+private:
+    Op & record(OpType type, NodeRef node, NodeRef target = kWorld);
+    unsigned int numLiveOps();
+    bool touches(const Op & op, NodeRef node);
+    bool definedBefore(NodeRef node, unsigned int index);
+    void replaceRef(unsigned int start, NodeRef oldRef, NodeRef newRef);
+    //optimizer passes
+    void mergeLookups(Report & report);
+    void fuseCreateRename(Report & report);
+    void fuseScaleIdentity(Report & report);
+    void dropDeadStores(Report & report);
+    void coalesceParents(Report & report);
+    void fuseCreateParent(Report & report);
+    void dropDuplicates(Report & report);
+    void dropDeadSelects(Report & report);
+    //applies a single op to the scene
+    MStatus applyOp(const Op & op);
+    MStatus bakeScale(MObject obj, MVector scale);
+
+    std::vector<Op> m_ops;
+    std::vector<MObject> m_nodes;
+    Report m_report;
+    static Report s_sessionReport;
+};
+
+#endif //_SceneOpList
@@ -9,16 +9,27 @@
 #include "MDHipNode.h"
 #include "MDSpineNode.h"
 #include "SpineComponent.h"
+#include "MetaRootNode.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include <string>
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 #include "LoadRigUtils.h"
+#include "ControllerShapes.h"
+#include "DisplayLayers.h"
+#include "JointOrient.h"
+#include "SplineIK.h"
+#include "HierarchyPlan.h"
+#include "Constraints.h"
+#include "GuideTransforms.h"
 #include <maya/MFnNurbsCurve.h>
 #include <maya/MFnMessageAttribute.h>
 #include <maya/MPlug.h>
 #include <maya/MDagPath.h>
+#include <maya/MDagModifier.h>
 #include <maya/MMatrix.h>
+#include <maya/MObjectHandle.h>
 #include <map>
 
 using namespace std;
@@ -32,16 +43,16 @@ SpineComponent::~SpineComponent() {
 }
 
 MObject SpineComponent::loadComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("SpineComponent::loadComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status = MS::kFailure;
     //get the metaRoot node of this rig
     MObject metaRootObj;
     status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
     //get the extras layer from the meta root
     MObject extrasLayerObj;
-    status = lrutils::getMetaNodeConnection(metaRootObj, extrasLayerObj, "extrasLayer");
+    status = lrutils::getMetaNodeConnection(metaRootObj, extrasLayerObj, MetaRootNode::extrasLayer);
     MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-    MFnDependencyNode extrasLayerFn(extrasLayerObj);
-    MString extrasLayerName = extrasLayerFn.name();
 
     //used for creating metaParent attributes for objects
     MFnMessageAttribute mAttr;
@@ -52,7 +63,7 @@ MObject SpineComponent::loadComponent(MDGModifier & dgMod) {
 
     this->m_metaDataNode = dgMod.createNode( "MDSpineNode", &status );
     MyCheckStatus(status, "createNode failed");
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
 
     MString metaNodeName = "MSN_";
     metaNodeName += this->m_rigName + "_";
@@ -61,32 +72,32 @@ MObject SpineComponent::loadComponent(MDGModifier & dgMod) {
 
     //set the meta data node's attributes
     MFnDependencyNode depMetaDataNodeFn(this->m_metaDataNode);
-    status = dgMod.newPlugValueFloat( depMetaDataNodeFn.findPlug("version"), this->m_pCompGuide->getVersion() );
+    status = dgMod.newPlugValueFloat( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion), this->m_pCompGuide->getVersion() );
     MyCheckStatus(status, "newPlugValueFloat() failed");
-    status = dgMod.newPlugValueString( depMetaDataNodeFn.findPlug("rigId"), this->m_pCompGuide->getRigId() );
+    status = dgMod.newPlugValueString( MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kRigId), this->m_pCompGuide->getRigId() );
     MyCheckStatus(status, "newPlugValueString() failed");
-    status = dgMod.newPlugValueString( depMetaDataNodeFn.findPlug("KinematicType"), spineGuide->getKinematicType() );
+    status = dgMod.newPlugValueString( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::KinematicType), spineGuide->getKinematicType() );
     MyCheckStatus(status, "newPlugValueString() failed");
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
 
 
     if(spineGuide->getKinematicType() == "splineIK" || spineGuide->getKinematicType() == "stretchySplineIK") {
         //create the spine's joints
         //create the spline IK joints that are also used for binding
         MString prefix = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_splineIK_BIND";
-        MPlug metaDataPlug = depMetaDataNodeFn.findPlug("BindJoints");
+        MPlug metaDataPlug(this->m_metaDataNode, MDSpineNode::BindJointArray);
         MObject metaDataParentNode = this->m_pParentComp->getMetaDataNode();
         MObject parentJoint;
         status = lrutils::getJointByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentJoint);
         MyCheckStatus(status, "lrutils::getJointByNum() failed");
-        m_vBindJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, parentJoint);
-        MGlobal::executeCommand("select -cl;");
+        m_vBindJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, parentJoint, "", this->getBuildPlan());
+        lrutils::executeCommand("select -cl;");
 
         MFnDependencyNode metaDataParentFn( metaDataParentNode );
         if(metaDataParentFn.typeId() == MDHipNode::id) {
             //create the hip joint copy
             MObject rigGroupObj;
-            status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, "rigGroup");
+            status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, MetaRootNode::rigGroup);
             MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
             prefix = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_HipJointCopy";
             this->m_hipJointCopyObj = lrutils::createJointFromLocation(this->m_pParentComp->getCompGuide()->getLocation(0),prefix,0,rigGroupObj);
@@ -94,76 +105,75 @@ MObject SpineComponent::loadComponent(MDGModifier & dgMod) {
             MObject jointAttr = mAttr.create("metaParent", "metaParent");
             hipJointCopyFn.addAttribute(jointAttr);
             //connect the metaparent attribute to the MDSpine node
-            metaDataPlug = depMetaDataNodeFn.findPlug("HipJointCopy");
-            status = dgMod.connect( metaDataPlug, hipJointCopyFn.findPlug("metaParent") );
+            metaDataPlug = lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::HipJointCopy);
+            status = dgMod.connect( metaDataPlug, lrutils::findPlug(hipJointCopyFn, "metaParent") );
             MyCheckStatus(status, "connect failed");
-            dgMod.doIt();
-            MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ extrasLayerName+" "+ hipJointCopyFn.name()+";");
-            MGlobal::executeCommand("select -cl;");
+            lrutils::doIt(dgMod);
+            lrutils::addToDisplayLayer(extrasLayerObj, hipJointCopyFn.object());
+            lrutils::executeCommand("select -cl;");
         }
         //create the FK joints
         prefix = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_FK";
-        metaDataPlug = depMetaDataNodeFn.findPlug("FKJoints");
+        metaDataPlug = MPlug(this->m_metaDataNode, MDSpineNode::FKJointArray);
         metaDataParentNode = this->m_pParentComp->getMetaDataNode();
         status = lrutils::getJointByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentJoint);
         MyCheckStatus(status, "lrutils::getJointByNum() failed");
         if(metaDataParentFn.typeId() == MDHipNode::id) {
-            m_vFKJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, this->m_hipJointCopyObj);
+            m_vFKJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, this->m_hipJointCopyObj, "", this->getBuildPlan());
         } else {
-            m_vFKJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug);
+            m_vFKJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, MObject(), "", this->getBuildPlan());
         }
-        MGlobal::executeCommand("select -cl;");
+        lrutils::executeCommand("select -cl;");
         //orient the hip copy joint chain if it exists
         if(!this->m_hipJointCopyObj.isNull()) {
-            MFnTransform hipJointCopyFn( this->m_hipJointCopyObj );
-            MGlobal::executeCommand("joint -e -zso -oj \"xyz\" -sao \"yup\" -ch " + hipJointCopyFn.fullPathName() + ";");
+            lrutils::orientJointChain(this->m_hipJointCopyObj);
         }
-        dgMod.doIt();
+        lrutils::doIt(dgMod);
         this->buildIKSpline(parentJoint,m_vBindJointObjs.back(),m_vFKJointObjs.front(),m_vFKJointObjs.back());
     }
     else if (spineGuide->getKinematicType() == "FK") {
         //create the spine's joints
         //create the spline IK joints that are also used for binding
         MString prefix = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_FK_BIND";
-        MPlug metaDataPlug = depMetaDataNodeFn.findPlug("BindJoints");
+        MPlug metaDataPlug(this->m_metaDataNode, MDSpineNode::BindJointArray);
         MObject metaDataParentNode = this->m_pParentComp->getMetaDataNode();
         MObject parentJoint;
         status = lrutils::getJointByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentJoint);
         MyCheckStatus(status, "lrutils::getJointByNum() failed");
-        m_vBindJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, parentJoint);
-        MGlobal::executeCommand("select -cl;");
+        m_vBindJointObjs = lrutils::buildSkeletonFromGuide(this->m_pCompGuide->getLocations(), prefix, metaDataPlug, parentJoint, "", this->getBuildPlan());
+        lrutils::executeCommand("select -cl;");
         //create the FK controller objects for the FK joint chain
         prefix = this->m_rigName + "_" + this->m_pCompGuide->getName();
         //get the controllers layer from the meta root
         MObject ctlLayerObj;
-        status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, "ctlLayer");
+        status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, MetaRootNode::ctlLayer);
         MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
         MFnDependencyNode ctlLayerFn(ctlLayerObj);
         MString ctlLayerName = ctlLayerFn.name();
-        MGlobal::executeCommand("select -cl;");
+        lrutils::executeCommand("select -cl;");
         //get the hip controller object to parent FK controllers to
         if(metaDataParentFn.typeId() == MDHipNode::id) {
             MObject hipControllerObj;
-            status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerObj, "controller");
+            status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerObj, MDHipNode::controller);
             MFnTransform hipControllerFn(hipControllerObj);
-            lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vBindJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,hipControllerObj, ctlLayerName);
+            lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vBindJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,hipControllerObj, this->getParentControllerMatrix(), ctlLayerName, false, this->getBuildPlan());
         } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
             MObject parentControllerObj;
-            MPlug kinematicTypePlug = metaDataParentFn.findPlug( "KinematicType" );
+            MPlug kinematicTypePlug = lrutils::findPlug(metaDataParentFn, MDSpineNode::KinematicType );
             MString kinematicType;
             kinematicTypePlug.getValue(kinematicType);
             if(kinematicType == "FK") {
                 status = lrutils::getFKControlByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentControllerObj);
                 MyCheckStatus(status, "lrutils::getFKControlByNum() failed");
             } else if (kinematicType == "splineIK" || kinematicType == "stretchySplineIK") {
-                status = lrutils::getMetaNodeConnection(metaDataParentNode, parentControllerObj, "ShoulderControl");
+                status = lrutils::getMetaNodeConnection(metaDataParentNode, parentControllerObj, MDSpineNode::ShoulderControl);
                 MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
             }
-            lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vBindJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode, parentControllerObj, ctlLayerName);
+            lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vBindJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode, parentControllerObj, this->getParentControllerMatrix(), ctlLayerName, false, this->getBuildPlan());
         }
     }
 
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
 
     return this->m_metaDataNode;
 }
@@ -180,24 +190,21 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
     //get the group nodes of this rig
     MObject rigGroupObj;
-    status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, "rigGroup");
+    status = lrutils::getMetaNodeConnection(metaRootObj, rigGroupObj, MetaRootNode::rigGroup);
     MFnTransform rigGroupFn(rigGroupObj);
     MObject ctlGroupObj;
-    status = lrutils::getMetaNodeConnection(metaRootObj,ctlGroupObj, "ctlGroup");
+    status = lrutils::getMetaNodeConnection(metaRootObj,ctlGroupObj, MetaRootNode::ctlGroup);
     MFnTransform ctlGroupFn(ctlGroupObj);
     //get the extras layer from the meta root
     MObject extrasLayerObj;
-    status = lrutils::getMetaNodeConnection(metaRootObj, extrasLayerObj, "extrasLayer");
+    status = lrutils::getMetaNodeConnection(metaRootObj, extrasLayerObj, MetaRootNode::extrasLayer);
     MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
-    MFnDependencyNode extrasLayerFn(extrasLayerObj);
-    MString extrasLayerName = extrasLayerFn.name();
     //get the controllers layer from the meta root
     MObject ctlLayerObj;
-    status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, "ctlLayer");
+    status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, MetaRootNode::ctlLayer);
     MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
     MFnDependencyNode ctlLayerFn(ctlLayerObj);
     MString ctlLayerName = ctlLayerFn.name();
-    MGlobal::executeCommand("select -cl;");
     //used for creating metaParent attributes for objects
     MFnMessageAttribute mAttr;
     MFnDependencyNode depMetaDataNodeFn(this->m_metaDataNode);
@@ -208,31 +215,22 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     SpineComponentGuidePtr spineGuide = boost::dynamic_pointer_cast<SpineComponentGuide>(this->m_pCompGuide);
 
     //create the IK spline solver
-    MString handleName = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_HDL";
+    MString namePrefix = this->m_rigName + "_" + this->m_pCompGuide->getName();
     MStringArray result;
-    MGlobal::executeCommand("ikHandle -n \""+handleName+"\" -sj \""+IKStartJointFn.fullPathName()+"\" -ee \""+IKEndJointFn.fullPathName()+"\" -sol \"ikSplineSolver\" -ns 2 -pcv false;",result);
-    //get the MObjects for all the IK solver components (handle, end effector, curve)
-    status = lrutils::getObjFromName(result[0], m_SplineIKHandleObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-    status = lrutils::getObjFromName(result[1], m_SplineIKEndEffectorObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-    status = lrutils::getObjFromName(result[2], m_SplineIKCurveObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-    //rename the end effector and curve objects
-    dgMod.renameNode(m_SplineIKEndEffectorObj, this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_EFF");
-    dgMod.renameNode(m_SplineIKCurveObj, this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_CRV");
-    dgMod.doIt();
-
-    //set parents for handle and curve
+    status = lrutils::createSplineIK(IKStartJoint, IKEndJoint, 2, ctlGroupObj, namePrefix + "_stretchIK_HDL", namePrefix + "_stretchIK_EFF", namePrefix + "_stretchIK_CRV",
+        m_SplineIKHandleObj, m_SplineIKEndEffectorObj, m_SplineIKCurveObj);
+    MyCheckStatus(status, "lrutils::createSplineIK() failed");
+
+    //set parent for the handle, the curve is created under the controls group
     MFnTransform splineIKHandleFn(m_SplineIKHandleObj);
-    MGlobal::executeCommand("parent " + splineIKHandleFn.fullPathName() + " " + rigGroupFn.fullPathName() + ";");
     MFnTransform splineIKCurveFn(m_SplineIKCurveObj);
-    MGlobal::executeCommand("parent " + splineIKCurveFn.fullPathName() + " " + ctlGroupFn.fullPathName() + ";");
+    MDagModifier dagMod;
+    dagMod.reparentNode(m_SplineIKHandleObj, rigGroupObj);
+    lrutils::doIt(dagMod);
 
     //set the display layers for handle and curve
-    MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ extrasLayerName+" "+ splineIKHandleFn.fullPathName()+";");
-    MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ extrasLayerName+" "+ splineIKCurveFn.fullPathName()+";");
-    MGlobal::executeCommand("select -cl;");
+    lrutils::addToDisplayLayer(extrasLayerObj, splineIKHandleFn.object());
+    lrutils::addToDisplayLayer(extrasLayerObj, splineIKCurveFn.object());
 
     //add the metaParent attributes to the handle, end effector, and curve
     MObject handleAttr = mAttr.create("metaParent", "metaParent");
@@ -244,94 +242,78 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     splineIKCurveFn.addAttribute(curveAttr);
     //set up the meta data node connections to the handle, end effector, and curve
     MPlug metaDataPlug;
-    metaDataPlug = depMetaDataNodeFn.findPlug("SplineIKHandle");
-    status = dgMod.connect( metaDataPlug, splineIKHandleFn.findPlug("metaParent") );
+    metaDataPlug = lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::SplineIKHandle);
+    status = dgMod.connect( metaDataPlug, lrutils::findPlug(splineIKHandleFn, "metaParent") );
     MyCheckStatus(status, "connect failed");
-    metaDataPlug = depMetaDataNodeFn.findPlug("SplineIKEndEffector");
-    status = dgMod.connect( metaDataPlug, splineIKEndEffectorFn.findPlug("metaParent") );
+    metaDataPlug = lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::SplineIKEndEffector);
+    status = dgMod.connect( metaDataPlug, lrutils::findPlug(splineIKEndEffectorFn, "metaParent") );
     MyCheckStatus(status, "connect failed");
-    metaDataPlug = depMetaDataNodeFn.findPlug("SplineIKCurve");
-    status = dgMod.connect( metaDataPlug, splineIKCurveFn.findPlug("metaParent") );
+    metaDataPlug = lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::SplineIKCurve);
+    status = dgMod.connect( metaDataPlug, lrutils::findPlug(splineIKCurveFn, "metaParent") );
     MyCheckStatus(status, "connect failed");
-    dgMod.doIt();
+    lrutils::doIt(dgMod);
     //create the clusters to control the IK spline
     MFnNurbsCurve curveFn(splineIKCurveFn.child(0));
     for (int i = 0; i < curveFn.numCVs(); i++) {
-        MString clusterName = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_"+i+"_CLS";
-        MGlobal::executeCommand("select -r "+curveFn.fullPathName()+".cv["+i+"];");
-        MStringArray result;
-        MGlobal::executeCommand("cluster -n \""+clusterName+"\";",result);
-        MGlobal::executeCommand("editDisplayLayerMembers -noRecurse "+ extrasLayerName+" "+ result[1]+";");
-        //rename the handle
-        MObject clusterHandleObj;
-        lrutils::getObjFromName(result[1],clusterHandleObj);
         MObject clusterObj;
-        lrutils::getObjFromName(result[0],clusterObj);
-        dgMod.renameNode(clusterHandleObj, this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_cluster"+i+"_HDL");
-        dgMod.doIt();
+        MObject clusterHandleObj;
+        status = lrutils::createCVCluster(m_SplineIKCurveObj, i, namePrefix + "_stretchIK_"+i+"_CLS", namePrefix + "_stretchIK_cluster"+i+"_HDL", clusterObj, clusterHandleObj);
+        MyCheckStatus(status, "lrutils::createCVCluster() failed");
+        lrutils::addToDisplayLayer(extrasLayerObj, clusterHandleObj);
         MFnTransform clusterHandleFn(clusterHandleObj);
         clusterHandleFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("SplineIKClusters"), clusterHandleFn.findPlug("metaParent"));
-        dgMod.doIt();
+        status = dgMod.connect( MPlug(this->m_metaDataNode, MDSpineNode::SplineIKClusterArray).elementByLogicalIndex(i), lrutils::findPlug(clusterHandleFn, "metaParent"));
         
         m_vSplineIKClusterObjs.push_back(clusterHandleObj);
     }
+    lrutils::doIt(dgMod);
 
     if(spineGuide->getKinematicType() == "stretchySplineIK") {
         //create the curve info node to get the arc length of the spline
-        MGlobal::executeCommand("arclen -ch true "+curveFn.fullPathName()+";",result);
-        MString splineCurveInfoNodeName = result[0];
         MObject splineCurveInfoNodeObj;
-        status = lrutils::getObjFromName(splineCurveInfoNodeName,splineCurveInfoNodeObj);
-        MyCheckStatus(status,"lrutils::getObjFromName() failed");
+        status = lrutils::createCurveInfo(m_SplineIKCurveObj, namePrefix + "_stretchIK_Curve_INF", splineCurveInfoNodeObj);
+        MyCheckStatus(status,"lrutils::createCurveInfo() failed");
         MFnDependencyNode splineCurveInfoNodeFn(splineCurveInfoNodeObj);
-        splineCurveInfoNodeFn.setName(this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_Curve_INF");
-        double arcLength;
-        MGlobal::executeCommand("getAttr "+splineCurveInfoNodeFn.name()+".arcLength;",arcLength);
+        //the curve is in world space, so its length is the arc length
+        double arcLength = curveFn.length();
         //arc length needs to be normalized to the scaling of the rig group to avoid double length scale
-        status = MGlobal::executeCommand( "python(\"mathNode = Utils.createMultiplyDivide('" + rigGroupFn.name() + ".scaleY','connection',"+arcLength+",'value','*')\");" );
-        status = MGlobal::executeCommand( MString("python(\"mathNode.name()\");"), result );
         MObject arcLengthMultDivNodeObj;
-        status = lrutils::getObjFromName(result[0], arcLengthMultDivNodeObj);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
+        status = lrutils::createMultiplyDivide(lrutils::findPlug(rigGroupFn, "scaleY"), MPlug(), arcLength, 1, namePrefix + "_arcLength_UND", arcLengthMultDivNodeObj);
+        MyCheckStatus(status, "lrutils::createMultiplyDivide() failed");
         MFnDependencyNode arcLengthMultDivNodeFn(arcLengthMultDivNodeObj);
         //connect the math node's metaParent to the MDSpine node
         MObject arcLengthNodeAttr = mAttr.create("metaParent", "metaParent");
         arcLengthMultDivNodeFn.addAttribute(arcLengthNodeAttr);
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("MathNodes"), arcLengthMultDivNodeFn.findPlug("metaParent") );
-        dgMod.doIt();
-        arcLengthMultDivNodeFn.setName(this->m_rigName + "_" + this->m_pCompGuide->getName() + "_arcLength_UND");
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::MathNodes), lrutils::findPlug(arcLengthMultDivNodeFn, "metaParent") );
         //use the arc length to calculate new scale values for the joints to make them reach the spline IK end effector
-        status = MGlobal::executeCommand( "python(\"mathNode = Utils.createMultiplyDivide('" + splineCurveInfoNodeFn.name() + ".arcLength','connection','"+arcLengthMultDivNodeFn.name()+".outputX','connection','/')\");" );
-        status = MGlobal::executeCommand( MString("python(\"mathNode.name()\");"), result );
         MObject stretchIKMultDivNodeObj;
-        status = lrutils::getObjFromName(result[0], stretchIKMultDivNodeObj);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
+        status = lrutils::createMultiplyDivide(lrutils::findPlug(splineCurveInfoNodeFn, "arcLength"), lrutils::findPlug(arcLengthMultDivNodeFn, "outputX"), 0, 2, namePrefix + "_stretchIK_UND", stretchIKMultDivNodeObj);
+        MyCheckStatus(status, "lrutils::createMultiplyDivide() failed");
         MFnDependencyNode stretchIKMultDivNodeFn(stretchIKMultDivNodeObj);
-        stretchIKMultDivNodeFn.setName(this->m_rigName + "_" + this->m_pCompGuide->getName() + "_stretchIK_UND");
         //connect the math node's metaParent to the MDSpine node
         MObject stretchIKAttr = mAttr.create("metaParent", "metaParent");
         stretchIKMultDivNodeFn.addAttribute(stretchIKAttr);
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("MathNodes"), stretchIKMultDivNodeFn.findPlug("metaParent") );
-        dgMod.doIt();
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::MathNodes), lrutils::findPlug(stretchIKMultDivNodeFn, "metaParent") );
         //hook up the multiply/divide node to the joint scaleX attributes
+        MPlug stretchPlug = lrutils::findPlug(stretchIKMultDivNodeFn, "outputX");
         for(int i = 0; i < this->m_vBindJointObjs.size(); i++) {
             MObject jointObj = this->m_vBindJointObjs.at(i);
             MFnTransform jointFn(jointObj);
-            MGlobal::executeCommand("connectAttr "+stretchIKMultDivNodeFn.name()+".outputX "+jointFn.fullPathName()+".scaleX;");
+            dgMod.connect( stretchPlug, lrutils::findPlug(jointFn, "scaleX") );
         }
         if(metaDataParentFn.typeId() == MDHipNode::id) {
             MObject hipJointObj;
-            status = lrutils::getMetaNodeConnection(metaDataParentNode, hipJointObj, "hipJoint");
+            status = lrutils::getMetaNodeConnection(metaDataParentNode, hipJointObj, MDHipNode::hipJoint);
             MFnTransform hipJointFn(hipJointObj);
-            MGlobal::executeCommand("connectAttr "+stretchIKMultDivNodeFn.name()+".outputX "+hipJointFn.fullPathName()+".scaleY;");
+            dgMod.connect( stretchPlug, lrutils::findPlug(hipJointFn, "scaleY") );
         } else {
             MObject parentJointObj;
             status = lrutils::getJointByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentJointObj);
             MyCheckStatus(status, "lrutils::getJointByNum() failed");
             MFnTransform parentJointFn(parentJointObj);
-            MGlobal::executeCommand("connectAttr "+stretchIKMultDivNodeFn.name()+".outputX "+parentJointFn.fullPathName()+".scaleY;");
+            dgMod.connect( stretchPlug, lrutils::findPlug(parentJointFn, "scaleY") );
         }
+        lrutils::doIt(dgMod);
     }
 
     MObject parentCtlObj; 
@@ -339,29 +321,27 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     MObject hipControllerObj;
     MFnTransform hipControllerFn;
     MFnTransform clusterFn;
+    //every cluster and the shoulder control group are moved once, when the plan is applied
+    HierarchyPlan hierarchy;
     if(metaDataParentFn.typeId() == MDHipNode::id) {
         //the first two clusters should be parented to the hip controller
-        status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerObj, "controller");
+        status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerObj, MDHipNode::controller);
         hipControllerFn.setObject(hipControllerObj);
-        clusterFn.setObject(m_vSplineIKClusterObjs.at(0));
-        MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + hipControllerFn.fullPathName() + ";");
-        clusterFn.setObject(m_vSplineIKClusterObjs.at(1));
-        MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + hipControllerFn.fullPathName() + ";");
+        hierarchy.setParent(m_vSplineIKClusterObjs.at(0), hipControllerObj);
+        hierarchy.setParent(m_vSplineIKClusterObjs.at(1), hipControllerObj);
     } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
         //the first two clusters will be parented to the correct controller in the spine, depending on the kinematic type
-        MPlug kinematicTypePlug = metaDataParentFn.findPlug( "KinematicType" );
+        MPlug kinematicTypePlug = lrutils::findPlug(metaDataParentFn, MDSpineNode::KinematicType );
         MString kinematicType;
         kinematicTypePlug.getValue(kinematicType);
         if( kinematicType == "FK" ) {
             lrutils::getFKControlByNum(metaDataParentNode, spineGuide->getParentJointNum(), parentCtlObj);
             parentCtlFn.setObject(parentCtlObj);
         } else if ( kinematicType == "splineIK" || kinematicType == "stretchySplineIK" ) {
-            status = lrutils::getMetaNodeConnection(metaDataParentNode, parentCtlObj, "ShoulderControl");
+            status = lrutils::getMetaNodeConnection(metaDataParentNode, parentCtlObj, MDSpineNode::ShoulderControl);
             parentCtlFn.setObject(parentCtlObj);
-            clusterFn.setObject(m_vSplineIKClusterObjs.at(0));
-            MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + parentCtlFn.fullPathName() + ";");
-            clusterFn.setObject(m_vSplineIKClusterObjs.at(1));
-            MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + parentCtlFn.fullPathName() + ";");
+            hierarchy.setParent(m_vSplineIKClusterObjs.at(0), parentCtlObj);
+            hierarchy.setParent(m_vSplineIKClusterObjs.at(1), parentCtlObj);
         }
 
     }
@@ -369,13 +349,9 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     //create the shoulder control for the end of the spine joint chain
     MString ctlColor = spineGuide->getShoulderColor();
     MString ctlShoulderIcon = spineGuide->getShoulderIcon();
-    status = MGlobal::executeCommand( "python(\"control = rig101().rig101WCGetByName('" + ctlShoulderIcon + "')\");" );
-    status = MGlobal::executeCommand( "python(\"Utils.setControllerColor(control, '" + ctlColor + "')\");" );
-    status = MGlobal::executeCommand( MString("python(\"control.fullPath()\");"), result );
-    //get the MObject for the controller
     MObject ctlObj;
-    status = lrutils::getObjFromName(result[0], ctlObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    status = lrutils::createController(ctlShoulderIcon, ctlColor, ctlObj);
+    MyCheckStatus(status, "lrutils::createController() failed");
     //set controller location
     MVectorArray ctlLocation = spineGuide->getShoulderLocation();
     MFnTransform ctlFn( ctlObj );
@@ -387,76 +363,66 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     MObject shoulderControlAttr = mAttr.create("metaParent", "metaParent");
     ctlFn.addAttribute(shoulderControlAttr);
     //connect the controller's metaParent to the MDSpine node
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("ShoulderControl"), ctlFn.findPlug("metaParent") );
-    dgMod.doIt();
+    status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::ShoulderControl), lrutils::findPlug(ctlFn, "metaParent") );
+    lrutils::doIt(dgMod);
 
-    //create the shoulder control null
+    //create the shoulder control null in place under the rig's control group
     MObject controllerGroupObj;
-    lrutils::makeHomeNull(ctlObj, MFnTransform(), controllerGroupObj);
-    lrutils::setLocation(controllerGroupObj, ctlLocation, MFnTransform::MFnTransform(), true, true, false);
+    status = lrutils::makeHomeNull(ctlObj, GuideTransforms::getLocationMatrix(ctlLocation), ctlGroupObj, controllerGroupObj);
+    MyCheckStatus(status, "lrutils::makeHomeNull() failed");
     MFnTransform controllerGroupFn( controllerGroupObj );
-    if(metaDataParentFn.typeId() == MDHipNode::id) {
-        MGlobal::executeCommand("parent " + controllerGroupFn.fullPathName() + " " + hipControllerFn.fullPathName() + ";");
-    } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
-        MGlobal::executeCommand("parent " + controllerGroupFn.fullPathName() + " " + parentCtlFn.fullPathName() + ";");
-    }
     //add the metaParent attribute to the controller group
     controllerGroupFn.addAttribute(mAttr.create("metaParent", "metaParent"));
     //connect the controller group's metaParent to the MDGlobal node
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("ShoulderControlGroup"), controllerGroupFn.findPlug("metaParent") );
+    status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::ShoulderControlGroup), lrutils::findPlug(controllerGroupFn, "metaParent") );
     MyCheckStatus(status, "connect failed"); 
-    dgMod.doIt();
-    ctlGroupFn.addChild(controllerGroupObj);
+    lrutils::doIt(dgMod);
     
     //parent the middle cluster under the rig group, and the last two clusters under the shoulder controller
-    clusterFn.setObject(m_vSplineIKClusterObjs.at(2));
-    MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + ctlGroupFn.fullPathName() + ";");
-    clusterFn.setObject(m_vSplineIKClusterObjs.at(3));
-    MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + ctlFn.fullPathName() + ";");
-    clusterFn.setObject(m_vSplineIKClusterObjs.at(4));
-    MGlobal::executeCommand("parent " + clusterFn.fullPathName() + " " + ctlFn.fullPathName() + ";");
+    hierarchy.setParent(m_vSplineIKClusterObjs.at(2), ctlGroupObj);
+    hierarchy.setParent(m_vSplineIKClusterObjs.at(3), ctlObj);
+    hierarchy.setParent(m_vSplineIKClusterObjs.at(4), ctlObj);
+    status = hierarchy.apply();
+    MyCheckStatus(status, "HierarchyPlan.apply() failed");
     //the middle cluster is equally weighted to both the hip and shoulder controllers
     clusterFn.setObject(m_vSplineIKClusterObjs.at(2));
-    MGlobal::executeCommand("parentConstraint -mo " + ctlFn.fullPathName() + " " + clusterFn.fullPathName() + ";",result);
-    //add the meta data connection to the middle cluster constraint
     MObject middleClusterParentConstraintObj;
-    status = lrutils::getObjFromName(result[0], middleClusterParentConstraintObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    status = lrutils::createParentConstraint(ctlObj, clusterFn.object(), middleClusterParentConstraintObj);
+    MyCheckStatus(status, "lrutils::createParentConstraint() failed");
+    //add the meta data connection to the middle cluster constraint
     MFnTransform middleClusterParentConstraintFn(middleClusterParentConstraintObj);
     middleClusterParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("MiddleClusterConstraint"), middleClusterParentConstraintFn.findPlug("metaParent"));
-    dgMod.doIt();
+    status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::MiddleClusterConstraint), lrutils::findPlug(middleClusterParentConstraintFn, "metaParent"));
+    lrutils::doIt(dgMod);
     if(metaDataParentFn.typeId() == MDHipNode::id) {
-        MGlobal::executeCommand("parentConstraint -mo " + hipControllerFn.fullPathName() + " " + clusterFn.fullPathName() + ";");
+        status = lrutils::addParentConstraintTarget(middleClusterParentConstraintObj, hipControllerFn.object());
+        MyCheckStatus(status, "lrutils::addParentConstraintTarget() failed");
     } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
-        MGlobal::executeCommand("parentConstraint -mo " + parentCtlFn.fullPathName() + " " + clusterFn.fullPathName() + ";");
+        status = lrutils::addParentConstraintTarget(middleClusterParentConstraintObj, parentCtlFn.object());
+        MyCheckStatus(status, "lrutils::addParentConstraintTarget() failed");
     }
 
     //the shoulder and hip controllers should be parent constrained to the fk chain
     if(metaDataParentFn.typeId() == MDHipNode::id) {
         MObject hipControllerGrpObj;
-        status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerGrpObj, "controllerGroup");
+        status = lrutils::getMetaNodeConnection(metaDataParentNode, hipControllerGrpObj, MDHipNode::controllerGrp);
         parentCtlFn.setObject(hipControllerGrpObj);
-        MFnTransform hipJointCopyFn(m_hipJointCopyObj);
-        MGlobal::executeCommand("parentConstraint -mo " + hipJointCopyFn.fullPathName() + " " + parentCtlFn.fullPathName() + ";",result);
         MObject hipCtlParentConstraintObj;
-        status = lrutils::getObjFromName(result[0], hipCtlParentConstraintObj);
-        MyCheckStatus(status, "lrutils::getObjFromName() failed");
+        status = lrutils::createParentConstraint(m_hipJointCopyObj, hipControllerGrpObj, hipCtlParentConstraintObj);
+        MyCheckStatus(status, "lrutils::createParentConstraint() failed");
         MFnTransform hipCtlParentConstraintFn(hipCtlParentConstraintObj);
         hipCtlParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-        status = dgMod.connect( depMetaDataNodeFn.findPlug("HipControlConstraint"), hipCtlParentConstraintFn.findPlug("metaParent"));
-        dgMod.doIt();
+        status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::HipControlConstraint), lrutils::findPlug(hipCtlParentConstraintFn, "metaParent"));
+        lrutils::doIt(dgMod);
     }
 
-    MFnTransform lastFKJointFn(this->m_vFKJointObjs.back());
-    MGlobal::executeCommand("parentConstraint -mo " + lastFKJointFn.fullPathName() + " " + controllerGroupFn.fullPathName() + ";",result);
     MObject shoulderCtlParentConstraintObj;
-    status = lrutils::getObjFromName(result[0], shoulderCtlParentConstraintObj);
-    MyCheckStatus(status, "lrutils::getObjFromName() failed");
+    status = lrutils::createParentConstraint(this->m_vFKJointObjs.back(), controllerGroupObj, shoulderCtlParentConstraintObj);
+    MyCheckStatus(status, "lrutils::createParentConstraint() failed");
     MFnTransform shoulderCtlParentConstraintFn(shoulderCtlParentConstraintObj);
     shoulderCtlParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-    status = dgMod.connect( depMetaDataNodeFn.findPlug("ShoulderControlConstraint"), shoulderCtlParentConstraintFn.findPlug("metaParent"));
-    dgMod.doIt();
+    status = dgMod.connect( lrutils::findPlug(depMetaDataNodeFn, MDSpineNode::ShoulderControlConstraint), lrutils::findPlug(shoulderCtlParentConstraintFn, "metaParent"));
+    lrutils::doIt(dgMod);
 
     //create an expression to drive the twist attribute of the IK handle by the rotateX attributes of the FK controllers
     MString jointRotations = "";
@@ -466,21 +432,55 @@ void SpineComponent::buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MOb
     }
     MFnTransform joint1Fn(m_vFKJointObjs[0]);
     if(metaDataParentFn.typeId() == MDHipNode::id) {
-        MGlobal::executeCommand("expression -n \""+this->m_rigName + "_" + this->m_pCompGuide->getName() + "_splineIKTwist_EXP\" -s \""+splineIKHandleFn.fullPathName()+".twist = ("+hipControllerFn.fullPathName()+".rotateY"+jointRotations+")\"");
-        MGlobal::executeCommand("select -cl;");
+        lrutils::executeCommand("expression -n \""+this->m_rigName + "_" + this->m_pCompGuide->getName() + "_splineIKTwist_EXP\" -s \""+splineIKHandleFn.fullPathName()+".twist = ("+hipControllerFn.fullPathName()+".rotateY"+jointRotations+")\"");
+        lrutils::executeCommand("select -cl;");
     } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
-        MGlobal::executeCommand("expression -n \""+this->m_rigName + "_" + this->m_pCompGuide->getName() + "_splineIKTwist_EXP\" -s \""+splineIKHandleFn.fullPathName()+".twist = ("+parentCtlFn.fullPathName()+".rotateY"+jointRotations+")\"");
-        MGlobal::executeCommand("select -cl;");
+        lrutils::executeCommand("expression -n \""+this->m_rigName + "_" + this->m_pCompGuide->getName() + "_splineIKTwist_EXP\" -s \""+splineIKHandleFn.fullPathName()+".twist = ("+parentCtlFn.fullPathName()+".rotateY"+jointRotations+")\"");
+        lrutils::executeCommand("select -cl;");
     }
     MString prefix = this->m_rigName + "_" + this->m_pCompGuide->getName();
     if(metaDataParentFn.typeId() == MDHipNode::id) {
-        lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vFKJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,hipControllerObj, ctlLayerName);
+        lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vFKJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,hipControllerObj, this->getParentControllerMatrix(), ctlLayerName, false, this->getBuildPlan());
     } else if (metaDataParentFn.typeId() == MDSpineNode::id) {
-        lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vFKJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,parentCtlObj, ctlLayerName);
+        lrutils::buildFKControls(this->m_vFKCtlObjs, this->m_vFKCtlGroupObjs, this->m_pCompGuide->getLocations(), this->m_vFKJointObjs, prefix, spineGuide->getFKIcon(), spineGuide->getColor(), this->m_metaDataNode,parentCtlObj, this->getParentControllerMatrix(), ctlLayerName, false, this->getBuildPlan());
+    }
+}
+
+void SpineComponent::getPlanInput(ComponentPlan::Input & input) {
+    Component::getPlanInput(input);
+    SpineComponentGuidePtr spineGuide = boost::dynamic_pointer_cast<SpineComponentGuide>(this->m_pCompGuide);
+    //the FK controls are planned under the controller they are built under
+    input.parentWorldMatrix = this->getParentControllerMatrix();
+    std::string prefix = (this->m_rigName + "_" + this->m_pCompGuide->getName()).asChar();
+    if(spineGuide->getKinematicType() == "splineIK" || spineGuide->getKinematicType() == "stretchySplineIK") {
+        input.chainPrefixes.push_back(prefix + "_splineIK_BIND");
+        input.chainPrefixes.push_back(prefix + "_FK");
+    } else if (spineGuide->getKinematicType() == "FK") {
+        input.chainPrefixes.push_back(prefix + "_FK_BIND");
     }
 }
 
+MMatrix SpineComponent::getParentControllerMatrix() {
+    if(!this->m_pParentComp)
+        return MMatrix::identity;
+    ComponentGuidePtr parentGuide = this->m_pParentComp->getCompGuide();
+    if(!parentGuide)
+        return MMatrix::identity;
+    if(parentGuide->getType() == MString("spine")) {
+        //a parent spine hands its FK controller or its shoulder controller to this spine, depending on its kinematic type
+        SpineComponentGuidePtr parentSpineGuide = boost::dynamic_pointer_cast<SpineComponentGuide>(parentGuide);
+        SpineComponentGuidePtr spineGuide = boost::dynamic_pointer_cast<SpineComponentGuide>(this->m_pCompGuide);
+        if(parentSpineGuide->getKinematicType() == "FK") {
+            return this->getGuideTransforms()->getWorldMatrix(parentGuide, spineGuide->getParentJointNum());
+        }
+        return GuideTransforms::getLocationMatrix(parentSpineGuide->getShoulderLocation());
+    }
+    return this->getGuideTransforms()->getWorldMatrix(parentGuide, 0);
+}
+
 void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool globalPos) {    
+    RigProfileScope profileScope("SpineComponent::updateComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MFnMessageAttribute mAttr;
     MStatus status;
     if( !this->m_metaDataNode.isNull() ) {
@@ -501,57 +501,57 @@ void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             lrutils::stringReplaceAll(metaNodeName, oldComponentName, newComponentName);
             metaDataNodeFn.setName(metaNodeName);
             //set FK controller names
-            MPlug fkControllersPlug = metaDataNodeFn.findPlug( "FKControllers", true, &status );
+            MPlug fkControllersPlug(this->m_metaDataNode, MDSpineNode::FKControllerArray);
             lrutils::updateMetaDataObjectNames(fkControllersPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set FK controller group names
-            MPlug fkControllerGroupsPlug = metaDataNodeFn.findPlug( "FKControllerGroups", true, &status );
+            MPlug fkControllerGroupsPlug(this->m_metaDataNode, MDSpineNode::FKControllerGrpArray);
             lrutils::updateMetaDataObjectNames(fkControllerGroupsPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set FK joint names
-            MPlug fkJointsPlug = metaDataNodeFn.findPlug( "FKJoints", true, &status );
+            MPlug fkJointsPlug(this->m_metaDataNode, MDSpineNode::FKJointArray);
             lrutils::updateMetaDataObjectNames(fkJointsPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set FK joint constraint names
-            MPlug fkJointConstraintsPlug = metaDataNodeFn.findPlug( "FKJointParentConstraints", true, &status );
+            MPlug fkJointConstraintsPlug(this->m_metaDataNode, MDSpineNode::FKJointParentConstraintArray);
             lrutils::updateMetaDataObjectNames(fkJointConstraintsPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set bind joint names
-            MPlug bindJointsPlug = metaDataNodeFn.findPlug( "BindJoints", true, &status );
+            MPlug bindJointsPlug(this->m_metaDataNode, MDSpineNode::BindJointArray);
             lrutils::updateMetaDataObjectNames(bindJointsPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set hip joints copy name
-            MPlug hipJointCopyPlug = metaDataNodeFn.findPlug( "HipJointCopy", true, &status );
+            MPlug hipJointCopyPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::HipJointCopy, true, &status );
             lrutils::updateMetaDataObjectNames(hipJointCopyPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set spline IK handle name
-            MPlug splineIKHandlePlug = metaDataNodeFn.findPlug( "SplineIKHandle", true, &status );
+            MPlug splineIKHandlePlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::SplineIKHandle, true, &status );
             lrutils::updateMetaDataObjectNames(splineIKHandlePlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set spline IK end effector name
-            MPlug splineIKEndEffectorPlug = metaDataNodeFn.findPlug( "SplineIKEndEffector", true, &status );
+            MPlug splineIKEndEffectorPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::SplineIKEndEffector, true, &status );
             lrutils::updateMetaDataObjectNames(splineIKEndEffectorPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set spline IK curve name
-            MPlug splineIKCurvePlug = metaDataNodeFn.findPlug( "SplineIKCurve", true, &status );
+            MPlug splineIKCurvePlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::SplineIKCurve, true, &status );
             lrutils::updateMetaDataObjectNames(splineIKCurvePlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set shoulder control name
-            MPlug shoulderControlPlug = metaDataNodeFn.findPlug( "ShoulderControl", true, &status );
+            MPlug shoulderControlPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::ShoulderControl, true, &status );
             lrutils::updateMetaDataObjectNames(shoulderControlPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set shoulder control group name
-            MPlug shoulderControlGroupPlug = metaDataNodeFn.findPlug( "ShoulderControlGroup", true, &status );
+            MPlug shoulderControlGroupPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::ShoulderControlGroup, true, &status );
             lrutils::updateMetaDataObjectNames(shoulderControlGroupPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set shoulder control constraint name
-            MPlug shoulderControlConstraintPlug = metaDataNodeFn.findPlug( "ShoulderControlConstraint", true, &status );
+            MPlug shoulderControlConstraintPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::ShoulderControlConstraint, true, &status );
             lrutils::updateMetaDataObjectNames(shoulderControlConstraintPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set math node names
-            MPlug mathNodesPlug = metaDataNodeFn.findPlug( "MathNodes", true, &status );
+            MPlug mathNodesPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::MathNodes, true, &status );
             lrutils::updateMetaDataObjectNames(mathNodesPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set spine IK cluster names
-            MPlug splineIKClustersPlug = metaDataNodeFn.findPlug( "SplineIKClusters", true, &status );
+            MPlug splineIKClustersPlug(this->m_metaDataNode, MDSpineNode::SplineIKClusterArray);
             lrutils::updateMetaDataObjectNames(splineIKClustersPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set hip control constraint name
-            MPlug hipControlConstraintPlug = metaDataNodeFn.findPlug( "HipControlConstraint", true, &status );
+            MPlug hipControlConstraintPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::HipControlConstraint, true, &status );
             lrutils::updateMetaDataObjectNames(hipControlConstraintPlug, oldRigName, newRigName, oldComponentName, newComponentName);
             //set middle cluster constraint name
-            MPlug middleClusterConstraintPlug = metaDataNodeFn.findPlug( "MiddleClusterConstraint", true, &status );
+            MPlug middleClusterConstraintPlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::MiddleClusterConstraint, true, &status );
             lrutils::updateMetaDataObjectNames(middleClusterConstraintPlug, oldRigName, newRigName, oldComponentName, newComponentName);
         }
         //update component settings, if the version increment is raised
         //or force update is true
-        MPlug versionPlug = metaDataNodeFn.findPlug( "version" );
+        MPlug versionPlug = MetaDataNode::getCommonPlug(this->m_metaDataNode, MetaDataNode::kVersion);
         float nodeVersion; 
         versionPlug.getValue(nodeVersion);
         if( (this->m_pCompGuide->getVersion() > nodeVersion) || forceUpdate ) {
@@ -561,14 +561,14 @@ void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
             status = lrutils::getMetaRootByName(metaRootObj, this->m_rigName);
             //get the controllers layer from the meta root
             MObject ctlLayerObj;
-            status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, "ctlLayer");
+            status = lrutils::getMetaNodeConnection(metaRootObj, ctlLayerObj, MetaRootNode::ctlLayer);
             MyCheckStatus(status, "lrutils::getMetaNodeConnection() failed");
             MFnDependencyNode ctlLayerFn(ctlLayerObj);
             MString ctlLayerName = ctlLayerFn.name();
 
             versionPlug.setValue( this->m_pCompGuide->getVersion() );
 
-            MPlug kTypePlug = metaDataNodeFn.findPlug( "KinematicType" );
+            MPlug kTypePlug = lrutils::findPlug(metaDataNodeFn, MDSpineNode::KinematicType );
             MString kinematicType;
             kTypePlug.getValue(kinematicType);
 
@@ -577,29 +577,19 @@ void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
                 MString ctlIcon = spineGuide->getFKIcon();
                 MString ctlColor = spineGuide->getColor();
 
-                MPlug fkControllersPlug = metaDataNodeFn.findPlug( "FKControllers", true, &status );
-                MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
-
-                MPlugArray connectedFKCtlPlugs;
-                fkControllersPlug.connectedTo(connectedFKCtlPlugs,false,true,&status);
-                MyCheckStatus(status,"MPlug.connectedTo() failed");
+                //the controllers and joints are held by their number, the last joint of the chain has no controller
+                MObjectArray fkCtlObjs;
+                status = lrutils::getMetaArrayConnections(MPlug(this->m_metaDataNode, MDSpineNode::FKControllerArray), fkCtlObjs);
+                MyCheckStatus(status, "lrutils::getMetaArrayConnections() failed");
+                MObjectArray fkCtlGroupObjs;
+                status = lrutils::getMetaArrayConnections(MPlug(this->m_metaDataNode, MDSpineNode::FKControllerGrpArray), fkCtlGroupObjs);
+                MyCheckStatus(status, "lrutils::getMetaArrayConnections() failed");
 
                 //update the fk controller colors,shapes, and locations
-                for (unsigned int i = 0; i < connectedFKCtlPlugs.length(); i++) {
-                    MPlug fkCtlPlug = connectedFKCtlPlugs[i];
-                    //need to switch the first and second in the plug list if more than one
-                    //is attached, because the are switched for some reason when plugs are
-                    //connected. This is an unavoidable bug in maya api.
-                    if( connectedFKCtlPlugs.length() > 1) {
-                        if(i == 0) { 
-                            fkCtlPlug = connectedFKCtlPlugs[1];
-                        } else if(i == 1) { 
-                            fkCtlPlug = connectedFKCtlPlugs[0];
-                        }
-                    }
-                    MObject fkCtlObj = fkCtlPlug.node(&status);
-                    MFnTransform fkCtlFn(fkCtlObj);
-                    MyCheckStatus(status, "MPlug.node() failed");
+                for (unsigned int i = 0; i < fkCtlObjs.length(); i++) {
+                    MObject fkCtlObj = fkCtlObjs[i];
+                    if(fkCtlObj.isNull())
+                        continue;
                     MVectorArray ctlLocation = this->m_pCompGuide->getLocation(i);
 
                     lrutils::updateControllerShapeColor(fkCtlObj, ctlIcon, ctlColor, ctlLocation);
@@ -611,82 +601,86 @@ void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
                     }
                 }
                 //update the number of fk joints and controllers
-                MPlug fkJointsPlug = metaDataNodeFn.findPlug( "BindJoints", true, &status );
-                MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
-                MPlugArray connectedFKJointPlugs;
-                fkJointsPlug.connectedTo(connectedFKJointPlugs,false,true,&status);
-                MyCheckStatus(status,"MPlug.connectedTo() failed");
+                MPlug fkJointsPlug(this->m_metaDataNode, MDSpineNode::BindJointArray);
+                MObjectArray fkJointObjs;
+                status = lrutils::getMetaArrayConnections(fkJointsPlug, fkJointObjs);
+                MyCheckStatus(status, "lrutils::getMetaArrayConnections() failed");
                 unsigned int numLocations = this->m_pCompGuide->getNumLocations();
-                unsigned int numJoints = connectedFKJointPlugs.length();
-                //remove excess joints and controllers
+                unsigned int numJoints = fkJointObjs.length();
+                //remove excess joints and controllers, from the end of the chain so that
+                //nothing is deleted after its parent already took it along
                 if( numLocations < numJoints) {
-                    unsigned int numJointsToDelete = numJoints - numLocations;
-                    for(unsigned int i = connectedFKJointPlugs.length() - 1; i > connectedFKJointPlugs.length() - 1 - numJointsToDelete; i--) {
-                        MGlobal::deleteNode(connectedFKJointPlugs[i].node());
-                        MGlobal::deleteNode(connectedFKCtlPlugs[i].node());
-                        MGlobal::displayInfo("blah");
+                    for(unsigned int i = numJoints; i > numLocations; i--) {
+                        if(!fkJointObjs[i-1].isNull())
+                            MGlobal::deleteNode(fkJointObjs[i-1]);
+                    }
+                    fkJointObjs.setLength(numLocations);
+                    for(unsigned int i = fkCtlGroupObjs.length(); i > 0 && i >= numLocations; i--) {
+                        if(!fkCtlGroupObjs[i-1].isNull())
+                            MGlobal::deleteNode(fkCtlGroupObjs[i-1]);
+                    }
+                    //the controllers went with their groups unless a group was missing
+                    for(unsigned int i = fkCtlObjs.length(); i > 0 && i >= numLocations; i--) {
+                        if(MObjectHandle(fkCtlObjs[i-1]).isValid())
+                            MGlobal::deleteNode(fkCtlObjs[i-1]);
+                        fkCtlObjs.remove(i-1);
                     }
-                    MGlobal::deleteNode(connectedFKCtlPlugs[connectedFKJointPlugs.length() - 1 - numJointsToDelete].node());
                 //add additional joints and controllers
-                } else if ( numLocations > numJoints) {
-                    unsigned int numJointsToAdd = numLocations - numJoints;
+                } else if ( numLocations > numJoints && numJoints > 0) {
                     MString prefixJoint = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_FK_BIND";
                     MString prefixCtl = this->m_rigName + "_" + this->m_pCompGuide->getName() + "_FK";
-                    for(unsigned int i = numLocations - 1 - numJointsToAdd; i < numLocations; i++) {
+                    for(unsigned int i = numJoints; i < numLocations; i++) {
                         MVectorArray location = this->m_pCompGuide->getLocation(i);
-                        MObject joint = lrutils::createJointFromLocation(location, prefixJoint, i, connectedFKJointPlugs[i-1].node());
+                        MObject joint = lrutils::createJointFromLocation(location, prefixJoint, i, fkJointObjs[i-1]);
 
                         MFnTransform jointFn( joint );
                         //add metaParent attributes to joint
                         MObject jointAttr = mAttr.create("metaParent", "metaParent");
                         jointFn.addAttribute(jointAttr);
                         //connect the metaparent attribute to the MDSpine node
-                        status = dgMod.connect( metaDataNodeFn.findPlug( "BindJoints", true, &status ), jointFn.findPlug("metaParent") );
+                        status = dgMod.connect( fkJointsPlug.elementByLogicalIndex(i), lrutils::findPlug(jointFn, "metaParent") );
                         MyCheckStatus(status, "connect failed");
-                        dgMod.doIt();
+                        lrutils::doIt(dgMod);
+                        fkJointObjs.append(joint);
 
-                        if(i != numLocations - 1) {
+                        //the joint that ended the chain gets its controller now that it has a child
+                        unsigned int ctlNum = i - 1;
+                        if(ctlNum >= fkCtlObjs.length()) {
                             MObject ctlObj;
                             MObject ctlGroupObj;
-                            lrutils::createFKCtlFromLocation(location, joint, prefixCtl, i, ctlIcon, ctlColor, connectedFKCtlPlugs[i-1].node(), ctlObj, ctlGroupObj, ctlLayerName, this->m_metaDataNode);
+                            MObject parentCtlObj = fkCtlObjs.length() > 0 ? fkCtlObjs[fkCtlObjs.length() - 1] : MObject();
+                            //the joint constraint is re-established with the rest of the chain below
+                            lrutils::createFKCtlFromLocation(this->m_pCompGuide->getLocation(ctlNum), fkJointObjs[ctlNum], prefixCtl, ctlNum, ctlIcon, ctlColor, parentCtlObj, ctlObj, ctlGroupObj, ctlLayerName, this->m_metaDataNode, false);
+                            fkCtlObjs.append(ctlObj);
                         }
                     }
                 }
                 //delete fk constraints
-                MPlug fkConstraintsPlug = metaDataNodeFn.findPlug( "FKJointParentConstraints", true, &status );
-                MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+                MPlug fkConstraintsPlug(this->m_metaDataNode, MDSpineNode::FKJointParentConstraintArray);
                 lrutils::deleteMetaDataPlugConnections(fkConstraintsPlug);
                 //re-orient the joint chain
-                MFnTransform topJointFn(connectedFKJointPlugs[0].node());
-                MGlobal::executeCommand("joint -e -zso -oj \"xyz\" -sao \"yup\" -ch " + topJointFn.fullPathName() + ";");
+                if(fkJointObjs.length() > 0)
+                    lrutils::orientJointChain(fkJointObjs[0]);
                 //re-establish the constraints
-                for(unsigned int i = 0; i < connectedFKCtlPlugs.length(); i++) {
-                    MPlug fkCtlPlug = connectedFKCtlPlugs[i];
-                    MPlug fkJointPlug = connectedFKJointPlugs[i];
-                    //need to switch the first and second in the plug list if more than one
-                    //is attached, because they are switched for some reason when plugs are
-                    //connected. This is an unavoidable bug in maya api.
-                    if( connectedFKCtlPlugs.length() > 1) {
-                        if(i == 0) { 
-                            fkCtlPlug = connectedFKCtlPlugs[1];
-                            fkJointPlug = connectedFKJointPlugs[1];
-                        } else if(i == 1) { 
-                            fkCtlPlug = connectedFKCtlPlugs[0];
-                            fkJointPlug = connectedFKJointPlugs[0];
-                        }
-                    }
-                    MStringArray result;
-                    MFnTransform fkCtlFn(fkCtlPlug.node());
-                    MFnTransform fkJointFn(fkJointPlug.node());
-                    MGlobal::executeCommand("parentConstraint -mo " + fkCtlFn.fullPathName() + " " + fkJointFn.fullPathName() + ";",result);
-                    MObject jointParentConstraintObj;
-                    status = lrutils::getObjFromName(result[0], jointParentConstraintObj);
-                    MyCheckStatus(status, "lrutils::getObjFromName() failed");
-                    MFnTransform jointParentConstraintFn(jointParentConstraintObj);
+                std::vector<MObject> constrainingCtlObjs;
+                std::vector<MObject> constrainedJointObjs;
+                std::vector<unsigned int> constraintNums;
+                for(unsigned int i = 0; i < fkCtlObjs.length() && i < fkJointObjs.length(); i++) {
+                    if(fkCtlObjs[i].isNull() || fkJointObjs[i].isNull())
+                        continue;
+                    constrainingCtlObjs.push_back(fkCtlObjs[i]);
+                    constrainedJointObjs.push_back(fkJointObjs[i]);
+                    constraintNums.push_back(i);
+                }
+                std::vector<MObject> jointParentConstraintObjs;
+                status = lrutils::createParentConstraints(constrainingCtlObjs, constrainedJointObjs, jointParentConstraintObjs);
+                MyCheckStatus(status, "lrutils::createParentConstraints() failed");
+                for(unsigned int i = 0; i < jointParentConstraintObjs.size(); i++) {
+                    MFnTransform jointParentConstraintFn(jointParentConstraintObjs[i]);
                     jointParentConstraintFn.addAttribute(mAttr.create("metaParent", "metaParent"));
-                    status = dgMod.connect( metaDataNodeFn.findPlug("FKJointParentConstraints"), jointParentConstraintFn.findPlug("metaParent"));
-                    dgMod.doIt();
+                    status = dgMod.connect( fkConstraintsPlug.elementByLogicalIndex(constraintNums[i]), lrutils::findPlug(jointParentConstraintFn, "metaParent"));
                 }
+                lrutils::doIt(dgMod);
 
             }
 
@@ -696,86 +690,85 @@ void SpineComponent::updateComponent(MDGModifier & dgMod,bool forceUpdate, bool
 }
 
 void SpineComponent::removeComponent(MDGModifier & dgMod) {
+    RigProfileScope profileScope("SpineComponent::removeComponent", RigProfiler::kComponentCategory);
+    if(profileScope.isTracing()) profileScope.setDetail(this->m_pCompGuide->getName());
     MStatus status;
     MFnDependencyNode metaNodeFn( this->m_metaDataNode );
+    //a node from an older scene still holds its chains in the single message attributes
+    status = lrutils::migrateMetaDataArrays(this->m_metaDataNode);
+    MyCheckStatus(status, "lrutils::migrateMetaDataArrays() failed");
     
     //delete shoulder constraint
-    MPlug shoulderConstraintPlug = metaNodeFn.findPlug("ShoulderControlConstraint", true, &status );
+    MPlug shoulderConstraintPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::ShoulderControlConstraint, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(shoulderConstraintPlug);
 
     //delete hip control constraint
-    MPlug hipConstraintPlug = metaNodeFn.findPlug("HipControlConstraint", true, &status );
+    MPlug hipConstraintPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::HipControlConstraint, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(hipConstraintPlug);
 
     //delete middle cluster constraint
-    MPlug middleClusterConstraintPlug = metaNodeFn.findPlug("MiddleClusterConstraint", true, &status );
+    MPlug middleClusterConstraintPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::MiddleClusterConstraint, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(middleClusterConstraintPlug);
 
     //delete shoulder control
-    MPlug shoulderControllerPlug = metaNodeFn.findPlug("ShoulderControl", true, &status );
+    MPlug shoulderControllerPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::ShoulderControl, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(shoulderControllerPlug);
 
     //delete shoulder control group
-    MPlug shoulderGroupPlug = metaNodeFn.findPlug("ShoulderControlGroup", true, &status );
+    MPlug shoulderGroupPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::ShoulderControlGroup, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(shoulderGroupPlug);
 
     //delete math nodes
-    MPlug mathNodesPlug = metaNodeFn.findPlug("MathNodes", true, &status );
+    MPlug mathNodesPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::MathNodes, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(mathNodesPlug);
 
     //delete clusters
-    MPlug clustersPlug = metaNodeFn.findPlug("SplineIKClusters", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug clustersPlug(this->m_metaDataNode, MDSpineNode::SplineIKClusterArray);
     lrutils::deleteMetaDataPlugConnections(clustersPlug);
 
     //delete spline IK curve
-    MPlug splineIKCurvePlug = metaNodeFn.findPlug("SplineIKCurve", true, &status );
+    MPlug splineIKCurvePlug = lrutils::findPlug(metaNodeFn, MDSpineNode::SplineIKCurve, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(splineIKCurvePlug);
 
     //delete spline IK end effector
-    MPlug splineIKEndEffectorPlug = metaNodeFn.findPlug("SplineIKEndEffector", true, &status );
+    MPlug splineIKEndEffectorPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::SplineIKEndEffector, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(splineIKEndEffectorPlug);
 
     //delete spline IK handle
-    MPlug splineIKHandlePlug = metaNodeFn.findPlug("SplineIKHandle", true, &status );
+    MPlug splineIKHandlePlug = lrutils::findPlug(metaNodeFn, MDSpineNode::SplineIKHandle, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(splineIKHandlePlug);
 
     //delete fk constraints
-    MPlug fkConstraintsPlug = metaNodeFn.findPlug( "FKJointParentConstraints", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug fkConstraintsPlug(this->m_metaDataNode, MDSpineNode::FKJointParentConstraintArray);
     lrutils::deleteMetaDataPlugConnections(fkConstraintsPlug);
 
     //delete fk joints
-    MPlug fkJointsPlug = metaNodeFn.findPlug( "FKJoints", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug fkJointsPlug(this->m_metaDataNode, MDSpineNode::FKJointArray);
     lrutils::deleteMetaDataPlugConnections(fkJointsPlug);
 
     //delete fk controllers
-    MPlug fkControllersPlug = metaNodeFn.findPlug( "FKControllers", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug fkControllersPlug(this->m_metaDataNode, MDSpineNode::FKControllerArray);
     lrutils::deleteMetaDataPlugConnections(fkControllersPlug);
 
     //delete fk controller groups
-    MPlug fkControllerGroupsPlug = metaNodeFn.findPlug( "FKControllerGroups", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug fkControllerGroupsPlug(this->m_metaDataNode, MDSpineNode::FKControllerGrpArray);
     lrutils::deleteMetaDataPlugConnections(fkControllerGroupsPlug);
 
     //delete hip joint copy
-    MPlug hipJointCopyPlug = metaNodeFn.findPlug("HipJointCopy", true, &status );
+    MPlug hipJointCopyPlug = lrutils::findPlug(metaNodeFn, MDSpineNode::HipJointCopy, true, &status );
     MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
     lrutils::deleteMetaDataPlugConnections(hipJointCopyPlug);
 
     //delete bind joints
-    MPlug bindJointsPlug = metaNodeFn.findPlug("BindJoints", true, &status );
-    MyCheckStatus(status, "MFnDependencyNode.findPlug() failed");
+    MPlug bindJointsPlug(this->m_metaDataNode, MDSpineNode::BindJointArray);
     lrutils::deleteMetaDataPlugConnections(bindJointsPlug);
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 #include <maya/MVectorArray.h>
+#include <maya/MMatrix.h>
 #include <maya/MCommandResult.h>
 #include <rapidxml.hpp>
 #include <vector>
@@ -27,10 +28,13 @@ public:
     MObject loadComponent(MDGModifier & dgMod);
     void updateComponent(MDGModifier & dgMod, bool forceUpdate = false, bool globalPos = false);
     void removeComponent(MDGModifier & dgMod);
+    void getPlanInput(ComponentPlan::Input & input);
     //creates a IK spline setup
     void buildIKSpline(MObject IKStartJoint, MObject IKEndJoint, MObject FKIndexStart, MObject FKIndexEnd);
 
 private:
+    //guide world matrix of the parent component's controller that the FK controls are parented to
+    MMatrix getParentControllerMatrix();
     //FK chain objects
     std::vector<MObject> m_vFKCtlObjs;
     std::vector<MObject> m_vFKCtlGroupObjs;
@@ -0,0 +1,348 @@
+/***************************************************************
+* Summary: Utility functions for building spline IK rigs       *
+*          through the API, without the ikHandle and arclen    *
+*          commands or the active selection.                   *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "SplineIK.h"
+#include "LoadRigUtils.h"
+#include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include <maya/MGlobal.h>
+#include <maya/MDagModifier.h>
+#include <maya/MDagPath.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnTransform.h>
+#include <maya/MFnIkHandle.h>
+#include <maya/MFnIkEffector.h>
+#include <maya/MFnNurbsCurve.h>
+#include <maya/MFnMatrixData.h>
+#include <maya/MFnComponentListData.h>
+#include <maya/MFnSingleIndexedComponent.h>
+#include <maya/MItDependencyNodes.h>
+#include <maya/MIntArray.h>
+#include <maya/MPointArray.h>
+#include <maya/MPoint.h>
+#include <maya/MPlugArray.h>
+#include <maya/MMatrix.h>
+#include <vector>
+
+namespace {
+
+//returns the scene's ikSplineSolver, creating and registering it with the ikSystem if it does not exist yet
+MStatus getSplineSolver(MObject & solverObj) {
+    MStatus status = MS::kSuccess;
+    for(MItDependencyNodes solverIt(MFn::kIkSolver); !solverIt.isDone(); solverIt.next()) {
+        MFnDependencyNode solverFn( solverIt.item() );
+        if(solverFn.typeName() == "ikSplineSolver") {
+            solverObj = solverIt.item();
+            return status;
+        }
+    }
+
+    MDGModifier dgMod;
+    solverObj = dgMod.createNode("ikSplineSolver", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(solverObj, "ikSplineSolver");
+    MItDependencyNodes systemIt(MFn::kIkSystem);
+    if(!systemIt.isDone()) {
+        MFnDependencyNode systemFn( systemIt.item() );
+        MFnDependencyNode solverFn( solverObj );
+        MPlug solversPlug = lrutils::findPlug(systemFn, "ikSolver");
+        MIntArray usedIds;
+        solversPlug.getExistingArrayAttributeIndices(usedIds);
+        int nextId = 0;
+        for(unsigned int i = 0; i < usedIds.length(); i++) {
+            if(usedIds[i] >= nextId)
+                nextId = usedIds[i] + 1;
+        }
+        dgMod.connect( lrutils::findPlug(solverFn, "message"), solversPlug.elementByLogicalIndex(nextId) );
+    }
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return status;
+}
+
+//the first child curve of the transform that isn't an intermediate object
+MStatus getVisibleShape(MObject curveTransformObj, MObject & curveShapeObj) {
+    MFnDagNode curveTransformFn( curveTransformObj );
+    for(unsigned int i = 0; i < curveTransformFn.childCount(); i++) {
+        MObject childObj = curveTransformFn.child(i);
+        if(childObj.hasFn(MFn::kNurbsCurve) && !MFnDagNode(childObj).isIntermediateObject()) {
+            curveShapeObj = childObj;
+            return MS::kSuccess;
+        }
+    }
+    return MS::kFailure;
+}
+
+MPoint getWorldPosition(MObject obj) {
+    MDagPath path;
+    MDagPath::getAPathTo(obj, path);
+    MMatrix worldMatrix = path.inclusiveMatrix();
+    return MPoint(worldMatrix[3][0], worldMatrix[3][1], worldMatrix[3][2]);
+}
+
+}
+
+MStatus lrutils::createSplineIK(MObject startJointObj, MObject endJointObj, unsigned int numSpans, MObject curveParentObj,
+    MString handleName, MString effectorName, MString curveName, MObject & handleObj, MObject & effectorObj, MObject & curveObj) {
+    RigProfileScope profileScope("lrutils::createSplineIK");
+    MStatus status = MS::kFailure;
+    if(numSpans == 0)
+        return status;
+
+    //collect the chain from the end joint up to the start joint
+    std::vector<MObject> chain;
+    MObject jointObj = endJointObj;
+    while(!jointObj.isNull()) {
+        chain.insert(chain.begin(), jointObj);
+        if(jointObj == startJointObj)
+            break;
+        MFnDagNode jointFn( jointObj );
+        jointObj = (jointFn.parentCount() > 0) ? jointFn.parent(0) : MObject::kNullObj;
+        if(!jointObj.hasFn(MFn::kJoint))
+            jointObj = MObject::kNullObj;
+    }
+    if(chain.size() < 2 || chain.front() != startJointObj) {
+        MGlobal::displayError("lrutils::createSplineIK(): end joint is not below the start joint");
+        return MS::kFailure;
+    }
+
+    //edit points spaced evenly by length along the chain
+    std::vector<MPoint> positions;
+    std::vector<double> lengths;
+    double chainLength = 0;
+    for(unsigned int i = 0; i < chain.size(); i++) {
+        positions.push_back(getWorldPosition(chain[i]));
+        if(i > 0)
+            chainLength += positions[i].distanceTo(positions[i-1]);
+        lengths.push_back(chainLength);
+    }
+    MPointArray editPoints;
+    unsigned int segment = 1;
+    for(unsigned int i = 0; i <= numSpans; i++) {
+        double target = chainLength * i / numSpans;
+        while(segment < positions.size() - 1 && lengths[segment] < target)
+            segment++;
+        double segmentLength = lengths[segment] - lengths[segment-1];
+        double t = (segmentLength > 0) ? (target - lengths[segment-1]) / segmentLength : 0;
+        editPoints.append( positions[segment-1] + (positions[segment] - positions[segment-1]) * t );
+    }
+
+    //the edit points are given in the space of the curve's parent, so the curve sits where ikHandle would have
+    //put it before it was parented
+    if(!curveParentObj.isNull()) {
+        MDagPath curveParentPath;
+        MDagPath::getAPathTo(curveParentObj, curveParentPath);
+        MMatrix parentInverseMatrix = curveParentPath.inclusiveMatrixInverse();
+        for(unsigned int i = 0; i < editPoints.length(); i++)
+            editPoints[i] *= parentInverseMatrix;
+    }
+    MDagModifier dagMod;
+    curveObj = dagMod.createNode("transform", curveParentObj, &status);
+    MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
+    dagMod.renameNode(curveObj, curveName);
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+    MFnNurbsCurve curveFn;
+    MObject curveShapeObj = curveFn.createWithEditPoints(editPoints, 3, MFnNurbsCurve::kOpen, false, false, false, curveObj, &status);
+    MyCheckStatusReturn(status, "MFnNurbsCurve.createWithEditPoints() failed");
+    dagMod.renameNode(curveShapeObj, curveName + "Shape");
+
+    //the end effector sits under the parent of the end joint and follows the end joint
+    MFnDagNode endJointFn( endJointObj );
+    MObject effectorParentObj = endJointFn.parent(0);
+    MFnIkEffector effectorFn;
+    effectorObj = effectorFn.create(effectorParentObj, &status);
+    MyCheckStatusReturn(status, "MFnIkEffector.create() failed");
+    MFnTransform endJointTransformFn( endJointObj );
+    effectorFn.setTranslation( endJointTransformFn.getTranslation(MSpace::kTransform), MSpace::kTransform );
+    dagMod.connect( lrutils::findPlug(endJointFn, "translate"), lrutils::findPlug(effectorFn, "translate") );
+    dagMod.renameNode(effectorObj, effectorName);
+
+    MObject solverObj;
+    status = getSplineSolver(solverObj);
+    MyCheckStatusReturn(status, "getSplineSolver() failed");
+    MDagPath startJointPath;
+    MDagPath effectorPath;
+    MDagPath::getAPathTo(startJointObj, startJointPath);
+    MDagPath::getAPathTo(effectorObj, effectorPath);
+    MFnIkHandle handleFn;
+    handleObj = handleFn.create(startJointPath, effectorPath, &status);
+    MyCheckStatusReturn(status, "MFnIkHandle.create() failed");
+    status = handleFn.setSolver(solverObj);
+    MyCheckStatusReturn(status, "MFnIkHandle.setSolver() failed");
+    dagMod.renameNode(handleObj, handleName);
+
+    //the spline solver follows the world space curve
+    MFnDependencyNode curveShapeFn( curveShapeObj );
+    dagMod.connect( lrutils::findPlug(curveShapeFn, "worldSpace").elementByLogicalIndex(0), lrutils::findPlug(handleFn, "inCurve") );
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+
+    return status;
+}
+
+MStatus lrutils::createCVCluster(MObject curveObj, unsigned int cvIndex, MString clusterName, MString handleName, MObject & clusterObj, MObject & handleObj) {
+    RigProfileScope profileScope("lrutils::createCVCluster");
+    MStatus status = MS::kFailure;
+
+    MFnDagNode curveTransformFn( curveObj );
+    MObject curveTransformObj = curveObj.hasFn(MFn::kNurbsCurve) ? curveTransformFn.parent(0) : curveObj;
+    MObject curveShapeObj;
+    status = getVisibleShape(curveTransformObj, curveShapeObj);
+    MyCheckStatusReturn(status, "getVisibleShape() failed");
+    MFnNurbsCurve curveFn( curveShapeObj );
+    if((int)cvIndex >= curveFn.numCVs())
+        return MS::kFailure;
+    MDagPath curvePath;
+    MDagPath::getAPathTo(curveShapeObj, curvePath);
+    MPoint cvPosition;
+    curveFn.getCV(cvIndex, cvPosition, MSpace::kWorld);
+
+    //the geometry going into the new deformer, the last deformer's output or an intermediate copy of the curve
+    MDGModifier dgMod;
+    MPlug createPlug = lrutils::findPlug(curveFn, "create");
+    MPlugArray inputPlugs;
+    createPlug.connectedTo(inputPlugs, true, false);
+    MPlug inputGeometryPlug;
+    if(inputPlugs.length() > 0) {
+        inputGeometryPlug = inputPlugs[0];
+        dgMod.disconnect(inputGeometryPlug, createPlug);
+    } else {
+        MObject origShapeObj = curveFn.copy(curveShapeObj, curveTransformObj, &status);
+        MyCheckStatusReturn(status, "MFnNurbsCurve.copy() failed");
+        MFnDagNode origShapeFn( origShapeObj );
+        dgMod.renameNode(origShapeObj, curveFn.name() + "Orig");
+        dgMod.newPlugValueBool( lrutils::findPlug(origShapeFn, "intermediateObject"), true );
+        inputGeometryPlug = lrutils::findPlug(origShapeFn, "worldSpace").elementByLogicalIndex(0);
+    }
+
+    //the cluster and its handle, which is pivoted on the CV like the cluster command's
+    MDagModifier dagMod;
+    handleObj = dagMod.createNode("clusterHandle", MObject::kNullObj, &status);
+    MyCheckStatusReturn(status, "MDagModifier.createNode() failed");
+    dagMod.renameNode(handleObj, handleName);
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDagModifier.doIt() failed");
+    clusterObj = dgMod.createNode("cluster", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(clusterObj, clusterName);
+    MObject groupIdObj = dgMod.createNode("groupId", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    MObject groupPartsObj = dgMod.createNode("groupParts", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(groupPartsObj, clusterName + "GroupParts");
+    MObject setObj = dgMod.createNode("objectSet", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(setObj, clusterName + "Set");
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    MFnDagNode handleFn( handleObj );
+    MObject handleShapeObj = handleFn.child(0);
+    dgMod.renameNode(handleShapeObj, clusterName + "HandleShape");
+    MFnDependencyNode handleShapeFn( handleShapeObj );
+    MFnDependencyNode clusterFn( clusterObj );
+    MFnDependencyNode groupIdFn( groupIdObj );
+    MFnDependencyNode groupPartsFn( groupPartsObj );
+    MFnDependencyNode setFn( setObj );
+    const char * axes[3] = { "X", "Y", "Z" };
+    for(unsigned int i = 0; i < 3; i++) {
+        dgMod.newPlugValueDouble( lrutils::findPlug(handleFn, MString("rotatePivot") + axes[i]), cvPosition[i] );
+        dgMod.newPlugValueDouble( lrutils::findPlug(handleFn, MString("scalePivot") + axes[i]), cvPosition[i] );
+        dgMod.newPlugValueDouble( lrutils::findPlug(handleShapeFn, MString("origin") + axes[i]), cvPosition[i] );
+    }
+    dgMod.connect( lrutils::findPlug(handleFn, "worldMatrix").elementByLogicalIndex(0), lrutils::findPlug(clusterFn, "matrix") );
+    dgMod.connect( lrutils::findPlug(handleShapeFn, "clusterTransforms").elementByLogicalIndex(0), lrutils::findPlug(clusterFn, "clusterXforms") );
+    MFnMatrixData matrixDataFn;
+    MObject geomMatrixObj = matrixDataFn.create(curvePath.inclusiveMatrix(), &status);
+    MyCheckStatusReturn(status, "MFnMatrixData.create() failed");
+    dgMod.newPlugValue( lrutils::findPlug(clusterFn, "geomMatrix").elementByLogicalIndex(0), geomMatrixObj );
+
+    //the deformer only sees the one CV, through a group on the curve's instance
+    MFnSingleIndexedComponent componentFn;
+    MObject componentObj = componentFn.create(MFn::kCurveCVComponent, &status);
+    MyCheckStatusReturn(status, "MFnSingleIndexedComponent.create() failed");
+    componentFn.addElement(cvIndex);
+    MFnComponentListData componentListFn;
+    MObject componentListObj = componentListFn.create(&status);
+    MyCheckStatusReturn(status, "MFnComponentListData.create() failed");
+    componentListFn.add(componentObj);
+    MPlug objectGroupsPlug = lrutils::findPlug(curveFn, "instObjGroups").elementByLogicalIndex(curvePath.instanceNumber()).child(curveFn.attribute("objectGroups"));
+    MIntArray usedGroups;
+    objectGroupsPlug.getExistingArrayAttributeIndices(usedGroups);
+    unsigned int groupIndex = 0;
+    for(unsigned int i = 0; i < usedGroups.length(); i++) {
+        if(usedGroups[i] >= (int)groupIndex)
+            groupIndex = usedGroups[i] + 1;
+    }
+    MPlug objectGroupPlug = objectGroupsPlug.elementByLogicalIndex(groupIndex);
+    MPlug groupIdPlug = lrutils::findPlug(groupIdFn, "groupId");
+    dgMod.newPlugValue( objectGroupPlug.child(curveFn.attribute("objectGrpCompList")), componentListObj );
+    dgMod.newPlugValue( lrutils::findPlug(groupPartsFn, "inputComponents"), componentListObj );
+    dgMod.connect( groupIdPlug, objectGroupPlug.child(curveFn.attribute("objectGroupId")) );
+    dgMod.connect( groupIdPlug, lrutils::findPlug(groupPartsFn, "groupId") );
+    dgMod.connect( objectGroupPlug, lrutils::findPlug(setFn, "dagSetMembers").elementByLogicalIndex(0) );
+    dgMod.connect( lrutils::findPlug(groupIdFn, "message"), lrutils::findPlug(setFn, "groupNodes").elementByLogicalIndex(0) );
+    dgMod.connect( lrutils::findPlug(clusterFn, "message"), lrutils::findPlug(setFn, "usedBy").elementByLogicalIndex(0) );
+
+    //and the geometry runs through the group parts and the cluster into the curve
+    MPlug deformerInputPlug = lrutils::findPlug(clusterFn, "input").elementByLogicalIndex(0);
+    dgMod.connect( inputGeometryPlug, lrutils::findPlug(groupPartsFn, "inputGeometry") );
+    dgMod.connect( lrutils::findPlug(groupPartsFn, "outputGeometry"), deformerInputPlug.child(clusterFn.attribute("inputGeometry")) );
+    dgMod.connect( groupIdPlug, deformerInputPlug.child(clusterFn.attribute("groupId")) );
+    dgMod.connect( lrutils::findPlug(clusterFn, "outputGeometry").elementByLogicalIndex(0), createPlug );
+    status = lrutils::doIt(dagMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return status;
+}
+
+MStatus lrutils::createCurveInfo(MObject curveObj, MString name, MObject & curveInfoObj) {
+    RigProfileScope profileScope("lrutils::createCurveInfo");
+    MStatus status = MS::kFailure;
+
+    MFnDagNode curveTransformFn( curveObj );
+    MObject curveShapeObj = curveObj.hasFn(MFn::kNurbsCurve) ? curveObj : curveTransformFn.child(0);
+    MFnDependencyNode curveShapeFn( curveShapeObj );
+
+    MDGModifier dgMod;
+    curveInfoObj = dgMod.createNode("curveInfo", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(curveInfoObj, name);
+    MFnDependencyNode curveInfoFn( curveInfoObj );
+    status = dgMod.connect( lrutils::findPlug(curveShapeFn, "worldSpace").elementByLogicalIndex(0), lrutils::findPlug(curveInfoFn, "inputCurve") );
+    MyCheckStatusReturn(status, "connect failed");
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return status;
+}
+
+MStatus lrutils::createMultiplyDivide(MPlug input1Plug, MPlug input2Plug, double input2Value, int operation, MString name, MObject & mathNodeObj) {
+    RigProfileScope profileScope("lrutils::createMultiplyDivide");
+    MStatus status = MS::kFailure;
+
+    MDGModifier dgMod;
+    mathNodeObj = dgMod.createNode("multiplyDivide", &status);
+    MyCheckStatusReturn(status, "MDGModifier.createNode() failed");
+    dgMod.renameNode(mathNodeObj, name);
+    MFnDependencyNode mathNodeFn( mathNodeObj );
+    dgMod.newPlugValueInt( lrutils::findPlug(mathNodeFn, "operation"), operation );
+    if(!input1Plug.isNull())
+        dgMod.connect( input1Plug, lrutils::findPlug(mathNodeFn, "input1X") );
+    if(!input2Plug.isNull()) {
+        dgMod.connect( input2Plug, lrutils::findPlug(mathNodeFn, "input2X") );
+    } else {
+        dgMod.newPlugValueDouble( lrutils::findPlug(mathNodeFn, "input2X"), input2Value );
+    }
+    status = lrutils::doIt(dgMod);
+    MyCheckStatusReturn(status, "MDGModifier.doIt() failed");
+
+    return status;
+}
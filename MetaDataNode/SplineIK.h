@@ -0,0 +1,32 @@
+/***************************************************************
+* Summary: Utility functions for building spline IK rigs       *
+*          through the API, without the ikHandle and arclen    *
+*          commands or the active selection.                   *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _SplineIK
+#define _SplineIK
+
+#include <maya/MStatus.h>
+#include <maya/MString.h>
+#include <maya/MObject.h>
+#include <maya/MPlug.h>
+
+namespace lrutils {
+    //builds a spline IK from startJointObj to endJointObj. The curve is fit through the joint chain with numSpans
+    //cubic spans, like ikHandle -sol ikSplineSolver -ns numSpans, and is created under curveParentObj.
+    //The handle, end effector and curve transform are returned directly.
+    MStatus createSplineIK(MObject startJointObj, MObject endJointObj, unsigned int numSpans, MObject curveParentObj,
+        MString handleName, MString effectorName, MString curveName, MObject & handleObj, MObject & effectorObj, MObject & curveObj);
+    //creates a cluster deformer on a single CV of the curve, named clusterName, with its handle named handleName.
+    //The deformer, handle, group and set are created and wired like the cluster command's, without the selection
+    MStatus createCVCluster(MObject curveObj, unsigned int cvIndex, MString clusterName, MString handleName, MObject & clusterObj, MObject & handleObj);
+    //creates a curveInfo node measuring the curve, like arclen -ch true
+    MStatus createCurveInfo(MObject curveObj, MString name, MObject & curveInfoObj);
+    //API version of Utils.createMultiplyDivide. input1Plug drives input1X, input2X is driven by input2Plug or set
+    //to input2Value when the plug is null. operation is 1 multiply, 2 divide or 3 power
+    MStatus createMultiplyDivide(MPlug input1Plug, MPlug input2Plug, double input2Value, int operation, MString name, MObject & mathNodeObj);
+}
+
+#endif //_SplineIK
@@ -0,0 +1,135 @@
+/***************************************************************
+* Summary: Generates rig definition xml for synthetic rigs of  *
+*          configurable size, used to measure how building,    *
+*          updating and removing rigs scales.                  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "SyntheticRig.h"
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+
+namespace {
+    const double kHipHeight = 10.0;
+    const double kMoveOffset = 0.5;
+
+    void writeLocationAttribs(std::stringstream & xml, double x, double y, double z) {
+        xml << " localX=\"" << x << "\" localY=\"" << y << "\" localZ=\"" << z << "\""
+            << " rotateX=\"0\" rotateY=\"0\" rotateZ=\"0\""
+            << " scaleX=\"1\" scaleY=\"1\" scaleZ=\"1\"";
+    }
+
+    void writeComponentAttribs(std::stringstream & xml, const char * type, const std::string & name, unsigned int rigId) {
+        xml << "type=\"" << type << "\" name=\"" << name << "\" version=\"1\" rigId=\"" << rigId << "\"";
+    }
+
+    std::string getCompName(const std::string & baseName, unsigned int changes) {
+        return (changes & lrutils::kSyntheticRenamed) ? baseName + "_renamed" : baseName;
+    }
+
+    //spines form a binary tree below the hip so the depth of the rig grows with log(M)
+    void writeSpine(std::stringstream & xml, const lrutils::SyntheticRigSpec & spec, unsigned int spineNum, unsigned int numSpines, unsigned int numJoints, double offset, unsigned int changes) {
+        std::stringstream name; name << "spine" << spineNum;
+        unsigned int parentJoint = (spineNum == 0) ? 0 : numJoints - 1;
+        double x = spineNum * 2.0 * spec.spacing + offset;
+        double y = kHipHeight + spec.spacing;
+        double z = offset;
+
+        xml << "<component ";
+        writeComponentAttribs(xml, "spine", getCompName(name.str(), changes), spineNum + 3);
+        xml << " color=\"blue\" parentJoint=\"" << parentJoint << "\" kinematicType=\"" << lrutils::getSyntheticKinematicType(spec, spineNum) << "\" fkIcon=\"Circle\">\n";
+        xml << "<shoulderControl icon=\"Square\" color=\"yellow\"";
+        writeLocationAttribs(xml, x, y + (numJoints - 1) * spec.spacing, z);
+        xml << "/>\n";
+        for(unsigned int i = 0; i < numJoints; i++) {
+            xml << "<location";
+            writeLocationAttribs(xml, x, y + i * spec.spacing, z);
+            xml << ">\n";
+        }
+        for(unsigned int i = 0; i < numJoints; i++) {
+            xml << "</location>\n";
+        }
+        unsigned int children[2] = { 2 * spineNum + 1, 2 * spineNum + 2 };
+        for(unsigned int i = 0; i < 2; i++) {
+            if(children[i] < numSpines)
+                writeSpine(xml, spec, children[i], numSpines, numJoints, offset, changes);
+        }
+        xml << "</component>\n";
+    }
+}
+
+lrutils::SyntheticRigSpec::SyntheticRigSpec() {
+    numComponents = 3;
+    numJoints = 5;
+    fkWeight = 1;
+    splineIKWeight = 1;
+    stretchySplineIKWeight = 1;
+    spacing = 2.0;
+}
+
+bool lrutils::parseKinematicMix(const std::string & mix, SyntheticRigSpec & spec) {
+    std::vector<unsigned int> weights;
+    std::stringstream ss(mix);
+    std::string weight;
+    while(std::getline(ss, weight, ':')) {
+        if(weight.empty() || weight.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+        weights.push_back((unsigned int)::atoi(weight.c_str()));
+    }
+    if(weights.size() != 3 || weights[0] + weights[1] + weights[2] == 0)
+        return false;
+    spec.fkWeight = weights[0];
+    spec.splineIKWeight = weights[1];
+    spec.stretchySplineIKWeight = weights[2];
+    return true;
+}
+
+std::string lrutils::getSyntheticKinematicType(const SyntheticRigSpec & spec, unsigned int spineNum) {
+    unsigned int total = spec.fkWeight + spec.splineIKWeight + spec.stretchySplineIKWeight;
+    if(total == 0)
+        return "FK";
+    unsigned int slot = spineNum % total;
+    if(slot < spec.fkWeight)
+        return "FK";
+    if(slot < spec.fkWeight + spec.splineIKWeight)
+        return "splineIK";
+    return "stretchySplineIK";
+}
+
+std::string lrutils::makeSyntheticRigXml(const std::string & rigName, double version, const SyntheticRigSpec & spec, unsigned int changes) {
+    unsigned int numSpines = (spec.numComponents > 2) ? spec.numComponents - 2 : 0;
+    unsigned int numJoints = spec.numJoints + ((changes & kSyntheticResized) ? 1 : 0);
+    double offset = (changes & kSyntheticMoved) ? kMoveOffset : 0.0;
+
+    std::stringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n";
+    xml << "<rig name=\"" << rigName << "\" version=\"" << version << "\">\n";
+    xml << "<component ";
+    writeComponentAttribs(xml, "global", getCompName("global", changes), 1);
+    xml << " color=\"yellow\" icon=\"FourArrowCircle\">\n";
+    xml << "<location";
+    writeLocationAttribs(xml, offset, 0.0, offset);
+    xml << "/>\n";
+    xml << "<component ";
+    writeComponentAttribs(xml, "hip", getCompName("hip", changes), 2);
+    xml << " color=\"red\" icon=\"Cube\">\n";
+    xml << "<location";
+    writeLocationAttribs(xml, offset, kHipHeight, offset);
+    xml << "/>\n";
+    if(numSpines > 0)
+        writeSpine(xml, spec, 0, numSpines, numJoints, offset, changes);
+    xml << "</component>\n";
+    xml << "</component>\n";
+    xml << "</rig>\n";
+    return xml.str();
+}
+
+bool lrutils::writeSyntheticRigXml(const std::string & filePath, const std::string & rigName, double version, const SyntheticRigSpec & spec, unsigned int changes) {
+    std::ofstream xmlFile(filePath.c_str());
+    if(!xmlFile)
+        return false;
+    xmlFile << makeSyntheticRigXml(rigName, version, spec, changes);
+    return xmlFile.good();
+}
@@ -0,0 +1,44 @@
+/***************************************************************
+* Summary: Generates rig definition xml for synthetic rigs of  *
+*          configurable size, used to measure how building,    *
+*          updating and removing rigs scales.                  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _SyntheticRig
+#define _SyntheticRig
+
+#include <string>
+
+namespace lrutils {
+    //the shape of a synthetic rig: a global and a hip component followed by spines
+    struct SyntheticRigSpec
+    {
+        SyntheticRigSpec();
+        unsigned int numComponents; //total components in the rig, at least 3
+        unsigned int numJoints; //joints in every spine
+        //relative share of spines built with each kinematic type
+        unsigned int fkWeight;
+        unsigned int splineIKWeight;
+        unsigned int stretchySplineIKWeight;
+        double spacing; //distance between neighbouring joints
+    };
+
+    //changes applied on top of the base guide, combinable as bit flags
+    enum SyntheticRigChange {
+        kSyntheticBase = 0,
+        kSyntheticRenamed = 1, //every component is renamed, rigIds are kept
+        kSyntheticMoved = 2, //every location is offset
+        kSyntheticResized = 4 //every spine gets one more joint
+    };
+
+    //reads a kinematic mix given as "fk:splineIK:stretchySplineIK" weights, i.e. "2:1:1"
+    bool parseKinematicMix(const std::string & mix, SyntheticRigSpec & spec);
+    //the kinematic type of the given spine, spread evenly according to the mix weights
+    std::string getSyntheticKinematicType(const SyntheticRigSpec & spec, unsigned int spineNum);
+    //the xml rig definition of a synthetic rig
+    std::string makeSyntheticRigXml(const std::string & rigName, double version, const SyntheticRigSpec & spec, unsigned int changes = kSyntheticBase);
+    bool writeSyntheticRigXml(const std::string & filePath, const std::string & rigName, double version, const SyntheticRigSpec & spec, unsigned int changes = kSyntheticBase);
+}
+
+#endif //_SyntheticRig
@@ -0,0 +1,134 @@
+/***************************************************************
+* Summary: Thin wrappers around the platform's mutexes,        *
+*          condition variables and threads, shared by the      *
+*          worker pool and the rig update pipeline.            *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "Threading.h"
+
+#ifdef _WIN32
+lrutils::Mutex::Mutex() {
+    InitializeCriticalSection(&this->m_mutex);
+}
+
+lrutils::Mutex::~Mutex() {
+    DeleteCriticalSection(&this->m_mutex);
+}
+
+void lrutils::Mutex::lock() {
+    EnterCriticalSection(&this->m_mutex);
+}
+
+void lrutils::Mutex::unlock() {
+    LeaveCriticalSection(&this->m_mutex);
+}
+
+lrutils::Condition::Condition() {
+    InitializeConditionVariable(&this->m_condition);
+}
+
+lrutils::Condition::~Condition() {
+
+}
+
+void lrutils::Condition::wait(Mutex & mutex) {
+    SleepConditionVariableCS(&this->m_condition, &mutex.m_mutex, INFINITE);
+}
+
+void lrutils::Condition::notifyAll() {
+    WakeAllConditionVariable(&this->m_condition);
+}
+
+bool lrutils::Thread::start(Function function, void * arg) {
+    this->m_function = function;
+    this->m_arg = arg;
+    this->m_thread = CreateThread(NULL, 0, threadMain, this, 0, NULL);
+    this->m_running = this->m_thread != NULL;
+    return this->m_running;
+}
+
+void lrutils::Thread::join() {
+    if(!this->m_running)
+        return;
+    WaitForSingleObject(this->m_thread, INFINITE);
+    CloseHandle(this->m_thread);
+    this->m_running = false;
+}
+
+DWORD WINAPI lrutils::Thread::threadMain(LPVOID thread) {
+    Thread * self = (Thread*)thread;
+    self->m_function(self->m_arg);
+    return 0;
+}
+
+long lrutils::atomicIncrement(volatile long * value) {
+    return InterlockedIncrement(value);
+}
+#else
+lrutils::Mutex::Mutex() {
+    pthread_mutex_init(&this->m_mutex, NULL);
+}
+
+lrutils::Mutex::~Mutex() {
+    pthread_mutex_destroy(&this->m_mutex);
+}
+
+void lrutils::Mutex::lock() {
+    pthread_mutex_lock(&this->m_mutex);
+}
+
+void lrutils::Mutex::unlock() {
+    pthread_mutex_unlock(&this->m_mutex);
+}
+
+lrutils::Condition::Condition() {
+    pthread_cond_init(&this->m_condition, NULL);
+}
+
+lrutils::Condition::~Condition() {
+    pthread_cond_destroy(&this->m_condition);
+}
+
+void lrutils::Condition::wait(Mutex & mutex) {
+    pthread_cond_wait(&this->m_condition, &mutex.m_mutex);
+}
+
+void lrutils::Condition::notifyAll() {
+    pthread_cond_broadcast(&this->m_condition);
+}
+
+bool lrutils::Thread::start(Function function, void * arg) {
+    this->m_function = function;
+    this->m_arg = arg;
+    this->m_running = pthread_create(&this->m_thread, NULL, threadMain, this) == 0;
+    return this->m_running;
+}
+
+void lrutils::Thread::join() {
+    if(!this->m_running)
+        return;
+    pthread_join(this->m_thread, NULL);
+    this->m_running = false;
+}
+
+void * lrutils::Thread::threadMain(void * thread) {
+    Thread * self = (Thread*)thread;
+    self->m_function(self->m_arg);
+    return NULL;
+}
+
+long lrutils::atomicIncrement(volatile long * value) {
+    return __sync_add_and_fetch(value, 1);
+}
+#endif
+
+lrutils::Thread::Thread() {
+    this->m_function = NULL;
+    this->m_arg = NULL;
+    this->m_running = false;
+}
+
+lrutils::Thread::~Thread() {
+    this->join();
+}
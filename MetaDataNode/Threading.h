@@ -0,0 +1,98 @@
+/***************************************************************
+* Summary: Thin wrappers around the platform's mutexes,        *
+*          condition variables and threads, shared by the      *
+*          worker pool and the rig update pipeline.            *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _Threading
+#define _Threading
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace lrutils {
+    class Mutex
+    {
+    public:
+        Mutex();
+        ~Mutex();
+        void lock();
+        void unlock();
+    private:
+        friend class Condition;
+        Mutex(const Mutex &);
+        Mutex & operator=(const Mutex &);
+#ifdef _WIN32
+        CRITICAL_SECTION m_mutex;
+#else
+        pthread_mutex_t m_mutex;
+#endif
+    };
+
+    class Condition
+    {
+    public:
+        Condition();
+        ~Condition();
+        //mutex must be locked, it is unlocked while waiting and locked again before returning
+        void wait(Mutex & mutex);
+        void notifyAll();
+    private:
+        Condition(const Condition &);
+        Condition & operator=(const Condition &);
+#ifdef _WIN32
+        CONDITION_VARIABLE m_condition;
+#else
+        pthread_cond_t m_condition;
+#endif
+    };
+
+    class ScopedLock
+    {
+    public:
+        ScopedLock(Mutex & mutex) : m_mutex(mutex) {m_mutex.lock();};
+        ~ScopedLock() {m_mutex.unlock();};
+    private:
+        Mutex & m_mutex;
+    };
+
+    class Thread
+    {
+    public:
+        typedef void (*Function)(void * arg);
+
+        Thread();
+        //joins the thread if it is still running
+        ~Thread();
+        //runs function(arg) on a new thread, returns false if the thread couldn't be started
+        bool start(Function function, void * arg);
+        void join();
+        bool isRunning() const {return m_running;};
+    private:
+        //the thread reads its function and argument from the object, so it must not be copied
+        Thread(const Thread &);
+        Thread & operator=(const Thread &);
+#ifdef _WIN32
+        static DWORD WINAPI threadMain(LPVOID thread);
+        HANDLE m_thread;
+#else
+        static void * threadMain(void * thread);
+        pthread_t m_thread;
+#endif
+        Function m_function;
+        void * m_arg;
+        bool m_running;
+    };
+
+    //adds one to value and returns the result, atomically
+    long atomicIncrement(volatile long * value);
+}
+
+#endif //_Threading
@@ -0,0 +1,173 @@
+/***************************************************************
+* Summary: Fixed size ring buffer of begin/end trace events    *
+*          that any thread can record into without taking a    *
+*          lock, written out as Chrome trace-event JSON.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TraceBuffer.h"
+#include <cstring>
+#include <sstream>
+#include <fstream>
+#include <map>
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#else
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+    long atomicFetchAdd(volatile long * value) {
+#ifdef _WIN32
+        return InterlockedIncrement(value) - 1;
+#else
+        return __sync_fetch_and_add(value, 1);
+#endif
+    }
+
+    void memoryBarrier() {
+#ifdef _WIN32
+        MemoryBarrier();
+#else
+        __sync_synchronize();
+#endif
+    }
+
+    void copyText(char * dst, const char * src, unsigned int length) {
+        if(src == NULL) {
+            dst[0] = '\0';
+            return;
+        }
+        strncpy(dst, src, length - 1);
+        dst[length - 1] = '\0';
+    }
+
+    void writeJsonString(std::stringstream & json, const char * value) {
+        json << '"';
+        for(const char * c = value; *c != '\0'; c++) {
+            if(*c == '"' || *c == '\\')
+                json << '\\' << *c;
+            else if(*c == '\n')
+                json << "\\n";
+            else if(*c == '\t')
+                json << "\\t";
+            else if((unsigned char)*c >= 0x20)
+                json << *c;
+        }
+        json << '"';
+    }
+}
+
+TraceBuffer::TraceBuffer(unsigned int capacity) {
+    m_next = 0;
+    this->setCapacity(capacity);
+}
+
+TraceBuffer::~TraceBuffer() {
+
+}
+
+void TraceBuffer::clear() {
+    for(unsigned int i = 0; i < this->m_events.size(); i++) {
+        this->m_events[i].sequence = 0;
+    }
+    this->m_next = 0;
+}
+
+void TraceBuffer::setCapacity(unsigned int capacity) {
+    if(capacity == 0)
+        capacity = 1;
+    this->m_events.resize(capacity);
+    this->clear();
+}
+
+void TraceBuffer::record(EventType type, unsigned int category, double timestamp, const char * name, const char * detail) {
+    long index = atomicFetchAdd(&this->m_next);
+    Event & event = this->m_events[(unsigned long)index % this->m_events.size()];
+    //readers skip the slot until it is published again
+    event.sequence = 0;
+    memoryBarrier();
+    event.type = (char)type;
+    event.category = category;
+    event.threadId = getCurrentThreadId();
+    event.timestamp = timestamp;
+    copyText(event.name, name, kNameLength);
+    copyText(event.detail, detail, kDetailLength);
+    memoryBarrier();
+    event.sequence = index + 1;
+}
+
+unsigned long TraceBuffer::getNumRecorded() const {
+    return (unsigned long)this->m_next;
+}
+
+std::string TraceBuffer::toChromeJson(const std::vector<std::string> & categoryNames) const {
+    long next = this->m_next;
+    long capacity = (long)this->m_events.size();
+    long first = (next > capacity) ? next - capacity : 0;
+    //the begin events of the oldest end events may have been overwritten, those ends are dropped
+    std::map<unsigned int, unsigned int> openDepths;
+
+    std::stringstream json;
+    json.precision(3);
+    json << std::fixed;
+    json << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool firstEvent = true;
+    for(long i = first; i < next; i++) {
+        const Event & event = this->m_events[(unsigned long)i % this->m_events.size()];
+        if(event.sequence != i + 1)
+            continue;
+        if(event.type == kBegin) {
+            openDepths[event.threadId]++;
+        } else {
+            if(openDepths[event.threadId] == 0)
+                continue;
+            openDepths[event.threadId]--;
+        }
+        std::string category = "default";
+        for(unsigned int bit = 0; bit < categoryNames.size(); bit++) {
+            if(event.category & (1u << bit)) {
+                category = categoryNames[bit];
+                break;
+            }
+        }
+        json << (firstEvent ? "\n" : ",\n");
+        firstEvent = false;
+        json << "{\"name\": ";
+        writeJsonString(json, event.name);
+        json << ", \"cat\": ";
+        writeJsonString(json, category.c_str());
+        json << ", \"ph\": \"" << event.type << "\"";
+        json << ", \"ts\": " << event.timestamp * 1.0e6;
+        json << ", \"pid\": 0, \"tid\": " << event.threadId;
+        if(event.detail[0] != '\0') {
+            json << ", \"args\": {\"detail\": ";
+            writeJsonString(json, event.detail);
+            json << "}";
+        }
+        json << "}";
+    }
+    json << "\n]}\n";
+    return json.str();
+}
+
+bool TraceBuffer::writeChromeJson(const std::string & filePath, const std::vector<std::string> & categoryNames) const {
+    std::ofstream jsonFile(filePath.c_str());
+    if(!jsonFile)
+        return false;
+    jsonFile << this->toChromeJson(categoryNames);
+    return jsonFile.good();
+}
+
+unsigned int TraceBuffer::getCurrentThreadId() {
+#ifdef _WIN32
+    return (unsigned int)GetCurrentThreadId();
+#elif defined(__APPLE__)
+    return (unsigned int)pthread_mach_thread_np(pthread_self());
+#else
+    return (unsigned int)syscall(SYS_gettid);
+#endif
+}
@@ -0,0 +1,60 @@
+/***************************************************************
+* Summary: Fixed size ring buffer of begin/end trace events    *
+*          that any thread can record into without taking a    *
+*          lock, written out as Chrome trace-event JSON.       *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _TraceBuffer
+#define _TraceBuffer
+
+#include <string>
+#include <vector>
+
+class TraceBuffer
+{
+public:
+    enum EventType {
+        kBegin = 'B',
+        kEnd = 'E'
+    };
+    //longer names and details are truncated
+    static const unsigned int kNameLength = 48;
+    static const unsigned int kDetailLength = 112;
+
+    struct Event
+    {
+        volatile long sequence; //one past the index the event was recorded at, 0 while a writer fills the slot
+        char type;
+        unsigned int category;
+        unsigned int threadId;
+        double timestamp; //seconds
+        char name[kNameLength];
+        char detail[kDetailLength];
+    };
+
+    TraceBuffer(unsigned int capacity = 16384);
+    ~TraceBuffer();
+
+    //drops every recorded event. Neither may be called while other threads record
+    void clear();
+    void setCapacity(unsigned int capacity);
+    unsigned int getCapacity() const {return (unsigned int)m_events.size();};
+
+    //claims the next slot with an atomic increment, once the buffer is full the oldest events are overwritten
+    void record(EventType type, unsigned int category, double timestamp, const char * name, const char * detail = NULL);
+    //events recorded since the last clear, including those that were overwritten
+    unsigned long getNumRecorded() const;
+
+    //categoryNames[i] names the category with bit i set. Must not be called while other threads record
+    std::string toChromeJson(const std::vector<std::string> & categoryNames) const;
+    bool writeChromeJson(const std::string & filePath, const std::vector<std::string> & categoryNames) const;
+
+    static unsigned int getCurrentThreadId();
+
+private:
+    std::vector<Event> m_events;
+    volatile long m_next; //index the next event is recorded at
+};
+
+#endif //_TraceBuffer
@@ -7,8 +7,8 @@
 ***********************************************************/
 
 #include "MetaDataManagerNode.h"
+#include "MetaRootNode.h"
 #include "UpdateMetaDataManagerCmd.h"
-#include <maya/MItDependencyNodes.h>
 #include <maya/MFn.h>
 #include <maya/MPlugArray.h>
 #include <maya/MObjectArray.h>
@@ -16,8 +16,10 @@
 #include <maya/MArgList.h>
 #include <maya/MArgDatabase.h>
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 #include "LoadRigUtils.h"
 #include "Rig.h"
+#include "RigUpdatePipeline.h"
 #include <sstream>
 #include <boost/lexical_cast.hpp>
 #include <rapidxml.hpp>
@@ -32,69 +34,84 @@ MStatus UpdateMetaDataManagerCmd::doIt ( const MArgList &args )
     MStatus stat;
 
     MStatus paramStatus = parseArgs(args);
+    RigTraceCapture traceCapture(this->m_tracePath);
+
+    MObject managerObj = MetaDataManagerNode::getManager();
+    if( !managerObj.isNull() ) {
+        MFnDependencyNode nodeFn( managerObj );
+        //Get the plug for the list of metaRoots
+        MPlug metaRootsPlug = lrutils::findPlug(nodeFn, MetaDataManagerNode::metaRoots,true,&stat);
+        MyCheckStatusReturn(stat,"findPlug failed");
+        //MGlobal::displayInfo( metaRootsPlug.name() );
+        
+        //follow its connection to all the plugs on connected metaRoots
+        MPlugArray rootPlugs;
+        lrutils::connectedTo(metaRootsPlug, rootPlugs,false,true,&stat);
+        MyCheckStatusReturn(stat,"MPlug.connectedTo failed");
+        //stringstream ss;
+        //ss << "rootPlugs length = " << rootPlugs.length();
+        //MGlobal::displayInfo( ss.str().c_str() );
+
+        //the rigs are read from the scene up front, their xml files are then parsed and planned
+        //on the pipeline's threads while the rig before them is updated
+        RigUpdatePipeline pipeline(this->m_forceUpdate);
+
+        //iterate over the rootPlugs and find their corresponding metaRoot nodes
+        for(unsigned int i = 0; i < rootPlugs.length(); i++) {
+            MObject rootNodeObj = rootPlugs[i].node(&stat);
+            MyCheckStatusReturn(stat,"MPlug.node() failed");
+            MFnDependencyNode rootNodeFn( rootNodeObj );
+
+            //only the named rig is updated when a name is given
+            if( paramStatus == MS::kSuccess && this->m_rootNodeName.length() > 0 ) {
+                if( rootNodeFn.name() != this->m_rootNodeName )
+                    continue;
+            }
 
-    for( MItDependencyNodes nodeIt(MFn::kPluginDependNode);
-        !nodeIt.isDone(); nodeIt.next() ) {
-        MFnDependencyNode nodeFn( nodeIt.item() );
-        if(nodeFn.typeId() == MetaDataManagerNode::id) {
-            //Get the plug for the list of metaRoots
-            MPlug metaRootsPlug = nodeFn.findPlug(MString("metaRoots"),true,&stat);
-            MyCheckStatusReturn(stat,"findPlug failed");
-            //MGlobal::displayInfo( metaRootsPlug.name() );
-            
-            //follow its connection to all the plugs on connected metaRoots
-            MPlugArray rootPlugs;
-            metaRootsPlug.connectedTo(rootPlugs,false,true,&stat);
-            MyCheckStatusReturn(stat,"MPlug.connectedTo failed");
-            //stringstream ss;
-            //ss << "rootPlugs length = " << rootPlugs.length();
-            //MGlobal::displayInfo( ss.str().c_str() );
-
-            //iterate over the rootPlugs and find their corresponding metaRoot nodes
-            for(unsigned int i = 0; i < rootPlugs.length(); i++) {
-                MObject rootNodeObj = rootPlugs[i].node(&stat);
-                MyCheckStatusReturn(stat,"MPlug.node() failed");
-                MFnDependencyNode rootNodeFn( rootNodeObj );
-
-                if( paramStatus == MS::kSuccess ) {
-                    if( rootNodeFn.name() != this->m_rootNodeName )
-                        continue;
-                }
-
-                //get the xml path string held in the xmlPath attribute
-                MString xmlString;
-                if (m_alternateXML) {
-                    xmlString = m_alternateXMLPath;
-                } else {
-                    MPlug rootXmlPath = rootNodeFn.findPlug(MString("xmlPath"),true,&stat);
-                    MyCheckStatusReturn(stat,"findPlug failed");
-                    rootXmlPath.getValue(xmlString);
-                }
-
-                //get the version number held in the version attribute
-                MPlug rootVersionPlug = rootNodeFn.findPlug(MString("version"),true,&stat);
+            //get the xml path string held in the xmlPath attribute
+            MString xmlString;
+            if (m_alternateXML) {
+                xmlString = m_alternateXMLPath;
+            } else {
+                MPlug rootXmlPath = lrutils::findPlug(rootNodeFn, MetaRootNode::xmlPath,true,&stat);
                 MyCheckStatusReturn(stat,"findPlug failed");
-                float nodeVersion = 0.0;
-                rootVersionPlug.getValue(nodeVersion);
-
-                //check to see if the version of the root node matches its xml file
-                m_xmlGuide = new XmlGuide(xmlString, true);
-                bool versionMatch = checkXmlFileVersion(nodeVersion);
-                //if the version doesn't match, update the loaded rig from the xml file
-                if(!versionMatch || this->m_forceUpdate) {
-                    float xmlVersion;
-                    m_xmlGuide->getVersion(xmlVersion);
-                    rootVersionPlug.setValue(xmlVersion);
-                    Rig* aRig = new Rig(xmlString, rootNodeObj);
-                    aRig->update(this->m_forceUpdate,this->m_globalPos);
-                    delete aRig;
-                    setResult(rootNodeFn.name());
-                }
-                delete m_xmlGuide;
+                rootXmlPath.getValue(xmlString);
             }
 
+            //get the version number held in the version attribute
+            MPlug rootVersionPlug = MetaDataNode::getCommonPlug(rootNodeFn.object(), MetaDataNode::kVersion, &stat);
+            MyCheckStatusReturn(stat,"findPlug failed");
+            float nodeVersion = 0.0;
+            rootVersionPlug.getValue(nodeVersion);
+
+            pipeline.addJob(rootNodeObj, xmlString, nodeVersion);
         }
-    }    
+
+        pipeline.start();
+        for(RigUpdatePipeline::Job * job = pipeline.next(); job != NULL; job = pipeline.next()) {
+            if(job->errors.length() > 0) {
+                MyError(job->errors);
+            }
+            //the pipeline only plans a rig whose version doesn't match its xml file
+            if(!job->status || !job->pRig)
+                continue;
+            MFnDependencyNode rootNodeFn( job->rootNodeObj );
+            MPlug rootVersionPlug = MetaDataNode::getCommonPlug(job->rootNodeObj, MetaDataNode::kVersion, &stat);
+            MyCheckStatusReturn(stat,"findPlug failed");
+            rootVersionPlug.setValue(job->xmlVersion);
+            job->pRig->setMetaRootNode(job->rootNodeObj);
+            job->pRig->update(this->m_forceUpdate,this->m_globalPos);
+            if(!this->m_utilization)
+                setResult(rootNodeFn.name());
+        }
+        //queried with rigProfile -buildReport along with the report of the last rig updated
+        MString report = pipeline.getReport().toString();
+        MStringArray buildReport = RigProfiler::getBuildReport();
+        buildReport.append(report);
+        RigProfiler::setBuildReport(buildReport);
+        if(this->m_utilization)
+            setResult(report);
+    }
 
     return redoIt();
 }
@@ -104,26 +121,6 @@ MStatus UpdateMetaDataManagerCmd::undoIt()
     return dgMod.undoIt();
 }
 
-bool UpdateMetaDataManagerCmd::checkXmlFileVersion(float version)
-{
-    MStatus status;
-    bool success = false;
-
-    //get info from the xml file      
-    float xmlVersion;
-    status = m_xmlGuide->getVersion(xmlVersion);
-    MyCheckStatus(status, "getVersion failed");
-    
-    //check to see if the versions match
-    if(xmlVersion == version) {
-        success = true;
-    } else {
-        success = false;
-    }    
-
-    return success;
-}
-
 MStatus UpdateMetaDataManagerCmd::updateHeaderInfo(MObject rootNode) {
     MStatus stat;
 
@@ -134,7 +131,7 @@ MStatus UpdateMetaDataManagerCmd::updateHeaderInfo(MObject rootNode) {
     float xmlVersion;
     m_xmlGuide->getVersion(xmlVersion);
     
-    MPlug rootVersionPlug = rootNodeFn.findPlug(MString("version"),true,&stat);
+    MPlug rootVersionPlug = MetaDataNode::getCommonPlug(rootNodeFn.object(), MetaDataNode::kVersion, &stat);
     MyCheckStatusReturn(stat,"findPlug failed");
     rootVersionPlug.setValue(xmlVersion);
 
@@ -147,7 +144,7 @@ MStatus UpdateMetaDataManagerCmd::updateHeaderInfo(MObject rootNode) {
 
 MStatus UpdateMetaDataManagerCmd::redoIt()
 {
-    return dgMod.doIt();
+    return lrutils::doIt(dgMod);
 }
 
 MStatus UpdateMetaDataManagerCmd::updateGeoNodes(MObject rootNode) {
@@ -155,10 +152,10 @@ MStatus UpdateMetaDataManagerCmd::updateGeoNodes(MObject rootNode) {
 
     MFnDependencyNode rootNodeFn( rootNode );
     
-    MPlug geometryPlug = rootNodeFn.findPlug(MString("geometry"),true,&status);
+    MPlug geometryPlug = lrutils::findPlug(rootNodeFn, MetaRootNode::geometry,true,&status);
     MyCheckStatusReturn(status,"findPlug geometry failed");
     MPlugArray geometryPlugs;
-    geometryPlug.connectedTo(geometryPlugs,false,true,&status);
+    lrutils::connectedTo(geometryPlug, geometryPlugs,false,true,&status);
     MyCheckStatusReturn(status, "MPlug.connectedTo failed");
     for(unsigned int j = 0; j < geometryPlugs.length(); j++) {
         MObject geoObj = geometryPlugs[j].node(&status);
@@ -182,7 +179,7 @@ MStatus UpdateMetaDataManagerCmd::updateGeoNodes(MObject rootNode) {
             stringstream tmp;
             tmp << "file -removeReference -referenceNode \"" << sNamespace.c_str() << "\";";
             MString referenceCommand = MString(tmp.str().c_str());
-            MGlobal::executeCommand(referenceCommand);
+            lrutils::executeCommand(referenceCommand);
 
             //get info from the xml file      
             MString geoFilePath;
@@ -203,7 +200,7 @@ MStatus UpdateMetaDataManagerCmd::updateGeoNodes(MObject rootNode) {
 
             transformFn.set(origGeoTransMat);
 
-            status = dgMod.connect( rootNodeFn.findPlug("geometry"), transformFn.findPlug("metaParent") );
+            status = dgMod.connect( lrutils::findPlug(rootNodeFn, MetaRootNode::geometry), lrutils::findPlug(transformFn, "metaParent") );
             MyCheckStatusReturn(status, "connect failed");
         }
 
@@ -220,6 +217,8 @@ MSyntax UpdateMetaDataManagerCmd::newSyntax()
     syntax.addFlag(UpdateMetaDataManagerCmd::XMLParam(), UpdateMetaDataManagerCmd::XMLParamLong(), MSyntax::kString);
     syntax.addFlag(UpdateMetaDataManagerCmd::ForceParam(), UpdateMetaDataManagerCmd::ForceParamLong(), MSyntax::kNoArg);
     syntax.addFlag(UpdateMetaDataManagerCmd::GlobalPosParam(), UpdateMetaDataManagerCmd::GlobalPosParamLong(), MSyntax::kNoArg);
+    syntax.addFlag(UpdateMetaDataManagerCmd::TraceParam(), UpdateMetaDataManagerCmd::TraceParamLong(), MSyntax::kString);
+    syntax.addFlag(UpdateMetaDataManagerCmd::UtilizationParam(), UpdateMetaDataManagerCmd::UtilizationParamLong(), MSyntax::kNoArg);
 
     return syntax;
 }
@@ -231,6 +230,7 @@ MStatus UpdateMetaDataManagerCmd::parseArgs(const MArgList & args )
         this->m_forceUpdate = false;
         this->m_globalPos = false;
         this->m_alternateXML = false;
+        this->m_utilization = false;
         return MS::kNotFound;
     }
 
@@ -271,5 +271,19 @@ MStatus UpdateMetaDataManagerCmd::parseArgs(const MArgList & args )
         this->m_alternateXML = false;
     }
 
+    if (argData.isFlagSet(UpdateMetaDataManagerCmd::UtilizationParam())) {
+        this->m_utilization = true;
+    } else {
+        this->m_utilization = false;
+    }
+
+    if (argData.isFlagSet(UpdateMetaDataManagerCmd::TraceParam())) {
+        status = argData.getFlagArgument(UpdateMetaDataManagerCmd::TraceParam(), 0, this->m_tracePath);
+        if (!status) {
+            status.perror("trace flag parsing failed");
+            return status;
+        }
+    }
+
     return MS::kSuccess;
 }
\ No newline at end of file
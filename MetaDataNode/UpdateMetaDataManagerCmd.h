@@ -38,18 +38,25 @@ public:
     //preserve global position of keys on all controller objects
     static const char* GlobalPosParam() { return "-g"; }
     static const char* GlobalPosParamLong() { return "-globalPos"; }
+    //write a Chrome trace-event timeline of the update to the given path
+    static const char* TraceParam() { return "-tr"; }
+    static const char* TraceParamLong() { return "-trace"; }
+    //return the per stage utilization of the update pipeline instead of the name of the last rig updated
+    static const char* UtilizationParam() { return "-u"; }
+    static const char* UtilizationParamLong() { return "-utilization"; }
 
 private:
-    virtual bool checkXmlFileVersion(float version);
     virtual MStatus updateHeaderInfo(MObject rootNode);
     virtual MStatus updateGeoNodes(MObject rootNode);
     MDGModifier dgMod;
-    XmlGuide* m_xmlGuide;
+    XmlGuidePtr m_xmlGuide;
     MString m_rootNodeName;
     MString m_alternateXMLPath; //path to the alternate xml file
+    MString m_tracePath; //path of the trace file, empty when the update isn't traced
     bool m_forceUpdate;
     bool m_alternateXML; //use an alternate xml file for the update
     bool m_globalPos; //fix keys to global position of controller
+    bool m_utilization; //return the update pipeline's utilization report
 
 };
 
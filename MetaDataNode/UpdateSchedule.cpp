@@ -0,0 +1,106 @@
+/***************************************************************
+* Summary: Dependency graph between the components of a rig    *
+*          update, ordered so that every component is loaded,  *
+*          updated or removed once and only after the nodes it *
+*          reads from other components are final.              *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "UpdateSchedule.h"
+#include <algorithm>
+#include <sstream>
+
+UpdateSchedule::UpdateSchedule() {
+    this->m_numGroups = 0;
+}
+
+UpdateSchedule::~UpdateSchedule() {
+
+}
+
+unsigned int UpdateSchedule::addItem() {
+    Item item;
+    item.numPredecessors = 0;
+    item.dependencies = 0;
+    item.group = 0;
+    this->m_items.push_back(item);
+    this->m_groupParents.push_back((unsigned int)this->m_groupParents.size());
+    return (unsigned int)this->m_items.size() - 1;
+}
+
+void UpdateSchedule::addDependency(unsigned int before, unsigned int after, unsigned int dependencies) {
+    if(before == after)
+        return;
+    this->m_items[after].dependencies |= dependencies;
+    std::vector<unsigned int> & successors = this->m_items[before].successors;
+    if(std::find(successors.begin(), successors.end(), after) != successors.end())
+        return;
+    successors.push_back(after);
+    this->m_items[after].numPredecessors++;
+
+    unsigned int beforeRoot = this->findRoot(before);
+    unsigned int afterRoot = this->findRoot(after);
+    //the lower index becomes the root so group numbers follow the order the items were added
+    if(beforeRoot < afterRoot)
+        this->m_groupParents[afterRoot] = beforeRoot;
+    else
+        this->m_groupParents[beforeRoot] = afterRoot;
+}
+
+unsigned int UpdateSchedule::findRoot(unsigned int item) {
+    while(this->m_groupParents[item] != item) {
+        this->m_groupParents[item] = this->m_groupParents[this->m_groupParents[item]];
+        item = this->m_groupParents[item];
+    }
+    return item;
+}
+
+bool UpdateSchedule::build() {
+    unsigned int numItems = (unsigned int)this->m_items.size();
+    this->m_order.clear();
+    this->m_order.reserve(numItems);
+
+    //Kahn's algorithm, the order vector doubles as the queue of ready items
+    std::vector<unsigned int> numWaiting(numItems);
+    for(unsigned int i = 0; i < numItems; i++) {
+        numWaiting[i] = this->m_items[i].numPredecessors;
+        if(numWaiting[i] == 0)
+            this->m_order.push_back(i);
+    }
+    for(unsigned int next = 0; next < this->m_order.size(); next++) {
+        const std::vector<unsigned int> & successors = this->m_items[this->m_order[next]].successors;
+        for(unsigned int i = 0; i < successors.size(); i++) {
+            if(--numWaiting[successors[i]] == 0)
+                this->m_order.push_back(successors[i]);
+        }
+    }
+    bool acyclic = this->m_order.size() == numItems;
+    if(!acyclic) {
+        for(unsigned int i = 0; i < numItems; i++) {
+            if(numWaiting[i] > 0)
+                this->m_order.push_back(i);
+        }
+    }
+
+    //number the groups by their first item
+    std::vector<int> groupNumbers(numItems, -1);
+    this->m_numGroups = 0;
+    for(unsigned int i = 0; i < numItems; i++) {
+        unsigned int root = this->findRoot(i);
+        if(groupNumbers[root] == -1)
+            groupNumbers[root] = (int)this->m_numGroups++;
+        this->m_items[i].group = (unsigned int)groupNumbers[root];
+    }
+    return acyclic;
+}
+
+MString UpdateSchedule::toString() const {
+    std::stringstream msg;
+    unsigned int numDependencies = 0;
+    for(unsigned int i = 0; i < this->m_items.size(); i++) {
+        numDependencies += (unsigned int)this->m_items[i].successors.size();
+    }
+    msg << "update schedule: " << this->m_items.size() << " components, " << numDependencies
+        << " dependencies, " << this->m_numGroups << " independent groups";
+    return MString(msg.str().c_str());
+}
@@ -0,0 +1,68 @@
+/***************************************************************
+* Summary: Dependency graph between the components of a rig    *
+*          update, ordered so that every component is loaded,  *
+*          updated or removed once and only after the nodes it *
+*          reads from other components are final.              *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _UpdateSchedule
+#define _UpdateSchedule
+
+#include <maya/MString.h>
+#include <vector>
+
+class UpdateSchedule
+{
+public:
+    //what a component reads from the component it depends on
+    enum Dependency {
+        kParentJoint = 1,       //the joint its first joint is parented under
+        kParentController = 2,  //the controller its controller group or clusters are parented under
+        kHipJointCopy = 4,      //the hip joint a spine copies to start its chain
+        kShoulderControl = 8,   //the shoulder controller of a spline IK parent spine
+        kMetaChild = 16         //a removed component's child has to leave it before it is deleted
+    };
+
+    UpdateSchedule();
+    ~UpdateSchedule();
+
+    //adds a work item, returns its index. Items are numbered in the order they were added
+    unsigned int addItem();
+    //item after can't be done before item before. Repeated dependencies are merged
+    void addDependency(unsigned int before, unsigned int after, unsigned int dependencies);
+
+    //orders the items topologically, the items without dependencies first in the order they were
+    //added, so the same graph always gives the same order. Returns false if the graph has a cycle,
+    //the items left waiting on it are then ordered last in the order they were added
+    bool build();
+
+    unsigned int getNumItems() const {return (unsigned int)m_items.size();};
+    //item indices in the order they are to be done
+    const std::vector<unsigned int> & getOrder() const {return m_order;};
+    //what item after depends on its predecessors for, 0 for an item without any
+    unsigned int getDependencies(unsigned int item) const {return m_items[item].dependencies;};
+    //items connected by dependencies share a group, groups don't depend on each other
+    unsigned int getNumGroups() const {return m_numGroups;};
+    unsigned int getGroup(unsigned int item) const {return m_items[item].group;};
+    MString toString() const;
+
+private:
+    struct Item
+    {
+        std::vector<unsigned int> successors;
+        unsigned int numPredecessors;
+        unsigned int dependencies;
+        unsigned int group;
+    };
+
+    unsigned int findRoot(unsigned int item);
+
+    std::vector<Item> m_items;
+    //union-find parents of the items while the groups are built
+    std::vector<unsigned int> m_groupParents;
+    std::vector<unsigned int> m_order;
+    unsigned int m_numGroups;
+};
+
+#endif //_UpdateSchedule
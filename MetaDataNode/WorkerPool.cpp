@@ -0,0 +1,201 @@
+/***************************************************************
+* Summary: Fixed set of worker threads that run batches of     *
+*          independent tasks. Each worker takes tasks from the *
+*          front of its own queue and steals from the back of  *
+*          the others' once it runs out. Tasks must not call   *
+*          into Maya.                                          *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "WorkerPool.h"
+#include "Threading.h"
+#include <deque>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using lrutils::Mutex;
+using lrutils::Condition;
+using lrutils::ScopedLock;
+
+struct WorkerPool::State
+{
+    struct Queue
+    {
+        Mutex lock;
+        std::deque<Task*> tasks;
+    };
+    struct ThreadArg
+    {
+        State * state;
+        unsigned int worker;
+    };
+
+    //one queue per worker, worker 0 being the thread that calls run
+    std::vector<Queue*> queues;
+    std::vector<lrutils::Thread*> threads;
+    std::vector<ThreadArg> threadArgs;
+    //guards the batch counters
+    Mutex batchLock;
+    Condition batchStarted;
+    Condition batchDone;
+    unsigned long batch;
+    unsigned int numBusy; //threads still working on the current batch
+    bool stopping;
+    volatile long numSteals;
+
+    Task * takeTask(unsigned int worker);
+    void work(unsigned int worker);
+    void threadLoop(unsigned int worker);
+};
+
+namespace {
+    void threadMain(void * arg) {
+        WorkerPool::State::ThreadArg * threadArg = (WorkerPool::State::ThreadArg*)arg;
+        threadArg->state->threadLoop(threadArg->worker);
+    }
+}
+
+WorkerPool * WorkerPool::s_shared = NULL;
+
+WorkerPool::WorkerPool(unsigned int numThreads) {
+    this->m_numThreads = numThreads > 0 ? numThreads : getHardwareThreads();
+    this->m_state = new State();
+    State & state = *this->m_state;
+    state.batch = 0;
+    state.numBusy = 0;
+    state.stopping = false;
+    state.numSteals = 0;
+    for(unsigned int i = 0; i < this->m_numThreads; i++) {
+        state.queues.push_back(new State::Queue());
+    }
+    //the arguments must not move once the threads have them
+    state.threadArgs.resize(this->m_numThreads);
+    for(unsigned int i = 1; i < this->m_numThreads; i++) {
+        state.threadArgs[i].state = this->m_state;
+        state.threadArgs[i].worker = i;
+        lrutils::Thread * thread = new lrutils::Thread();
+        if(!thread->start(threadMain, &state.threadArgs[i])) {
+            delete thread;
+            break;
+        }
+        state.threads.push_back(thread);
+    }
+    //a thread that couldn't be started leaves its tasks to the others
+    this->m_numThreads = (unsigned int)state.threads.size() + 1;
+}
+
+WorkerPool::~WorkerPool() {
+    State & state = *this->m_state;
+    {
+        ScopedLock lock(state.batchLock);
+        state.stopping = true;
+        state.batchStarted.notifyAll();
+    }
+    for(unsigned int i = 0; i < state.threads.size(); i++) {
+        //joined on deletion
+        delete state.threads[i];
+    }
+    for(unsigned int i = 0; i < state.queues.size(); i++) {
+        delete state.queues[i];
+    }
+    delete this->m_state;
+}
+
+void WorkerPool::run(const std::vector<Task*> & tasks) {
+    if(tasks.empty())
+        return;
+    State & state = *this->m_state;
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        State::Queue & queue = *state.queues[i % this->m_numThreads];
+        ScopedLock lock(queue.lock);
+        queue.tasks.push_back(tasks[i]);
+    }
+    {
+        ScopedLock lock(state.batchLock);
+        state.numBusy = (unsigned int)state.threads.size();
+        state.batch++;
+        state.batchStarted.notifyAll();
+    }
+    state.work(0);
+    ScopedLock lock(state.batchLock);
+    while(state.numBusy > 0) {
+        state.batchDone.wait(state.batchLock);
+    }
+}
+
+unsigned long WorkerPool::getNumSteals() const {
+    return (unsigned long)this->m_state->numSteals;
+}
+
+unsigned int WorkerPool::getHardwareThreads() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long numThreads = (long)info.dwNumberOfProcessors;
+#else
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return numThreads > 0 ? (unsigned int)numThreads : 1;
+}
+
+WorkerPool & WorkerPool::getShared() {
+    if(s_shared == NULL)
+        s_shared = new WorkerPool();
+    return *s_shared;
+}
+
+void WorkerPool::releaseShared() {
+    delete s_shared;
+    s_shared = NULL;
+}
+
+WorkerPool::Task * WorkerPool::State::takeTask(unsigned int worker) {
+    {
+        Queue & own = *this->queues[worker];
+        ScopedLock lock(own.lock);
+        if(!own.tasks.empty()) {
+            Task * task = own.tasks.front();
+            own.tasks.pop_front();
+            return task;
+        }
+    }
+    //steal from the back, away from where the owner is working
+    unsigned int numQueues = (unsigned int)this->queues.size();
+    for(unsigned int i = 1; i < numQueues; i++) {
+        Queue & other = *this->queues[(worker + i) % numQueues];
+        ScopedLock lock(other.lock);
+        if(!other.tasks.empty()) {
+            Task * task = other.tasks.back();
+            other.tasks.pop_back();
+            lrutils::atomicIncrement(&this->numSteals);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+void WorkerPool::State::work(unsigned int worker) {
+    //no tasks are added while a batch runs, so once every queue is empty the batch is done
+    for(Task * task = this->takeTask(worker); task != NULL; task = this->takeTask(worker)) {
+        task->run();
+    }
+}
+
+void WorkerPool::State::threadLoop(unsigned int worker) {
+    unsigned long lastBatch = 0;
+    ScopedLock lock(this->batchLock);
+    while(true) {
+        while(this->batch == lastBatch && !this->stopping) {
+            this->batchStarted.wait(this->batchLock);
+        }
+        if(this->stopping)
+            return;
+        lastBatch = this->batch;
+        this->batchLock.unlock();
+        this->work(worker);
+        this->batchLock.lock();
+        if(--this->numBusy == 0)
+            this->batchDone.notifyAll();
+    }
+}
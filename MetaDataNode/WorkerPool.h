@@ -0,0 +1,56 @@
+/***************************************************************
+* Summary: Fixed set of worker threads that run batches of     *
+*          independent tasks. Each worker takes tasks from the *
+*          front of its own queue and steals from the back of  *
+*          the others' once it runs out. Tasks must not call   *
+*          into Maya.                                          *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _WorkerPool
+#define _WorkerPool
+
+#include <vector>
+
+class WorkerPool
+{
+public:
+    class Task
+    {
+    public:
+        virtual ~Task() {};
+        virtual void run() = 0;
+    };
+
+    //the calling thread works through the tasks as well, so a pool of one thread starts none.
+    //0 uses one thread per hardware thread
+    WorkerPool(unsigned int numThreads = 0);
+    ~WorkerPool();
+
+    unsigned int getNumThreads() const {return m_numThreads;};
+    //runs every task and returns once all of them have finished. Tasks are dealt to the
+    //workers' queues in order, so with a single thread they run in order
+    void run(const std::vector<Task*> & tasks);
+    //tasks run by another worker than the one they were dealt to, over the pool's lifetime
+    unsigned long getNumSteals() const;
+
+    static unsigned int getHardwareThreads();
+    //pool sized to the hardware shared by the rig builds, created on first use
+    static WorkerPool & getShared();
+    //joins the shared pool's threads, called when the plugin is unloaded
+    static void releaseShared();
+
+    //the queues, threads and locks, defined with the platform's threading in the source file
+    struct State;
+
+private:
+    //the threads belong to one pool
+    WorkerPool(const WorkerPool &);
+    WorkerPool & operator=(const WorkerPool &);
+
+    unsigned int m_numThreads;
+    State * m_state;
+    static WorkerPool * s_shared;
+};
+
+#endif //_WorkerPool
@@ -13,6 +13,7 @@
 #include <sstream>
 #include <vector>
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
 
 using namespace std;
 using namespace rapidxml;
@@ -29,21 +30,28 @@ XmlGuide ::~XmlGuide() {
 }
 
 MStatus XmlGuide ::loadXmlFile(MString filePath, bool bFullPath) {
-    MStatus success = MStatus::kFailure;
-
-    MString projPath = MGlobal::executeCommandStringResult(MString("workspace -q -rd;"),false,false);
-    MString relativePath = filePath.substring(2,filePath.numChars() - 1);
-
     //assemble the full file path of the xml file if necessary
     MString fullPath;
     if(bFullPath) {
         fullPath = filePath;
     } else {    
-        MString projPath = MGlobal::executeCommandStringResult(MString("workspace -q -rd;"),false,false);
+        MString projPath = lrutils::executeCommandStringResult(MString("workspace -q -rd;"),false,false);
         MString relativePath = filePath.substring(2,filePath.numChars() - 1);
         fullPath = projPath + relativePath;
     }
+
+    MStatus success = this->parseXmlFile(fullPath);
+    if(this->m_errors.length() > 0) {
+        MString errors = this->m_errors;
+        MyError(errors);
+    }
+    return success;
+}
+
+MStatus XmlGuide ::parseXmlFile(MString fullPath) {
+    MStatus success = MStatus::kFailure;
     this->m_filePath = fullPath;
+    this->m_errors = "";
 
     //open the xml file and read its contents into a string
     ifstream xmlFile;
@@ -51,7 +59,8 @@ MStatus XmlGuide ::loadXmlFile(MString filePath, bool bFullPath) {
     //file open failed
     if(!xmlFile) {
         xmlFile.close();
-        MyCheckStatusReturn(success, "Could not open the input xml file: "+fullPath);
+        this->m_errors += "Could not open the input xml file: "+fullPath+"\n";
+        return success;
     }
     string xmlContent;
     xmlContent.assign( (istreambuf_iterator<char>(xmlFile)),
@@ -70,7 +79,8 @@ MStatus XmlGuide ::loadXmlFile(MString filePath, bool bFullPath) {
         doc.parse<parse_declaration_node | parse_no_data_nodes>(&xmlContentCopy[0]);
     }
     catch (rapidxml::parse_error e) {
-        MyCheckStatusReturn(success,"Could not parse the xml file.");
+        this->m_errors += "Could not parse the xml file: "+fullPath+"\n";
+        return success;
     }
     string xmlNameString = doc.first_node()->first_attribute("name")->value();
 
@@ -133,8 +143,8 @@ boost::shared_ptr<ComponentGuide> XmlGuide::createGuide(xml_node<>* compNode, bo
             compGuide.reset( new SpineComponentGuide(componentNode) );
         }
         else {
-            stringstream msg; msg << "component type " << componentType.asChar() << " is invalid";
-            MGlobal::displayError(msg.str().c_str());
+            stringstream msg; msg << "component type " << componentType.asChar() << " is invalid\n";
+            this->m_errors += msg.str().c_str();
         }
         if( parentGuide != boost::shared_ptr<ComponentGuide>() )
             parentGuide->addChildCompGuide(compGuide);
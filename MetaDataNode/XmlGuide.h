@@ -23,6 +23,11 @@ public:
     ~XmlGuide();
 
     MStatus loadXmlFile(MString filePath, bool bFullPath);
+    //reads and parses the xml file at fullPath without calling into Maya, so it can run off the main thread.
+    //Problems are kept for getErrors() instead of being displayed
+    MStatus parseXmlFile(MString fullPath);
+    //problems found by the last parse, one per line, empty if there were none
+    MString getErrors() {return m_errors;};
     MStatus getName(MString & name);
     MStatus setName(MString name);
     MStatus getVersion(float & version);
@@ -41,6 +46,7 @@ private:
     MString m_filePath; //full path to the xml file for this guide
     MString m_geoFilePath; //local path to the geometry asset file
     MString m_geoName; //name of the object within the geometry asset file used in the rig
+    MString m_errors; //problems found while parsing
     //rapidxml::xml_document<> m_xmlDoc;
     boost::shared_ptr<ComponentGuide> m_pChildComponent; //root component of the rig (typically the global component)
 
@@ -48,4 +54,6 @@ private:
 
 };
 
+typedef boost::shared_ptr<XmlGuide> XmlGuidePtr;
+
 #endif
\ No newline at end of file
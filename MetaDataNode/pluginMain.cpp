@@ -13,12 +13,19 @@
 #include "RemoveRigCmd.h"
 #include "GetMetaNodeConnectionCmd.h"
 #include "GetMetaChildByIdCmd.h"
+#include "RigBenchmarkCmd.h"
+#include "RigProfileCmd.h"
+#include "NodeNameIndexCmd.h"
 #include "MetaRootNode.h"
 #include "MDGlobalNode.h"
 #include "MDHipNode.h"
 #include "MDSpineNode.h"
 #include "MetaDataManagerNode.h"
+#include "ControllerShapes.h"
 #include "MyErrorChecking.h"
+#include "RigProfiler.h"
+#include "NodeNameIndex.h"
+#include "WorkerPool.h"
 
 #include <maya/MFnPlugin.h>
 
@@ -61,6 +68,18 @@ MStatus initializePlugin( MObject obj )
 
     MyCheckStatusReturn(status, "registerCommand getMetaChildById failed");
 
+    status = plugin.registerCommand( "rigBenchmark", RigBenchmarkCmd::creator, RigBenchmarkCmd::newSyntax );
+
+    MyCheckStatusReturn(status, "registerCommand rigBenchmark failed");
+
+    status = plugin.registerCommand( "rigProfile", RigProfileCmd::creator, RigProfileCmd::newSyntax );
+
+    MyCheckStatusReturn(status, "registerCommand rigProfile failed");
+
+    status = plugin.registerCommand( "nodeNameIndex", NodeNameIndexCmd::creator, NodeNameIndexCmd::newSyntax );
+
+    MyCheckStatusReturn(status, "registerCommand nodeNameIndex failed");
+
     /* Register all nodes */
 	status = plugin.registerNode( "MetaDataNode", MetaDataNode::id, MetaDataNode::creator,
 								  MetaDataNode::initialize );
@@ -91,6 +110,12 @@ MStatus initializePlugin( MObject obj )
     //plugin.removeMenuItem(items);
     //plugin.addMenuItem("Metadata Rigging","MayaWindow","","");
 
+    status = NodeNameIndex::install();
+    MyCheckStatusReturn(status, "NodeNameIndex::install() failed");
+
+    status = MetaDataManagerNode::installCallbacks();
+    MyCheckStatusReturn(status, "MetaDataManagerNode::installCallbacks() failed");
+
     status = plugin.registerUI("InitMetaDataUI","UninitMetaDataUI");
     MyCheckStatusReturn(status, "registerUI failed");
 
@@ -110,6 +135,12 @@ MStatus uninitializePlugin( MObject obj)
 	MStatus   status;
 	MFnPlugin plugin( obj );
 
+    lrutils::clearControllerPrototypes();
+    NodeNameIndex::uninstall();
+    MetaDataManagerNode::removeCallbacks();
+    //the worker threads can't outlive the plugin's code
+    WorkerPool::releaseShared();
+
     status = plugin.deregisterCommand( "updateMetaDataManager" );
     if (!status) {
         status.perror("deregisterCommand failed");
@@ -141,6 +172,24 @@ MStatus uninitializePlugin( MObject obj)
     }
 
     status = plugin.deregisterCommand( "getMetaChildById" );
+    if (!status) {
+        status.perror("deregisterCommand failed");
+        return status;
+    }
+
+    status = plugin.deregisterCommand( "rigBenchmark" );
+    if (!status) {
+        status.perror("deregisterCommand failed");
+        return status;
+    }
+
+    status = plugin.deregisterCommand( "rigProfile" );
+    if (!status) {
+        status.perror("deregisterCommand failed");
+        return status;
+    }
+
+    status = plugin.deregisterCommand( "nodeNameIndex" );
     if (!status) {
         status.perror("deregisterCommand failed");
         return status;
@@ -0,0 +1,121 @@
+/***************************************************************
+* Summary: Checks the maintain offsets createParentConstraint  *
+*          and addParentConstraintTarget write against the     *
+*          ones parentConstraint -mo gives the same nodes,     *
+*          with rotate pivots moved off the origin on the      *
+*          driver, the driven node or both.                    *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../Constraints.h"
+#include "../LoadRigUtils.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MDagPath.h>
+#include <maya/MMatrix.h>
+#include <maya/MStringArray.h>
+#include <string>
+
+namespace {
+
+const double kTolerance = 1.0e-5;
+const char * kOffsetAttrs[6] = {
+    "targetOffsetTranslateX", "targetOffsetTranslateY", "targetOffsetTranslateZ",
+    "targetOffsetRotateX", "targetOffsetRotateY", "targetOffsetRotateZ"
+};
+
+MObject getObj(MString name) {
+    MObject obj;
+    lrutils::getObjFromName(name, obj);
+    return obj;
+}
+
+MMatrix getWorldMatrix(MString name) {
+    MDagPath path;
+    MDagPath::getAPathTo(getObj(name), path);
+    return path.inclusiveMatrix();
+}
+
+//a transform placed with xform, its rotate pivot given in object space
+void makeTransform(MString name, MString parent, MString placement, MString rotatePivot) {
+    MGlobal::executeCommand("createNode transform -n \""+name+"\";");
+    if(parent.length() > 0)
+        MGlobal::executeCommand("parent \""+name+"\" \""+parent+"\";");
+    MGlobal::executeCommand("xform -os "+placement+" \""+name+"\";");
+    MGlobal::executeCommand("setAttr \""+name+".rotatePivot\" "+rotatePivot+";");
+}
+
+double getOffset(MString constraintName, unsigned int target, const char * attr) {
+    double value = 0.0;
+    MString targetIndex;
+    targetIndex += (int)target;
+    MGlobal::executeCommand("getAttr \""+constraintName+".target["+targetIndex+"]."+attr+"\";", value);
+    return value;
+}
+
+void checkOffsets(MString constraintName, MString commandName, unsigned int target, const char * what) {
+    for(unsigned int i = 0; i < 6; i++) {
+        double value = getOffset(constraintName, target, kOffsetAttrs[i]);
+        double expected = getOffset(commandName, target, kOffsetAttrs[i]);
+        if(!lrtest::isClose(value, expected, kTolerance))
+            lrtest::fail(__FILE__, __LINE__, (std::string(what) + " " + kOffsetAttrs[i]).c_str());
+    }
+}
+
+//builds the driver and two copies of the driven node, one constrained with parentConstraint -mo and one
+//with createParentConstraint, and compares their offsets and that neither driven node moved
+void compareWithCommand(MString name, MString driverPivot, MString drivenPivot) {
+    MString group = name + "Group";
+    MString driver = name + "Driver";
+    MString driven = name + "Driven";
+    MString commandDriven = name + "CommandDriven";
+    makeTransform(group, "", "-t 0 2 -1 -ro 0 30 0", "0 0 0");
+    makeTransform(driver, "", "-t 1 2 3 -ro 20 -35 10", driverPivot);
+    makeTransform(driven, group, "-t -2 1 4 -ro 15 40 -25", drivenPivot);
+    makeTransform(commandDriven, group, "-t -2 1 4 -ro 15 40 -25", drivenPivot);
+    MMatrix drivenBefore = getWorldMatrix(driven);
+
+    MStringArray result;
+    MGlobal::executeCommand("parentConstraint -mo \""+driver+"\" \""+commandDriven+"\";", result);
+    LR_CHECK( result.length() == 1 );
+    MObject constraintObj;
+    LR_CHECK( lrutils::createParentConstraint(getObj(driver), getObj(driven), constraintObj, true) == MS::kSuccess );
+    if(result.length() != 1 || constraintObj.isNull())
+        return;
+
+    checkOffsets(driven + "_parentConstraint1", result[0], 0, name.asChar());
+    LR_CHECK( getWorldMatrix(driven).isEquivalent(drivenBefore, kTolerance) );
+    LR_CHECK( getWorldMatrix(commandDriven).isEquivalent(drivenBefore, kTolerance) );
+
+    //a second driver added to each constraint, with its own pivot
+    MString secondDriver = name + "SecondDriver";
+    makeTransform(secondDriver, group, "-t 3 -1 0 -ro -10 0 55", "0.5 -1 2");
+    MGlobal::executeCommand("parentConstraint -mo \""+secondDriver+"\" \""+commandDriven+"\";");
+    LR_CHECK( lrutils::addParentConstraintTarget(constraintObj, getObj(secondDriver), true) == MS::kSuccess );
+    checkOffsets(driven + "_parentConstraint1", result[0], 1, (name + " added target").asChar());
+    LR_CHECK( getWorldMatrix(driven).isEquivalent(getWorldMatrix(commandDriven), kTolerance) );
+}
+
+void testPivots() {
+    //the plain case the offsets were written for
+    compareWithCommand("noPivot", "0 0 0", "0 0 0");
+    compareWithCommand("driverPivot", "1 -2 0.5", "0 0 0");
+    compareWithCommand("drivenPivot", "0 0 0", "-1.5 0 3");
+    compareWithCommand("bothPivots", "1 -2 0.5", "-1.5 0 3");
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    testPivots();
+    int result = lrtest::finish("ConstraintsTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
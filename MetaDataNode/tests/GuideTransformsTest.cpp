@@ -0,0 +1,146 @@
+/***************************************************************
+* Summary: Checks GuideTransforms against fixture matrices for *
+*          a global, hip and spine guide tree read from xml,   *
+*          and that matches() catches a wrong matrix. Needs no *
+*          scene.                                              *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../GuideTransforms.h"
+#include "../XmlGuide.h"
+#include <rapidxml.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+//the scales are baked into the controller shapes, so they must not reach the matrices
+const char * kFixtureXml =
+    "<rig name=\"fixture\" version=\"1.0\">"
+    "<component type=\"global\" name=\"global\" version=\"1.0\" rigId=\"1\" color=\"yellow\" icon=\"global\">"
+        "<location localX=\"0\" localY=\"0\" localZ=\"0\" scaleX=\"3\" scaleY=\"3\" scaleZ=\"3\"/>"
+        "<component type=\"hip\" name=\"hip\" version=\"1.0\" rigId=\"2\" color=\"red\" icon=\"hip\">"
+            "<location localX=\"0\" localY=\"10\" localZ=\"0\" scaleX=\".9\" scaleY=\".9\" scaleZ=\".9\"/>"
+            "<component type=\"spine\" name=\"spine\" version=\"1.0\" rigId=\"3\" color=\"blue\" parentJoint=\"0\" kinematicType=\"FK\" fkIcon=\"circle\">"
+                "<shoulderControl icon=\"square\" color=\"blue\" localX=\"0\" localY=\"18\" localZ=\"0\"/>"
+                "<location localX=\"0\" localY=\"12\" localZ=\"0\" rotateZ=\"90\">"
+                    "<location localX=\"0\" localY=\"15\" localZ=\"0\" rotateZ=\"90\">"
+                        "<location localX=\"0\" localY=\"18\" localZ=\"2\" rotateX=\"90\"/>"
+                    "</location>"
+                "</location>"
+            "</component>"
+        "</component>"
+    "</component>"
+    "</rig>";
+
+//the guide locations only differ by their positions and quarter turns, so the
+//recorded matrices are exact up to the 3.141592 GuideTransforms converts degrees with
+const double kTolerance = 1.0e-5;
+
+MMatrix makeMatrix(double r00, double r01, double r02,
+                   double r10, double r11, double r12,
+                   double r20, double r21, double r22,
+                   double tx, double ty, double tz) {
+    MMatrix matrix;
+    matrix[0][0] = r00; matrix[0][1] = r01; matrix[0][2] = r02;
+    matrix[1][0] = r10; matrix[1][1] = r11; matrix[1][2] = r12;
+    matrix[2][0] = r20; matrix[2][1] = r21; matrix[2][2] = r22;
+    matrix[3][0] = tx; matrix[3][1] = ty; matrix[3][2] = tz;
+    return matrix;
+}
+
+//world matrices of every location in component tree order: global, hip, spine 0, 1 and 2
+std::vector<MMatrix> getExpectedWorldMatrices() {
+    std::vector<MMatrix> expected;
+    expected.push_back( makeMatrix(1,0,0, 0,1,0, 0,0,1, 0,0,0) );
+    expected.push_back( makeMatrix(1,0,0, 0,1,0, 0,0,1, 0,10,0) );
+    //rotateZ 90
+    expected.push_back( makeMatrix(0,1,0, -1,0,0, 0,0,1, 0,12,0) );
+    expected.push_back( makeMatrix(0,1,0, -1,0,0, 0,0,1, 0,15,0) );
+    //rotateX 90
+    expected.push_back( makeMatrix(1,0,0, 0,0,1, 0,-1,0, 0,18,2) );
+    return expected;
+}
+
+boost::shared_ptr<ComponentGuide> readFixture(std::vector<char> & xmlText, rapidxml::xml_document<> & doc) {
+    std::string xml(kFixtureXml);
+    xmlText.assign(xml.begin(), xml.end());
+    xmlText.push_back('\0');
+    doc.parse<rapidxml::parse_no_data_nodes>(&xmlText[0]);
+    XmlGuide xmlGuide;
+    return xmlGuide.recursiveGuideCreate(doc.first_node()->first_node("component"), boost::shared_ptr<ComponentGuide>());
+}
+
+void testWorldMatrices(GuideTransforms & transforms, boost::shared_ptr<ComponentGuide> globalGuide) {
+    std::vector<MMatrix> expected = getExpectedWorldMatrices();
+    LR_CHECK( transforms.getNumMatrices() == expected.size() );
+    for(unsigned int i = 0; i < transforms.getWorldMatrices().size() && i < expected.size(); i++) {
+        if(!transforms.getWorldMatrices()[i].isEquivalent(expected[i], kTolerance))
+            lrtest::fail(__FILE__, __LINE__, "world matrix of a location");
+    }
+
+    boost::shared_ptr<ComponentGuide> hipGuide = globalGuide->getChildCompGuide(0);
+    boost::shared_ptr<ComponentGuide> spineGuide = hipGuide->getChildCompGuide(0);
+    LR_CHECK( transforms.getWorldMatrix(hipGuide, 0).isEquivalent(expected[1], kTolerance) );
+    LR_CHECK( transforms.getWorldMatrix(spineGuide, 2).isEquivalent(expected[4], kTolerance) );
+    //out of range locations give the identity
+    LR_CHECK( transforms.getWorldMatrix(spineGuide, 3).isEquivalent(MMatrix::identity) );
+}
+
+void testLocalMatrices(GuideTransforms & transforms, boost::shared_ptr<ComponentGuide> globalGuide) {
+    boost::shared_ptr<ComponentGuide> hipGuide = globalGuide->getChildCompGuide(0);
+    boost::shared_ptr<ComponentGuide> spineGuide = hipGuide->getChildCompGuide(0);
+
+    //the hip is under the global location
+    LR_CHECK( transforms.getLocalMatrix(hipGuide, 0).isEquivalent(makeMatrix(1,0,0, 0,1,0, 0,0,1, 0,10,0), kTolerance) );
+    //the first spine location is under the hip
+    LR_CHECK( transforms.getLocalMatrix(spineGuide, 0).isEquivalent(makeMatrix(0,1,0, -1,0,0, 0,0,1, 0,2,0), kTolerance) );
+    //the second is 3 up in the world, along the first one's X axis
+    LR_CHECK( transforms.getLocalMatrix(spineGuide, 1).isEquivalent(makeMatrix(1,0,0, 0,1,0, 0,0,1, 3,0,0), kTolerance) );
+    //the third turns from rotateZ 90 to rotateX 90
+    LR_CHECK( transforms.getLocalMatrix(spineGuide, 2).isEquivalent(makeMatrix(0,-1,0, 0,0,1, -1,0,0, 3,0,2), kTolerance) );
+
+    //the chain helper agrees with the table
+    std::vector<MMatrix> chain = GuideTransforms::getChainLocalMatrices(spineGuide->getLocations(), transforms.getWorldMatrix(hipGuide, 0));
+    LR_CHECK( chain.size() == 3 );
+    for(unsigned int i = 0; i < chain.size(); i++) {
+        if(!chain[i].isEquivalent(transforms.getLocalMatrix(spineGuide, i), kTolerance))
+            lrtest::fail(__FILE__, __LINE__, "chain local matrix");
+    }
+}
+
+void testMatches(GuideTransforms & transforms) {
+    std::vector<MMatrix> expected = getExpectedWorldMatrices();
+    unsigned int firstMismatch = 99;
+    LR_CHECK( transforms.matches(expected, kTolerance, &firstMismatch) );
+    LR_CHECK( firstMismatch == 99 );
+
+    //a moved location is reported, and the locations before it aren't
+    std::vector<MMatrix> moved = expected;
+    moved[3][3][1] += 0.01;
+    LR_CHECK( !transforms.matches(moved, kTolerance, &firstMismatch) );
+    LR_CHECK( firstMismatch == 3 );
+
+    //so is a missing one
+    std::vector<MMatrix> missing = expected;
+    missing.pop_back();
+    LR_CHECK( !transforms.matches(missing, kTolerance, &firstMismatch) );
+    LR_CHECK( firstMismatch == 4 );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    std::vector<char> xmlText;
+    rapidxml::xml_document<> doc;
+    boost::shared_ptr<ComponentGuide> globalGuide = readFixture(xmlText, doc);
+    LR_CHECK( globalGuide );
+    if(globalGuide) {
+        GuideTransforms transforms(globalGuide);
+        testWorldMatrices(transforms, globalGuide);
+        testLocalMatrices(transforms, globalGuide);
+        testMatches(transforms);
+    }
+    return lrtest::finish("GuideTransformsTest");
+}
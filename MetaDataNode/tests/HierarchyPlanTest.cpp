@@ -0,0 +1,147 @@
+/***************************************************************
+* Summary: Checks that a HierarchyPlan moves each node once to *
+*          its last planned parent, keeps world transforms     *
+*          through the moves, places nodes in world space      *
+*          without moving them and counts the work it elided.  *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../HierarchyPlan.h"
+#include "../LoadRigUtils.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MDagPath.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnIkJoint.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MQuaternion.h>
+#include <maya/MVectorArray.h>
+
+namespace {
+
+const double kTolerance = 1.0e-6;
+
+MObject makeNode(MString type, MString name, MString placement) {
+    MGlobal::executeCommand("createNode "+type+" -n \""+name+"\";");
+    MGlobal::executeCommand("xform -ws "+placement+" \""+name+"\";");
+    MObject obj;
+    lrutils::getObjFromName(name, obj);
+    return obj;
+}
+
+MMatrix getWorldMatrix(MObject obj) {
+    MDagPath path;
+    MDagPath::getAPathTo(obj, path);
+    return path.inclusiveMatrix();
+}
+
+//the name of the node's parent, "world" at the top of the hierarchy
+MString getParentName(MObject obj) {
+    MFnDagNode dagFn( obj );
+    MObject parentObj = dagFn.parent(0);
+    if(parentObj.hasFn(MFn::kWorld))
+        return "world";
+    return MFnDagNode(parentObj).name();
+}
+
+void testLastParentWins() {
+    HierarchyPlan::resetSessionReport();
+    MObject firstGroup = makeNode("transform", "firstGroup", "-t 0 4 0");
+    MObject group = makeNode("transform", "finalGroup", "-t 5 0 0 -ro 0 0 90");
+    MObject node = makeNode("transform", "node", "-t 1 2 3 -ro 0 45 0");
+    MMatrix worldBefore = getWorldMatrix(node);
+
+    HierarchyPlan plan;
+    plan.setParent(node, firstGroup);
+    plan.setParent(node, group);
+    LR_CHECK( plan.getNumPlannedNodes() == 1 );
+    LR_CHECK( plan.apply() == MS::kSuccess );
+
+    LR_CHECK( getParentName(node) == "finalGroup" );
+    LR_CHECK( getWorldMatrix(node).isEquivalent(worldBefore, kTolerance) );
+    HierarchyPlan::Report report = HierarchyPlan::getSessionReport();
+    LR_CHECK( report.plannedMoves == 2 );
+    LR_CHECK( report.elidedMoves == 1 );
+    LR_CHECK( report.reparents == 1 );
+    //the plan is emptied by apply
+    LR_CHECK( plan.getNumPlannedNodes() == 0 );
+}
+
+void testMoveToCurrentParentIsElided() {
+    HierarchyPlan::resetSessionReport();
+    MObject group = makeNode("transform", "sameGroup", "-t 0 1 0");
+    MObject node = makeNode("transform", "sameNode", "-t 2 0 0");
+    LR_CHECK( HierarchyPlan::reparent(node, group) == MS::kSuccess );
+    LR_CHECK( HierarchyPlan::reparent(node, group) == MS::kSuccess );
+    LR_CHECK( getParentName(node) == "sameGroup" );
+    HierarchyPlan::Report report = HierarchyPlan::getSessionReport();
+    LR_CHECK( report.plannedMoves == 2 );
+    LR_CHECK( report.reparents == 1 );
+    LR_CHECK( report.elidedMoves == 1 );
+
+    //back to the world
+    MMatrix worldBefore = getWorldMatrix(node);
+    LR_CHECK( HierarchyPlan::reparent(node, MObject::kNullObj) == MS::kSuccess );
+    LR_CHECK( getParentName(node) == "world" );
+    LR_CHECK( getWorldMatrix(node).isEquivalent(worldBefore, kTolerance) );
+}
+
+void testWorldPlacement() {
+    HierarchyPlan::resetSessionReport();
+    MObject group = makeNode("transform", "placementGroup", "-t 0 10 0 -ro 90 0 0");
+    MObject node = makeNode("transform", "placedNode", "-t 0 0 0");
+    HierarchyPlan::reparent(node, group);
+
+    //placed under the parent it already has, at a world position and rotation
+    MVectorArray location;
+    location.append(MVector(3, 4, 5));
+    location.append(MVector(0, 0, 90));
+    HierarchyPlan plan;
+    plan.setWorldLocation(node, location);
+    LR_CHECK( plan.apply() == MS::kSuccess );
+
+    LR_CHECK( getParentName(node) == "placementGroup" );
+    MMatrix world = getWorldMatrix(node);
+    LR_CHECK_CLOSE( world[3][0], 3.0, kTolerance );
+    LR_CHECK_CLOSE( world[3][1], 4.0, kTolerance );
+    LR_CHECK_CLOSE( world[3][2], 5.0, kTolerance );
+    //rotateZ 90 turns X to world Y, within the 3.141592 the location is converted with
+    LR_CHECK_CLOSE( world[0][1], 1.0, 1.0e-5 );
+    LR_CHECK( HierarchyPlan::getSessionReport().worldPlacements == 1 );
+}
+
+void testJointKeepsItsOrient() {
+    MObject group = makeNode("transform", "jointGroup", "-t 0 0 2 -ro 0 90 0");
+    MObject joint = makeNode("joint", "orientedJoint", "-t 1 1 1");
+    MFnIkJoint jointFn( joint );
+    MQuaternion jointOrient = MEulerRotation(0.0, 0.0, 3.14159265358979323846 / 4.0).asQuaternion();
+    jointFn.setOrientation(jointOrient);
+    MMatrix worldBefore = getWorldMatrix(joint);
+
+    LR_CHECK( HierarchyPlan::reparent(joint, group) == MS::kSuccess );
+    LR_CHECK( getParentName(joint) == "jointGroup" );
+    //the rotation under the new parent goes into rotate, the orient is left as it was
+    LR_CHECK( getWorldMatrix(joint).isEquivalent(worldBefore, kTolerance) );
+    MQuaternion orientAfter;
+    jointFn.getOrientation(orientAfter);
+    LR_CHECK( orientAfter.isEquivalent(jointOrient, kTolerance) );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    testLastParentWins();
+    testMoveToCurrentParentIsElided();
+    testWorldPlacement();
+    testJointKeepsItsOrient();
+    int result = lrtest::finish("HierarchyPlanTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
@@ -0,0 +1,187 @@
+/***************************************************************
+* Summary: Checks the joint orients solveJointOrients and      *
+*          orientJointChain give fixture chains against the    *
+*          ones joint -e -zso -oj xyz -sao yup -ch gives the   *
+*          same chains: a straight chain, bones straight up    *
+*          and down, a branching joint and a lone joint under  *
+*          a translated group.                                 *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../JointOrient.h"
+#include "../LoadRigUtils.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MDagPath.h>
+#include <maya/MFnIkJoint.h>
+#include <maya/MMatrix.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double kTolerance = 1.0e-5;
+
+struct Chain
+{
+    std::vector<MVector> positions;
+    std::vector<int> parents;
+};
+
+//a quaternion and its negation are the same rotation
+bool isSameRotation(const MQuaternion & a, const MQuaternion & b) {
+    double dot = a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;
+    return lrtest::isClose(std::fabs(dot), 1.0, kTolerance);
+}
+
+MString getJointName(MString prefix, unsigned int i) {
+    MString name = prefix;
+    name += (int)i;
+    return name;
+}
+
+MObject getObj(MString name) {
+    MObject obj;
+    lrutils::getObjFromName(name, obj);
+    return obj;
+}
+
+//builds the chain with the joint tool at its world positions, the root under group when one is given
+void buildChain(const Chain & chain, MString prefix, MString group) {
+    for(unsigned int i = 0; i < chain.positions.size(); i++) {
+        MGlobal::executeCommand("select -cl;");
+        if(chain.parents[i] >= 0)
+            MGlobal::executeCommand("select \""+getJointName(prefix, chain.parents[i])+"\";");
+        MString position;
+        position += chain.positions[i].x; position += " ";
+        position += chain.positions[i].y; position += " ";
+        position += chain.positions[i].z;
+        MGlobal::executeCommand("joint -p "+position+" -n \""+getJointName(prefix, i)+"\";");
+        if(chain.parents[i] < 0 && group.length() > 0)
+            MGlobal::executeCommand("parent \""+getJointName(prefix, i)+"\" \""+group+"\";");
+    }
+    MGlobal::executeCommand("select -cl;");
+}
+
+MMatrix getParentMatrix(MString name) {
+    MDagPath path;
+    MDagPath::getAPathTo(getObj(name), path);
+    return path.exclusiveMatrix();
+}
+
+//compares the orients and translations of every joint of the chain with the ones given
+void checkChain(MString prefix, unsigned int numJoints, const std::vector<MQuaternion> & jointOrients,
+    const std::vector<MVector> & localTranslations, const char * what) {
+    for(unsigned int i = 0; i < numJoints; i++) {
+        MFnIkJoint jointFn( getObj(getJointName(prefix, i)) );
+        MQuaternion orient;
+        jointFn.getOrientation(orient);
+        std::string joint = std::string(what) + " " + getJointName(prefix, i).asChar();
+        if(!isSameRotation(orient, jointOrients[i]))
+            lrtest::fail(__FILE__, __LINE__, (joint + " orient").c_str());
+        if(!jointFn.getTranslation(MSpace::kTransform).isEquivalent(localTranslations[i], kTolerance))
+            lrtest::fail(__FILE__, __LINE__, (joint + " translation").c_str());
+    }
+}
+
+//orients one copy of the chain with the joint tool and records its orients, then checks that
+//solveJointOrients gives the same and that orientJointChain writes them to a second copy
+void compareWithJointTool(const Chain & chain, MString name, MString group) {
+    unsigned int numJoints = (unsigned int)chain.positions.size();
+    MString toolPrefix = name + "Tool";
+    MString solverPrefix = name + "Solver";
+    buildChain(chain, toolPrefix, group);
+    buildChain(chain, solverPrefix, group);
+
+    MGlobal::executeCommand("joint -e -zso -oj xyz -sao yup -ch \""+getJointName(toolPrefix, 0)+"\";");
+    std::vector<MQuaternion> toolOrients(numJoints);
+    std::vector<MVector> toolTranslations(numJoints);
+    for(unsigned int i = 0; i < numJoints; i++) {
+        MFnIkJoint jointFn( getObj(getJointName(toolPrefix, i)) );
+        jointFn.getOrientation(toolOrients[i]);
+        toolTranslations[i] = jointFn.getTranslation(MSpace::kTransform);
+    }
+
+    std::vector<MQuaternion> jointOrients;
+    std::vector<MVector> localTranslations;
+    lrutils::solveJointOrients(chain.positions, chain.parents, getParentMatrix(getJointName(toolPrefix, 0)), jointOrients, localTranslations);
+    LR_CHECK( jointOrients.size() == numJoints );
+    LR_CHECK( localTranslations.size() == numJoints );
+    if(jointOrients.size() == numJoints && localTranslations.size() == numJoints)
+        checkChain(toolPrefix, numJoints, jointOrients, localTranslations, "solveJointOrients");
+
+    LR_CHECK( lrutils::orientJointChain(getObj(getJointName(solverPrefix, 0))) == MS::kSuccess );
+    checkChain(solverPrefix, numJoints, toolOrients, toolTranslations, "orientJointChain");
+}
+
+Chain makeChain(const MVector * positions, const int * parents, unsigned int numJoints) {
+    Chain chain;
+    chain.positions.assign(positions, positions + numJoints);
+    chain.parents.assign(parents, parents + numJoints);
+    return chain;
+}
+
+void testStraightChain() {
+    //three joints along world Z
+    const MVector positions[] = { MVector(0, 0, 0), MVector(0, 0, 3), MVector(0, 0, 6) };
+    const int parents[] = { -1, 0, 1 };
+    compareWithJointTool(makeChain(positions, parents, 3), "straight", "");
+}
+
+void testVerticalBones() {
+    //the second bone points straight up, so world up can't pick its Y axis
+    const MVector positions[] = { MVector(0, 0, 0), MVector(2, 0, 0), MVector(2, 3, 0) };
+    const int parents[] = { -1, 0, 1 };
+    compareWithJointTool(makeChain(positions, parents, 3), "up", "");
+
+    //and straight down
+    const MVector downPositions[] = { MVector(0, 0, 0), MVector(2, 0, 0), MVector(2, -3, 0) };
+    compareWithJointTool(makeChain(downPositions, parents, 3), "down", "");
+}
+
+void testBranchingJoint() {
+    //two leaves of one parent
+    const MVector positions[] = { MVector(0, 0, 0), MVector(-4, 0, 0), MVector(0, 0, 4) };
+    const int parents[] = { -1, 0, 0 };
+    compareWithJointTool(makeChain(positions, parents, 3), "branch", "");
+}
+
+void testLoneJoint() {
+    //a lone joint has nothing to aim at
+    MGlobal::executeCommand("createNode transform -n \"loneGroup\";");
+    MGlobal::executeCommand("xform -t 1 5 -2 \"loneGroup\";");
+    const MVector positions[] = { MVector(1, 7, -2) };
+    const int parents[] = { -1 };
+    compareWithJointTool(makeChain(positions, parents, 1), "lone", "loneGroup");
+}
+
+void testEmptyChain() {
+    std::vector<MVector> positions;
+    std::vector<int> parents;
+    std::vector<MQuaternion> jointOrients(1);
+    std::vector<MVector> localTranslations(1);
+    lrutils::solveJointOrients(positions, parents, MMatrix::identity, jointOrients, localTranslations);
+    LR_CHECK( jointOrients.empty() );
+    LR_CHECK( localTranslations.empty() );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    testStraightChain();
+    testVerticalBones();
+    testBranchingJoint();
+    testLoneJoint();
+    testEmptyChain();
+    int result = lrtest::finish("JointOrientTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
@@ -0,0 +1,137 @@
+/***************************************************************
+* Summary: Checks that a component's metadata node is only     *
+*          matched by its own rig and component name, when     *
+*          names are prefixes of one another or hold           *
+*          underscores, and only by its own rigId, in the      *
+*          scene and in a MetaNetworkSnapshot, when rigIds are *
+*          prefixes or suffixes of one another.                *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../LoadRigUtils.h"
+#include "../MetaNetworkSnapshot.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MFnDependencyNode.h>
+
+namespace {
+
+void testStripPrefix() {
+    LR_CHECK( lrutils::stripMetaNodePrefix("MSN_myRig_spine") == "myRig_spine" );
+    LR_CHECK( lrutils::stripMetaNodePrefix("MGN_my_rig_global") == "my_rig_global" );
+    LR_CHECK( lrutils::stripMetaNodePrefix("character:MHN_rig_hip") == "rig_hip" );
+    LR_CHECK( lrutils::stripMetaNodePrefix("metaRoot") == "metaRoot" );
+}
+
+void testNumberedComponents() {
+    //"1" is a prefix of "12" and a suffix of "21"
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MSN_rig_1", "rig", "1") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_1", "rig", "12") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_1", "rig", "21") );
+
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MSN_rig_12", "rig", "12") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_12", "rig", "1") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_12", "rig", "2") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_12", "rig", "21") );
+
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MSN_rig_21", "rig", "21") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_21", "rig", "1") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_21", "rig", "12") );
+}
+
+void testUnderscoredRigNames() {
+    //the component name starts after the rig name, not after the second underscore
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MGN_my_rig_spine", "my_rig", "spine") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MGN_my_rig_spine", "my_rig", "rig_spine") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MGN_my_rig_spine", "rig", "spine") );
+
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MSN_rig_1_2", "rig_1", "2") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_1_2", "rig_1", "1_2") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_1_2", "rig", "2") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_rig_1_2", "rig_12", "2") );
+
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MSN_a_b_12", "a_b", "12") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_a_b_12", "a_b", "2") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MSN_a_b_12", "a_b", "b_12") );
+
+    //components with underscores of their own
+    LR_CHECK( lrutils::isMetaNodeOfComponent("MHN_my_rig_left_hip", "my_rig", "left_hip") );
+    LR_CHECK( !lrutils::isMetaNodeOfComponent("MHN_my_rig_left_hip", "my_rig", "hip") );
+}
+
+//a network node with the attributes the metadata queries look up by name, under metaParent when one is given
+MObject makeMetaNode(MString name, MString rigId, MString metaParent) {
+    MGlobal::executeCommand("createNode network -n \""+name+"\";");
+    MGlobal::executeCommand("addAttr -ln metaParent -dt \"string\" \""+name+"\";");
+    MGlobal::executeCommand("addAttr -ln metaChildren -dt \"string\" \""+name+"\";");
+    MGlobal::executeCommand("addAttr -ln rigId -dt \"string\" \""+name+"\";");
+    MGlobal::executeCommand("setAttr -type \"string\" \""+name+".rigId\" \""+rigId+"\";");
+    if(metaParent.length() > 0)
+        MGlobal::executeCommand("connectAttr \""+metaParent+".metaChildren\" \""+name+".metaParent\";");
+    MObject obj;
+    lrutils::getObjFromName(name, obj);
+    return obj;
+}
+
+MString getName(MObject obj) {
+    return MFnDependencyNode(obj).name();
+}
+
+//each rigId finds its own child and no other, whichever child is connected first
+void checkRigIds(MObject metaRootObj) {
+    MObject childObj;
+    LR_CHECK( lrutils::getMetaChildByRigId(metaRootObj, "1", childObj) == MS::kSuccess );
+    LR_CHECK( getName(childObj) == "MSN_rig_1" );
+    LR_CHECK( lrutils::getMetaChildByRigId(metaRootObj, "12", childObj) == MS::kSuccess );
+    LR_CHECK( getName(childObj) == "MSN_rig_12" );
+    LR_CHECK( lrutils::getMetaChildByRigId(metaRootObj, "21", childObj) == MS::kSuccess );
+    LR_CHECK( getName(childObj) == "MSN_rig_21" );
+    //"2" is in both "12" and "21"
+    LR_CHECK( lrutils::getMetaChildByRigId(metaRootObj, "2", childObj) != MS::kSuccess );
+    LR_CHECK( lrutils::getMetaChildByRigId(metaRootObj, "", childObj) != MS::kSuccess );
+}
+
+void testNumberedRigIds() {
+    MObject metaRootObj = makeMetaNode("MRN_rig", "", "");
+    //the children that hold "1" are connected first
+    makeMetaNode("MSN_rig_12", "12", "MRN_rig");
+    makeMetaNode("MSN_rig_21", "21", "MRN_rig");
+    makeMetaNode("MSN_rig_1", "1", "MRN_rig");
+
+    //searching the scene's connections
+    LR_CHECK( MetaNetworkSnapshot::getCurrent() == NULL );
+    checkRigIds(metaRootObj);
+
+    //and the snapshot's rigId index
+    MetaNetworkScope scope( metaRootObj );
+    MetaNetworkSnapshot * snapshot = MetaNetworkSnapshot::getCurrent();
+    LR_CHECK( snapshot != NULL );
+    if(snapshot == NULL)
+        return;
+    LR_CHECK( snapshot->getNumNodes() == 4 );
+    MObject childObj;
+    bool found = false;
+    LR_CHECK( snapshot->getMetaChildByRigId(metaRootObj, "1", childObj, found) && found );
+    LR_CHECK( getName(childObj) == "MSN_rig_1" );
+    LR_CHECK( snapshot->getMetaChildByRigId(metaRootObj, "2", childObj, found) && !found );
+    checkRigIds(metaRootObj);
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    testStripPrefix();
+    testNumberedComponents();
+    testUnderscoredRigNames();
+    testNumberedRigIds();
+    int result = lrtest::finish("MetaNodeNameTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
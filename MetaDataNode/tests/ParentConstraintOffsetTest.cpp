@@ -0,0 +1,164 @@
+/***************************************************************
+* Summary: Checks setParentConstraintOffsets against the per   *
+*          attribute setAttr commands it replaced: the same    *
+*          offsets in radians, rotations in degrees where the  *
+*          old path stored radians as degrees. Also checks     *
+*          that a batch only touches the target it was given.  *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../LoadRigUtils.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MEulerRotation.h>
+#include <maya/MTransformationMatrix.h>
+#include <maya/MStringArray.h>
+#include <vector>
+
+namespace {
+
+const double kDegrees = 3.14159265358979323846 / 180.0;
+const double kTolerance = 1.0e-6;
+const char * kOffsetAttrs[6] = {
+    "targetOffsetTranslateX", "targetOffsetTranslateY", "targetOffsetTranslateZ",
+    "targetOffsetRotateX", "targetOffsetRotateY", "targetOffsetRotateZ"
+};
+
+//a constrained transform and its parentConstraint, returns the constraint's name
+MString makeConstraint(MString driven, MString drivers) {
+    MGlobal::executeCommand("createNode transform -n \""+driven+"\";");
+    MStringArray result;
+    MGlobal::executeCommand("parentConstraint "+drivers+" "+driven+";", result);
+    return result.length() > 0 ? result[0] : MString();
+}
+
+MObject getObj(MString name) {
+    MObject obj;
+    lrutils::getObjFromName(name, obj);
+    return obj;
+}
+
+//rotations are read in the UI angle unit
+double getOffset(MString constraintName, unsigned int target, const char * attr) {
+    double value = 0.0;
+    MString targetIndex;
+    targetIndex += (int)target;
+    MGlobal::executeCommand("getAttr \""+constraintName+".target["+targetIndex+"]."+attr+"\";", value);
+    return value;
+}
+
+//the per attribute setAttr path the batched writes replaced, which gave setAttr the radians from getRotation
+void setOffsetsWithSetAttr(MString constraintName, MTransformationMatrix transform) {
+    MVector vTranslation = transform.getTranslation(MSpace::kTransform);
+    double rotation[3];
+    MTransformationMatrix::RotationOrder rotOrder = MTransformationMatrix::kXYZ;
+    transform.getRotation(rotation, rotOrder);
+    double values[6] = { vTranslation.x, vTranslation.y, vTranslation.z, rotation[0], rotation[1], rotation[2] };
+    for(unsigned int i = 0; i < 6; i++) {
+        MString value;
+        value.set(values[i], 12);
+        MGlobal::executeCommand("setAttr \""+constraintName+".target[0]."+kOffsetAttrs[i]+"\" "+value+";");
+    }
+}
+
+MTransformationMatrix makeOffset(double tx, double ty, double tz, double rx, double ry, double rz) {
+    MTransformationMatrix transform;
+    transform.setTranslation(MVector(tx, ty, tz), MSpace::kTransform);
+    transform.rotateTo(MEulerRotation(rx*kDegrees, ry*kDegrees, rz*kDegrees));
+    return transform;
+}
+
+//sets the same offset on a constraint with each path, in the current UI angle unit, and compares what is
+//stored. The batched rotations are the old ones times rotationScale. Returns the batched constraint's name
+MString checkAgainstSetAttr(MString name, MTransformationMatrix offset, double rotationScale) {
+    MString batchedName = makeConstraint(name+"Batched", "driver");
+    MString setAttrName = makeConstraint(name+"SetAttr", "driver");
+
+    MStatus status = lrutils::setParentConstraintOffsets(std::vector<MObject>(1, getObj(batchedName)), std::vector<MTransformationMatrix>(1, offset));
+    LR_CHECK( status == MS::kSuccess );
+    setOffsetsWithSetAttr(setAttrName, offset);
+
+    for(unsigned int i = 0; i < 6; i++) {
+        double scale = (i < 3) ? 1.0 : rotationScale;
+        if(!lrtest::isClose(getOffset(batchedName, 0, kOffsetAttrs[i]), scale * getOffset(setAttrName, 0, kOffsetAttrs[i]), kTolerance))
+            lrtest::fail(__FILE__, __LINE__, kOffsetAttrs[i]);
+    }
+    return batchedName;
+}
+
+void testAgainstSetAttr() {
+    MGlobal::executeCommand("createNode transform -n \"driver\";");
+    //setAttr read the radians it was given in the UI unit, so with radians as the UI unit both paths agree
+    MGlobal::executeCommand("currentUnit -a radian;");
+    checkAgainstSetAttr("drivenRadians", makeOffset(0.0, 1.0, 0.0, -10.0, 20.0, 170.0), 1.0);
+    MGlobal::executeCommand("currentUnit -a degree;");
+    //with degrees the old path stored the radians as degrees, the batched rotations are the ones the offset was made from
+    MTransformationMatrix offset = makeOffset(1.0, -2.5, 4.0, 30.0, -45.0, 60.0);
+    MString batchedName = checkAgainstSetAttr("drivenDegrees", offset, 1.0 / kDegrees);
+    LR_CHECK_CLOSE( getOffset(batchedName, 0, "targetOffsetRotateX"), 30.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(batchedName, 0, "targetOffsetRotateY"), -45.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(batchedName, 0, "targetOffsetRotateZ"), 60.0, kTolerance );
+}
+
+void testIndependentOfAngleUnit() {
+    MString constraintName = makeConstraint("drivenUnit", "driver");
+    MTransformationMatrix offset = makeOffset(0.0, 1.0, 0.0, -10.0, 20.0, 170.0);
+
+    //the batched writes give radians to the plugs, so the UI unit doesn't change what is stored
+    MGlobal::executeCommand("currentUnit -a radian;");
+    MStatus status = lrutils::setParentConstraintOffset(getObj(constraintName), offset);
+    MGlobal::executeCommand("currentUnit -a degree;");
+    LR_CHECK( status == MS::kSuccess );
+    LR_CHECK_CLOSE( getOffset(constraintName, 0, "targetOffsetRotateX"), -10.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(constraintName, 0, "targetOffsetRotateY"), 20.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(constraintName, 0, "targetOffsetRotateZ"), 170.0, kTolerance );
+}
+
+void testBatchAndTargetIndex() {
+    MGlobal::executeCommand("createNode transform -n \"secondDriver\";");
+    std::vector<MObject> constraintObjs;
+    std::vector<MTransformationMatrix> offsets;
+    MString firstName = makeConstraint("drivenFirst", "driver secondDriver");
+    MString secondName = makeConstraint("drivenSecond", "driver secondDriver");
+    constraintObjs.push_back(getObj(firstName));
+    constraintObjs.push_back(getObj(secondName));
+    offsets.push_back(makeOffset(1.0, 0.0, 0.0, 0.0, 0.0, 15.0));
+    offsets.push_back(makeOffset(0.0, 2.0, 0.0, 0.0, 25.0, 0.0));
+
+    MStatus status = lrutils::setParentConstraintOffsets(constraintObjs, offsets, 1);
+    LR_CHECK( status == MS::kSuccess );
+    //each constraint gets its own offset on the second target
+    LR_CHECK_CLOSE( getOffset(firstName, 1, "targetOffsetTranslateX"), 1.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(firstName, 1, "targetOffsetRotateZ"), 15.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(secondName, 1, "targetOffsetTranslateY"), 2.0, kTolerance );
+    LR_CHECK_CLOSE( getOffset(secondName, 1, "targetOffsetRotateY"), 25.0, kTolerance );
+    //and the first target is left alone
+    for(unsigned int i = 0; i < 6; i++) {
+        if(!lrtest::isClose(getOffset(firstName, 0, kOffsetAttrs[i]), 0.0, kTolerance))
+            lrtest::fail(__FILE__, __LINE__, kOffsetAttrs[i]);
+    }
+
+    //mismatched lists write nothing
+    offsets.pop_back();
+    LR_CHECK( lrutils::setParentConstraintOffsets(constraintObjs, offsets, 0) != MS::kSuccess );
+    LR_CHECK_CLOSE( getOffset(firstName, 0, "targetOffsetTranslateX"), 0.0, kTolerance );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    MGlobal::executeCommand("currentUnit -a degree;");
+    testAgainstSetAttr();
+    testIndependentOfAngleUnit();
+    testBatchAndTargetIndex();
+    int result = lrtest::finish("ParentConstraintOffsetTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
@@ -0,0 +1,106 @@
+/***************************************************************
+* Summary: Builds and removes rig scaffolds on the in-memory   *
+*          scene backend and checks the groups, metaRoot       *
+*          values and metadata connections they leave behind.  *
+*          Needs no scene and no Maya libraries.               *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../MemorySceneBackend.h"
+#include "../RigScaffold.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef SceneBackend::NodeId NodeId;
+
+void testBuild() {
+    MemorySceneBackend scene;
+    NodeId managerNode = scene.createNode("MetaDataManagerNode", "MetaDataManager");
+    lrutils::RigScaffold scaffold;
+    LR_CHECK( lrutils::buildRigScaffold(scene, "biped", "rigs/biped.xml", 1.5, managerNode, scaffold) );
+
+    //the groups sit under the top group, which is in the world
+    LR_CHECK( scene.getName(scaffold.topGroup) == "biped_GRP" );
+    LR_CHECK( scene.getParent(scaffold.topGroup) == SceneBackend::kNullNode );
+    LR_CHECK( scene.getParent(scaffold.rigGroup) == scaffold.topGroup );
+    LR_CHECK( scene.getParent(scaffold.ctlGroup) == scaffold.topGroup );
+    LR_CHECK( scene.getParent(scaffold.noTransformGroup) == scaffold.topGroup );
+    LR_CHECK( scene.findNode("biped_Rig_GRP") == scaffold.rigGroup );
+    LR_CHECK( scene.findNode("biped_Control_GRP") == scaffold.ctlGroup );
+    LR_CHECK( scene.findNode("biped_NoTransform_GRP") == scaffold.noTransformGroup );
+
+    //the metaRoot keeps the xml it was built from and hangs under the manager
+    LR_CHECK( scene.getName(scaffold.metaRoot) == "MRN_biped" );
+    LR_CHECK( scene.getType(scaffold.metaRoot) == "MetaRootNode" );
+    std::string xmlPath;
+    LR_CHECK( scene.getString(scaffold.metaRoot, "xmlPath", xmlPath) && xmlPath == "rigs/biped.xml" );
+    double version = 0.0;
+    LR_CHECK( scene.getDouble(scaffold.metaRoot, "version", version) && version == 1.5 );
+    LR_CHECK( scene.getMetaParent(scaffold.metaRoot) == managerNode );
+    std::vector<NodeId> metaRoots;
+    scene.getConnectedNodes(managerNode, "metaRoots", true, metaRoots);
+    LR_CHECK( metaRoots.size() == 1 && metaRoots[0] == scaffold.metaRoot );
+    LR_CHECK( scene.getMetaNodeConnection(scaffold.metaRoot, "topGroup") == scaffold.topGroup );
+    LR_CHECK( scene.getMetaNodeConnection(scaffold.metaRoot, "rigGroup") == scaffold.rigGroup );
+    LR_CHECK( scene.getMetaNodeConnection(scaffold.metaRoot, "ctlGroup") == scaffold.ctlGroup );
+    LR_CHECK( scene.getMetaNodeConnection(scaffold.metaRoot, "noTransformGroup") == scaffold.noTransformGroup );
+
+    //manager, metaRoot and four groups, tied together by the manager and four group connections
+    LR_CHECK( scene.getNumNodes() == 6 );
+    LR_CHECK( scene.getNumConnections() == 5 );
+}
+
+void testNameClash() {
+    //a second rig of the same name gets numbered groups, like Maya would give it
+    MemorySceneBackend scene;
+    lrutils::RigScaffold first;
+    lrutils::RigScaffold second;
+    LR_CHECK( lrutils::buildRigScaffold(scene, "prop", "prop.xml", 1.0, SceneBackend::kNullNode, first) );
+    LR_CHECK( lrutils::buildRigScaffold(scene, "prop", "prop.xml", 1.0, SceneBackend::kNullNode, second) );
+    LR_CHECK( scene.getName(second.topGroup) == "prop_GRP1" );
+    LR_CHECK( scene.getName(second.metaRoot) == "MRN_prop1" );
+    LR_CHECK( scene.getParent(second.rigGroup) == second.topGroup );
+    LR_CHECK( scene.getMetaNodeConnection(second.metaRoot, "rigGroup") == second.rigGroup );
+}
+
+void testRemove() {
+    MemorySceneBackend scene;
+    NodeId managerNode = scene.createNode("MetaDataManagerNode", "MetaDataManager");
+    lrutils::RigScaffold scaffold;
+    LR_CHECK( lrutils::buildRigScaffold(scene, "biped", "biped.xml", 1.0, managerNode, scaffold) );
+    //the display layers are connected to the metaRoot when the rig is loaded
+    NodeId ctlLayer = scene.createNode("displayLayer", "biped_Control_LYR");
+    LR_CHECK( scene.connectMeta(scaffold.metaRoot, "ctlLayer", ctlLayer) );
+    //and something the rig built beneath its groups
+    NodeId joint = scene.createDagNode("joint", "biped_hip_JNT", scaffold.rigGroup);
+
+    LR_CHECK( lrutils::removeRigScaffold(scene, scaffold.metaRoot) );
+    LR_CHECK( !scene.isValid(scaffold.topGroup) );
+    LR_CHECK( !scene.isValid(scaffold.rigGroup) );
+    LR_CHECK( !scene.isValid(scaffold.ctlGroup) );
+    LR_CHECK( !scene.isValid(scaffold.noTransformGroup) );
+    LR_CHECK( !scene.isValid(ctlLayer) );
+    LR_CHECK( !scene.isValid(joint) );
+    LR_CHECK( scene.findNode("biped_GRP") == SceneBackend::kNullNode );
+    //the metaRoot itself is left for the rig to delete, still under the manager
+    LR_CHECK( scene.isValid(scaffold.metaRoot) );
+    LR_CHECK( scene.getNumNodes() == 2 );
+    LR_CHECK( scene.getNumConnections() == 1 );
+
+    //a metaRoot that is gone can't be removed again
+    scene.deleteNode(scaffold.metaRoot);
+    LR_CHECK( !lrutils::removeRigScaffold(scene, scaffold.metaRoot) );
+    LR_CHECK( scene.getNumConnections() == 0 );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    testBuild();
+    testNameClash();
+    testRemove();
+    return lrtest::finish("RigScaffoldTest");
+}
@@ -0,0 +1,180 @@
+/***************************************************************
+* Summary: Checks that the rig update pipeline returns its     *
+*          jobs in the order they were added, only plans the   *
+*          rigs that are out of date, reports xml problems,    *
+*          keeps no more prepare threads than its queue holds, *
+*          takes about as long as its applies when they are    *
+*          the slower stage and can be dropped part way        *
+*          through. Needs no scene, the fixture xml files are  *
+*          written to the working directory and removed        *
+*          afterwards.                                         *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../RigUpdatePipeline.h"
+#include "../Rig.h"
+#include "../RigProfiler.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const unsigned int kNumRigs = 6;
+
+struct Fixture
+{
+    std::vector<MString> paths;
+    std::vector<float> xmlVersions;
+    std::vector<float> nodeVersions;
+    std::vector<bool> exists;
+};
+
+//rig i is out of date when i is odd, and the last path names a file that doesn't exist
+Fixture writeFixture() {
+    Fixture fixture;
+    for(unsigned int i = 0; i < kNumRigs; i++) {
+        std::stringstream path;
+        path << "RigUpdatePipelineTest_" << i << ".xml";
+        float xmlVersion = 1.0f + 0.25f * i;
+        std::ofstream file(path.str().c_str());
+        file << "<rig name=\"rig" << i << "\" version=\"" << xmlVersion << "\">"
+             << "<component type=\"global\" name=\"global\" version=\"1.0\" rigId=\"1\" color=\"yellow\" icon=\"global\">"
+             << "<location localX=\"0\" localY=\"0\" localZ=\"0\" scaleX=\"1\" scaleY=\"1\" scaleZ=\"1\"/>"
+             << "</component></rig>";
+        fixture.paths.push_back(MString(path.str().c_str()));
+        fixture.xmlVersions.push_back(xmlVersion);
+        fixture.nodeVersions.push_back((i % 2 == 1) ? 0.5f : xmlVersion);
+        fixture.exists.push_back(true);
+    }
+    fixture.paths.push_back("RigUpdatePipelineTest_missing.xml");
+    fixture.xmlVersions.push_back(0.0f);
+    fixture.nodeVersions.push_back(1.0f);
+    fixture.exists.push_back(false);
+    return fixture;
+}
+
+void removeFixture(const Fixture & fixture) {
+    for(unsigned int i = 0; i < fixture.paths.size(); i++) {
+        if(fixture.exists[i])
+            std::remove(fixture.paths[i].asChar());
+    }
+}
+
+void addJobs(RigUpdatePipeline & pipeline, const Fixture & fixture) {
+    for(unsigned int i = 0; i < fixture.paths.size(); i++) {
+        pipeline.addJob(MObject::kNullObj, fixture.paths[i], fixture.nodeVersions[i]);
+    }
+}
+
+void runPipeline(const Fixture & fixture, bool forceUpdate, unsigned int numThreads, unsigned int capacity) {
+    RigUpdatePipeline pipeline(forceUpdate, numThreads, capacity);
+    addJobs(pipeline, fixture);
+    pipeline.start();
+    LR_CHECK( pipeline.getNumJobs() == fixture.paths.size() );
+    //threads beyond the queue's capacity would only wait
+    LR_CHECK( pipeline.getNumPrepareThreads() <= capacity );
+
+    unsigned int numReturned = 0;
+    for(RigUpdatePipeline::Job * job = pipeline.next(); job != NULL; job = pipeline.next()) {
+        unsigned int i = numReturned++;
+        if(i >= fixture.paths.size()) {
+            lrtest::fail(__FILE__, __LINE__, "more jobs returned than added");
+            break;
+        }
+        //jobs come back in the order they were added, however the threads finish
+        LR_CHECK( job->xmlPath == fixture.paths[i] );
+        if(fixture.exists[i]) {
+            LR_CHECK( job->status == MS::kSuccess );
+            LR_CHECK( job->errors.length() == 0 );
+            LR_CHECK( job->xmlVersion == fixture.xmlVersions[i] );
+            bool outOfDate = forceUpdate || fixture.nodeVersions[i] != fixture.xmlVersions[i];
+            LR_CHECK( (bool)job->pRig == outOfDate );
+        } else {
+            LR_CHECK( job->status != MS::kSuccess );
+            LR_CHECK( job->errors.length() > 0 );
+            LR_CHECK( !job->pRig );
+        }
+    }
+    LR_CHECK( numReturned == fixture.paths.size() );
+    //and it stays finished
+    LR_CHECK( pipeline.next() == NULL );
+}
+
+void testOrderAndPlanning(const Fixture & fixture) {
+    runPipeline(fixture, false, 3, 2);
+    runPipeline(fixture, false, 1, 1);
+    //more threads than jobs
+    runPipeline(fixture, false, 16, 16);
+    runPipeline(fixture, true, 3, 2);
+}
+
+//stands in for applying a rig to the scene, which the test has no scene for
+void spin(double seconds) {
+    double start = RigProfiler::now();
+    while(RigProfiler::now() - start < seconds) {}
+}
+
+void testReport(const Fixture & fixture) {
+    //applying is the slower stage here, so the plans are ready before they are asked for
+    //and the pipeline takes about as long as the applies
+    const double kApplyTime = 0.02;
+    RigUpdatePipeline pipeline(true, 2, 2);
+    addJobs(pipeline, fixture);
+    pipeline.start();
+    unsigned int numApplied = 0;
+    for(RigUpdatePipeline::Job * job = pipeline.next(); job != NULL; job = pipeline.next()) {
+        spin(kApplyTime);
+        numApplied++;
+    }
+    RigUpdatePipeline::Report report = pipeline.getReport();
+    LR_CHECK( report.numJobs == fixture.paths.size() );
+    LR_CHECK( report.numPrepareThreads == 2 );
+    LR_CHECK( report.capacity == 2 );
+    LR_CHECK( report.applyTime >= numApplied * kApplyTime );
+    LR_CHECK( report.wallTime >= report.applyTime );
+    //what is left is the wait for the first plan
+    LR_CHECK( report.wallTime - report.applyTime < kApplyTime );
+    LR_CHECK( report.applyUtilization > 0.85 && report.applyUtilization <= 1.0 );
+    LR_CHECK( report.prepareTime > 0.0 );
+    LR_CHECK( report.prepareUtilization > 0.0 && report.prepareUtilization <= 1.0 );
+    //the wall time stops when the last job is done with
+    spin(kApplyTime);
+    LR_CHECK( pipeline.getReport().wallTime == report.wallTime );
+
+    //the line updateMetaDataManager -utilization returns
+    std::stringstream expected;
+    expected << "rig pipeline: " << fixture.paths.size() << " rigs, 2 prepare threads, queue of 2, wall ";
+    std::string text = report.toString().asChar();
+    LR_CHECK( text.find(expected.str()) == 0 );
+    LR_CHECK( text.find("% utilized") != std::string::npos );
+}
+
+void testDroppedPartWay(const Fixture & fixture) {
+    //destroying the pipeline with jobs left stops the prepare threads instead of waiting on the queue
+    RigUpdatePipeline * pipeline = new RigUpdatePipeline(true, 2, 1);
+    addJobs(*pipeline, fixture);
+    pipeline->start();
+    RigUpdatePipeline::Job * job = pipeline->next();
+    LR_CHECK( job != NULL );
+    delete pipeline;
+
+    //and so does one that was never started
+    pipeline = new RigUpdatePipeline(true, 2, 1);
+    addJobs(*pipeline, fixture);
+    delete pipeline;
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    Fixture fixture = writeFixture();
+    testOrderAndPlanning(fixture);
+    testReport(fixture);
+    testDroppedPartWay(fixture);
+    removeFixture(fixture);
+    return lrtest::finish("RigUpdatePipelineTest");
+}
@@ -0,0 +1,192 @@
+/***************************************************************
+* Summary: Checks the SceneOpList peephole passes that drop    *
+*          overwritten stores, coalesce repeated parents and   *
+*          create nodes under their final parent, and the ops  *
+*          that must stop each of them. Only optimizes, so it  *
+*          needs no scene.                                     *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../SceneOpList.h"
+#include <vector>
+
+namespace {
+
+typedef SceneOpList::NodeRef NodeRef;
+
+//the live ops of the given type, in the order they will be applied
+std::vector<SceneOpList::Op> getLiveOps(const SceneOpList & ops, SceneOpList::OpType type) {
+    std::vector<SceneOpList::Op> live;
+    for(unsigned int i = 0; i < ops.getPendingOps().size(); i++) {
+        const SceneOpList::Op & op = ops.getPendingOps()[i];
+        if(op.live && op.type == type)
+            live.push_back(op);
+    }
+    return live;
+}
+
+void testDeadStores() {
+    //only the last of several writes is kept
+    SceneOpList ops;
+    NodeRef node = ops.addExisting(MObject::kNullObj);
+    ops.setTranslation(node, MVector(1, 0, 0));
+    ops.setRotation(node, MVector(0, 1, 0));
+    ops.setTranslation(node, MVector(2, 0, 0));
+    ops.rename(node, "first");
+    ops.setRotation(node, MVector(0, 2, 0));
+    ops.rename(node, "second");
+    SceneOpList::Report report = ops.optimize();
+    LR_CHECK( report.droppedDeadStores == 3 );
+    LR_CHECK( report.opsIn == 6 && report.opsOut == 3 );
+    std::vector<SceneOpList::Op> translations = getLiveOps(ops, SceneOpList::kSetTranslation);
+    LR_CHECK( translations.size() == 1 && translations[0].vec == MVector(2, 0, 0) );
+    std::vector<SceneOpList::Op> renames = getLiveOps(ops, SceneOpList::kRename);
+    LR_CHECK( renames.size() == 1 && renames[0].name == "second" );
+
+    //a write to another node doesn't make a store dead
+    SceneOpList otherNode;
+    NodeRef first = otherNode.addExisting(MObject::kNullObj);
+    NodeRef second = otherNode.addExisting(MObject::kNullObj);
+    otherNode.setScale(first, MVector(2, 2, 2));
+    otherNode.setScale(second, MVector(3, 3, 3));
+    LR_CHECK( otherNode.optimize().droppedDeadStores == 0 );
+}
+
+void testDeadStoreBarriers() {
+    //a MEL command can read anything
+    SceneOpList command;
+    NodeRef node = command.addExisting(MObject::kNullObj);
+    command.setTranslation(node, MVector(1, 0, 0));
+    command.command("xform -q -ws -t node;");
+    command.setTranslation(node, MVector(2, 0, 0));
+    LR_CHECK( command.optimize().droppedDeadStores == 0 );
+
+    //parent keeps the world position, which it reads from the translation
+    SceneOpList parent;
+    node = parent.addExisting(MObject::kNullObj);
+    NodeRef group = parent.addExisting(MObject::kNullObj);
+    parent.setTranslation(node, MVector(1, 0, 0));
+    parent.parent(node, group);
+    parent.setTranslation(node, MVector(2, 0, 0));
+    LR_CHECK( parent.optimize().droppedDeadStores == 0 );
+
+    //orienting a joint reads the positions of its chain
+    SceneOpList orient;
+    node = orient.addExisting(MObject::kNullObj);
+    orient.setRotation(node, MVector(0, 1, 0));
+    orient.orientJoint(node);
+    orient.setRotation(node, MVector(0, 2, 0));
+    LR_CHECK( orient.optimize().droppedDeadStores == 0 );
+
+    //a lookup reads names but not transforms
+    SceneOpList lookup;
+    node = lookup.addExisting(MObject::kNullObj);
+    lookup.rename(node, "first");
+    lookup.setTranslation(node, MVector(1, 0, 0));
+    lookup.lookup("first");
+    lookup.rename(node, "second");
+    lookup.setTranslation(node, MVector(2, 0, 0));
+    SceneOpList::Report report = lookup.optimize();
+    LR_CHECK( report.droppedDeadStores == 1 );
+    LR_CHECK( getLiveOps(lookup, SceneOpList::kRename).size() == 2 );
+}
+
+void testCoalesceParents() {
+    //the last of several parents wins
+    SceneOpList ops;
+    NodeRef node = ops.addExisting(MObject::kNullObj);
+    NodeRef firstGroup = ops.addExisting(MObject::kNullObj);
+    NodeRef secondGroup = ops.addExisting(MObject::kNullObj);
+    ops.parent(node, firstGroup);
+    ops.addToLayer("ctl_LYR", node);
+    ops.parent(node, secondGroup);
+    SceneOpList::Report report = ops.optimize();
+    LR_CHECK( report.coalescedParents == 1 );
+    std::vector<SceneOpList::Op> parents = getLiveOps(ops, SceneOpList::kParent);
+    LR_CHECK( parents.size() == 1 && parents[0].target == secondGroup );
+
+    //parenting a node under the parent it was created under does nothing
+    SceneOpList created;
+    NodeRef group = created.addExisting(MObject::kNullObj);
+    node = created.createNode("transform", group);
+    created.parent(node, group);
+    report = created.optimize();
+    LR_CHECK( report.coalescedParents == 1 );
+    LR_CHECK( getLiveOps(created, SceneOpList::kParent).empty() );
+
+    //a node moved between the parents is kept where the first parent put it
+    SceneOpList moved;
+    node = moved.addExisting(MObject::kNullObj);
+    firstGroup = moved.addExisting(MObject::kNullObj);
+    secondGroup = moved.addExisting(MObject::kNullObj);
+    moved.parent(node, firstGroup);
+    moved.setTranslation(node, MVector(0, 1, 0));
+    moved.parent(node, secondGroup);
+    LR_CHECK( moved.optimize().coalescedParents == 0 );
+    LR_CHECK( getLiveOps(moved, SceneOpList::kParent).size() == 2 );
+
+    //so is one that another node was parented under in between
+    SceneOpList child;
+    node = child.addExisting(MObject::kNullObj);
+    NodeRef childNode = child.addExisting(MObject::kNullObj);
+    firstGroup = child.addExisting(MObject::kNullObj);
+    secondGroup = child.addExisting(MObject::kNullObj);
+    child.parent(node, firstGroup);
+    child.parent(childNode, node);
+    child.parent(node, secondGroup);
+    LR_CHECK( child.optimize().coalescedParents == 0 );
+}
+
+void testFuseCreateParent() {
+    //created straight under the group, the translation set before the parent becomes a world position
+    SceneOpList ops;
+    NodeRef group = ops.createNode("transform");
+    NodeRef node = ops.createNode("transform");
+    ops.rename(node, "node");
+    ops.setTranslation(node, MVector(1, 2, 3));
+    ops.parent(node, group);
+    SceneOpList::Report report = ops.optimize();
+    LR_CHECK( report.fusedParents == 1 );
+    LR_CHECK( getLiveOps(ops, SceneOpList::kParent).empty() );
+    std::vector<SceneOpList::Op> creates = getLiveOps(ops, SceneOpList::kCreate);
+    LR_CHECK( creates.size() == 2 && creates[1].node == node && creates[1].target == group );
+    std::vector<SceneOpList::Op> translations = getLiveOps(ops, SceneOpList::kSetTranslation);
+    LR_CHECK( translations.size() == 1 && translations[0].world );
+
+    //a rotation set at the world would be changed by the parent's rotation
+    SceneOpList rotated;
+    group = rotated.createNode("transform");
+    node = rotated.createNode("transform");
+    rotated.setRotation(node, MVector(0, 1, 0));
+    rotated.parent(node, group);
+    LR_CHECK( rotated.optimize().fusedParents == 0 );
+    LR_CHECK( getLiveOps(rotated, SceneOpList::kParent).size() == 1 );
+
+    //the parent has to exist when the node is created
+    SceneOpList later;
+    node = later.createNode("transform");
+    group = later.createNode("transform");
+    later.parent(node, group);
+    LR_CHECK( later.optimize().fusedParents == 0 );
+
+    //and can't move before the node is parented under it
+    SceneOpList movingParent;
+    group = movingParent.createNode("transform");
+    node = movingParent.createNode("transform");
+    movingParent.setTranslation(group, MVector(0, 5, 0));
+    movingParent.parent(node, group);
+    LR_CHECK( movingParent.optimize().fusedParents == 0 );
+    translations = getLiveOps(movingParent, SceneOpList::kSetTranslation);
+    LR_CHECK( translations.size() == 1 && !translations[0].world );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    testDeadStores();
+    testDeadStoreBarriers();
+    testCoalesceParents();
+    testFuseCreateParent();
+    return lrtest::finish("SceneOpListTest");
+}
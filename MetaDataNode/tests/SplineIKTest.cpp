@@ -0,0 +1,120 @@
+/***************************************************************
+* Summary: Checks that createCVCluster builds cluster          *
+*          deformers on a single CV each, chained one after    *
+*          the other in the curve's history and named like the *
+*          ones the cluster command made.                      *
+*          Scene test, runs Maya as a standalone application.  *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#include "TestUtils.h"
+#include "../LoadRigUtils.h"
+#include "../SplineIK.h"
+#include <maya/MLibrary.h>
+#include <maya/MGlobal.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MFnNurbsCurve.h>
+#include <maya/MPoint.h>
+#include <maya/MPlugArray.h>
+
+namespace {
+
+MObject makeCurve(MString name) {
+    MString curveName;
+    MGlobal::executeCommand("curve -d 3 -p 0 0 0 -p 0 1 0 -p 0 2 0 -p 0 3 0 -p 0 4 0 -n \""+name+"\";", curveName);
+    MObject curveObj;
+    lrutils::getObjFromName(curveName, curveObj);
+    return curveObj;
+}
+
+void testClusterOnOneCV() {
+    MObject curveObj = makeCurve("spine_stretchIK_Curve");
+    LR_CHECK( !curveObj.isNull() );
+    MFnDagNode curveTransformFn( curveObj );
+    MFnNurbsCurve curveFn( curveTransformFn.child(0) );
+
+    MObject clusterObj;
+    MObject handleObj;
+    MStatus status = lrutils::createCVCluster(curveObj, 2, "rig_spine_stretchIK_2_CLS", "rig_spine_stretchIK_cluster2_HDL", clusterObj, handleObj);
+    LR_CHECK( status == MS::kSuccess );
+    LR_CHECK( clusterObj.hasFn(MFn::kCluster) );
+    LR_CHECK( MFnDependencyNode(clusterObj).name() == "rig_spine_stretchIK_2_CLS" );
+    LR_CHECK( handleObj.hasFn(MFn::kTransform) );
+    LR_CHECK( MFnDependencyNode(handleObj).name() == "rig_spine_stretchIK_cluster2_HDL" );
+
+    //moving the handle moves that CV and no other
+    MPoint cv1Before, cv2Before, cv3Before;
+    curveFn.getCV(1, cv1Before, MSpace::kWorld);
+    curveFn.getCV(2, cv2Before, MSpace::kWorld);
+    curveFn.getCV(3, cv3Before, MSpace::kWorld);
+    MGlobal::executeCommand("setAttr rig_spine_stretchIK_cluster2_HDL.translateX 1;");
+    MPoint cv1After, cv2After, cv3After;
+    curveFn.getCV(1, cv1After, MSpace::kWorld);
+    curveFn.getCV(2, cv2After, MSpace::kWorld);
+    curveFn.getCV(3, cv3After, MSpace::kWorld);
+    LR_CHECK_CLOSE( cv2After.x - cv2Before.x, 1.0, 1e-6 );
+    LR_CHECK_CLOSE( cv1After.x, cv1Before.x, 1e-6 );
+    LR_CHECK_CLOSE( cv3After.x, cv3Before.x, 1e-6 );
+}
+
+void testClustersChain() {
+    MObject curveObj = makeCurve("chain_Curve");
+    MFnDagNode curveTransformFn( curveObj );
+    MObject firstClusterObj, firstHandleObj, secondClusterObj, secondHandleObj;
+    LR_CHECK( lrutils::createCVCluster(curveObj, 0, "rig_chain_stretchIK_0_CLS", "rig_chain_stretchIK_cluster0_HDL", firstClusterObj, firstHandleObj) == MS::kSuccess );
+    LR_CHECK( lrutils::createCVCluster(curveObj, 4, "rig_chain_stretchIK_4_CLS", "rig_chain_stretchIK_cluster4_HDL", secondClusterObj, secondHandleObj) == MS::kSuccess );
+
+    //one intermediate copy of the curve feeds both deformers
+    unsigned int numIntermediate = 0;
+    MObject curveShapeObj;
+    for(unsigned int i = 0; i < curveTransformFn.childCount(); i++) {
+        MFnDagNode childFn( curveTransformFn.child(i) );
+        if(childFn.isIntermediateObject())
+            numIntermediate++;
+        else
+            curveShapeObj = curveTransformFn.child(i);
+    }
+    LR_CHECK( numIntermediate == 1 );
+    MPlugArray inputPlugs;
+    MFnDependencyNode(curveShapeObj).findPlug("create").connectedTo(inputPlugs, true, false);
+    LR_CHECK( inputPlugs.length() == 1 && inputPlugs[0].node() == secondClusterObj );
+
+    //each handle still moves only its own CV
+    MFnNurbsCurve curveFn( curveShapeObj );
+    MPoint firstBefore, lastBefore;
+    curveFn.getCV(0, firstBefore, MSpace::kWorld);
+    curveFn.getCV(4, lastBefore, MSpace::kWorld);
+    MGlobal::executeCommand("setAttr rig_chain_stretchIK_cluster0_HDL.translateZ 2;");
+    MGlobal::executeCommand("setAttr rig_chain_stretchIK_cluster4_HDL.translateZ -1;");
+    MPoint firstAfter, lastAfter;
+    curveFn.getCV(0, firstAfter, MSpace::kWorld);
+    curveFn.getCV(4, lastAfter, MSpace::kWorld);
+    LR_CHECK_CLOSE( firstAfter.z - firstBefore.z, 2.0, 1e-6 );
+    LR_CHECK_CLOSE( lastAfter.z - lastBefore.z, -1.0, 1e-6 );
+}
+
+void testCVOutOfRange() {
+    MObject curveObj = makeCurve("short_Curve");
+    MObject clusterObj;
+    MObject handleObj;
+    //the curve command takes its points as CVs, so there are 5
+    MStatus status = lrutils::createCVCluster(curveObj, 5, "rig_short_stretchIK_5_CLS", "rig_short_stretchIK_cluster5_HDL", clusterObj, handleObj);
+    LR_CHECK( status != MS::kSuccess );
+}
+
+}
+
+int main(int argc, char * argv[]) {
+    MStatus status = MLibrary::initialize(true, argv[0], true);
+    if(!status) {
+        status.perror("MLibrary::initialize");
+        return 1;
+    }
+    testClusterOnOneCV();
+    testClustersChain();
+    testCVOutOfRange();
+    int result = lrtest::finish("SplineIKTest");
+    MLibrary::cleanup(result, false);
+    return result;
+}
@@ -0,0 +1,46 @@
+/***************************************************************
+* Summary: Checks shared by the standalone test programs. A    *
+*          failed check prints where it is and what it tested, *
+*          and the program exits non-zero if any check failed. *
+*    Date: 10/19/26                                            *
+***************************************************************/
+
+#ifndef _TestUtils
+#define _TestUtils
+
+#include <cmath>
+#include <iostream>
+
+namespace lrtest {
+    inline int & numFailures() {
+        static int s_numFailures = 0;
+        return s_numFailures;
+    }
+
+    inline void fail(const char * file, int line, const char * check) {
+        std::cerr << file << "(" << line << "): check failed: " << check << std::endl;
+        numFailures()++;
+    }
+
+    inline bool isClose(double a, double b, double tolerance) {
+        return std::fabs(a - b) <= tolerance;
+    }
+
+    //prints the result of the test program and returns its exit code
+    inline int finish(const char * testName) {
+        if(numFailures() == 0) {
+            std::cout << testName << ": passed" << std::endl;
+            return 0;
+        }
+        std::cout << testName << ": " << numFailures() << " checks failed" << std::endl;
+        return 1;
+    }
+}
+
+#define LR_CHECK(expr) \
+    do { if(!(expr)) lrtest::fail(__FILE__, __LINE__, #expr); } while(0)
+
+#define LR_CHECK_CLOSE(a, b, tolerance) \
+    do { if(!lrtest::isClose((a), (b), (tolerance))) lrtest::fail(__FILE__, __LINE__, #a " == " #b); } while(0)
+
+#endif //_TestUtils